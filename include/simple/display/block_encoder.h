@@ -0,0 +1,68 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include "buffer.h"
+
+//! @file
+
+//--------------------------------------------------------------
+//! The min number of blocks that an image must contain for it to
+//! be encoded using multiple threads, because encoding images with
+//! fewer blocks is faster than the overhead of starting threads.
+//--------------------------------------------------------------
+#ifndef BLOCK_ENCODER_THREAD_THRESHOLD_BLOCKS
+#define BLOCK_ENCODER_THREAD_THRESHOLD_BLOCKS 4096
+#endif//BLOCK_ENCODER_THREAD_THRESHOLD_BLOCKS
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Display
+{
+
+//--------------------------------------------------------------
+//! Class that compresses images into block-compressed formats.
+//!
+//! The Simple::Display::BlockEncoder class encodes RGBA_UINT8
+//! pixels into the blocks of a block-compressed format, which can
+//! then be written to a display buffer of the same format, so that
+//! large static images use a fraction of the memory and bandwidth.
+//!
+//! Each block encodes 4x4 pixels, with the pixels of any partial
+//! blocks at the right and bottom edges of the image clamped to
+//! the nearest edge pixel. Rows of blocks are encoded in bands by
+//! separate threads, so encoding is intended to be done once (for
+//! example when an image is loaded) rather than every frame.
+//!
+//! The encoder favors speed over quality: BC1 and BC3 colors are
+//! interpolated between the bounds of each block, and BC7 blocks
+//! are encoded using a single mode (mode 6) for all pixels.
+//--------------------------------------------------------------
+class BlockEncoder
+{
+public:
+    static bool Encode(const void* a_pixels,
+                       uint32_t a_width,
+                       uint32_t a_height,
+                       uint64_t a_pitch,
+                       Buffer::Format a_format,
+                       void* o_blocks,
+                       uint64_t a_blockPitch,
+                       uint32_t a_threadCount = 0);
+    static bool Encode(const void* a_pixels,
+                       uint64_t a_pitch,
+                       Buffer& o_buffer,
+                       uint32_t a_threadCount = 0);
+
+    BlockEncoder() = delete;
+};
+
+} // namespace Display
+} // namespace Simple
@@ -40,6 +40,71 @@
 #define DEFAULT_BUFFER_INTEROP Interop::HOST
 #endif//DEFAULT_BUFFER_INTEROP
 
+//--------------------------------------------------------------
+//! The default display storage of any display buffer.
+//--------------------------------------------------------------
+#ifndef DEFAULT_BUFFER_STORAGE
+#define DEFAULT_BUFFER_STORAGE Storage::NATIVE
+#endif//DEFAULT_BUFFER_STORAGE
+
+//--------------------------------------------------------------
+//! The default row pitch alignment (in bytes) of display buffers.
+//--------------------------------------------------------------
+#ifndef DEFAULT_BUFFER_PITCH_ALIGNMENT
+#define DEFAULT_BUFFER_PITCH_ALIGNMENT 1
+#endif//DEFAULT_BUFFER_PITCH_ALIGNMENT
+
+//--------------------------------------------------------------
+//! The default memory layout of the pixels in display buffers.
+//--------------------------------------------------------------
+#ifndef DEFAULT_BUFFER_LAYOUT
+#define DEFAULT_BUFFER_LAYOUT Layout::LINEAR
+#endif//DEFAULT_BUFFER_LAYOUT
+
+//--------------------------------------------------------------
+//! The default change detection mode of any display buffer.
+//--------------------------------------------------------------
+#ifndef DEFAULT_BUFFER_DETECT_CHANGES
+#define DEFAULT_BUFFER_DETECT_CHANGES false
+#endif//DEFAULT_BUFFER_DETECT_CHANGES
+
+//--------------------------------------------------------------
+//! The default scroll mode of any display buffer.
+//--------------------------------------------------------------
+#ifndef DEFAULT_BUFFER_SCROLL
+#define DEFAULT_BUFFER_SCROLL Scroll::NONE
+#endif//DEFAULT_BUFFER_SCROLL
+
+//--------------------------------------------------------------
+//! The default progressive display mode of any display buffer.
+//--------------------------------------------------------------
+#ifndef DEFAULT_BUFFER_PROGRESSIVE
+#define DEFAULT_BUFFER_PROGRESSIVE false
+#endif//DEFAULT_BUFFER_PROGRESSIVE
+
+//--------------------------------------------------------------
+//! The default number of flipbook frames of any display buffer.
+//--------------------------------------------------------------
+#ifndef DEFAULT_BUFFER_FLIPBOOK_FRAMES
+#define DEFAULT_BUFFER_FLIPBOOK_FRAMES 0
+#endif//DEFAULT_BUFFER_FLIPBOOK_FRAMES
+
+//--------------------------------------------------------------
+//! The default accumulation mode of any display buffer.
+//--------------------------------------------------------------
+#ifndef DEFAULT_BUFFER_ACCUMULATE
+#define DEFAULT_BUFFER_ACCUMULATE false
+#endif//DEFAULT_BUFFER_ACCUMULATE
+
+//--------------------------------------------------------------
+//! The free GPU memory (measured in megabytes) below which any
+//! display buffer configured with Storage::AUTO will be stored
+//! using compact storage instead of the native display storage.
+//--------------------------------------------------------------
+#ifndef BUFFER_STORAGE_AUTO_THRESHOLD_MB
+#define BUFFER_STORAGE_AUTO_THRESHOLD_MB 512
+#endif//BUFFER_STORAGE_AUTO_THRESHOLD_MB
+
 //--------------------------------------------------------------
 namespace Simple
 {
@@ -62,13 +127,31 @@ public:
 
     //----------------------------------------------------------
     //! The format of each pixel contained by the display buffer.
+    //!
+    //! Block-compressed (BC) formats store pre-compressed blocks of
+    //! 4x4 pixels (see BlockEncoder) for static imagery, and each
+    //! row of the buffer data is a row of blocks. They always use
+    //! the LINEAR layout, cannot scroll, detect changes, or commit
+    //! rows, and cannot be written by operations (eg. FillRect).
+    //! Buffers should be a whole number of blocks wide and high,
+    //! because some graphics apis (D3D12) display the padding of
+    //! partial blocks, and graphics apis that cannot display them
+    //! (OpenGL compat) display nothing.
     //----------------------------------------------------------
     enum class Format
     {
-        NONE = 0,   //!< None/unknown/invalid pixel components.
-        RGBA_FLOAT, //!< Red/green/blue/alpha float components.
-        RGBA_UINT8, //!< Red/green/blue/alpha uint8 components.
-        RGBA_UINT16 //!< Red/green/blue/alpha uint16 components.
+        NONE = 0,       //!< None/unknown/invalid pixel components.
+        RGBA_FLOAT,     //!< Red/green/blue/alpha float components.
+        RGBA_UINT8,     //!< Red/green/blue/alpha uint8 components.
+        RGBA_UINT16,    //!< Red/green/blue/alpha uint16 components.
+        RGB10A2_UNORM,  //!< Red/green/blue/alpha 10/10/10/2 bits
+                        //!< packed into uint32 (red in low bits).
+        BC1_UNORM,      //!< Blocks of 8 bytes, storing red/green/blue
+                        //!< and optionally 1 bit alpha (DXT1).
+        BC3_UNORM,      //!< Blocks of 16 bytes, storing red/green/blue
+                        //!< and interpolated alpha (DXT5).
+        BC7_UNORM       //!< Blocks of 16 bytes, storing red/green/blue
+                        //!< and alpha in higher quality (BPTC).
     };
 
     //----------------------------------------------------------
@@ -82,6 +165,116 @@ public:
         CUDA        //!< Data mapped to CUDA device memory.
     };
 
+    //----------------------------------------------------------
+    //! The storage used by the GPU texture that is rendered to
+    //! the display. Compact storage only applies to RGBA_FLOAT
+    //! buffers, which are converted each frame while uploading,
+    //! and is ignored (ie. NATIVE is used) for all other formats
+    //! or by any graphics api that does not support conversion.
+    //----------------------------------------------------------
+    enum class Storage
+    {
+        NATIVE = 0,       //!< Same format as the buffer pixels.
+        RGBA_HALF,        //!< Red/green/blue/alpha half floats.
+        R11G11B10_FLOAT,  //!< Red/green/blue 11/11/10 bit floats
+                          //!< (unsigned, alpha is always opaque).
+        AUTO              //!< RGBA_HALF if free GPU memory is below
+                          //!< BUFFER_STORAGE_AUTO_THRESHOLD_MB,
+                          //!< otherwise NATIVE.
+    };
+
+    //----------------------------------------------------------
+    //! The order in which pixels are stored in the buffer data.
+    //!
+    //! Tiled layouts store each square tile of pixels in one
+    //! contiguous block, improving the cache locality of any
+    //! renderer that writes pixels one 2D tile at a time. Tiles
+    //! are stored row by row, and the GPU de-tiles the pixels
+    //! while rendering them to the display, but graphics apis
+    //! that cannot de-tile will use LINEAR instead (GetLayout).
+    //! The buffer width and height are padded to whole tiles.
+    //----------------------------------------------------------
+    enum class Layout
+    {
+        LINEAR = 0,    //!< Rows of pixels, one after another.
+        TILED_8X8,     //!< 8x8 pixel tiles stored row by row.
+        TILED_16X16,   //!< 16x16 pixel tiles stored row by row.
+        MORTON_16X16   //!< 16x16 pixel tiles, with the pixels in
+                       //!< each tile stored in Morton (Z) order.
+    };
+
+    //----------------------------------------------------------
+    //! How the buffer data scrolls, for displays that add a new
+    //! line of pixels each frame (eg. waterfalls/strip charts).
+    //!
+    //! Scrolling buffers are stored on the GPU as a ring of lines.
+    //! Each line acquired (see AcquireScrollLine) replaces the
+    //! oldest line, and is displayed as the last row/column of
+    //! the buffer with the older lines shifted towards the first,
+    //! so only the lines acquired are uploaded each frame instead
+    //! of the entire buffer. Scrolling buffers use LINEAR layout
+    //! and do not detect changes, and graphics apis that cannot
+    //! scroll buffers will use NONE instead (see GetScroll).
+    //----------------------------------------------------------
+    enum class Scroll
+    {
+        NONE = 0,  //!< The buffer data is displayed as stored.
+        ROWS,      //!< Lines are rows, scrolling to the first.
+        COLUMNS    //!< Lines are columns, scrolling to the first.
+    };
+
+    //----------------------------------------------------------
+    //! The region of the buffer (measured in pixels, relative to
+    //! the first pixel of the buffer) scaled to fill the display,
+    //! allowing applications to pan/zoom large buffers. Regions
+    //! may extend beyond the edges of the buffer, and a region
+    //! without any area always displays the entire buffer.
+    //!
+    //! Graphics apis that split large buffers into multiple GPU
+    //! textures only upload and draw the textures in the region.
+    //----------------------------------------------------------
+    struct Viewport
+    {
+        float x = 0.0f;       //!< The first column displayed.
+        float y = 0.0f;       //!< The first row displayed.
+        float width = 0.0f;   //!< The number of columns displayed.
+        float height = 0.0f;  //!< The number of rows displayed.
+    };
+
+    //----------------------------------------------------------
+    //! A color (with each component in the range [0, 1]) which is
+    //! converted to the pixel format of the buffer when written.
+    //----------------------------------------------------------
+    struct Color
+    {
+        float red = 0.0f;    //!< The red component.
+        float green = 0.0f;  //!< The green component.
+        float blue = 0.0f;   //!< The blue component.
+        float alpha = 1.0f;  //!< The alpha component.
+    };
+
+    //----------------------------------------------------------
+    //! A rectangular region of the buffer, measured in pixels.
+    //----------------------------------------------------------
+    struct Rect
+    {
+        uint32_t x = 0;       //!< The first column of the region.
+        uint32_t y = 0;       //!< The first row of the region.
+        uint32_t width = 0;   //!< The number of columns.
+        uint32_t height = 0;  //!< The number of rows.
+    };
+
+    //----------------------------------------------------------
+    //! Totals (since the buffer was created or last resized) of
+    //! the tiles of buffer data hashed to detect changes, and of
+    //! the tiles uploaded to the GPU because they had changed.
+    //----------------------------------------------------------
+    struct UploadCounters
+    {
+        uint64_t tilesHashed = 0;    //!< The number of tiles hashed.
+        uint64_t tilesUploaded = 0;  //!< The number of tiles uploaded.
+    };
+
     //----------------------------------------------------------
     //! Values needed to define Simple::Display::Buffer objects.
     //----------------------------------------------------------
@@ -99,6 +292,48 @@ public:
         //! The type of interop used to map the display buffer.
         Interop  interop = DEFAULT_BUFFER_INTEROP;
 
+        //! The storage used to display the buffer on the GPU.
+        Storage  storage = DEFAULT_BUFFER_STORAGE;
+
+        //! The alignment (measured in bytes, and a power of two)
+        //! of the start of each row of pixels, relative to the
+        //! start of the buffer data. Rows are padded as needed, and
+        //! alignments that are not a power of two are rounded up.
+        uint32_t pitchAlignment = DEFAULT_BUFFER_PITCH_ALIGNMENT;
+
+        //! The order in which pixels are stored in the buffer.
+        Layout   layout = DEFAULT_BUFFER_LAYOUT;
+
+        //! Whether to hash tiles of host buffer data each frame, and
+        //! only upload the tiles that changed since the last frame,
+        //! for buffers that are mostly unchanged from frame to frame.
+        //! Ignored by graphics apis that cannot upload partial data.
+        bool     detectChanges = DEFAULT_BUFFER_DETECT_CHANGES;
+
+        //! How the buffer data scrolls as new lines are acquired.
+        Scroll   scroll = DEFAULT_BUFFER_SCROLL;
+
+        //! Whether rows committed (see CommitRows) are displayed as
+        //! soon as they are uploaded, presenting partially complete
+        //! frames, instead of once every row has been committed.
+        bool     progressive = DEFAULT_BUFFER_PROGRESSIVE;
+
+        //! The number of frames that can be stored on the GPU (see
+        //! StoreFlipbookFrame) and then displayed any number of times
+        //! without being uploaded again, for looping animations, test
+        //! patterns, or short clips. Ignored by graphics apis that
+        //! cannot store frames (see GetFlipbookFrameCount).
+        uint32_t flipbookFrames = DEFAULT_BUFFER_FLIPBOOK_FRAMES;
+
+        //! Whether each batch of samples written to the buffer (see
+        //! AccumulateSamples) is added to a float accumulator on the
+        //! GPU, which displays the mean of all the samples, so that
+        //! progressive renderers only need to write the latest batch.
+        //! Ignored by graphics apis that cannot accumulate samples on
+        //! the GPU, or by buffers that cannot be stored in a single GPU
+        //! texture or that scroll (see IsAccumulating).
+        bool     accumulate = DEFAULT_BUFFER_ACCUMULATE;
+
         //! An invalid buffer configuration.
         static Config Invalid();
     };
@@ -113,24 +348,78 @@ public:
     void Render(uint32_t a_displayWidth,
                 uint32_t a_displayHeight);
 
+    void SetViewport(const Viewport& a_viewport);
+    Viewport GetViewport() const;
+
+    void Invalidate();
+    bool IsInvalidated() const;
+
+    void* AcquireScrollLine();
+    uint32_t GetScrollOffset() const;
+
+    void CommitRows(uint32_t a_firstRow,
+                    uint32_t a_rowCount);
+
+    void Clear(const Color& a_color);
+    void FillRect(const Rect& a_rect,
+                  const Color& a_color);
+    void CopyRect(const Rect& a_source,
+                  uint32_t a_destX,
+                  uint32_t a_destY);
+
+    bool StoreFlipbookFrame(uint32_t a_frame);
+    void ShowFlipbookFrame(uint32_t a_frame);
+    uint32_t GetFlipbookFrame() const;
+    uint32_t GetFlipbookFrameCount() const;
+
+    void AccumulateSamples(uint32_t a_sampleCount = 1);
+    void ResetAccumulation();
+    uint32_t GetAccumulatedSampleCount() const;
+    bool IsAccumulating() const;
+
     template<typename Type, Interop InteropType = Interop::HOST>
     Type* GetData() const;
 
     void* GetData() const;
-    uint32_t GetSize() const;
-    uint32_t GetPitch() const;
+    uint64_t GetSize() const;
+    uint64_t GetPitch() const;
     uint32_t GetWidth() const;
     uint32_t GetHeight() const;
     Format   GetFormat() const;
     Interop  GetInterop() const;
+    Storage  GetStorage() const;
+    Layout   GetLayout() const;
+    Scroll   GetScroll() const;
+    uint64_t GetStorageSavings() const;
+    UploadCounters GetUploadCounters() const;
 
-    static constexpr uint32_t MinSizeBytes(const Config&);
-    static constexpr uint32_t MinPitchBytes(const Config&);
+    static constexpr uint64_t MinSizeBytes(const Config&);
+    static constexpr uint64_t MinPitchBytes(const Config&);
+    static constexpr uint64_t AlignedSizeBytes(const Config&);
+    static constexpr uint64_t AlignedPitchBytes(const Config&);
+    static constexpr uint64_t FlipbookSizeBytes(const Config&);
     static constexpr uint32_t BytesPerPixel(const Format&);
+    static constexpr uint32_t BytesPerBlock(const Format&);
+    static constexpr uint32_t BlockSize(const Format&);
     static constexpr uint32_t BytesPerChannel(const Format&);
     static constexpr uint32_t ChannelsPerPixel(const Format&);
+    static constexpr uint32_t BytesPerStoragePixel(const Format&,
+                                                   const Storage&);
+    static constexpr uint32_t TileSize(const Layout&);
+
+    static constexpr uint32_t PackRGB10A2(float a_red,
+                                          float a_green,
+                                          float a_blue,
+                                          float a_alpha);
+    static constexpr float UnpackRGB10A2(uint32_t a_packed,
+                                         uint32_t a_channel);
 
 private:
+    static constexpr uint64_t RoundUp(uint64_t a_value,
+                                      uint64_t a_multiple);
+    static constexpr uint32_t PackUNORM(float a_value,
+                                        uint32_t a_maxValue);
+
     const std::unique_ptr<Implementation> m_pimpl;
 };
 
@@ -140,39 +429,156 @@ private:
 //! \param[in] a_config The configuration values of the buffer.
 //! \return The min size in bytes required to store the buffer.
 //--------------------------------------------------------------
-constexpr uint32_t Buffer::MinSizeBytes(const Config& a_config)
+constexpr uint64_t Buffer::MinSizeBytes(const Config& a_config)
 {
-    return a_config.height * MinPitchBytes(a_config);
+    return (RoundUp(a_config.height, BlockSize(a_config.format)) /
+            BlockSize(a_config.format)) * MinPitchBytes(a_config);
 }
 
 //--------------------------------------------------------------
 //! Calculate the min pitch in bytes required to store a buffer.
 //!
 //! Also known as stride, this is the distance in bytes between
-//! the starting memory addresses of consecutive rows of pixels.
+//! the starting memory addresses of consecutive rows of pixels
+//! (or rows of blocks if the format is block-compressed).
 //!
 //! \param[in] a_config The configuration values for the buffer.
 //! \return The min pitch in bytes required to store the buffer.
 //--------------------------------------------------------------
-constexpr uint32_t Buffer::MinPitchBytes(const Config& a_config)
+constexpr uint64_t Buffer::MinPitchBytes(const Config& a_config)
 {
-    return a_config.width * BytesPerPixel(a_config.format);
+    return (RoundUp(a_config.width, BlockSize(a_config.format)) /
+            BlockSize(a_config.format)) * BytesPerBlock(a_config.format);
+}
+
+//--------------------------------------------------------------
+//! Calculate the size in bytes required to store a buffer with
+//! each row of pixels padded to the configured pitch alignment,
+//! and the height padded to whole tiles if the layout is tiled
+//! (or to whole blocks if the format is block-compressed).
+//!
+//! \param[in] a_config The configuration values of the buffer.
+//! \return The aligned size in bytes required to store the buffer.
+//--------------------------------------------------------------
+constexpr uint64_t Buffer::AlignedSizeBytes(const Config& a_config)
+{
+    return (BlockSize(a_config.format) > 1 ?
+            RoundUp(a_config.height, BlockSize(a_config.format)) /
+            BlockSize(a_config.format) :
+            RoundUp(a_config.height, TileSize(a_config.layout))) *
+           AlignedPitchBytes(a_config);
+}
+
+//--------------------------------------------------------------
+//! Calculate the pitch in bytes required to store a buffer with
+//! each row of pixels padded to the configured pitch alignment.
+//!
+//! An alignment of zero or one results in the min pitch in bytes.
+//!
+//! For tiled layouts, the width is first padded to whole tiles,
+//! and the pitch is the size of a row of tiles divided by their
+//! height, which is padded to also keep the pitch a multiple of
+//! the size of a row of pixels within a tile.
+//!
+//! For block-compressed formats, the layout is always linear and
+//! the pitch is the size of a row of blocks padded to alignment.
+//!
+//! \param[in] a_config The configuration values of the buffer.
+//! \return The aligned pitch in bytes required to store the buffer.
+//--------------------------------------------------------------
+constexpr uint64_t Buffer::AlignedPitchBytes(const Config& a_config)
+{
+    return BlockSize(a_config.format) > 1 ?
+           RoundUp(MinPitchBytes(a_config), a_config.pitchAlignment) :
+           RoundUp(RoundUp(a_config.width, TileSize(a_config.layout)) *
+                   BytesPerPixel(a_config.format),
+                   (TileSize(a_config.layout) > 1 &&
+                    TileSize(a_config.layout) * BytesPerPixel(a_config.format) >
+                    a_config.pitchAlignment) ?
+                   TileSize(a_config.layout) * BytesPerPixel(a_config.format) :
+                   a_config.pitchAlignment);
+}
+
+//--------------------------------------------------------------
+//! Calculate the GPU memory (measured in bytes) used to store the
+//! flipbook frames of a buffer, so it can be reported before any
+//! frames are stored. Tiled layouts store the padded tiles, and
+//! AUTO storage is counted as NATIVE (see BytesPerStoragePixel).
+//! Block-compressed formats store the blocks without padding.
+//!
+//! \param[in] a_config The configuration values of the buffer.
+//! \return The GPU memory (in bytes) used to store the frames.
+//--------------------------------------------------------------
+constexpr uint64_t Buffer::FlipbookSizeBytes(const Config& a_config)
+{
+    return static_cast<uint64_t>(a_config.flipbookFrames) *
+           (!BytesPerPixel(a_config.format) ? MinSizeBytes(a_config) :
+            BytesPerStoragePixel(a_config.format, a_config.storage) *
+            ((a_config.layout == Layout::LINEAR) ?
+             static_cast<uint64_t>(a_config.width) * a_config.height :
+             AlignedSizeBytes(a_config) / BytesPerPixel(a_config.format)));
 }
 
 //--------------------------------------------------------------
 //! Calculate the number of bytes required to store a pixel.
 //!
+//! Block-compressed formats do not store each pixel in whole
+//! bytes, so zero is returned for them (use BytesPerBlock).
+//!
 //! \param[in] a_format The format that describes the pixel.
 //! \return The number of bytes required to store the pixel.
 //--------------------------------------------------------------
 constexpr uint32_t Buffer::BytesPerPixel(const Format& a_format)
 {
-    return BytesPerChannel(a_format) * ChannelsPerPixel(a_format);
+    switch (a_format)
+    {
+        case Format::RGB10A2_UNORM: return 4;
+        default: return BytesPerChannel(a_format) * ChannelsPerPixel(a_format);
+    }
+}
+
+//--------------------------------------------------------------
+//! Calculate the number of bytes required to store a block of
+//! pixels, which is a single pixel unless block-compressed.
+//!
+//! \param[in] a_format The format that describes the pixels.
+//! \return The number of bytes required to store the block.
+//--------------------------------------------------------------
+constexpr uint32_t Buffer::BytesPerBlock(const Format& a_format)
+{
+    switch (a_format)
+    {
+        case Format::BC1_UNORM: return 8;
+        case Format::BC3_UNORM: return 16;
+        case Format::BC7_UNORM: return 16;
+        default: return BytesPerPixel(a_format);
+    }
+}
+
+//--------------------------------------------------------------
+//! Get the width and height (in pixels) of each block of pixels.
+//!
+//! \param[in] a_format The format that describes the pixels.
+//! \return The width and height (in pixels) of each block, or one
+//!         if the format is not block-compressed.
+//--------------------------------------------------------------
+constexpr uint32_t Buffer::BlockSize(const Format& a_format)
+{
+    switch (a_format)
+    {
+        case Format::BC1_UNORM: return 4;
+        case Format::BC3_UNORM: return 4;
+        case Format::BC7_UNORM: return 4;
+        default: return 1;
+    }
 }
 
 //--------------------------------------------------------------
 //! Get the number of bytes needed to store a pixel channel.
 //!
+//! Packed formats do not store each channel in whole bytes, so
+//! zero is returned for them (use BytesPerPixel in this case).
+//!
 //! \param[in] a_format The format that describes the pixel.
 //! \return Number of bytes needed to store a pixel channel.
 //--------------------------------------------------------------
@@ -200,9 +606,119 @@ constexpr uint32_t Buffer::ChannelsPerPixel(const Format& a_format)
         case Format::RGBA_FLOAT: return 4;
         case Format::RGBA_UINT8: return 4;
         case Format::RGBA_UINT16: return 4;
+        case Format::RGB10A2_UNORM: return 4;
+        case Format::BC1_UNORM: return 4;
+        case Format::BC3_UNORM: return 4;
+        case Format::BC7_UNORM: return 4;
         default: return 0;
     }
 }
 
+//--------------------------------------------------------------
+//! Get the number of bytes the GPU needs to display a pixel.
+//!
+//! Compact storage only applies to RGBA_FLOAT pixels, and AUTO
+//! storage is counted as NATIVE (its worst case) because it is
+//! only resolved when the buffer is created (see GetStorage).
+//!
+//! \param[in] a_format The format that describes the pixel.
+//! \param[in] a_storage The storage used to display the pixel.
+//! \return Number of bytes the GPU needs to display the pixel.
+//--------------------------------------------------------------
+constexpr uint32_t Buffer::BytesPerStoragePixel(const Format& a_format,
+                                                const Storage& a_storage)
+{
+    return a_format != Format::RGBA_FLOAT ? BytesPerPixel(a_format) :
+           a_storage == Storage::RGBA_HALF ? 8 :
+           a_storage == Storage::R11G11B10_FLOAT ? 4 :
+           BytesPerPixel(a_format);
+}
+
+//--------------------------------------------------------------
+//! Get the width and height (in pixels) of the layout's tiles.
+//!
+//! \param[in] a_layout The layout of the pixels in the buffer.
+//! \return The width and height (in pixels) of each tile, or one
+//!         if the layout is linear (ie. each pixel is a tile).
+//--------------------------------------------------------------
+constexpr uint32_t Buffer::TileSize(const Layout& a_layout)
+{
+    switch (a_layout)
+    {
+        case Layout::TILED_8X8: return 8;
+        case Layout::TILED_16X16: return 16;
+        case Layout::MORTON_16X16: return 16;
+        default: return 1;
+    }
+}
+
+//--------------------------------------------------------------
+//! Round a value up to the nearest multiple, or return the value
+//! unchanged if the multiple is zero or one.
+//--------------------------------------------------------------
+constexpr uint64_t Buffer::RoundUp(uint64_t a_value,
+                                   uint64_t a_multiple)
+{
+    return a_multiple > 1 ?
+           ((a_value + a_multiple - 1) / a_multiple) * a_multiple :
+           a_value;
+}
+
+//--------------------------------------------------------------
+//! Convert a normalized value to an unsigned integer in the range
+//! [0, a_maxValue], clamping the value to [0, 1] and rounding it.
+//--------------------------------------------------------------
+constexpr uint32_t Buffer::PackUNORM(float a_value,
+                                     uint32_t a_maxValue)
+{
+    return static_cast<uint32_t>((a_value <= 0.0f ? 0.0f :
+                                  a_value >= 1.0f ? 1.0f :
+                                  a_value) * a_maxValue + 0.5f);
+}
+
+//--------------------------------------------------------------
+//! Pack normalized color components into a RGB10A2_UNORM pixel.
+//!
+//! Each component is clamped to [0, 1] then rounded to nearest.
+//!
+//! \param[in] a_red The normalized red component of the pixel.
+//! \param[in] a_green The normalized green component of the pixel.
+//! \param[in] a_blue The normalized blue component of the pixel.
+//! \param[in] a_alpha The normalized alpha component of the pixel.
+//! \return The components packed into a single RGB10A2_UNORM pixel.
+//--------------------------------------------------------------
+constexpr uint32_t Buffer::PackRGB10A2(float a_red,
+                                       float a_green,
+                                       float a_blue,
+                                       float a_alpha)
+{
+    return PackUNORM(a_red, 1023) |
+           (PackUNORM(a_green, 1023) << 10) |
+           (PackUNORM(a_blue, 1023) << 20) |
+           (PackUNORM(a_alpha, 3) << 30);
+}
+
+//--------------------------------------------------------------
+//! Unpack a normalized color component from a RGB10A2_UNORM pixel.
+//!
+//! \param[in] a_packed The RGB10A2_UNORM pixel to be unpacked.
+//! \param[in] a_channel The index of the channel (0 = red, 1 =
+//!                      green, 2 = blue, 3 = alpha) to unpack.
+//! \return The normalized value of the component in [0, 1],
+//!         or zero if the channel index is out of the range.
+//--------------------------------------------------------------
+constexpr float Buffer::UnpackRGB10A2(uint32_t a_packed,
+                                      uint32_t a_channel)
+{
+    switch (a_channel)
+    {
+        case 0: return static_cast<float>(a_packed & 0x3FF) / 1023.0f;
+        case 1: return static_cast<float>((a_packed >> 10) & 0x3FF) / 1023.0f;
+        case 2: return static_cast<float>((a_packed >> 20) & 0x3FF) / 1023.0f;
+        case 3: return static_cast<float>((a_packed >> 30) & 0x3) / 3.0f;
+        default: return 0.0f;
+    }
+}
+
 } // namespace Display
 } // namespace Simple
@@ -20,6 +20,73 @@
 #define DEFAULT_GRAPHICS_API GraphicsAPI::NATIVE
 #endif//DEFAULT_GRAPHICS_API
 
+//--------------------------------------------------------------
+//! The default render mode used to create any display context.
+//--------------------------------------------------------------
+#ifndef DEFAULT_RENDER_ON_DEMAND
+#define DEFAULT_RENDER_ON_DEMAND false
+#endif//DEFAULT_RENDER_ON_DEMAND
+
+//--------------------------------------------------------------
+//! The default present mode used to create any display context.
+//--------------------------------------------------------------
+#ifndef DEFAULT_PRESENT_MODE
+#define DEFAULT_PRESENT_MODE PresentMode::FIFO
+#endif//DEFAULT_PRESENT_MODE
+
+//--------------------------------------------------------------
+//! The default max number of frames that can be rendered before
+//! waiting for the GPU to complete earlier frames (frames in flight).
+//--------------------------------------------------------------
+#ifndef DEFAULT_FRAMES_IN_FLIGHT
+#define DEFAULT_FRAMES_IN_FLIGHT 2
+#endif//DEFAULT_FRAMES_IN_FLIGHT
+
+//--------------------------------------------------------------
+//! The default number of swap chain images, where zero selects one
+//! more than the minimum number supported by the display surface.
+//--------------------------------------------------------------
+#ifndef DEFAULT_SWAP_CHAIN_IMAGE_COUNT
+#define DEFAULT_SWAP_CHAIN_IMAGE_COUNT 0
+#endif//DEFAULT_SWAP_CHAIN_IMAGE_COUNT
+
+//--------------------------------------------------------------
+//! The default threading mode used to create any display context.
+//--------------------------------------------------------------
+#ifndef DEFAULT_ASYNC_PRESENT
+#define DEFAULT_ASYNC_PRESENT false
+#endif//DEFAULT_ASYNC_PRESENT
+
+//--------------------------------------------------------------
+//! The default frame rate that OnFrameStart waits to pace frames
+//! at, where zero does not wait (leaving frames paced by vsync).
+//--------------------------------------------------------------
+#ifndef DEFAULT_TARGET_FRAME_RATE
+#define DEFAULT_TARGET_FRAME_RATE 0.0f
+#endif//DEFAULT_TARGET_FRAME_RATE
+
+//--------------------------------------------------------------
+//! The default latency mode used to create any display context.
+//--------------------------------------------------------------
+#ifndef DEFAULT_LOW_LATENCY
+#define DEFAULT_LOW_LATENCY false
+#endif//DEFAULT_LOW_LATENCY
+
+//--------------------------------------------------------------
+//! The default max number of frames that can be queued to be
+//! presented at target times (see Context::QueueFrame).
+//--------------------------------------------------------------
+#ifndef DEFAULT_FRAME_QUEUE_SIZE
+#define DEFAULT_FRAME_QUEUE_SIZE 4
+#endif//DEFAULT_FRAME_QUEUE_SIZE
+
+//--------------------------------------------------------------
+//! The default policy for queued frames that are presented late.
+//--------------------------------------------------------------
+#ifndef DEFAULT_LATE_FRAME_POLICY
+#define DEFAULT_LATE_FRAME_POLICY LateFramePolicy::DROP
+#endif//DEFAULT_LATE_FRAME_POLICY
+
 //--------------------------------------------------------------
 namespace Simple
 {
@@ -49,6 +116,90 @@ public:
         VULKAN      //!< The Vulkan graphics API.
     };
 
+    //----------------------------------------------------------
+    //! How rendered frames are presented to the display, which
+    //! determines whether presentation waits for vertical sync.
+    //!
+    //! A mode not supported by the graphics API or device falls
+    //! back to the nearest supported mode (IMMEDIATE to MAILBOX,
+    //! then any mode to FIFO), which is always supported, so use
+    //! Context::GetPresentMode to query the mode actually in use.
+    //----------------------------------------------------------
+    enum class PresentMode
+    {
+        NONE = 0,       //!< None/unknown/invalid present mode.
+        FIFO,           //!< Wait for vertical sync (frame rate capped).
+        FIFO_RELAXED,   //!< Wait for vertical sync unless late (may tear).
+        MAILBOX,        //!< Replace any queued frame (no tearing or cap).
+        IMMEDIATE       //!< Present without waiting (may tear, no cap).
+    };
+
+    //----------------------------------------------------------
+    //! What happens to frames queued to be presented at a target
+    //! time (see Context::QueueFrame) when a later queued frame is
+    //! also due by the time they can be presented.
+    //----------------------------------------------------------
+    enum class LateFramePolicy
+    {
+        NONE = 0,   //!< None/unknown/invalid late frame policy.
+        DROP,       //!< Drop late frames (stay in sync with targets).
+        PRESENT     //!< Present every frame (falling behind targets).
+    };
+
+    //----------------------------------------------------------
+    //! Counters that measure the latency of frames, from the time
+    //! each was submitted at the end of a frame to the time it was
+    //! found to be completed by the GPU (checked once each frame).
+    //----------------------------------------------------------
+    struct LatencyCounters
+    {
+        uint64_t framesMeasured = 0;     //!< The number of frames measured.
+        uint64_t totalMicroseconds = 0;  //!< The total latency of all frames.
+        uint64_t maxMicroseconds = 0;    //!< The max latency of any frame.
+    };
+
+    //----------------------------------------------------------
+    //! Counters that measure the number of frames presented, and
+    //! dropped by Context::TryPresent when no slot was available
+    //! (or late queued frames dropped, see Config::lateFramePolicy).
+    //----------------------------------------------------------
+    struct FrameCounters
+    {
+        uint64_t framesPresented = 0;  //!< The number of frames presented.
+        uint64_t framesDropped = 0;    //!< The number of frames dropped.
+    };
+
+    //----------------------------------------------------------
+    //! Counters that measure how late each frame was started by
+    //! Context::OnFrameStart, relative to its scheduled deadline
+    //! (see Config::targetFrameRate).
+    //----------------------------------------------------------
+    struct PacingCounters
+    {
+        uint64_t framesPaced = 0;             //!< The number of frames paced.
+        uint64_t totalErrorMicroseconds = 0;  //!< The total error of all frames.
+        uint64_t maxErrorMicroseconds = 0;    //!< The max error of any frame.
+        uint64_t lastErrorMicroseconds = 0;   //!< The error of the last frame.
+    };
+
+    //----------------------------------------------------------
+    //! Timing of the last frame that reached the display, measured
+    //! using the system time and refresh counter of the display, so
+    //! apps can animate to the time their frames are actually shown.
+    //! Times use the monotonic clock (std::chrono::steady_clock on
+    //! Linux), and are all zero for graphics apis that do not expose
+    //! present timing (only OpenGL on Linux currently does).
+    //----------------------------------------------------------
+    struct PresentTiming
+    {
+        uint64_t framesPresented = 0;            //!< The number of frames displayed.
+        uint64_t presentMicroseconds = 0;        //!< The time the last frame was displayed.
+        uint64_t presentRefresh = 0;             //!< The refresh it was displayed at.
+        uint64_t refreshPeriodNanoseconds = 0;   //!< The measured refresh period.
+        uint64_t missedRefreshes = 0;            //!< Refreshes missed by frames already submitted.
+        uint64_t nextPresentMicroseconds = 0;    //!< The predicted time the next frame is displayed.
+    };
+
     //----------------------------------------------------------
     //! Values needed to define Simple::Display::Context objects.
     //----------------------------------------------------------
@@ -62,6 +213,77 @@ public:
 
         //! The graphics API used to create the display context.
         GraphicsAPI graphicsAPI = DEFAULT_GRAPHICS_API;
+
+        //! Whether to render and present the buffer at the end of a
+        //! frame only if it was invalidated (see Buffer::Invalidate),
+        //! or the window was exposed, resized, or requested a redraw
+        //! (see Window::RequestRedraw), instead of every frame.
+        bool renderOnDemand = DEFAULT_RENDER_ON_DEMAND;
+
+        //! The mode used to present rendered frames to the display,
+        //! which should be MAILBOX or IMMEDIATE to run benchmarks at
+        //! uncapped frame rates (see Context::GetPresentMode).
+        PresentMode presentMode = DEFAULT_PRESENT_MODE;
+
+        //! The max number of frames that can be rendered before
+        //! waiting for the GPU to complete earlier frames, where
+        //! fewer frames reduce latency and more absorb jitter to
+        //! increase throughput (see Context::GetLatencyCounters).
+        uint32_t framesInFlight = DEFAULT_FRAMES_IN_FLIGHT;
+
+        //! The number of swap chain images, clamped to the range
+        //! supported by the display surface, or zero to select one
+        //! more than the minimum supported (graphics APIs that do
+        //! not expose the swap chain image count ignore this value).
+        uint32_t swapChainImageCount = DEFAULT_SWAP_CHAIN_IMAGE_COUNT;
+
+        //! Whether the context owns a render thread that uploads and
+        //! presents frames, so OnFrameEnded only hands the buffer data
+        //! over and returns immediately, letting the caller run at its
+        //! own rate while the display runs at the refresh rate. Frames
+        //! handed over before the previous one was presented replace
+        //! it (see GetFrameCounters). The buffer data is handed over
+        //! by swapping its memory, then copied back so it is preserved
+        //! between frames, but it is stored in different memory after
+        //! each frame (so Buffer::GetData must be called again). Window
+        //! events are pumped by the render thread (so native event
+        //! callbacks are invoked on it), which updates the window state
+        //! atomically so it can be queried by the calling thread (eg.
+        //! Window::IsClosed), but the window should not be changed by
+        //! the calling thread (eg. Window::Close). Buffers that scroll,
+        //! store flipbook frames, or accumulate samples, buffers without
+        //! host interop, and platforms that must render on the main
+        //! thread (macOS) ignore this value (and present synchronously).
+        bool asyncPresent = DEFAULT_ASYNC_PRESENT;
+
+        //! The rate (measured in frames per second) that OnFrameStart
+        //! paces frames at, by sleeping then spinning until each frame
+        //! is due, or zero to start each frame immediately. Deadlines
+        //! are scheduled from the previous deadline so errors do not
+        //! accumulate (see Context::GetPacingCounters), and should be
+        //! combined with an uncapped present mode to avoid also being
+        //! paced by vertical sync (see Config::presentMode).
+        float targetFrameRate = DEFAULT_TARGET_FRAME_RATE;
+
+        //! Whether to minimize the latency from input to display (at
+        //! the cost of throughput), by waiting until each frame is
+        //! presented at the end of OnFrameEnded, then delaying the
+        //! next OnFrameStart so it returns just in time for the frame
+        //! to be presented at the following refresh, so input is read
+        //! as late as possible (see Context::GetPresentLatencyCounters).
+        //! Graphics apis that cannot wait for frames to be presented
+        //! (Metal), or contexts that present asynchronously, ignore
+        //! this value.
+        bool lowLatency = DEFAULT_LOW_LATENCY;
+
+        //! The max number of frames that can be queued to be presented
+        //! at target times (see Context::QueueFrame), where more frames
+        //! let the caller render further ahead of the display.
+        uint32_t frameQueueSize = DEFAULT_FRAME_QUEUE_SIZE;
+
+        //! What happens to queued frames that are late because a later
+        //! queued frame is also due (see Context::GetFrameCounters).
+        LateFramePolicy lateFramePolicy = DEFAULT_LATE_FRAME_POLICY;
     };
 
     Context(const Config& a_config);
@@ -73,10 +295,36 @@ public:
     Buffer& GetBuffer() const;
     Window* GetWindow() const;
 
+    void SetViewport(const Buffer::Viewport& a_viewport);
+    Buffer::Viewport GetViewport() const;
+
+    PresentMode GetPresentMode() const;
+    LatencyCounters GetLatencyCounters() const;
+
     void OnFrameStart();
     void OnFrameEnded();
 
+    bool IsFrameSlotAvailable() const;
+    bool TryPresent();
+
+    FrameCounters GetFrameCounters() const;
+    PacingCounters GetPacingCounters() const;
+    LatencyCounters GetPresentLatencyCounters() const;
+    PresentTiming GetPresentTiming() const;
+
+    bool QueueFrame(uint64_t a_targetPresentMicroseconds);
+    uint32_t GetQueuedFrameCount() const;
+
+    static uint64_t GetTimeMicroseconds();
+
+    Window* AddMirrorWindow(const Window::Config& a_windowConfig);
+    void RemoveMirrorWindow(Window* a_window);
+    uint32_t GetMirrorWindowCount() const;
+    void SetMirrorViewport(Window* a_window,
+                           const Buffer::Viewport& a_viewport);
+
 private:
+    friend class ContextGroup;
     const std::unique_ptr<Implementation> m_pimpl;
 };
 
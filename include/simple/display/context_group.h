@@ -0,0 +1,60 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include "context.h"
+
+//! @file
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Display
+{
+
+//--------------------------------------------------------------
+//! Class that presents a group of display contexts together.
+//!
+//! The Simple::Display::ContextGroup class renders the buffers of
+//! several contexts (eg. one per display of a video wall) before
+//! presenting any of them, so the GPU renders them all concurrently
+//! and they are presented back to back on the same refresh, instead
+//! of each context waiting to present before the next is rendered.
+//!
+//! Contexts must be created and presented by the same thread as
+//! the group, and removed from it before they are destroyed. The
+//! windows of contexts created by the same thread share a native
+//! display connection (on Linux), but each window only processes
+//! its own events, so OnFrameStart pumps the events of each window
+//! into that window alone (eg. closing one closes only that one).
+//--------------------------------------------------------------
+class ContextGroup
+{
+public:
+    class Implementation;
+
+    ContextGroup();
+    ~ContextGroup();
+
+    ContextGroup(const ContextGroup&) = delete;
+    ContextGroup& operator=(const ContextGroup&) = delete;
+
+    void AddContext(Context& a_context);
+    void RemoveContext(Context& a_context);
+    uint32_t GetContextCount() const;
+
+    void OnFrameStart();
+    void PresentAll();
+
+private:
+    const std::unique_ptr<Implementation> m_pimpl;
+};
+
+} // namespace Display
+} // namespace Simple
@@ -0,0 +1,575 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include "buffer.h"
+
+//! @file
+
+//--------------------------------------------------------------
+//! Qualifier for pixel view functions, which are also callable
+//! from device code when compiled as part of a CUDA source file.
+//--------------------------------------------------------------
+#ifdef __CUDACC__
+#define PIXEL_VIEW_FUNCTION __host__ __device__ inline
+#else
+#define PIXEL_VIEW_FUNCTION inline
+#endif//__CUDACC__
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Display
+{
+
+//--------------------------------------------------------------
+//! A pixel that stores each of its four channels separately.
+//--------------------------------------------------------------
+template<typename ChannelType>
+struct PixelRGBA
+{
+    ChannelType r;  //!< The red channel of the pixel.
+    ChannelType g;  //!< The green channel of the pixel.
+    ChannelType b;  //!< The blue channel of the pixel.
+    ChannelType a;  //!< The alpha channel of the pixel.
+};
+
+//--------------------------------------------------------------
+//! A pixel that packs all of its channels into a single value.
+//!
+//! Use Buffer::PackRGB10A2 and Buffer::UnpackRGB10A2 to access
+//! the individual channels of the packed value.
+//--------------------------------------------------------------
+struct PixelRGB10A2
+{
+    uint32_t rgba;  //!< The packed channels of the pixel.
+};
+
+//--------------------------------------------------------------
+//! Spread the low four bits of a value so that each one is moved
+//! into every other bit (ie. 0b1111 becomes 0b01010101), as used
+//! to interleave the x and y bits of each Morton ordered pixel.
+//--------------------------------------------------------------
+PIXEL_VIEW_FUNCTION constexpr uint32_t SpreadBits(uint32_t a_value)
+{
+    return ((((a_value & 0xF) | ((a_value & 0xF) << 2)) & 0x33) |
+            ((((a_value & 0xF) | ((a_value & 0xF) << 2)) & 0x33) << 1)) & 0x55;
+}
+
+//--------------------------------------------------------------
+//! Compile time traits of each Simple::Display::Buffer::Format.
+//!
+//! Only formats that describe pixels are specialized, so using
+//! Buffer::Format::NONE (or any future format that has not been
+//! given traits) with a Simple::Display::PixelView fails to compile.
+//--------------------------------------------------------------
+template<Buffer::Format FormatType>
+struct PixelTraits;
+
+//--------------------------------------------------------------
+//! Compile time traits of Buffer::Format::RGBA_FLOAT pixels.
+//--------------------------------------------------------------
+template<>
+struct PixelTraits<Buffer::Format::RGBA_FLOAT>
+{
+    using Channel = float;
+    using Pixel = PixelRGBA<Channel>;
+    static constexpr uint32_t BytesPerPixel = sizeof(Pixel);
+    static constexpr uint32_t BytesPerChannel = sizeof(Channel);
+    static constexpr uint32_t ChannelsPerPixel = 4;
+};
+
+//--------------------------------------------------------------
+//! Compile time traits of Buffer::Format::RGBA_UINT8 pixels.
+//--------------------------------------------------------------
+template<>
+struct PixelTraits<Buffer::Format::RGBA_UINT8>
+{
+    using Channel = uint8_t;
+    using Pixel = PixelRGBA<Channel>;
+    static constexpr uint32_t BytesPerPixel = sizeof(Pixel);
+    static constexpr uint32_t BytesPerChannel = sizeof(Channel);
+    static constexpr uint32_t ChannelsPerPixel = 4;
+};
+
+//--------------------------------------------------------------
+//! Compile time traits of Buffer::Format::RGBA_UINT16 pixels.
+//--------------------------------------------------------------
+template<>
+struct PixelTraits<Buffer::Format::RGBA_UINT16>
+{
+    using Channel = uint16_t;
+    using Pixel = PixelRGBA<Channel>;
+    static constexpr uint32_t BytesPerPixel = sizeof(Pixel);
+    static constexpr uint32_t BytesPerChannel = sizeof(Channel);
+    static constexpr uint32_t ChannelsPerPixel = 4;
+};
+
+//--------------------------------------------------------------
+//! Compile time traits of Buffer::Format::RGB10A2_UNORM pixels.
+//!
+//! Channels are not stored in whole bytes, so BytesPerChannel is
+//! zero, matching the value returned by Buffer::BytesPerChannel.
+//--------------------------------------------------------------
+template<>
+struct PixelTraits<Buffer::Format::RGB10A2_UNORM>
+{
+    using Channel = uint32_t;
+    using Pixel = PixelRGB10A2;
+    static constexpr uint32_t BytesPerPixel = sizeof(Pixel);
+    static constexpr uint32_t BytesPerChannel = 0;
+    static constexpr uint32_t ChannelsPerPixel = 4;
+};
+
+//--------------------------------------------------------------
+//! Get the index of a pixel in the data of a buffer, which is
+//! stored in tiles (row by row) that each contain TileSize rows
+//! of TileSize pixels, stored in either row or Morton order.
+//!
+//! \param[in] a_rowLength The buffer pitch measured in pixels.
+//! \param[in] a_x The column of the pixel in the buffer.
+//! \param[in] a_y The row of the pixel in the buffer.
+//! \return The index of the pixel in the buffer data.
+//--------------------------------------------------------------
+template<Buffer::Layout LayoutType>
+PIXEL_VIEW_FUNCTION constexpr uint32_t PixelIndex(uint32_t a_rowLength,
+                                                  uint32_t a_x,
+                                                  uint32_t a_y)
+{
+    return (LayoutType == Buffer::Layout::LINEAR) ?
+           (a_y * a_rowLength) + a_x :
+           ((a_y / Buffer::TileSize(LayoutType)) * a_rowLength * Buffer::TileSize(LayoutType)) +
+           ((a_x / Buffer::TileSize(LayoutType)) * Buffer::TileSize(LayoutType) * Buffer::TileSize(LayoutType)) +
+           ((LayoutType == Buffer::Layout::MORTON_16X16) ?
+            (SpreadBits(a_x % Buffer::TileSize(LayoutType)) |
+             (SpreadBits(a_y % Buffer::TileSize(LayoutType)) << 1)) :
+            ((a_y % Buffer::TileSize(LayoutType)) * Buffer::TileSize(LayoutType)) +
+            (a_x % Buffer::TileSize(LayoutType)));
+}
+
+//--------------------------------------------------------------
+//! Contiguous span of pixels that make up (part of) a pixel row.
+//--------------------------------------------------------------
+template<typename PixelType>
+class PixelSpan
+{
+public:
+    PIXEL_VIEW_FUNCTION PixelSpan(PixelType* a_data,
+                                  uint32_t a_size);
+
+    PIXEL_VIEW_FUNCTION PixelType* begin() const;
+    PIXEL_VIEW_FUNCTION PixelType* end() const;
+    PIXEL_VIEW_FUNCTION uint32_t size() const;
+
+    PIXEL_VIEW_FUNCTION PixelType& operator[](uint32_t a_x) const;
+
+private:
+    PixelType* m_data;
+    uint32_t m_size;
+};
+
+//--------------------------------------------------------------
+//! Typed, pitch aware view of the pixels stored by a buffer.
+//!
+//! The format and interop of the view are template parameters,
+//! so the pixel type is known at compile time and accessing the
+//! pixels requires no per pixel checks or channel arithmetic:
+//!
+//! \code
+//! PixelView<Buffer::Format::RGBA_UINT8> view(buffer);
+//! for (uint32_t y = 0; y < view.GetHeight(); ++y)
+//! {
+//!     for (auto& pixel : view.GetRow(y))
+//!     {
+//!         pixel = { 255, 0, 0, 255 };
+//!     }
+//! }
+//! \endcode
+//!
+//! Views of buffers with a tiled layout (see Buffer::Layout) can
+//! not be accessed by row, but instead provide a view of each tile
+//! so renderers can write pixels one tile at a time (eg. from many
+//! threads) while each tile's pixels are contiguous in memory:
+//!
+//! \code
+//! using View = PixelView<Buffer::Format::RGBA_UINT8,
+//!                        Buffer::Interop::HOST,
+//!                        Buffer::Layout::TILED_8X8>;
+//! View view(buffer);
+//! View::Tile tile = view.GetTile(tileX, tileY);
+//! for (uint32_t y = 0; y < tile.GetHeight(); ++y)
+//! {
+//!     for (auto& pixel : tile.GetRow(y))
+//!     {
+//!         pixel = { 255, 0, 0, 255 };
+//!     }
+//! }
+//! \endcode
+//!
+//! A view created from a buffer whose format, interop, or layout
+//! do not match is empty (like Buffer::GetData returning nullptr),
+//! and must be recreated whenever the buffer is resized. Views hold
+//! no resources, so they are cheap to copy, and may be passed to
+//! (and used within) CUDA kernels when the interop is CUDA.
+//--------------------------------------------------------------
+template<Buffer::Format FormatType,
+         Buffer::Interop InteropType = Buffer::Interop::HOST,
+         Buffer::Layout LayoutType = Buffer::Layout::LINEAR>
+class PixelView
+{
+public:
+    using Traits = PixelTraits<FormatType>;
+    using Pixel = typename Traits::Pixel;
+    using Row = PixelSpan<Pixel>;
+
+    //! The view of a single tile, with its pixels in row order,
+    //! unless the tile's pixels are stored in Morton order.
+    using Tile = PixelView<FormatType, InteropType,
+                           LayoutType == Buffer::Layout::MORTON_16X16 ?
+                           Buffer::Layout::MORTON_16X16 :
+                           Buffer::Layout::LINEAR>;
+
+    //! The width and height of each tile, measured in pixels.
+    static constexpr uint32_t TileSize = Buffer::TileSize(LayoutType);
+
+    static_assert(Traits::BytesPerPixel == Buffer::BytesPerPixel(FormatType),
+                  "Pixel traits do not match Buffer::BytesPerPixel");
+    static_assert(Traits::BytesPerChannel == Buffer::BytesPerChannel(FormatType),
+                  "Pixel traits do not match Buffer::BytesPerChannel");
+    static_assert(Traits::ChannelsPerPixel == Buffer::ChannelsPerPixel(FormatType),
+                  "Pixel traits do not match Buffer::ChannelsPerPixel");
+
+    PixelView() = default;
+    explicit PixelView(const Buffer& a_buffer);
+    PIXEL_VIEW_FUNCTION PixelView(Pixel* a_data,
+                                  uint32_t a_width,
+                                  uint32_t a_height,
+                                  uint64_t a_pitch);
+
+    PIXEL_VIEW_FUNCTION Row GetRow(uint32_t a_y) const;
+    PIXEL_VIEW_FUNCTION Pixel& operator()(uint32_t a_x,
+                                          uint32_t a_y) const;
+    PIXEL_VIEW_FUNCTION PixelView SubView(uint32_t a_x,
+                                          uint32_t a_y,
+                                          uint32_t a_width,
+                                          uint32_t a_height) const;
+
+    PIXEL_VIEW_FUNCTION Tile GetTile(uint32_t a_tileX,
+                                     uint32_t a_tileY) const;
+    PIXEL_VIEW_FUNCTION uint32_t GetTileCountX() const;
+    PIXEL_VIEW_FUNCTION uint32_t GetTileCountY() const;
+
+    PIXEL_VIEW_FUNCTION Pixel* GetData() const;
+    PIXEL_VIEW_FUNCTION uint64_t GetPitch() const;
+    PIXEL_VIEW_FUNCTION uint32_t GetWidth() const;
+    PIXEL_VIEW_FUNCTION uint32_t GetHeight() const;
+    PIXEL_VIEW_FUNCTION bool IsEmpty() const;
+
+private:
+    Pixel* m_data = nullptr;
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    uint64_t m_pitch = 0;
+};
+
+//--------------------------------------------------------------
+//! Constructor.
+//!
+//! \param[in] a_data Pointer to the first pixel of the span.
+//! \param[in] a_size The number of pixels in the span.
+//--------------------------------------------------------------
+template<typename PixelType>
+PIXEL_VIEW_FUNCTION PixelSpan<PixelType>::PixelSpan(PixelType* a_data,
+                                                    uint32_t a_size)
+    : m_data(a_data)
+    , m_size(a_size)
+{
+}
+
+//--------------------------------------------------------------
+//! Get the first pixel of the span.
+//!
+//! \return Pointer to the first pixel of the span.
+//--------------------------------------------------------------
+template<typename PixelType>
+PIXEL_VIEW_FUNCTION PixelType* PixelSpan<PixelType>::begin() const
+{
+    return m_data;
+}
+
+//--------------------------------------------------------------
+//! Get one past the last pixel of the span.
+//!
+//! \return Pointer to one past the last pixel of the span.
+//--------------------------------------------------------------
+template<typename PixelType>
+PIXEL_VIEW_FUNCTION PixelType* PixelSpan<PixelType>::end() const
+{
+    return m_data + m_size;
+}
+
+//--------------------------------------------------------------
+//! Get the number of pixels in the span.
+//!
+//! \return The number of pixels in the span.
+//--------------------------------------------------------------
+template<typename PixelType>
+PIXEL_VIEW_FUNCTION uint32_t PixelSpan<PixelType>::size() const
+{
+    return m_size;
+}
+
+//--------------------------------------------------------------
+//! Access a pixel of the span.
+//!
+//! \param[in] a_x The index of the pixel, which must be less
+//!                than the number of pixels in the span.
+//! \return Reference to the pixel at the given index.
+//--------------------------------------------------------------
+template<typename PixelType>
+PIXEL_VIEW_FUNCTION PixelType& PixelSpan<PixelType>::operator[](uint32_t a_x) const
+{
+    return m_data[a_x];
+}
+
+//--------------------------------------------------------------
+template<Buffer::Format FormatType, Buffer::Interop InteropType, Buffer::Layout LayoutType>
+constexpr uint32_t PixelView<FormatType, InteropType, LayoutType>::TileSize;
+
+//--------------------------------------------------------------
+//! Constructor.
+//!
+//! The format, interop, and layout of the buffer are only checked
+//! here, so none of the other functions of the view perform checks.
+//!
+//! \param[in] a_buffer The buffer whose pixels will be viewed.
+//--------------------------------------------------------------
+template<Buffer::Format FormatType, Buffer::Interop InteropType, Buffer::Layout LayoutType>
+inline PixelView<FormatType, InteropType, LayoutType>::PixelView(const Buffer& a_buffer)
+{
+    if (a_buffer.GetFormat() != FormatType ||
+        a_buffer.GetInterop() != InteropType ||
+        a_buffer.GetLayout() != LayoutType ||
+        !a_buffer.GetData())
+    {
+        return;
+    }
+
+    m_data = static_cast<Pixel*>(a_buffer.GetData());
+    m_width = a_buffer.GetWidth();
+    m_height = a_buffer.GetHeight();
+    m_pitch = a_buffer.GetPitch();
+}
+
+//--------------------------------------------------------------
+//! Constructor.
+//!
+//! \param[in] a_data Pointer to the first pixel of the view.
+//! \param[in] a_width The width of the view in pixels.
+//! \param[in] a_height The height of the view in pixels.
+//! \param[in] a_pitch The distance in bytes between the start
+//!                    of consecutive rows of pixels in the view,
+//!                    which for tiled layouts is the size of a
+//!                    row of tiles divided by the tile size.
+//--------------------------------------------------------------
+template<Buffer::Format FormatType, Buffer::Interop InteropType, Buffer::Layout LayoutType>
+PIXEL_VIEW_FUNCTION PixelView<FormatType, InteropType, LayoutType>::PixelView(Pixel* a_data,
+                                                                              uint32_t a_width,
+                                                                              uint32_t a_height,
+                                                                              uint64_t a_pitch)
+    : m_data(a_data)
+    , m_width(a_width)
+    , m_height(a_height)
+    , m_pitch(a_pitch)
+{
+}
+
+//--------------------------------------------------------------
+//! Get a row of pixels, accounting for any padding between rows.
+//! Only views of pixels with a linear layout can be accessed by row.
+//!
+//! \param[in] a_y The index of the row, which must be less than
+//!                the height of the view.
+//! \return Span of all pixels in the row within the view.
+//--------------------------------------------------------------
+template<Buffer::Format FormatType, Buffer::Interop InteropType, Buffer::Layout LayoutType>
+PIXEL_VIEW_FUNCTION typename PixelView<FormatType, InteropType, LayoutType>::Row
+PixelView<FormatType, InteropType, LayoutType>::GetRow(uint32_t a_y) const
+{
+    static_assert(LayoutType == Buffer::Layout::LINEAR,
+                  "Tiled pixels cannot be accessed by row");
+    uint8_t* rowData = reinterpret_cast<uint8_t*>(m_data) +
+                       static_cast<size_t>(a_y) * m_pitch;
+    return Row(reinterpret_cast<Pixel*>(rowData), m_width);
+}
+
+//--------------------------------------------------------------
+//! Access a pixel of the view.
+//!
+//! \param[in] a_x The column of the pixel (less than the width).
+//! \param[in] a_y The row of the pixel (less than the height).
+//! \return Reference to the pixel at the given column and row.
+//--------------------------------------------------------------
+template<Buffer::Format FormatType, Buffer::Interop InteropType, Buffer::Layout LayoutType>
+PIXEL_VIEW_FUNCTION typename PixelView<FormatType, InteropType, LayoutType>::Pixel&
+PixelView<FormatType, InteropType, LayoutType>::operator()(uint32_t a_x,
+                                                           uint32_t a_y) const
+{
+    // The layout is known at compile time, so only one of these
+    // is evaluated, and the tile size divisions become shifts.
+    const size_t offset = (LayoutType == Buffer::Layout::LINEAR) ?
+                          (static_cast<size_t>(a_y) * m_pitch) + (a_x * sizeof(Pixel)) :
+                          static_cast<size_t>(PixelIndex<LayoutType>(static_cast<uint32_t>(m_pitch / sizeof(Pixel)),
+                                                                     a_x,
+                                                                     a_y)) * sizeof(Pixel);
+    return *reinterpret_cast<Pixel*>(reinterpret_cast<uint8_t*>(m_data) + offset);
+}
+
+//--------------------------------------------------------------
+//! Get a view of a rectangular region of this view's pixels.
+//! Only views of pixels with a linear layout can be sub-viewed.
+//!
+//! The region is clamped to the bounds of this view, so it may
+//! result in an empty view if it starts outside of these bounds.
+//!
+//! \param[in] a_x The column of the first pixel in the region.
+//! \param[in] a_y The row of the first pixel in the region.
+//! \param[in] a_width The width of the region in pixels.
+//! \param[in] a_height The height of the region in pixels.
+//! \return View of the pixels that are contained by the region.
+//--------------------------------------------------------------
+template<Buffer::Format FormatType, Buffer::Interop InteropType, Buffer::Layout LayoutType>
+PIXEL_VIEW_FUNCTION PixelView<FormatType, InteropType, LayoutType>
+PixelView<FormatType, InteropType, LayoutType>::SubView(uint32_t a_x,
+                                                        uint32_t a_y,
+                                                        uint32_t a_width,
+                                                        uint32_t a_height) const
+{
+    if (a_x >= m_width || a_y >= m_height)
+    {
+        return PixelView();
+    }
+
+    const uint32_t width = (m_width - a_x) < a_width ?
+                           (m_width - a_x) : a_width;
+    const uint32_t height = (m_height - a_y) < a_height ?
+                            (m_height - a_y) : a_height;
+    return PixelView(GetRow(a_y).begin() + a_x, width, height, m_pitch);
+}
+
+//--------------------------------------------------------------
+//! Get a view of a single tile of this view's pixels, which are
+//! contiguous in memory. Only views of tiled pixels have tiles.
+//!
+//! Tiles on the right and bottom edges are clamped to the width
+//! and height of this view, so may contain fewer pixels.
+//!
+//! \param[in] a_tileX The column of the tile (see GetTileCountX).
+//! \param[in] a_tileY The row of the tile (see GetTileCountY).
+//! \return View of the pixels that are contained by the tile.
+//--------------------------------------------------------------
+template<Buffer::Format FormatType, Buffer::Interop InteropType, Buffer::Layout LayoutType>
+PIXEL_VIEW_FUNCTION typename PixelView<FormatType, InteropType, LayoutType>::Tile
+PixelView<FormatType, InteropType, LayoutType>::GetTile(uint32_t a_tileX,
+                                                        uint32_t a_tileY) const
+{
+    static_assert(LayoutType != Buffer::Layout::LINEAR,
+                  "Linear pixels are not stored in tiles");
+    if (a_tileX >= GetTileCountX() || a_tileY >= GetTileCountY())
+    {
+        return Tile();
+    }
+
+    const uint32_t x = a_tileX * TileSize;
+    const uint32_t y = a_tileY * TileSize;
+    const uint32_t width = (m_width - x) < TileSize ? (m_width - x) : TileSize;
+    const uint32_t height = (m_height - y) < TileSize ? (m_height - y) : TileSize;
+    return Tile(&(*this)(x, y), width, height, TileSize * sizeof(Pixel));
+}
+
+//--------------------------------------------------------------
+//! Get the number of tiles in each row of tiles.
+//!
+//! \return The number of tiles in each row of tiles.
+//--------------------------------------------------------------
+template<Buffer::Format FormatType, Buffer::Interop InteropType, Buffer::Layout LayoutType>
+PIXEL_VIEW_FUNCTION uint32_t PixelView<FormatType, InteropType, LayoutType>::GetTileCountX() const
+{
+    return (m_width + TileSize - 1) / TileSize;
+}
+
+//--------------------------------------------------------------
+//! Get the number of rows of tiles.
+//!
+//! \return The number of rows of tiles.
+//--------------------------------------------------------------
+template<Buffer::Format FormatType, Buffer::Interop InteropType, Buffer::Layout LayoutType>
+PIXEL_VIEW_FUNCTION uint32_t PixelView<FormatType, InteropType, LayoutType>::GetTileCountY() const
+{
+    return (m_height + TileSize - 1) / TileSize;
+}
+
+//--------------------------------------------------------------
+//! Get the first pixel of the view.
+//!
+//! \return Pointer to the first pixel, or nullptr if empty.
+//--------------------------------------------------------------
+template<Buffer::Format FormatType, Buffer::Interop InteropType, Buffer::Layout LayoutType>
+PIXEL_VIEW_FUNCTION typename PixelView<FormatType, InteropType, LayoutType>::Pixel*
+PixelView<FormatType, InteropType, LayoutType>::GetData() const
+{
+    return m_data;
+}
+
+//--------------------------------------------------------------
+//! Get the distance in bytes between the start of rows.
+//!
+//! \return The distance in bytes between the start of rows.
+//--------------------------------------------------------------
+template<Buffer::Format FormatType, Buffer::Interop InteropType, Buffer::Layout LayoutType>
+PIXEL_VIEW_FUNCTION uint64_t PixelView<FormatType, InteropType, LayoutType>::GetPitch() const
+{
+    return m_pitch;
+}
+
+//--------------------------------------------------------------
+//! Get the width of the view in pixels.
+//!
+//! \return The width of the view in pixels.
+//--------------------------------------------------------------
+template<Buffer::Format FormatType, Buffer::Interop InteropType, Buffer::Layout LayoutType>
+PIXEL_VIEW_FUNCTION uint32_t PixelView<FormatType, InteropType, LayoutType>::GetWidth() const
+{
+    return m_width;
+}
+
+//--------------------------------------------------------------
+//! Get the height of the view in pixels.
+//!
+//! \return The height of the view in pixels.
+//--------------------------------------------------------------
+template<Buffer::Format FormatType, Buffer::Interop InteropType, Buffer::Layout LayoutType>
+PIXEL_VIEW_FUNCTION uint32_t PixelView<FormatType, InteropType, LayoutType>::GetHeight() const
+{
+    return m_height;
+}
+
+//--------------------------------------------------------------
+//! Check whether the view contains any pixels.
+//!
+//! \return True if the view contains no pixels, false otherwise.
+//--------------------------------------------------------------
+template<Buffer::Format FormatType, Buffer::Interop InteropType, Buffer::Layout LayoutType>
+PIXEL_VIEW_FUNCTION bool PixelView<FormatType, InteropType, LayoutType>::IsEmpty() const
+{
+    return !m_data || !m_width || !m_height;
+}
+
+} // namespace Display
+} // namespace Simple
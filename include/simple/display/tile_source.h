@@ -0,0 +1,252 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include "context.h"
+
+#include <string>
+
+//! @file
+
+//--------------------------------------------------------------
+//! The default width and height (in pixels) of each file tile.
+//--------------------------------------------------------------
+#ifndef DEFAULT_TILE_SOURCE_TILE_SIZE
+#define DEFAULT_TILE_SOURCE_TILE_SIZE 256
+#endif//DEFAULT_TILE_SOURCE_TILE_SIZE
+
+//--------------------------------------------------------------
+//! The default max number of tiles kept in memory by a source.
+//--------------------------------------------------------------
+#ifndef DEFAULT_TILE_SOURCE_CACHE_TILES
+#define DEFAULT_TILE_SOURCE_CACHE_TILES 256
+#endif//DEFAULT_TILE_SOURCE_CACHE_TILES
+
+//--------------------------------------------------------------
+//! The default number of frames of viewport movement to prefetch.
+//--------------------------------------------------------------
+#ifndef DEFAULT_TILE_SOURCE_PREFETCH_FRAMES
+#define DEFAULT_TILE_SOURCE_PREFETCH_FRAMES 8
+#endif//DEFAULT_TILE_SOURCE_PREFETCH_FRAMES
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Display
+{
+
+//--------------------------------------------------------------
+//! Class that streams an image too large to be stored in memory.
+//!
+//! The Simple::Display::TileSource class maps a tiled image file
+//! into memory, then each frame copies the region of the image in
+//! its viewport to a display buffer, sampling the mip level with
+//! the resolution closest to (but not less than) the buffer's.
+//!
+//! Tiles are read from the file by a background thread into a
+//! cache of the most recently used tiles, so the memory used does
+//! not depend on the size of the image. Tiles that have not been
+//! read yet are drawn using the closest coarser mip level in the
+//! cache, so updates never wait for the file, and the tiles the
+//! viewport is moving towards are read before they are visible.
+//!
+//! Files store each mip level in turn, starting with the full
+//! resolution image, then each level half the width and height
+//! (rounded down, but at least one pixel) of the previous level.
+//! Each level stores rows of tiles, and each tile stores rows of
+//! pixels, with tiles at the right and bottom edges of the level
+//! padded to the full tile size (see TileSource::TileOffsetBytes).
+//--------------------------------------------------------------
+class TileSource
+{
+public:
+    class Implementation;
+
+    //----------------------------------------------------------
+    //! Values needed to define Simple::Display::TileSource objects.
+    //----------------------------------------------------------
+    struct Config
+    {
+        //! The path (utf8) of the tiled image file to be mapped.
+        std::string filePathUTF8;
+
+        //! The offset (measured in bytes) of the first tile.
+        uint64_t fileOffset = 0;
+
+        //! The width of the full resolution image, in pixels.
+        uint32_t width = 0;
+
+        //! The height of the full resolution image, in pixels.
+        uint32_t height = 0;
+
+        //! The pixel format of the image, which must match the
+        //! format of any display buffer the image is copied to.
+        Buffer::Format format = Buffer::Format::RGBA_UINT8;
+
+        //! The width and height of each tile (a power of two).
+        uint32_t tileSize = DEFAULT_TILE_SOURCE_TILE_SIZE;
+
+        //! The number of mip levels stored in the image file.
+        uint32_t levelCount = 1;
+
+        //! The max number of tiles that are kept in memory.
+        uint32_t cacheTileCount = DEFAULT_TILE_SOURCE_CACHE_TILES;
+
+        //! The number of frames the viewport is expected to keep
+        //! moving at its current velocity, used to prefetch tiles.
+        uint32_t prefetchFrames = DEFAULT_TILE_SOURCE_PREFETCH_FRAMES;
+    };
+
+    TileSource(const Config& a_config);
+    ~TileSource();
+
+    TileSource(const TileSource&) = delete;
+    TileSource& operator=(const TileSource&) = delete;
+
+    bool Update(Context& a_context);
+    bool Update(void* o_pixels,
+                uint32_t a_width,
+                uint32_t a_height,
+                uint64_t a_pitch);
+
+    void SetViewport(const Buffer::Viewport& a_viewport);
+    Buffer::Viewport GetViewport() const;
+
+    bool IsOpen() const;
+    uint32_t GetLevel() const;
+    uint32_t GetCachedTileCount() const;
+    uint32_t GetPendingTileCount() const;
+
+    static constexpr uint32_t LevelWidth(const Config&,
+                                         uint32_t a_level);
+    static constexpr uint32_t LevelHeight(const Config&,
+                                          uint32_t a_level);
+    static constexpr uint32_t TileCountX(const Config&,
+                                         uint32_t a_level);
+    static constexpr uint32_t TileCountY(const Config&,
+                                         uint32_t a_level);
+    static constexpr uint64_t TileSizeBytes(const Config&);
+    static constexpr uint64_t TileOffsetBytes(const Config&,
+                                              uint32_t a_level,
+                                              uint32_t a_tileX,
+                                              uint32_t a_tileY);
+    static constexpr uint64_t FileSizeBytes(const Config&);
+
+private:
+    const std::unique_ptr<Implementation> m_pimpl;
+};
+
+//--------------------------------------------------------------
+//! Calculate the width (in pixels) of a mip level of the image.
+//!
+//! \param[in] a_config The configuration values of the source.
+//! \param[in] a_level The mip level, where zero is full resolution.
+//! \return The width (in pixels) of the mip level of the image.
+//--------------------------------------------------------------
+constexpr uint32_t TileSource::LevelWidth(const Config& a_config,
+                                          uint32_t a_level)
+{
+    return (a_level < 32 && (a_config.width >> a_level)) ?
+           (a_config.width >> a_level) : (a_config.width ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+//! Calculate the height (in pixels) of a mip level of the image.
+//!
+//! \param[in] a_config The configuration values of the source.
+//! \param[in] a_level The mip level, where zero is full resolution.
+//! \return The height (in pixels) of the mip level of the image.
+//--------------------------------------------------------------
+constexpr uint32_t TileSource::LevelHeight(const Config& a_config,
+                                           uint32_t a_level)
+{
+    return (a_level < 32 && (a_config.height >> a_level)) ?
+           (a_config.height >> a_level) : (a_config.height ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+//! Calculate the number of tiles in each row of a mip level.
+//!
+//! \param[in] a_config The configuration values of the source.
+//! \param[in] a_level The mip level, where zero is full resolution.
+//! \return The number of tiles in each row of the mip level.
+//--------------------------------------------------------------
+constexpr uint32_t TileSource::TileCountX(const Config& a_config,
+                                          uint32_t a_level)
+{
+    return a_config.tileSize ?
+           (LevelWidth(a_config, a_level) + a_config.tileSize - 1) /
+           a_config.tileSize : 0;
+}
+
+//--------------------------------------------------------------
+//! Calculate the number of rows of tiles in a mip level.
+//!
+//! \param[in] a_config The configuration values of the source.
+//! \param[in] a_level The mip level, where zero is full resolution.
+//! \return The number of rows of tiles in the mip level.
+//--------------------------------------------------------------
+constexpr uint32_t TileSource::TileCountY(const Config& a_config,
+                                          uint32_t a_level)
+{
+    return a_config.tileSize ?
+           (LevelHeight(a_config, a_level) + a_config.tileSize - 1) /
+           a_config.tileSize : 0;
+}
+
+//--------------------------------------------------------------
+//! Calculate the size in bytes of each tile stored in the file.
+//!
+//! \param[in] a_config The configuration values of the source.
+//! \return The size in bytes of each tile stored in the file.
+//--------------------------------------------------------------
+constexpr uint64_t TileSource::TileSizeBytes(const Config& a_config)
+{
+    return static_cast<uint64_t>(a_config.tileSize) * a_config.tileSize *
+           Buffer::BytesPerPixel(a_config.format);
+}
+
+//--------------------------------------------------------------
+//! Calculate the offset in bytes of a tile stored in the file.
+//!
+//! \param[in] a_config The configuration values of the source.
+//! \param[in] a_level The mip level, where zero is full resolution.
+//! \param[in] a_tileX The column of the tile in the mip level.
+//! \param[in] a_tileY The row of the tile in the mip level.
+//! \return The offset in bytes of the tile stored in the file.
+//--------------------------------------------------------------
+constexpr uint64_t TileSource::TileOffsetBytes(const Config& a_config,
+                                               uint32_t a_level,
+                                               uint32_t a_tileX,
+                                               uint32_t a_tileY)
+{
+    uint64_t offset = a_config.fileOffset;
+    for (uint32_t level = 0; level < a_level; ++level)
+    {
+        offset += static_cast<uint64_t>(TileCountX(a_config, level)) *
+                  TileCountY(a_config, level) * TileSizeBytes(a_config);
+    }
+    return offset + ((static_cast<uint64_t>(a_tileY) * TileCountX(a_config, a_level)) +
+                     a_tileX) * TileSizeBytes(a_config);
+}
+
+//--------------------------------------------------------------
+//! Calculate the min size in bytes of the file, including all of
+//! the mip levels and the offset before the first tile.
+//!
+//! \param[in] a_config The configuration values of the source.
+//! \return The min size in bytes of the file.
+//--------------------------------------------------------------
+constexpr uint64_t TileSource::FileSizeBytes(const Config& a_config)
+{
+    return TileOffsetBytes(a_config, a_config.levelCount, 0, 0);
+}
+
+} // namespace Display
+} // namespace Simple
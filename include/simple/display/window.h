@@ -111,6 +111,9 @@ public:
     void PumpWindowEventsOnce();
     void PumpWindowEventsUntilEmpty();
 
+    void RequestRedraw();
+    bool IsRedrawRequested() const;
+
     bool IsFullScreen() const;
     bool IsMinimized() const;
     bool IsMaximized() const;
@@ -157,6 +160,9 @@ public:
     NativeTextEvents* GetNativeTextEvents() const;
 
 private:
+    friend class Context;
+    void ClearRedrawRequest();
+
     const std::unique_ptr<Implementation> m_pimpl;
 };
 
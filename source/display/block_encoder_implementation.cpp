@@ -0,0 +1,514 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <simple/display/block_encoder.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace Simple::Display;
+
+namespace
+{
+
+//--------------------------------------------------------------
+// The red/green/blue/alpha components of the pixels in a block,
+// stored in rows from the top left pixel.
+//--------------------------------------------------------------
+struct BlockPixels
+{
+    uint8_t rgba[16][4];
+};
+
+//--------------------------------------------------------------
+inline void LoadBlock(const uint8_t* a_pixels,
+                      uint32_t a_width,
+                      uint32_t a_height,
+                      uint64_t a_pitch,
+                      uint32_t a_blockX,
+                      uint32_t a_blockY,
+                      BlockPixels& o_block)
+{
+    // Pixels beyond the edges of the image are clamped to them.
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        const uint32_t x = std::min((a_blockX * 4) + (i % 4), a_width - 1);
+        const uint32_t y = std::min((a_blockY * 4) + (i / 4), a_height - 1);
+        const uint8_t* pixel = a_pixels + (y * a_pitch) + (x * 4ull);
+        std::copy(pixel, pixel + 4, o_block.rgba[i]);
+    }
+}
+
+//--------------------------------------------------------------
+inline uint32_t ColorError(const uint8_t* a_color0,
+                           const uint8_t* a_color1,
+                           uint32_t a_channels)
+{
+    uint32_t error = 0;
+    for (uint32_t c = 0; c < a_channels; ++c)
+    {
+        const int32_t delta = int32_t(a_color0[c]) - int32_t(a_color1[c]);
+        error += static_cast<uint32_t>(delta * delta);
+    }
+    return error;
+}
+
+//--------------------------------------------------------------
+inline uint16_t PackColor565(const uint8_t* a_color)
+{
+    return static_cast<uint16_t>((((a_color[0] * 31 + 127) / 255) << 11) |
+                                 (((a_color[1] * 63 + 127) / 255) << 5) |
+                                 ((a_color[2] * 31 + 127) / 255));
+}
+
+//--------------------------------------------------------------
+inline void UnpackColor565(uint16_t a_packed, uint8_t* o_color)
+{
+    const uint32_t r = (a_packed >> 11) & 31;
+    const uint32_t g = (a_packed >> 5) & 63;
+    const uint32_t b = a_packed & 31;
+    o_color[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+    o_color[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+    o_color[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+    o_color[3] = 255;
+}
+
+//--------------------------------------------------------------
+inline void WriteLittleEndian(uint64_t a_value,
+                              uint32_t a_bytes,
+                              uint8_t* o_dest)
+{
+    for (uint32_t i = 0; i < a_bytes; ++i)
+    {
+        o_dest[i] = static_cast<uint8_t>(a_value >> (i * 8));
+    }
+}
+
+//--------------------------------------------------------------
+// Encode the color of a block as two 5:6:5 endpoints and a 2 bit
+// index per pixel, using the endpoints (inset slightly) of the box
+// bounding the colors. If transparency is allowed and any pixel is
+// less than half opaque, the block uses three colors, with the
+// fourth index for transparent pixels (otherwise it uses four).
+//--------------------------------------------------------------
+inline void EncodeColorBlock(const BlockPixels& a_block,
+                             bool a_allowTransparency,
+                             uint8_t* o_dest)
+{
+    bool transparent = false;
+    uint8_t minColor[3] = { 255, 255, 255 };
+    uint8_t maxColor[3] = { 0, 0, 0 };
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        if (a_allowTransparency && a_block.rgba[i][3] < 128)
+        {
+            transparent = true;
+            continue;
+        }
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+            minColor[c] = std::min(minColor[c], a_block.rgba[i][c]);
+            maxColor[c] = std::max(maxColor[c], a_block.rgba[i][c]);
+        }
+    }
+
+    // Fully transparent blocks only need the transparent index.
+    if (minColor[0] > maxColor[0])
+    {
+        WriteLittleEndian(0, 2, o_dest);
+        WriteLittleEndian(0, 2, o_dest + 2);
+        WriteLittleEndian(0xFFFFFFFF, 4, o_dest + 4);
+        return;
+    }
+
+    // Inset the bounding box by 1/16 of its size on each side, so
+    // the endpoints are not skewed towards outlying pixels.
+    for (uint32_t c = 0; c < 3; ++c)
+    {
+        const uint8_t inset = static_cast<uint8_t>((maxColor[c] - minColor[c]) >> 4);
+        minColor[c] = static_cast<uint8_t>(minColor[c] + inset);
+        maxColor[c] = static_cast<uint8_t>(maxColor[c] - inset);
+    }
+
+    // Four color blocks need the first endpoint to be greater than
+    // the second, and three color blocks need the opposite.
+    uint16_t packed0 = PackColor565(maxColor);
+    uint16_t packed1 = PackColor565(minColor);
+    if (transparent ? (packed0 > packed1) : (packed0 < packed1))
+    {
+        std::swap(packed0, packed1);
+    }
+
+    uint8_t palette[4][4];
+    UnpackColor565(packed0, palette[0]);
+    UnpackColor565(packed1, palette[1]);
+    for (uint32_t c = 0; c < 3; ++c)
+    {
+        if (transparent)
+        {
+            palette[2][c] = static_cast<uint8_t>((palette[0][c] + palette[1][c]) / 2);
+            palette[3][c] = 0;
+        }
+        else
+        {
+            palette[2][c] = static_cast<uint8_t>(((2 * palette[0][c]) + palette[1][c]) / 3);
+            palette[3][c] = static_cast<uint8_t>((palette[0][c] + (2 * palette[1][c])) / 3);
+        }
+    }
+
+    // Find the closest color in the palette for each pixel.
+    const uint32_t colorCount = transparent ? 3 : 4;
+    uint32_t indices = 0;
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        uint32_t bestIndex = 3;
+        if (!transparent || a_block.rgba[i][3] >= 128)
+        {
+            uint32_t bestError = UINT32_MAX;
+            for (uint32_t index = 0; index < colorCount; ++index)
+            {
+                const uint32_t error = ColorError(a_block.rgba[i], palette[index], 3);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    bestIndex = index;
+                }
+            }
+        }
+        indices |= bestIndex << (i * 2);
+    }
+
+    WriteLittleEndian(packed0, 2, o_dest);
+    WriteLittleEndian(packed1, 2, o_dest + 2);
+    WriteLittleEndian(indices, 4, o_dest + 4);
+}
+
+//--------------------------------------------------------------
+// Encode the alpha of a block as two 8 bit endpoints and a 3 bit
+// index per pixel, interpolating eight values between the min and
+// max alpha of the block.
+//--------------------------------------------------------------
+inline void EncodeAlphaBlock(const BlockPixels& a_block,
+                             uint8_t* o_dest)
+{
+    uint8_t minAlpha = 255;
+    uint8_t maxAlpha = 0;
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        minAlpha = std::min(minAlpha, a_block.rgba[i][3]);
+        maxAlpha = std::max(maxAlpha, a_block.rgba[i][3]);
+    }
+
+    // Indices zero and one are the endpoints, and two to seven are
+    // interpolated from the first endpoint towards the second.
+    uint64_t indices = 0;
+    if (maxAlpha > minAlpha)
+    {
+        uint32_t palette[8] = { maxAlpha, minAlpha };
+        for (uint32_t index = 2; index < 8; ++index)
+        {
+            palette[index] = (((8 - index) * maxAlpha) + ((index - 1) * minAlpha)) / 7;
+        }
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            uint32_t bestIndex = 0;
+            uint32_t bestError = UINT32_MAX;
+            for (uint32_t index = 0; index < 8; ++index)
+            {
+                const int32_t delta = int32_t(a_block.rgba[i][3]) - int32_t(palette[index]);
+                const uint32_t error = static_cast<uint32_t>(delta * delta);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    bestIndex = index;
+                }
+            }
+            indices |= uint64_t(bestIndex) << (i * 3);
+        }
+    }
+
+    o_dest[0] = maxAlpha;
+    o_dest[1] = minAlpha;
+    WriteLittleEndian(indices, 6, o_dest + 2);
+}
+
+//--------------------------------------------------------------
+inline void WriteBits(uint32_t a_value,
+                      uint32_t a_count,
+                      uint32_t& io_bit,
+                      uint8_t* o_dest)
+{
+    for (uint32_t i = 0; i < a_count; ++i, ++io_bit)
+    {
+        if ((a_value >> i) & 1)
+        {
+            o_dest[io_bit / 8] |= static_cast<uint8_t>(1 << (io_bit % 8));
+        }
+    }
+}
+
+//--------------------------------------------------------------
+// Encode a block in BC7 mode 6, which stores two 7 bit red/green/
+// blue/alpha endpoints, each with a shared lowest bit (p-bit), and
+// a 4 bit index per pixel. The endpoints are the bounds of the
+// block, and the p-bits are chosen to minimize the error.
+//--------------------------------------------------------------
+inline void EncodeBC7Block(const BlockPixels& a_block,
+                           uint8_t* o_dest)
+{
+    static constexpr uint32_t Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30,
+                                              34, 38, 43, 47, 51, 55, 60, 64 };
+
+    uint8_t minColor[4] = { 255, 255, 255, 255 };
+    uint8_t maxColor[4] = { 0, 0, 0, 0 };
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            minColor[c] = std::min(minColor[c], a_block.rgba[i][c]);
+            maxColor[c] = std::max(maxColor[c], a_block.rgba[i][c]);
+        }
+    }
+
+    uint32_t bestError = UINT32_MAX;
+    uint8_t bestEndpoints[2][4] = {};
+    uint32_t bestPBits[2] = {};
+    uint8_t bestIndices[16] = {};
+    for (uint32_t pBits = 0; pBits < 4; ++pBits)
+    {
+        // Quantize each endpoint to the nearest 7 bit value that,
+        // combined with the p-bit, lies within the bounds.
+        const uint32_t pBit[2] = { pBits & 1, pBits >> 1 };
+        const uint8_t* bounds[2] = { minColor, maxColor };
+        uint8_t endpoints[2][4];
+        uint8_t expanded[2][4];
+        for (uint32_t e = 0; e < 2; ++e)
+        {
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                const int32_t value = (int32_t(bounds[e][c]) - int32_t(pBit[e]) + 1) >> 1;
+                endpoints[e][c] = static_cast<uint8_t>(std::min(std::max(value, 0), 127));
+                expanded[e][c] = static_cast<uint8_t>((endpoints[e][c] << 1) | pBit[e]);
+            }
+        }
+
+        uint8_t palette[16][4];
+        for (uint32_t index = 0; index < 16; ++index)
+        {
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                palette[index][c] = static_cast<uint8_t>((((64 - Weights[index]) * expanded[0][c]) +
+                                                          (Weights[index] * expanded[1][c]) + 32) >> 6);
+            }
+        }
+
+        uint32_t error = 0;
+        uint8_t indices[16];
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            uint32_t pixelError = UINT32_MAX;
+            for (uint32_t index = 0; index < 16; ++index)
+            {
+                const uint32_t indexError = ColorError(a_block.rgba[i], palette[index], 4);
+                if (indexError < pixelError)
+                {
+                    pixelError = indexError;
+                    indices[i] = static_cast<uint8_t>(index);
+                }
+            }
+            error += pixelError;
+        }
+
+        if (error < bestError)
+        {
+            bestError = error;
+            std::copy(&endpoints[0][0], &endpoints[0][0] + 8, &bestEndpoints[0][0]);
+            std::copy(pBit, pBit + 2, bestPBits);
+            std::copy(indices, indices + 16, bestIndices);
+        }
+    }
+
+    // The highest bit of the first index is implied to be zero, so
+    // swap the endpoints and invert the indices if it is not.
+    if (bestIndices[0] >= 8)
+    {
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            std::swap(bestEndpoints[0][c], bestEndpoints[1][c]);
+        }
+        std::swap(bestPBits[0], bestPBits[1]);
+        for (uint8_t& index : bestIndices)
+        {
+            index = static_cast<uint8_t>(15 - index);
+        }
+    }
+
+    // Write the mode, endpoints, p-bits, and indices.
+    std::fill(o_dest, o_dest + 16, uint8_t(0));
+    uint32_t bit = 0;
+    WriteBits(1 << 6, 7, bit, o_dest);
+    for (uint32_t c = 0; c < 4; ++c)
+    {
+        WriteBits(bestEndpoints[0][c], 7, bit, o_dest);
+        WriteBits(bestEndpoints[1][c], 7, bit, o_dest);
+    }
+    WriteBits(bestPBits[0], 1, bit, o_dest);
+    WriteBits(bestPBits[1], 1, bit, o_dest);
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        WriteBits(bestIndices[i], i ? 4 : 3, bit, o_dest);
+    }
+}
+
+//--------------------------------------------------------------
+void EncodeRows(const uint8_t* a_pixels,
+                uint32_t a_width,
+                uint32_t a_height,
+                uint64_t a_pitch,
+                Buffer::Format a_format,
+                uint8_t* o_blocks,
+                uint64_t a_blockPitch,
+                uint32_t a_firstRow,
+                uint32_t a_endRow)
+{
+    const uint32_t blockCountX = (a_width + 3) / 4;
+    const uint32_t bytesPerBlock = Buffer::BytesPerBlock(a_format);
+    BlockPixels block;
+    for (uint32_t blockY = a_firstRow; blockY < a_endRow; ++blockY)
+    {
+        uint8_t* dest = o_blocks + (blockY * a_blockPitch);
+        for (uint32_t blockX = 0; blockX < blockCountX; ++blockX, dest += bytesPerBlock)
+        {
+            LoadBlock(a_pixels, a_width, a_height, a_pitch, blockX, blockY, block);
+            switch (a_format)
+            {
+                case Buffer::Format::BC1_UNORM:
+                {
+                    EncodeColorBlock(block, true, dest);
+                }
+                break;
+                case Buffer::Format::BC3_UNORM:
+                {
+                    EncodeAlphaBlock(block, dest);
+                    EncodeColorBlock(block, false, dest + 8);
+                }
+                break;
+                case Buffer::Format::BC7_UNORM:
+                {
+                    EncodeBC7Block(block, dest);
+                }
+                break;
+                default: break;
+            }
+        }
+    }
+}
+
+} // namespace
+
+//--------------------------------------------------------------
+//! Encode RGBA_UINT8 pixels into the blocks of a block-compressed
+//! format, writing each row of blocks at the given block pitch.
+//!
+//! \param[in] a_pixels The RGBA_UINT8 pixels of the image.
+//! \param[in] a_width The width of the image in pixels.
+//! \param[in] a_height The height of the image in pixels.
+//! \param[in] a_pitch The size in bytes of each row of pixels.
+//! \param[in] a_format The block-compressed format to encode.
+//! \param[out] o_blocks The blocks written for the image, which
+//!             must store ((a_height + 3) / 4) rows of blocks.
+//! \param[in] a_blockPitch The size in bytes of each row of blocks.
+//! \param[in] a_threadCount The max number of threads used (zero to
+//!            use one for each hardware thread), though images with
+//!            less than BLOCK_ENCODER_THREAD_THRESHOLD_BLOCKS blocks
+//!            are always encoded using a single thread.
+//! \return True if the image was encoded, false otherwise.
+//--------------------------------------------------------------
+bool BlockEncoder::Encode(const void* a_pixels,
+                          uint32_t a_width,
+                          uint32_t a_height,
+                          uint64_t a_pitch,
+                          Buffer::Format a_format,
+                          void* o_blocks,
+                          uint64_t a_blockPitch,
+                          uint32_t a_threadCount)
+{
+    const uint32_t blockCountX = (a_width + 3) / 4;
+    const uint32_t blockCountY = (a_height + 3) / 4;
+    if (!a_pixels || !o_blocks || !a_width || !a_height ||
+        Buffer::BlockSize(a_format) != 4 ||
+        a_pitch < a_width * 4ull ||
+        a_blockPitch < blockCountX * uint64_t(Buffer::BytesPerBlock(a_format)))
+    {
+        return false;
+    }
+
+    // Split large images into bands of block rows, each encoded by
+    // a separate thread, with the last band encoded by this thread.
+    const uint8_t* pixels = static_cast<const uint8_t*>(a_pixels);
+    uint8_t* blocks = static_cast<uint8_t*>(o_blocks);
+    const uint64_t blockCount = uint64_t(blockCountX) * blockCountY;
+    const uint32_t maxThreadCount = a_threadCount ? a_threadCount :
+                                    std::max(std::thread::hardware_concurrency(), 1u);
+    const uint32_t threadCount = (blockCount < BLOCK_ENCODER_THREAD_THRESHOLD_BLOCKS) ? 1 :
+                                  std::min(maxThreadCount, blockCountY);
+    const uint32_t bandSize = (blockCountY + threadCount - 1) / threadCount;
+
+    std::vector<std::thread> threads;
+    uint32_t firstRow = 0;
+    for (; firstRow + bandSize < blockCountY; firstRow += bandSize)
+    {
+        threads.emplace_back(EncodeRows, pixels, a_width, a_height, a_pitch,
+                             a_format, blocks, a_blockPitch,
+                             firstRow, firstRow + bandSize);
+    }
+    EncodeRows(pixels, a_width, a_height, a_pitch,
+               a_format, blocks, a_blockPitch,
+               firstRow, blockCountY);
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------
+//! Encode RGBA_UINT8 pixels into the data of a display buffer,
+//! which must be a host buffer with a block-compressed format and
+//! the same width and height as the image, then invalidate it.
+//!
+//! \param[in] a_pixels The RGBA_UINT8 pixels of the image.
+//! \param[in] a_pitch The size in bytes of each row of pixels.
+//! \param[out] o_buffer The display buffer the blocks are written to.
+//! \param[in] a_threadCount The max number of threads used (zero to
+//!            use one for each hardware thread).
+//! \return True if the image was encoded, false otherwise.
+//--------------------------------------------------------------
+bool BlockEncoder::Encode(const void* a_pixels,
+                          uint64_t a_pitch,
+                          Buffer& o_buffer,
+                          uint32_t a_threadCount)
+{
+    if (o_buffer.GetInterop() != Buffer::Interop::HOST ||
+        !Encode(a_pixels,
+                o_buffer.GetWidth(),
+                o_buffer.GetHeight(),
+                a_pitch,
+                o_buffer.GetFormat(),
+                o_buffer.GetData(),
+                o_buffer.GetPitch(),
+                a_threadCount))
+    {
+        return false;
+    }
+
+    o_buffer.Invalidate();
+    return true;
+}
@@ -0,0 +1,356 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <display/buffer_implementation.h>
+
+#include <functional>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Display
+{
+
+//--------------------------------------------------------------
+// Buffer that stores pixels in host memory without rendering them,
+// which contexts that present asynchronously hand to the producer
+// so it never touches the buffer owned by their render thread.
+//--------------------------------------------------------------
+class BufferHost : public Buffer::Implementation
+{
+public:
+    // Resizes the buffer that is rendered each time this buffer is
+    // created or resized, returning a config that matches the layout
+    // and pitch of its pixel data (so frames are copied in a single
+    // block), which this buffer then uses instead.
+    using RenderResizer = std::function<Buffer::Config(const Buffer::Config&)>;
+
+    BufferHost(const Buffer::Config& a_config,
+               const RenderResizer& a_renderResizer = nullptr);
+    ~BufferHost() override;
+
+    BufferHost(const BufferHost&) = delete;
+    BufferHost& operator=(const BufferHost&) = delete;
+
+    // Swap the pixel data memory with other memory (so frames can be
+    // handed over without holding a lock while copying them), then
+    // copy the pixel data back from it (see RestoreData) so it is
+    // preserved between frames, replacing the memory taken if it is
+    // not the size of the buffer (eg. from before a resize).
+    void SwapData(void*& io_data,
+                  uint64_t& io_size);
+    void RestoreData(const void* a_data);
+
+    // Set the upload counters of the buffer that is rendered, which
+    // are reported as those of this buffer.
+    void SetUploadCounters(const Buffer::UploadCounters& a_uploadCounters);
+
+    // Get the config of a buffer that can be presented by copying
+    // the pixel data of a buffer created using the returned config.
+    static Buffer::Config GetHostConfig(const Buffer::Config& a_config);
+
+protected:
+    void Create(const Buffer::Config& a_config);
+    void Delete();
+
+    void Resize(const Buffer::Config& a_config) override;
+    void Render(uint32_t a_displayWidth,
+                uint32_t a_displayHeight) override;
+
+    void SetViewport(const Buffer::Viewport& a_viewport) override;
+    Buffer::Viewport GetViewport() const override;
+
+    void CommitRows(uint32_t a_firstRow,
+                    uint32_t a_rowCount) override;
+
+    void FillRect(const Buffer::Rect& a_rect,
+                  const uint8_t* a_pixel) override;
+    void CopyRect(const Buffer::Rect& a_source,
+                  uint32_t a_destX,
+                  uint32_t a_destY) override;
+
+    bool StoreFlipbookFrame(uint32_t a_frame) override;
+    void SetDataReadable(bool a_readable) override;
+
+    void* GetData() const override;
+    uint64_t GetSize() const override;
+    uint64_t GetPitch() const override;
+    uint32_t GetWidth() const override;
+    uint32_t GetHeight() const override;
+    Buffer::Format GetFormat() const override;
+    Buffer::Interop GetInterop() const override;
+    Buffer::Storage GetStorage() const override;
+    Buffer::Layout GetLayout() const override;
+    Buffer::Scroll GetScroll() const override;
+    uint32_t GetFlipbookFrameCount() const override;
+    bool IsAccumulating() const override;
+    Buffer::UploadCounters GetUploadCounters() const override;
+
+private:
+    Buffer::Config m_config = Buffer::Config::Invalid();
+    Buffer::Viewport m_viewport = {};
+    Buffer::UploadCounters m_uploadCounters = {};
+    RenderResizer m_renderResizer;
+    void* m_data = nullptr;
+};
+
+//--------------------------------------------------------------
+inline BufferHost::BufferHost(const Buffer::Config& a_config,
+                              const RenderResizer& a_renderResizer)
+    : m_renderResizer(a_renderResizer)
+{
+    Create(a_config);
+}
+
+//--------------------------------------------------------------
+inline BufferHost::~BufferHost()
+{
+    Delete();
+}
+
+//--------------------------------------------------------------
+inline void BufferHost::SwapData(void*& io_data,
+                                 uint64_t& io_size)
+{
+    const uint64_t sizeBytes = Buffer::AlignedSizeBytes(m_config);
+    std::swap(m_data, io_data);
+    if (io_size != sizeBytes)
+    {
+        ::operator delete(m_data);
+        m_data = ::operator new(sizeBytes);
+        memset(m_data, 0, sizeBytes);
+    }
+    io_size = sizeBytes;
+}
+
+//--------------------------------------------------------------
+inline void BufferHost::RestoreData(const void* a_data)
+{
+    memcpy(m_data, a_data, Buffer::AlignedSizeBytes(m_config));
+}
+
+//--------------------------------------------------------------
+inline void BufferHost::SetUploadCounters(const Buffer::UploadCounters& a_uploadCounters)
+{
+    m_uploadCounters = a_uploadCounters;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Config BufferHost::GetHostConfig(const Buffer::Config& a_config)
+{
+    // Only the pixel data is copied to the buffer that is rendered,
+    // so it must be stored in host memory (buffers that scroll, store
+    // flipbook frames, or accumulate depend on state that is not
+    // copied, so they are never presented this way), and block-
+    // compressed formats are stored as rows of blocks (matching the
+    // layout of every rendered buffer), with the pitch alignment
+    // rounded up to a power of two (as they all do).
+    assert(a_config.scroll == Buffer::Scroll::NONE);
+    assert(!a_config.flipbookFrames);
+    assert(!a_config.accumulate);
+    Buffer::Config config = a_config;
+    config.pitchAlignment = GetPowerOfTwoAlignment(config.pitchAlignment);
+    config.interop = Buffer::Interop::HOST;
+    if (Buffer::BlockSize(config.format) > 1)
+    {
+        config.layout = Buffer::Layout::LINEAR;
+    }
+    return config;
+}
+
+//--------------------------------------------------------------
+inline void BufferHost::Create(const Buffer::Config& a_config)
+{
+    // Store the config, matching the buffer that is rendered.
+    assert(!m_data);
+    m_config = GetHostConfig(a_config);
+    if (m_renderResizer)
+    {
+        m_config = m_renderResizer(m_config);
+    }
+
+    // Allocate the pixel data memory.
+    const uint64_t sizeBytes = Buffer::AlignedSizeBytes(m_config);
+    m_data = ::operator new(sizeBytes);
+    memset(m_data, 0, sizeBytes);
+}
+
+//--------------------------------------------------------------
+inline void BufferHost::Delete()
+{
+    // Deallocate the pixel data memory.
+    assert(m_data);
+    ::operator delete(m_data);
+    m_data = nullptr;
+
+    // Invalidate the config.
+    m_config = Buffer::Config::Invalid();
+}
+
+//--------------------------------------------------------------
+inline void BufferHost::Resize(const Buffer::Config& a_config)
+{
+    Delete();
+    Create(a_config);
+}
+
+//--------------------------------------------------------------
+inline void BufferHost::Render(uint32_t a_displayWidth,
+                               uint32_t a_displayHeight)
+{
+    // Pixels are copied to the buffer that is rendered instead.
+    (void)a_displayWidth;
+    (void)a_displayHeight;
+}
+
+//--------------------------------------------------------------
+inline void BufferHost::SetViewport(const Buffer::Viewport& a_viewport)
+{
+    m_viewport = a_viewport;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Viewport BufferHost::GetViewport() const
+{
+    return m_viewport;
+}
+
+//--------------------------------------------------------------
+inline void BufferHost::CommitRows(uint32_t a_firstRow,
+                                   uint32_t a_rowCount)
+{
+    // All rows are copied to the buffer that is rendered.
+    (void)a_firstRow;
+    (void)a_rowCount;
+}
+
+//--------------------------------------------------------------
+inline void BufferHost::FillRect(const Buffer::Rect& a_rect,
+                                 const uint8_t* a_pixel)
+{
+    // Pixels are stored in host memory, so apply each operation
+    // to them immediately.
+    FillByteRanges(m_data,
+                   GetByteRanges(m_config, a_rect),
+                   a_pixel,
+                   Buffer::BytesPerPixel(m_config.format));
+}
+
+//--------------------------------------------------------------
+inline void BufferHost::CopyRect(const Buffer::Rect& a_source,
+                                 uint32_t a_destX,
+                                 uint32_t a_destY)
+{
+    // Pixels are stored in host memory, so apply each operation
+    // to them immediately.
+    std::vector<ByteRange> source;
+    std::vector<ByteRange> dest;
+    GetCopyByteRanges(m_config, a_source, a_destX, a_destY, source, dest);
+    CopyByteRanges(m_data, source, dest);
+}
+
+//--------------------------------------------------------------
+inline bool BufferHost::StoreFlipbookFrame(uint32_t a_frame)
+{
+    // There are never any flipbook frames to store pixels in.
+    (void)a_frame;
+    return false;
+}
+
+//--------------------------------------------------------------
+inline void BufferHost::SetDataReadable(bool a_readable)
+{
+    // The buffer data is stored in host memory, so is always readable.
+    (void)a_readable;
+}
+
+//--------------------------------------------------------------
+inline void* BufferHost::GetData() const
+{
+    return m_data;
+}
+
+//--------------------------------------------------------------
+inline uint64_t BufferHost::GetSize() const
+{
+    return Buffer::AlignedSizeBytes(m_config);
+}
+
+//--------------------------------------------------------------
+inline uint64_t BufferHost::GetPitch() const
+{
+    return Buffer::AlignedPitchBytes(m_config);
+}
+
+//--------------------------------------------------------------
+inline uint32_t BufferHost::GetWidth() const
+{
+    return m_config.width;
+}
+
+//--------------------------------------------------------------
+inline uint32_t BufferHost::GetHeight() const
+{
+    return m_config.height;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Format BufferHost::GetFormat() const
+{
+    return m_config.format;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Interop BufferHost::GetInterop() const
+{
+    return m_config.interop;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Storage BufferHost::GetStorage() const
+{
+    // The storage of the buffer that is rendered (which resolves AUTO
+    // storage), or NATIVE if nothing is rendered.
+    return (m_config.storage == Buffer::Storage::AUTO) ? Buffer::Storage::NATIVE :
+                                                         m_config.storage;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Layout BufferHost::GetLayout() const
+{
+    return m_config.layout;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Scroll BufferHost::GetScroll() const
+{
+    return m_config.scroll;
+}
+
+//--------------------------------------------------------------
+inline uint32_t BufferHost::GetFlipbookFrameCount() const
+{
+    return m_config.flipbookFrames;
+}
+
+//--------------------------------------------------------------
+inline bool BufferHost::IsAccumulating() const
+{
+    return m_config.accumulate;
+}
+
+//--------------------------------------------------------------
+inline Buffer::UploadCounters BufferHost::GetUploadCounters() const
+{
+    return m_uploadCounters;
+}
+
+} // namespace Display
+} // namespace Simple
@@ -8,12 +8,14 @@
 
 #include <display/buffer_implementation.h>
 
+#include <algorithm>
+
 using namespace Simple::Display;
 
 //--------------------------------------------------------------
 Buffer::Config Buffer::Config::Invalid()
 {
-    return { 0, 0, Format::NONE, Interop::NONE };
+    return { 0, 0, Format::NONE, Interop::NONE, Storage::NATIVE, 0, Layout::LINEAR, false, Scroll::NONE, false, 0, false };
 }
 
 //--------------------------------------------------------------
@@ -37,6 +39,12 @@ void Buffer::Resize(const Config& a_config)
     if (m_pimpl)
     {
         m_pimpl->Resize(a_config);
+        m_pimpl->m_isInvalidated = true;
+        m_pimpl->m_scrollOffset = 0;
+        m_pimpl->m_scrollPendingLines = UINT32_MAX;
+        m_pimpl->m_flipbookFrame = UINT32_MAX;
+        m_pimpl->m_accumulatePendingSamples = 0;
+        m_pimpl->m_accumulatedSamples = 0;
     }
 }
 
@@ -53,9 +61,391 @@ void Buffer::Render(uint32_t a_displayWidth,
     if (m_pimpl)
     {
         m_pimpl->Render(a_displayWidth, a_displayHeight);
+        m_pimpl->m_isInvalidated = false;
+        m_pimpl->m_scrollPendingLines = 0;
+        m_pimpl->m_accumulatePendingSamples = 0;
+    }
+}
+
+//--------------------------------------------------------------
+//! Set the region of the buffer that is scaled to fill the display
+//! when rendered. Should usually be set via the Context instead.
+//!
+//! \param[in] a_viewport The region of the buffer to be displayed.
+//--------------------------------------------------------------
+void Buffer::SetViewport(const Viewport& a_viewport)
+{
+    if (m_pimpl)
+    {
+        m_pimpl->SetViewport(a_viewport);
+        m_pimpl->m_isInvalidated = true;
+    }
+}
+
+//--------------------------------------------------------------
+//! Get the region of the buffer that is scaled to fill the display.
+//!
+//! \return The region of the buffer that is scaled to fill the
+//!         display, which has no area if the entire buffer is.
+//--------------------------------------------------------------
+Buffer::Viewport Buffer::GetViewport() const
+{
+    return m_pimpl ? m_pimpl->GetViewport() : Viewport();
+}
+
+//--------------------------------------------------------------
+//! Mark the buffer data as changed, so that it will be presented
+//! at the end of the frame by a context that renders on demand.
+//! Should be called each frame the buffer data is written to.
+//--------------------------------------------------------------
+void Buffer::Invalidate()
+{
+    if (m_pimpl)
+    {
+        m_pimpl->m_isInvalidated = true;
+    }
+}
+
+//--------------------------------------------------------------
+//! Query whether the buffer has been invalidated (or resized, or
+//! its viewport has been set) since it was last rendered.
+//!
+//! \return True if the buffer needs to be rendered, false otherwise.
+//--------------------------------------------------------------
+bool Buffer::IsInvalidated() const
+{
+    return m_pimpl ? m_pimpl->m_isInvalidated : false;
+}
+
+//--------------------------------------------------------------
+//! Acquire the next line of a scrolling buffer, which replaces the
+//! oldest line and will be displayed as the last row (or column)
+//! of the buffer. Only the acquired line needs to be written, and
+//! the buffer is invalidated. Lines must be written before the end
+//! of the frame, and pointers to them should not be stored.
+//!
+//! \return The first pixel of the line, or nullptr if the buffer
+//!         does not scroll. Pixels in each row are contiguous,
+//!         while pixels in each column are one pitch apart.
+//--------------------------------------------------------------
+void* Buffer::AcquireScrollLine()
+{
+    const Scroll scroll = GetScroll();
+    const uint32_t lineCount = (scroll == Scroll::ROWS) ? GetHeight() :
+                               (scroll == Scroll::COLUMNS) ? GetWidth() : 0;
+    uint8_t* data = static_cast<uint8_t*>(GetData());
+    if (!data || !lineCount)
+    {
+        return nullptr;
+    }
+
+    const uint32_t line = m_pimpl->m_scrollOffset;
+    m_pimpl->m_scrollOffset = (line + 1) % lineCount;
+    if (m_pimpl->m_scrollPendingLines < lineCount)
+    {
+        ++m_pimpl->m_scrollPendingLines;
+    }
+    m_pimpl->m_isInvalidated = true;
+
+    return data + ((scroll == Scroll::ROWS) ?
+                   line * GetPitch() :
+                   line * static_cast<uint64_t>(BytesPerPixel(GetFormat())));
+}
+
+//--------------------------------------------------------------
+//! Get the line of buffer data (a row or column, depending on the
+//! scroll mode) that is displayed first, which is the oldest line.
+//!
+//! \return The line of buffer data that is displayed first.
+//--------------------------------------------------------------
+uint32_t Buffer::GetScrollOffset() const
+{
+    return m_pimpl ? m_pimpl->m_scrollOffset : 0;
+}
+
+//--------------------------------------------------------------
+//! Commit a band of rows of buffer data that are complete, so only
+//! the rows committed are uploaded to the GPU. Bands are uploaded the
+//! next time the buffer is rendered, not when they are committed
+//! (the buffer data stays mapped for writing until then), so this
+//! reduces what is uploaded rather than overlapping uploads with the
+//! rest of the frame being written. Once any rows of a frame have
+//! been committed, only the rows committed are uploaded, and the
+//! frame is displayed when all of its rows have been committed (or
+//! as each band is uploaded if the buffer is progressive), after
+//! which the next frame is uploaded whole as usual unless its rows
+//! are also committed. Bands of tiled buffers are extended to whole
+//! rows of tiles. Only the OpenGL core profile uploads bands of rows;
+//! other graphics apis, and block-compressed or scrolling buffers,
+//! ignore committed rows and upload the entire buffer when it is
+//! rendered (as usual).
+//!
+//! \param[in] a_firstRow The first row of the band of buffer data.
+//! \param[in] a_rowCount The number of rows in the band.
+//--------------------------------------------------------------
+void Buffer::CommitRows(uint32_t a_firstRow,
+                        uint32_t a_rowCount)
+{
+    const uint32_t height = GetHeight();
+    if (!m_pimpl || a_firstRow >= height || !a_rowCount)
+    {
+        return;
+    }
+
+    m_pimpl->CommitRows(a_firstRow, std::min(a_rowCount, height - a_firstRow));
+    m_pimpl->m_isInvalidated = true;
+}
+
+//--------------------------------------------------------------
+//! Fill the entire buffer with a color (see Buffer::FillRect).
+//!
+//! \param[in] a_color The color to fill the buffer with.
+//--------------------------------------------------------------
+void Buffer::Clear(const Color& a_color)
+{
+    FillRect({ 0, 0, GetWidth(), GetHeight() }, a_color);
+}
+
+//--------------------------------------------------------------
+//! Fill a region of the buffer with a color, on the GPU if it is
+//! supported by the graphics api, instead of writing each pixel
+//! through the buffer data. Operations are applied immediately, so
+//! they are ordered with pixels written through the buffer data
+//! (overwriting pixels written before them, and being overwritten
+//! by pixels written after them) on every graphics api. Graphics
+//! apis that cannot apply operations on the GPU apply them to host
+//! accessible buffer data instead (leaving any other unchanged).
+//! Applying an operation on the GPU may map the buffer data again,
+//! so GetData must be called again after calling it.
+//!
+//! Regions are clipped to the buffer, and regions of tiled buffers
+//! are extended to whole tiles. Changes are uploaded like pixels
+//! written through the buffer data (eg. rows must be committed by
+//! buffers that commit rows, see Buffer::CommitRows), except that
+//! rows already committed this frame are uploaded again.
+//!
+//! \param[in] a_rect The region of the buffer to fill.
+//! \param[in] a_color The color to fill the region with.
+//--------------------------------------------------------------
+void Buffer::FillRect(const Rect& a_rect,
+                      const Color& a_color)
+{
+    const uint32_t width = GetWidth();
+    const uint32_t height = GetHeight();
+    if (!m_pimpl || a_rect.x >= width || a_rect.y >= height)
+    {
+        return;
+    }
+
+    Rect rect = a_rect;
+    rect.width = std::min(rect.width, width - rect.x);
+    rect.height = std::min(rect.height, height - rect.y);
+    if (!rect.width || !rect.height)
+    {
+        return;
+    }
+
+    // Convert the color to the pixel format of the buffer.
+    uint8_t pixel[16] = {};
+    switch (GetFormat())
+    {
+        case Format::RGBA_FLOAT:
+        {
+            const float color[4] = { a_color.red, a_color.green,
+                                     a_color.blue, a_color.alpha };
+            memcpy(pixel, color, sizeof(color));
+        }
+        break;
+        case Format::RGBA_UINT8:
+        {
+            const uint8_t color[4] = { static_cast<uint8_t>(PackUNORM(a_color.red, 0xFF)),
+                                       static_cast<uint8_t>(PackUNORM(a_color.green, 0xFF)),
+                                       static_cast<uint8_t>(PackUNORM(a_color.blue, 0xFF)),
+                                       static_cast<uint8_t>(PackUNORM(a_color.alpha, 0xFF)) };
+            memcpy(pixel, color, sizeof(color));
+        }
+        break;
+        case Format::RGBA_UINT16:
+        {
+            const uint16_t color[4] = { static_cast<uint16_t>(PackUNORM(a_color.red, 0xFFFF)),
+                                        static_cast<uint16_t>(PackUNORM(a_color.green, 0xFFFF)),
+                                        static_cast<uint16_t>(PackUNORM(a_color.blue, 0xFFFF)),
+                                        static_cast<uint16_t>(PackUNORM(a_color.alpha, 0xFFFF)) };
+            memcpy(pixel, color, sizeof(color));
+        }
+        break;
+        case Format::RGB10A2_UNORM:
+        {
+            const uint32_t color = PackRGB10A2(a_color.red, a_color.green,
+                                               a_color.blue, a_color.alpha);
+            memcpy(pixel, &color, sizeof(color));
+        }
+        break;
+        default: return;
+    }
+
+    m_pimpl->FillRect(rect, pixel);
+    m_pimpl->m_isInvalidated = true;
+}
+
+//--------------------------------------------------------------
+//! Copy a region of the buffer to another position in the buffer,
+//! on the GPU if it is supported by the graphics api, in the same
+//! way as Buffer::FillRect. The regions may overlap, and copies of
+//! tiled buffers are rounded down to the start of a whole tile.
+//!
+//! \param[in] a_source The region of the buffer to copy.
+//! \param[in] a_destX The column to copy the region to.
+//! \param[in] a_destY The row to copy the region to.
+//--------------------------------------------------------------
+void Buffer::CopyRect(const Rect& a_source,
+                      uint32_t a_destX,
+                      uint32_t a_destY)
+{
+    const uint32_t width = GetWidth();
+    const uint32_t height = GetHeight();
+    if (!m_pimpl || !BytesPerPixel(GetFormat()) ||
+        a_source.x >= width || a_source.y >= height ||
+        a_destX >= width || a_destY >= height)
+    {
+        return;
+    }
+
+    Rect source = a_source;
+    source.width = std::min({ source.width, width - source.x, width - a_destX });
+    source.height = std::min({ source.height, height - source.y, height - a_destY });
+    if (!source.width || !source.height)
+    {
+        return;
+    }
+
+    m_pimpl->CopyRect(source, a_destX, a_destY);
+    m_pimpl->m_isInvalidated = true;
+}
+
+//--------------------------------------------------------------
+//! Store the buffer data on the GPU as a frame of the flipbook, so
+//! it can be displayed any number of times (see ShowFlipbookFrame)
+//! without being uploaded again. Should be called after the buffer
+//! data has been written (and any operations applied, eg. FillRect)
+//! but stores the frame immediately, so the buffer data can then
+//! be written again before the end of the frame. Frames are kept
+//! until the buffer is resized.
+//!
+//! \param[in] a_frame The index of the flipbook frame to store.
+//! \return True if the frame was stored, or false if the index is
+//!         not less than the number of frames (see GetFlipbookFrameCount).
+//--------------------------------------------------------------
+bool Buffer::StoreFlipbookFrame(uint32_t a_frame)
+{
+    return m_pimpl && a_frame < m_pimpl->GetFlipbookFrameCount() &&
+           m_pimpl->StoreFlipbookFrame(a_frame);
+}
+
+//--------------------------------------------------------------
+//! Display a stored flipbook frame instead of the buffer data when
+//! the buffer is rendered, without uploading anything. The buffer
+//! data is displayed again (and uploaded as usual) once any frame
+//! that is not in the flipbook (eg. UINT32_MAX) is shown instead.
+//! Frames that have not been stored are displayed as undefined.
+//!
+//! \param[in] a_frame The index of the flipbook frame to display.
+//--------------------------------------------------------------
+void Buffer::ShowFlipbookFrame(uint32_t a_frame)
+{
+    if (m_pimpl)
+    {
+        m_pimpl->m_flipbookFrame = (a_frame < m_pimpl->GetFlipbookFrameCount()) ?
+                                   a_frame : UINT32_MAX;
+        m_pimpl->m_isInvalidated = true;
     }
 }
 
+//--------------------------------------------------------------
+//! Get the flipbook frame displayed instead of the buffer data.
+//!
+//! \return The index of the flipbook frame that is displayed, or
+//!         UINT32_MAX if the buffer data is displayed as usual.
+//--------------------------------------------------------------
+uint32_t Buffer::GetFlipbookFrame() const
+{
+    return m_pimpl ? m_pimpl->m_flipbookFrame : UINT32_MAX;
+}
+
+//--------------------------------------------------------------
+//! Get the number of frames that can be stored in the flipbook,
+//! which is zero if the graphics api cannot store any frames, or
+//! the frames do not fit in a single GPU texture array.
+//!
+//! \return The number of frames that can be stored in the flipbook.
+//--------------------------------------------------------------
+uint32_t Buffer::GetFlipbookFrameCount() const
+{
+    return m_pimpl ? m_pimpl->GetFlipbookFrameCount() : 0;
+}
+
+//--------------------------------------------------------------
+//! Add the buffer data, which should be the mean of a batch of
+//! samples, to the accumulator when the buffer is next rendered,
+//! weighted by the number of samples in the batch. Should be called
+//! once each frame a new batch is written to the buffer data, which
+//! is only uploaded when a batch is added while accumulating.
+//!
+//! The mean of all the samples accumulated is displayed instead of
+//! the buffer data, until the accumulation is reset. Buffers that
+//! are not accumulating (see IsAccumulating) display the buffer data
+//! as usual, so the application must accumulate samples itself.
+//!
+//! \param[in] a_sampleCount The number of samples in the batch.
+//--------------------------------------------------------------
+void Buffer::AccumulateSamples(uint32_t a_sampleCount)
+{
+    if (m_pimpl)
+    {
+        m_pimpl->m_accumulatePendingSamples += a_sampleCount;
+        m_pimpl->m_isInvalidated = true;
+    }
+}
+
+//--------------------------------------------------------------
+//! Discard all the samples accumulated (and any batch added since
+//! the buffer was last rendered), so that the accumulator is cleared
+//! before the next batch is added to it, eg. when the camera moves.
+//! The buffer data is displayed until the next batch is added.
+//--------------------------------------------------------------
+void Buffer::ResetAccumulation()
+{
+    if (m_pimpl)
+    {
+        m_pimpl->m_accumulatePendingSamples = 0;
+        m_pimpl->m_accumulatedSamples = 0;
+        m_pimpl->m_isInvalidated = true;
+    }
+}
+
+//--------------------------------------------------------------
+//! Get the number of samples accumulated when the buffer was last
+//! rendered, which is always zero if the buffer is not accumulating.
+//!
+//! \return The number of samples accumulated since the last reset.
+//--------------------------------------------------------------
+uint32_t Buffer::GetAccumulatedSampleCount() const
+{
+    return m_pimpl ? m_pimpl->m_accumulatedSamples : 0;
+}
+
+//--------------------------------------------------------------
+//! Get whether batches of samples are accumulated on the GPU, which
+//! is false if the buffer was not configured to accumulate, or the
+//! graphics api cannot accumulate samples for the buffer.
+//!
+//! \return True if samples are accumulated, false otherwise.
+//--------------------------------------------------------------
+bool Buffer::IsAccumulating() const
+{
+    return m_pimpl ? m_pimpl->IsAccumulating() : false;
+}
+
 //--------------------------------------------------------------
 //! Get the buffer data as a host accessible array of floats.
 //!
@@ -140,9 +530,39 @@ uint16_t* Buffer::GetData<uint16_t, Buffer::Interop::CUDA>() const
             static_cast<uint16_t*>(GetData()) : nullptr;
 }
 
+//--------------------------------------------------------------
+//! Get the buffer data as a host accessible array of uint32s.
+//!
+//! \return Buffer data as a host accessible array of uint32s,
+//!         or nullptr if it cannot be accessed/cast as such.
+//--------------------------------------------------------------
+template<>
+uint32_t* Buffer::GetData<uint32_t, Buffer::Interop::HOST>() const
+{
+    return (GetInterop() == Interop::HOST &&
+            GetFormat() == Format::RGB10A2_UNORM) ?
+            static_cast<uint32_t*>(GetData()) : nullptr;
+}
+
+//--------------------------------------------------------------
+//! Get the buffer data as a CUDA accessible array of uint32s.
+//!
+//! \return Buffer data as a CUDA accessible array of uint32s,
+//!         or nullptr if it cannot be accessed/cast as such.
+//--------------------------------------------------------------
+template<>
+uint32_t* Buffer::GetData<uint32_t, Buffer::Interop::CUDA>() const
+{
+    return (GetInterop() == Interop::CUDA &&
+            GetFormat() == Format::RGB10A2_UNORM) ?
+            static_cast<uint32_t*>(GetData()) : nullptr;
+}
+
 //--------------------------------------------------------------
 //! Get the raw buffer data. Should not be cached/stored between
-//! frames, as the pointer address could be swapped or recreated.
+//! frames, as the pointer address could be swapped or recreated,
+//! or across calls that may map it again (eg. FillRect, CopyRect,
+//! Clear, StoreFlipbookFrame, or Context::QueueFrame).
 //! Prefer accessing with the various GetData<> template methods.
 //!
 //! \return Buffer of the raw pixel data which will be displayed.
@@ -159,7 +579,7 @@ void* Buffer::GetData() const
 //!
 //! \return Actual size (measured in bytes) of the buffer data.
 //--------------------------------------------------------------
-uint32_t Buffer::GetSize() const
+uint64_t Buffer::GetSize() const
 {
     return m_pimpl ? m_pimpl->GetSize() : 0;
 }
@@ -171,7 +591,7 @@ uint32_t Buffer::GetSize() const
 //!
 //! \return Actual pitch (measured in bytes) of the buffer data.
 //--------------------------------------------------------------
-uint32_t Buffer::GetPitch() const
+uint64_t Buffer::GetPitch() const
 {
     return m_pimpl ? m_pimpl->GetPitch() : 0;
 }
@@ -215,3 +635,67 @@ Buffer::Interop Buffer::GetInterop() const
 {
     return m_pimpl ? m_pimpl->GetInterop() : Interop::NONE;
 }
+
+//--------------------------------------------------------------
+//! Get the storage used by the GPU to display the buffer data.
+//! This may differ from the configured storage if it was AUTO,
+//! or if compact storage is not supported by the graphics api
+//! or the pixel format, in which case NATIVE will be returned.
+//!
+//! \return Storage used by the GPU to display the buffer data.
+//--------------------------------------------------------------
+Buffer::Storage Buffer::GetStorage() const
+{
+    return m_pimpl ? m_pimpl->GetStorage() : Storage::NATIVE;
+}
+
+//--------------------------------------------------------------
+//! Get the order in which pixels are stored in the buffer data.
+//! This may differ from the configured layout if the graphics
+//! api cannot de-tile pixels, in which case LINEAR is returned.
+//!
+//! \return Order in which pixels are stored in the buffer data.
+//--------------------------------------------------------------
+Buffer::Layout Buffer::GetLayout() const
+{
+    return m_pimpl ? m_pimpl->GetLayout() : Layout::LINEAR;
+}
+
+//--------------------------------------------------------------
+//! Get how the buffer data scrolls as new lines are acquired.
+//! This may differ from the configured scroll mode if scrolling
+//! is not supported by the graphics api, in which case NONE is
+//! returned (and the buffer data is displayed as stored).
+//!
+//! \return How the buffer data scrolls as new lines are acquired.
+//--------------------------------------------------------------
+Buffer::Scroll Buffer::GetScroll() const
+{
+    return m_pimpl ? m_pimpl->GetScroll() : Scroll::NONE;
+}
+
+//--------------------------------------------------------------
+//! Get the GPU memory (measured in bytes) saved by displaying the
+//! buffer data using compact storage instead of native storage.
+//!
+//! \return GPU memory (measured in bytes) saved by the storage.
+//--------------------------------------------------------------
+uint64_t Buffer::GetStorageSavings() const
+{
+    const Format format = GetFormat();
+    const uint64_t pixelCount = static_cast<uint64_t>(GetWidth()) * GetHeight();
+    return pixelCount * (BytesPerPixel(format) -
+                         BytesPerStoragePixel(format, GetStorage()));
+}
+
+//--------------------------------------------------------------
+//! Get the totals of the tiles hashed and uploaded to the GPU by
+//! a buffer that was configured to detect changes, which will be
+//! zero if change detection is not supported by the graphics api.
+//!
+//! \return Totals of the tiles hashed and uploaded to the GPU.
+//--------------------------------------------------------------
+Buffer::UploadCounters Buffer::GetUploadCounters() const
+{
+    return m_pimpl ? m_pimpl->GetUploadCounters() : UploadCounters();
+}
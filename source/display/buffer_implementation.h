@@ -10,6 +10,11 @@
 
 #include <simple/display/buffer.h>
 
+#include <algorithm>
+#include <assert.h>
+#include <cstring>
+#include <vector>
+
 //--------------------------------------------------------------
 namespace Simple
 {
@@ -23,6 +28,11 @@ public:
     // Public destructor for unique_ptr.
     virtual ~Implementation() = default;
 
+    // Set whether the data of a buffer is readable, which contexts
+    // call through here because it is not part of the public api.
+    static void SetBufferDataReadable(Buffer& a_buffer,
+                                      bool a_readable);
+
 protected:
     friend class Buffer;
     Implementation() = default;
@@ -34,14 +44,305 @@ protected:
     virtual void Render(uint32_t a_displayWidth,
                         uint32_t a_displayHeight) = 0;
 
+    virtual void SetViewport(const Viewport& a_viewport) = 0;
+    virtual Viewport GetViewport() const = 0;
+
+    virtual void CommitRows(uint32_t a_firstRow,
+                            uint32_t a_rowCount) = 0;
+
+    virtual void FillRect(const Rect& a_rect,
+                          const uint8_t* a_pixel) = 0;
+    virtual void CopyRect(const Rect& a_source,
+                          uint32_t a_destX,
+                          uint32_t a_destY) = 0;
+
+    virtual bool StoreFlipbookFrame(uint32_t a_frame) = 0;
+
+    // Buffer data that may be mapped write only must be mapped so it
+    // can also be read while it is readable (see Context::QueueFrame).
+    virtual void SetDataReadable(bool a_readable) = 0;
+
     virtual void* GetData() const = 0;
-    virtual uint32_t GetSize() const = 0;
-    virtual uint32_t GetPitch() const = 0;
+    virtual uint64_t GetSize() const = 0;
+    virtual uint64_t GetPitch() const = 0;
     virtual uint32_t GetWidth() const = 0;
     virtual uint32_t GetHeight() const = 0;
     virtual Format   GetFormat() const = 0;
     virtual Interop  GetInterop() const = 0;
+    virtual Storage  GetStorage() const = 0;
+    virtual Layout   GetLayout() const = 0;
+    virtual Scroll   GetScroll() const = 0;
+    virtual uint32_t GetFlipbookFrameCount() const = 0;
+    virtual bool IsAccumulating() const = 0;
+    virtual UploadCounters GetUploadCounters() const = 0;
+
+    // Set when the buffer data may have changed since it was last
+    // rendered, so contexts that render on demand must present it.
+    bool m_isInvalidated = true;
+
+    // The line of buffer data displayed first by scrolling buffers,
+    // and the number of lines acquired since the buffer was last
+    // rendered (the max value if every line must be uploaded).
+    uint32_t m_scrollOffset = 0;
+    uint32_t m_scrollPendingLines = UINT32_MAX;
+
+    // The flipbook frame displayed instead of the buffer data, or
+    // the max value if the buffer data is displayed as usual.
+    uint32_t m_flipbookFrame = UINT32_MAX;
+
+    // The number of samples in the batch written to the buffer data
+    // that will be accumulated when the buffer is next rendered, and
+    // the number of samples accumulated (zero if the accumulator must
+    // be cleared before the next batch is added to it).
+    uint32_t m_accumulatePendingSamples = 0;
+    uint32_t m_accumulatedSamples = 0;
+};
+
+//--------------------------------------------------------------
+inline void Buffer::Implementation::SetBufferDataReadable(Buffer& a_buffer,
+                                                          bool a_readable)
+{
+    if (a_buffer.m_pimpl)
+    {
+        a_buffer.m_pimpl->SetDataReadable(a_readable);
+    }
+}
+
+//--------------------------------------------------------------
+// Values used by shaders to de-tile the pixels of the texture
+// that stores the buffer data, which for tiled layouts is the
+// data treated as linear rows of pixels the length of a pitch.
+//--------------------------------------------------------------
+struct TextureTiling
+{
+    uint32_t width = 0;      // Buffer width in pixels.
+    uint32_t height = 0;     // Buffer height in pixels.
+    uint32_t rowLength = 0;  // Texture width in pixels.
+    uint32_t tileSize = 1;   // One if the layout is linear.
+    uint32_t morton = 0;     // Non-zero if tiles are Morton.
 };
 
+//--------------------------------------------------------------
+// The region of the texture (normalized to the buffer width and
+// height) that is scaled to fill the display, which shaders use
+// to offset and scale the texture coordinates of the display.
+//--------------------------------------------------------------
+struct TextureRegion
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float width = 1.0f;
+    float height = 1.0f;
+};
+
+//--------------------------------------------------------------
+// Round a pitch alignment up to the next power of two (at least
+// one), because graphics apis only support those alignments.
+//--------------------------------------------------------------
+constexpr uint32_t GetPowerOfTwoAlignment(uint32_t a_alignment)
+{
+    uint32_t alignment = 1;
+    while (alignment < a_alignment && alignment < 0x80000000u)
+    {
+        alignment <<= 1;
+    }
+    return alignment;
+}
+
+//--------------------------------------------------------------
+constexpr uint32_t GetTextureWidth(const Buffer::Config& a_config)
+{
+    return (a_config.layout == Buffer::Layout::LINEAR ||
+            !Buffer::BytesPerPixel(a_config.format)) ? a_config.width :
+           static_cast<uint32_t>(Buffer::AlignedPitchBytes(a_config) /
+                                 Buffer::BytesPerPixel(a_config.format));
+}
+
+//--------------------------------------------------------------
+constexpr uint32_t GetTextureHeight(const Buffer::Config& a_config)
+{
+    return (a_config.layout == Buffer::Layout::LINEAR ||
+            !Buffer::AlignedPitchBytes(a_config)) ? a_config.height :
+           static_cast<uint32_t>(Buffer::AlignedSizeBytes(a_config) /
+                                 Buffer::AlignedPitchBytes(a_config));
+}
+
+//--------------------------------------------------------------
+inline TextureTiling GetTextureTiling(const Buffer::Config& a_config)
+{
+    TextureTiling tiling;
+    tiling.width = a_config.width;
+    tiling.height = a_config.height;
+    tiling.rowLength = GetTextureWidth(a_config);
+    tiling.tileSize = Buffer::TileSize(a_config.layout);
+    tiling.morton = (a_config.layout == Buffer::Layout::MORTON_16X16);
+    return tiling;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Viewport ResolveViewport(const Buffer::Viewport& a_viewport,
+                                        uint32_t a_bufferWidth,
+                                        uint32_t a_bufferHeight)
+{
+    // Viewports without any area display the entire buffer.
+    if (a_viewport.width > 0.0f && a_viewport.height > 0.0f)
+    {
+        return a_viewport;
+    }
+
+    Buffer::Viewport viewport;
+    viewport.width = static_cast<float>(a_bufferWidth);
+    viewport.height = static_cast<float>(a_bufferHeight);
+    return viewport;
+}
+
+//--------------------------------------------------------------
+inline TextureRegion GetTextureRegion(const Buffer::Viewport& a_viewport,
+                                      uint32_t a_bufferWidth,
+                                      uint32_t a_bufferHeight)
+{
+    TextureRegion region;
+    if (!a_bufferWidth || !a_bufferHeight)
+    {
+        return region;
+    }
+
+    const Buffer::Viewport viewport = ResolveViewport(a_viewport,
+                                                      a_bufferWidth,
+                                                      a_bufferHeight);
+    region.x = viewport.x / static_cast<float>(a_bufferWidth);
+    region.y = viewport.y / static_cast<float>(a_bufferHeight);
+    region.width = viewport.width / static_cast<float>(a_bufferWidth);
+    region.height = viewport.height / static_cast<float>(a_bufferHeight);
+    return region;
+}
+
+//--------------------------------------------------------------
+// A contiguous range of the buffer data, measured in bytes.
+//--------------------------------------------------------------
+struct ByteRange
+{
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
+//--------------------------------------------------------------
+inline Buffer::Rect AlignRectToTiles(const Buffer::Config& a_config,
+                                     const Buffer::Rect& a_rect)
+{
+    // Extend the region to whole tiles if the layout is tiled, so
+    // the pixels in each row of tiles are stored contiguously.
+    const uint32_t tileSize = Buffer::TileSize(a_config.layout);
+    Buffer::Rect rect;
+    rect.x = (a_rect.x / tileSize) * tileSize;
+    rect.y = (a_rect.y / tileSize) * tileSize;
+    rect.width = (((a_rect.x + a_rect.width + tileSize - 1) / tileSize) * tileSize) - rect.x;
+    rect.height = (((a_rect.y + a_rect.height + tileSize - 1) / tileSize) * tileSize) - rect.y;
+    return rect;
+}
+
+//--------------------------------------------------------------
+inline std::vector<ByteRange> GetByteRanges(const Buffer::Config& a_config,
+                                            const Buffer::Rect& a_rect)
+{
+    const Buffer::Rect rect = AlignRectToTiles(a_config, a_rect);
+    const uint32_t tileSize = Buffer::TileSize(a_config.layout);
+    const uint32_t paddedWidth = ((a_config.width + tileSize - 1) / tileSize) * tileSize;
+    const uint64_t pitch = Buffer::AlignedPitchBytes(a_config);
+    const uint64_t bytesPerPixel = Buffer::BytesPerPixel(a_config.format);
+
+    // Find the range storing each row of the region (or each row
+    // of tiles), including the padding at the end of any row that
+    // is entirely inside the region, and merge adjacent ranges so
+    // the entire buffer is stored in a single range.
+    std::vector<ByteRange> ranges;
+    for (uint32_t y = rect.y; y < rect.y + rect.height; y += tileSize)
+    {
+        ByteRange range;
+        range.offset = (y * pitch) + (rect.x * tileSize * bytesPerPixel);
+        range.size = (rect.x == 0 && rect.width >= paddedWidth) ?
+                     (pitch * tileSize) :
+                     (rect.width * tileSize * bytesPerPixel);
+        if (!ranges.empty() &&
+            ranges.back().offset + ranges.back().size == range.offset)
+        {
+            ranges.back().size += range.size;
+        }
+        else
+        {
+            ranges.push_back(range);
+        }
+    }
+    return ranges;
+}
+
+//--------------------------------------------------------------
+inline bool GetCopyByteRanges(const Buffer::Config& a_config,
+                              const Buffer::Rect& a_source,
+                              uint32_t a_destX,
+                              uint32_t a_destY,
+                              std::vector<ByteRange>& o_source,
+                              std::vector<ByteRange>& o_dest)
+{
+    // Extend the source region to whole tiles, round the destination
+    // down to whole tiles, then clamp both to the padded buffer size.
+    const uint32_t tileSize = Buffer::TileSize(a_config.layout);
+    const uint32_t paddedWidth = ((a_config.width + tileSize - 1) / tileSize) * tileSize;
+    const uint32_t paddedHeight = ((a_config.height + tileSize - 1) / tileSize) * tileSize;
+    Buffer::Rect source = AlignRectToTiles(a_config, a_source);
+    Buffer::Rect dest = source;
+    dest.x = (a_destX / tileSize) * tileSize;
+    dest.y = (a_destY / tileSize) * tileSize;
+    dest.width = source.width = std::min(source.width, paddedWidth - dest.x);
+    dest.height = source.height = std::min(source.height, paddedHeight - dest.y);
+
+    // Return whether the regions overlap.
+    o_source = GetByteRanges(a_config, source);
+    o_dest = GetByteRanges(a_config, dest);
+    return source.x < dest.x + dest.width && dest.x < source.x + source.width &&
+           source.y < dest.y + dest.height && dest.y < source.y + source.height;
+}
+
+//--------------------------------------------------------------
+inline void FillByteRanges(void* o_data,
+                           const std::vector<ByteRange>& a_ranges,
+                           const uint8_t* a_pixel,
+                           uint32_t a_bytesPerPixel)
+{
+    // Copy the pixel to the start of each range, then repeatedly
+    // double the number of pixels filled until it is complete.
+    for (const ByteRange& range : a_ranges)
+    {
+        uint8_t* data = static_cast<uint8_t*>(o_data) + range.offset;
+        uint64_t filled = std::min<uint64_t>(a_bytesPerPixel, range.size);
+        memcpy(data, a_pixel, filled);
+        while (filled < range.size)
+        {
+            const uint64_t size = std::min(filled, range.size - filled);
+            memcpy(data + filled, data, size);
+            filled += size;
+        }
+    }
+}
+
+//--------------------------------------------------------------
+inline void CopyByteRanges(void* o_data,
+                           const std::vector<ByteRange>& a_source,
+                           const std::vector<ByteRange>& a_dest)
+{
+    // Copy the last range first if moving data towards the end, so
+    // overlapping ranges are not overwritten before they are read.
+    assert(a_source.size() == a_dest.size());
+    uint8_t* data = static_cast<uint8_t*>(o_data);
+    const bool reverse = !a_dest.empty() && a_dest[0].offset > a_source[0].offset;
+    for (size_t i = 0; i < a_source.size(); ++i)
+    {
+        const size_t index = reverse ? (a_source.size() - 1 - i) : i;
+        memmove(data + a_dest[index].offset,
+                data + a_source[index].offset,
+                a_source[index].size);
+    }
+}
+
 } // namespace Display
 } // namespace Simple
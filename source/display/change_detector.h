@@ -0,0 +1,527 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <simple/display/buffer.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define CHANGE_DETECTOR_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#   include <arm_neon.h>
+#   define CHANGE_DETECTOR_NEON
+#endif
+
+//--------------------------------------------------------------
+//! The min size (measured in megabytes) of buffer data that will
+//! be hashed using multiple threads to detect changed tiles.
+//--------------------------------------------------------------
+#ifndef BUFFER_DETECT_CHANGES_THREAD_THRESHOLD_MB
+#define BUFFER_DETECT_CHANGES_THREAD_THRESHOLD_MB 4
+#endif//BUFFER_DETECT_CHANGES_THREAD_THRESHOLD_MB
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Display
+{
+
+//--------------------------------------------------------------
+// Detects which tiles of buffer data changed since the previous
+// frame, by hashing each tile and comparing it to the previous
+// hash, so only the changed tiles need to be uploaded to the GPU.
+// Tiles stay dirty until they are uploaded, so tiles that are not
+// uploaded (eg. because they are outside the viewport) aren't lost.
+// Large data is hashed by a pool of worker threads, which are only
+// started the first time they are needed and then kept until the
+// detector is destroyed (so they are not recreated every frame).
+//--------------------------------------------------------------
+class ChangeDetector
+{
+public:
+    static constexpr uint32_t TILE_SIZE = 64;
+
+    ChangeDetector() = default;
+    ~ChangeDetector();
+
+    ChangeDetector(const ChangeDetector&) = delete;
+    ChangeDetector& operator=(const ChangeDetector&) = delete;
+
+    // A region of the data, measured in pixels.
+    struct Region
+    {
+        uint32_t x = 0;
+        uint32_t y = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+
+    void Reset(uint32_t a_width,
+               uint32_t a_height,
+               uint32_t a_bytesPerPixel,
+               uint64_t a_pitch);
+    void Invalidate();
+    void Hash(const void* a_data);
+    const std::vector<Region>& Upload(const Region& a_region);
+    const Buffer::UploadCounters& GetCounters() const;
+
+private:
+    struct TileHash
+    {
+        uint64_t lanes[2] = {};
+    };
+
+    void StartWorkers(uint32_t a_workerCount);
+    void RunWorker(uint32_t a_band);
+    void HashRows(const uint8_t* a_data,
+                  uint32_t a_firstTileY,
+                  uint32_t a_lastTileY);
+    TileHash HashTile(const uint8_t* a_data,
+                      uint32_t a_width,
+                      uint32_t a_height) const;
+
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    uint32_t m_bytesPerPixel = 0;
+    uint64_t m_pitch = 0;
+    uint32_t m_tileCountX = 0;
+    uint32_t m_tileCountY = 0;
+    std::vector<TileHash> m_hashes;
+    std::vector<uint8_t> m_dirty;
+    std::vector<Region> m_regions;
+    Buffer::UploadCounters m_counters;
+
+    // Worker threads that each hash one band of tile rows when the
+    // generation changes, guarded by m_workerMutex.
+    std::vector<std::thread> m_workers;
+    std::mutex m_workerMutex;
+    std::condition_variable m_workerStart;
+    std::condition_variable m_workerDone;
+    const uint8_t* m_workerData = nullptr;
+    uint32_t m_workerBandSize = 0;
+    uint32_t m_workersPending = 0;
+    uint64_t m_workerGeneration = 0;
+    bool m_workerExit = false;
+};
+
+//--------------------------------------------------------------
+inline ChangeDetector::~ChangeDetector()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_workerMutex);
+        m_workerExit = true;
+    }
+    m_workerStart.notify_all();
+
+    for (std::thread& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+//--------------------------------------------------------------
+inline void ChangeDetector::Reset(uint32_t a_width,
+                                  uint32_t a_height,
+                                  uint32_t a_bytesPerPixel,
+                                  uint64_t a_pitch)
+{
+    m_width = a_width;
+    m_height = a_height;
+    m_bytesPerPixel = a_bytesPerPixel;
+    m_pitch = a_pitch;
+    m_tileCountX = (a_width + TILE_SIZE - 1) / TILE_SIZE;
+    m_tileCountY = (a_height + TILE_SIZE - 1) / TILE_SIZE;
+
+    // Every tile must be uploaded after a reset.
+    const size_t tileCount = static_cast<size_t>(m_tileCountX) * m_tileCountY;
+    m_hashes.assign(tileCount, TileHash());
+    m_dirty.assign(tileCount, 1);
+    m_regions.clear();
+    m_counters = Buffer::UploadCounters();
+}
+
+//--------------------------------------------------------------
+inline void ChangeDetector::Invalidate()
+{
+    // Every tile must be uploaded again (eg. after the data has been
+    // uploaded some other way), whether or not its hash changes.
+    std::fill(m_hashes.begin(), m_hashes.end(), TileHash());
+    std::fill(m_dirty.begin(), m_dirty.end(), 1);
+}
+
+//--------------------------------------------------------------
+inline void ChangeDetector::Hash(const void* a_data)
+{
+    if (!a_data || m_hashes.empty())
+    {
+        return;
+    }
+
+    // Small buffers are hashed by this thread alone.
+    const uint8_t* data = static_cast<const uint8_t*>(a_data);
+    constexpr uint64_t threshold = BUFFER_DETECT_CHANGES_THREAD_THRESHOLD_MB * 1024ull * 1024ull;
+    if (m_pitch * m_height < threshold)
+    {
+        HashRows(data, 0, m_tileCountY);
+        m_counters.tilesHashed += m_hashes.size();
+        return;
+    }
+
+    // Split large buffers into bands of tile rows, each hashed by a
+    // worker thread, with the last band hashed by this thread.
+    StartWorkers(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+    const uint32_t workerCount = static_cast<uint32_t>(m_workers.size());
+    const uint32_t bandSize = (m_tileCountY + workerCount) / (workerCount + 1);
+    if (workerCount)
+    {
+        std::lock_guard<std::mutex> lock(m_workerMutex);
+        m_workerData = data;
+        m_workerBandSize = bandSize;
+        m_workersPending = workerCount;
+        ++m_workerGeneration;
+    }
+    m_workerStart.notify_all();
+
+    HashRows(data, std::min(workerCount * bandSize, m_tileCountY), m_tileCountY);
+    {
+        std::unique_lock<std::mutex> lock(m_workerMutex);
+        m_workerDone.wait(lock, [this] { return m_workersPending == 0; });
+    }
+
+    m_counters.tilesHashed += m_hashes.size();
+}
+
+//--------------------------------------------------------------
+inline const std::vector<ChangeDetector::Region>&
+ChangeDetector::Upload(const Region& a_region)
+{
+    // Find the runs of dirty tiles in each row of tiles within the
+    // region, clipped to the region, and clean the tiles entirely
+    // inside the region (tiles crossing the edges of the region may
+    // also need to be uploaded as part of a neighbouring region).
+    m_regions.clear();
+    const uint32_t regionX1 = std::min(a_region.x + a_region.width, m_width);
+    const uint32_t regionY1 = std::min(a_region.y + a_region.height, m_height);
+    if (a_region.x >= regionX1 || a_region.y >= regionY1)
+    {
+        return m_regions;
+    }
+
+    const uint32_t firstTileX = a_region.x / TILE_SIZE;
+    const uint32_t lastTileX = (regionX1 - 1) / TILE_SIZE;
+    const uint32_t firstTileY = a_region.y / TILE_SIZE;
+    const uint32_t lastTileY = (regionY1 - 1) / TILE_SIZE;
+    for (uint32_t tileY = firstTileY; tileY <= lastTileY; ++tileY)
+    {
+        const uint32_t y0 = std::max(tileY * TILE_SIZE, a_region.y);
+        const uint32_t y1 = std::min((tileY + 1) * TILE_SIZE, regionY1);
+        const bool insideY = (y0 == tileY * TILE_SIZE) &&
+                             (y1 == std::min((tileY + 1) * TILE_SIZE, m_height));
+        for (uint32_t tileX = firstTileX; tileX <= lastTileX; ++tileX)
+        {
+            uint8_t& dirty = m_dirty[static_cast<size_t>(tileY) * m_tileCountX + tileX];
+            if (!dirty)
+            {
+                continue;
+            }
+
+            const uint32_t x0 = std::max(tileX * TILE_SIZE, a_region.x);
+            const uint32_t x1 = std::min((tileX + 1) * TILE_SIZE, regionX1);
+            const bool insideX = (x0 == tileX * TILE_SIZE) &&
+                                 (x1 == std::min((tileX + 1) * TILE_SIZE, m_width));
+            dirty = !(insideX && insideY);
+            ++m_counters.tilesUploaded;
+
+            // Extend the previous run if this tile is adjacent to it.
+            Region* previous = m_regions.empty() ? nullptr : &m_regions.back();
+            if (previous && previous->y == y0 && previous->x + previous->width == x0)
+            {
+                previous->width += x1 - x0;
+                continue;
+            }
+
+            Region region;
+            region.x = x0;
+            region.y = y0;
+            region.width = x1 - x0;
+            region.height = y1 - y0;
+            m_regions.push_back(region);
+        }
+    }
+
+    return m_regions;
+}
+
+//--------------------------------------------------------------
+inline const Buffer::UploadCounters& ChangeDetector::GetCounters() const
+{
+    return m_counters;
+}
+
+//--------------------------------------------------------------
+inline void ChangeDetector::StartWorkers(uint32_t a_workerCount)
+{
+    for (uint32_t band = static_cast<uint32_t>(m_workers.size()); band < a_workerCount; ++band)
+    {
+        m_workers.emplace_back(&ChangeDetector::RunWorker, this, band);
+    }
+}
+
+//--------------------------------------------------------------
+inline void ChangeDetector::RunWorker(uint32_t a_band)
+{
+    uint64_t generation = 0;
+    std::unique_lock<std::mutex> lock(m_workerMutex);
+    while (true)
+    {
+        m_workerStart.wait(lock, [this, &generation]
+        {
+            return m_workerGeneration != generation || m_workerExit;
+        });
+        if (m_workerExit)
+        {
+            return;
+        }
+        generation = m_workerGeneration;
+
+        // Hash this band (which is empty if there are more workers
+        // than rows of tiles) without holding the lock.
+        const uint8_t* data = m_workerData;
+        const uint32_t firstTileY = std::min(a_band * m_workerBandSize, m_tileCountY);
+        const uint32_t lastTileY = std::min(firstTileY + m_workerBandSize, m_tileCountY);
+        lock.unlock();
+        HashRows(data, firstTileY, lastTileY);
+        lock.lock();
+
+        if (--m_workersPending == 0)
+        {
+            m_workerDone.notify_one();
+        }
+    }
+}
+
+//--------------------------------------------------------------
+inline void ChangeDetector::HashRows(const uint8_t* a_data,
+                                     uint32_t a_firstTileY,
+                                     uint32_t a_lastTileY)
+{
+    // Each thread only accesses the hashes of its own tile rows.
+    for (uint32_t tileY = a_firstTileY; tileY < a_lastTileY; ++tileY)
+    {
+        const uint32_t y = tileY * TILE_SIZE;
+        const uint32_t height = std::min(TILE_SIZE, m_height - y);
+        for (uint32_t tileX = 0; tileX < m_tileCountX; ++tileX)
+        {
+            const uint32_t x = tileX * TILE_SIZE;
+            const uint32_t width = std::min(TILE_SIZE, m_width - x);
+            const uint8_t* tile = a_data + (y * m_pitch) +
+                                  (static_cast<uint64_t>(x) * m_bytesPerPixel);
+            const TileHash hash = HashTile(tile, width, height);
+
+            const size_t index = static_cast<size_t>(tileY) * m_tileCountX + tileX;
+            TileHash& previous = m_hashes[index];
+            if (hash.lanes[0] != previous.lanes[0] ||
+                hash.lanes[1] != previous.lanes[1])
+            {
+                previous = hash;
+                m_dirty[index] = 1;
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------
+inline ChangeDetector::TileHash ChangeDetector::HashTile(const uint8_t* a_data,
+                                                         uint32_t a_width,
+                                                         uint32_t a_height) const
+{
+    // Each 16 bytes of a row are accumulated into two 64 bit lanes
+    // the way XXH3 does: the data of each lane is added to the other
+    // lane, and the product of the 32 bit halves of each lane (xor-ed
+    // with a key for the position of the chunk) is added to itself.
+    // The lanes are scrambled by an invertible mix after every 16
+    // chunks (so each key is only used once between scrambles) and at
+    // the end of each row, so changing any one chunk always changes
+    // the hash, and moving data between chunks almost always does.
+    alignas(16) static const uint64_t KEYS[34] =
+    {
+        0xE220A8397B1DCDAFull, 0x6E789E6AA1B965F4ull, 0x06C45D188009454Full, 0xF88BB8A8724C81ECull,
+        0x1B39896A51A8749Bull, 0x53CB9F0C747EA2EAull, 0x2C829ABE1F4532E1ull, 0xC584133AC916AB3Cull,
+        0x3EE5789041C98AC3ull, 0xF3B8488C368CB0A6ull, 0x657EECDD3CB13D09ull, 0xC2D326E0055BDEF6ull,
+        0x8621A03FE0BBDB7Bull, 0x8E1F7555983AA92Full, 0xB54E0F1600CC4D19ull, 0x84BB3F97971D80ABull,
+        0x7D29825C75521255ull, 0xC3CF17102B7F7F86ull, 0x3466E9A083914F64ull, 0xD81A8D2B5A4485ACull,
+        0xDB01602B100B9ED7ull, 0xA9038A921825F10Dull, 0xEDF5F1D90DCA2F6Aull, 0x54496AD67BD2634Cull,
+        0xDD7C01D4F5407269ull, 0x935E82F1DB4C4F7Bull, 0x69B82EBC92233300ull, 0x40D29EB57DE1D510ull,
+        0xA2F09DABB45C6316ull, 0xEE521D7A0F4D3872ull, 0xF16952EE72F3454Full, 0x377D35DEA8E40225ull,
+        0x0C7DE8064963BAB0ull, 0x05582D37111AC529ull,
+    };
+    constexpr uint32_t PRIME = 0x9E3779B1u;
+    constexpr size_t CHUNKS_PER_SCRAMBLE = 16;
+    const uint8_t* scrambleKey = reinterpret_cast<const uint8_t*>(KEYS + 2 * CHUNKS_PER_SCRAMBLE);
+
+#if defined(CHANGE_DETECTOR_SSE2)
+    using Lanes = __m128i;
+    const __m128i prime = _mm_set1_epi32(static_cast<int>(PRIME));
+    const auto load = [](const uint8_t* a_chunk)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(a_chunk));
+    };
+    const auto accumulate = [](__m128i a_lanes, __m128i a_chunk, __m128i a_key)
+    {
+        const __m128i keyed = _mm_xor_si128(a_chunk, a_key);
+        const __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+        const __m128i swapped = _mm_shuffle_epi32(a_chunk, _MM_SHUFFLE(1, 0, 3, 2));
+        return _mm_add_epi64(a_lanes, _mm_add_epi64(product, swapped));
+    };
+    const auto scramble = [&prime](__m128i a_lanes, __m128i a_key)
+    {
+        a_lanes = _mm_xor_si128(a_lanes, _mm_srli_epi64(a_lanes, 47));
+        a_lanes = _mm_xor_si128(a_lanes, a_key);
+        const __m128i productLow = _mm_mul_epu32(a_lanes, prime);
+        const __m128i productHigh = _mm_mul_epu32(_mm_srli_epi64(a_lanes, 32), prime);
+        return _mm_add_epi64(productLow, _mm_slli_epi64(productHigh, 32));
+    };
+    const auto store = [](__m128i a_lanes, uint64_t* o_lanes)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(o_lanes), a_lanes);
+    };
+#elif defined(CHANGE_DETECTOR_NEON)
+    using Lanes = uint64x2_t;
+    const uint32x2_t prime = vdup_n_u32(PRIME);
+    const auto load = [](const uint8_t* a_chunk)
+    {
+        return vreinterpretq_u64_u8(vld1q_u8(a_chunk));
+    };
+    const auto accumulate = [](uint64x2_t a_lanes, uint64x2_t a_chunk, uint64x2_t a_key)
+    {
+        const uint64x2_t keyed = veorq_u64(a_chunk, a_key);
+        a_lanes = vaddq_u64(a_lanes, vextq_u64(a_chunk, a_chunk, 1));
+        return vmlal_u32(a_lanes, vmovn_u64(keyed), vshrn_n_u64(keyed, 32));
+    };
+    const auto scramble = [&prime](uint64x2_t a_lanes, uint64x2_t a_key)
+    {
+        a_lanes = veorq_u64(a_lanes, vshrq_n_u64(a_lanes, 47));
+        a_lanes = veorq_u64(a_lanes, a_key);
+        const uint64x2_t productHigh = vshlq_n_u64(vmull_u32(vshrn_n_u64(a_lanes, 32), prime), 32);
+        return vmlal_u32(productHigh, vmovn_u64(a_lanes), prime);
+    };
+    const auto store = [](uint64x2_t a_lanes, uint64_t* o_lanes)
+    {
+        vst1q_u64(o_lanes, a_lanes);
+    };
+#else
+    struct Lanes
+    {
+        uint64_t lane[2];
+    };
+    const auto load = [](const uint8_t* a_chunk)
+    {
+        Lanes lanes;
+        memcpy(lanes.lane, a_chunk, sizeof(lanes.lane));
+        return lanes;
+    };
+    const auto accumulate = [](Lanes a_lanes, Lanes a_chunk, Lanes a_key)
+    {
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            const uint64_t keyed = a_chunk.lane[i] ^ a_key.lane[i];
+            a_lanes.lane[i] += (keyed & 0xFFFFFFFFull) * (keyed >> 32);
+            a_lanes.lane[i ^ 1] += a_chunk.lane[i];
+        }
+        return a_lanes;
+    };
+    const auto scramble = [](Lanes a_lanes, Lanes a_key)
+    {
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            a_lanes.lane[i] ^= a_lanes.lane[i] >> 47;
+            a_lanes.lane[i] ^= a_key.lane[i];
+            a_lanes.lane[i] *= PRIME;
+        }
+        return a_lanes;
+    };
+    const auto store = [](Lanes a_lanes, uint64_t* o_lanes)
+    {
+        memcpy(o_lanes, a_lanes.lane, sizeof(a_lanes.lane));
+    };
+#endif
+
+    const auto chunkKey = [](size_t a_chunk)
+    {
+        return reinterpret_cast<const uint8_t*>(KEYS + 2 * (a_chunk % CHUNKS_PER_SCRAMBLE));
+    };
+
+    const size_t rowBytes = static_cast<size_t>(a_width) * m_bytesPerPixel;
+    const size_t chunkBytes = rowBytes & ~static_cast<size_t>(15);
+    const uint64_t seed[2] = { rowBytes, a_height };
+    const Lanes scrambleLanes = load(scrambleKey);
+    Lanes lanes = load(reinterpret_cast<const uint8_t*>(seed));
+    Lanes oddLanes = lanes;
+    uint8_t tail[16] = {};
+    for (uint32_t y = 0; y < a_height; ++y)
+    {
+        // Alternate chunks are accumulated into independent lanes, so
+        // consecutive multiplies do not have to wait on each other.
+        const uint8_t* row = a_data + (y * m_pitch);
+        size_t i = 0;
+        for (; i + 32 <= chunkBytes; i += 32)
+        {
+            lanes = accumulate(lanes, load(row + i), load(chunkKey(i / 16)));
+            oddLanes = accumulate(oddLanes, load(row + i + 16), load(chunkKey(i / 16 + 1)));
+            if ((i / 16 + 2) % CHUNKS_PER_SCRAMBLE == 0)
+            {
+                lanes = scramble(lanes, scrambleLanes);
+                oddLanes = scramble(oddLanes, scrambleLanes);
+            }
+        }
+        if (i < chunkBytes)
+        {
+            lanes = accumulate(lanes, load(row + i), load(chunkKey(i / 16)));
+            i += 16;
+        }
+        if (chunkBytes < rowBytes)
+        {
+            // The last chunk of the row is partial, so it is padded.
+            memcpy(tail, row + chunkBytes, rowBytes - chunkBytes);
+            Lanes& target = ((i / 16) & 1) ? oddLanes : lanes;
+            target = accumulate(target, load(tail), load(chunkKey(i / 16)));
+        }
+        lanes = scramble(lanes, scrambleLanes);
+        oddLanes = scramble(oddLanes, scrambleLanes);
+    }
+
+    // Combine the lanes, then finalize each one with the (invertible)
+    // MurmurHash3 fmix64 mix, so every bit of the hash is well mixed.
+    uint64_t evenValues[2] = {};
+    uint64_t oddValues[2] = {};
+    store(lanes, evenValues);
+    store(oddLanes, oddValues);
+    TileHash hash;
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        uint64_t lane = evenValues[i] + oddValues[i];
+        lane ^= lane >> 33;
+        lane *= 0xFF51AFD7ED558CCDull;
+        lane ^= lane >> 33;
+        lane *= 0xC4CEB9FE1A85EC53ull;
+        lane ^= lane >> 33;
+        hash.lanes[i] = lane;
+    }
+    return hash;
+}
+
+} // namespace Display
+} // namespace Simple
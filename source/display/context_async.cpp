@@ -0,0 +1,319 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <display/context_async.h>
+#include <display/buffer_host.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+using namespace Simple::Display;
+
+//--------------------------------------------------------------
+ContextAsync::ContextAsync(const Context::Config& a_config)
+{
+    // Start the render thread, and wait until it has created the
+    // platform context (which sets the window and present mode).
+    using namespace std;
+    m_thread = std::thread(&ContextAsync::RenderFrames, this, a_config);
+    {
+        unique_lock<mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] { return m_isStarted; });
+    }
+    if (!m_window)
+    {
+        return;
+    }
+
+    // Create the buffer written by the calling thread, matching the
+    // buffer that is rendered each time it is resized.
+    m_bufferHost = new BufferHost(a_config.bufferConfig,
+                                  [this](const Buffer::Config& a_bufferConfig)
+                                  {
+                                      return ResizeRenderBuffer(a_bufferConfig);
+                                  });
+    m_buffer = new Buffer(unique_ptr<Buffer::Implementation>(m_bufferHost));
+}
+
+//--------------------------------------------------------------
+ContextAsync::~ContextAsync()
+{
+    // Stop the render thread, which destroys the platform context.
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_exit = true;
+    }
+    m_condition.notify_one();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    // Destroy the buffer, and the memory of the other frames.
+    delete m_buffer;
+    m_buffer = nullptr;
+    m_bufferHost = nullptr;
+    ::operator delete(m_pendingFrame.data);
+    ::operator delete(m_renderFrame.data);
+}
+
+//--------------------------------------------------------------
+std::unique_ptr<Context::Implementation> ContextAsync::Create(const Context::Config& a_config)
+{
+    // Buffers with any other interop are written by the GPU, buffers
+    // that scroll, store flipbook frames, or accumulate depend on state
+    // that is not handed over with the pixel data, and AppKit windows
+    // can only be created and drawn on the main thread.
+#ifdef __APPLE__
+    const bool isSupported = false;
+#else
+    const Buffer::Config& bufferConfig = a_config.bufferConfig;
+    const bool isSupported = bufferConfig.interop == Buffer::Interop::HOST &&
+                             bufferConfig.scroll == Buffer::Scroll::NONE &&
+                             !bufferConfig.flipbookFrames &&
+                             !bufferConfig.accumulate;
+#endif
+    if (!isSupported)
+    {
+        return Implementation::Create(a_config);
+    }
+
+    std::unique_ptr<ContextAsync> context = std::make_unique<ContextAsync>(a_config);
+    if (!context->m_window)
+    {
+        return nullptr;
+    }
+    return std::unique_ptr<Context::Implementation>(std::move(context));
+}
+
+//--------------------------------------------------------------
+Buffer& ContextAsync::GetBuffer() const
+{
+    return *m_buffer;
+}
+
+//--------------------------------------------------------------
+Window* ContextAsync::GetWindow() const
+{
+    return m_window;
+}
+
+//--------------------------------------------------------------
+void ContextAsync::OnFrameStart()
+{
+    // Window events are pumped by the render thread, which owns the
+    // window (native windows can only be pumped by the thread that
+    // created them on some platforms, eg. Win32), so native event
+    // callbacks are invoked on the render thread, and window state
+    // that events change is atomic so it can be queried from here.
+}
+
+//--------------------------------------------------------------
+void ContextAsync::OnFrameEnded()
+{
+    const Buffer::Viewport viewport = m_buffer->GetViewport();
+    const void* frameData = nullptr;
+
+    {
+        // Hand the frame over by swapping the buffer data with the
+        // memory of the pending frame (instead of copying it while
+        // holding the lock), which replaces any frame that the render
+        // thread has not started presenting yet (which is dropped).
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_hasPendingFrame)
+        {
+            m_frameCounters.framesPresented--;
+            m_frameCounters.framesDropped++;
+        }
+        m_bufferHost->SwapData(m_pendingFrame.data, m_pendingFrame.size);
+        m_pendingFrame.viewport = viewport;
+        m_hasPendingFrame = true;
+        frameData = m_pendingFrame.data;
+
+        // Update the latency, timing, and upload counters of frames
+        // presented by the render thread.
+        m_latencyCounters = m_renderLatencyCounters;
+        m_presentTiming = m_renderPresentTiming;
+        m_bufferHost->SetUploadCounters(m_renderUploadCounters);
+    }
+    m_condition.notify_one();
+
+    // Copy the frame back into the buffer data so it is preserved
+    // between frames, which is safe without the lock because frames
+    // are only read by the render thread, and only this thread frees
+    // their memory (when swapping it, see BufferHost::SwapData).
+    m_bufferHost->RestoreData(frameData);
+
+    // Nothing is rendered, but this clears the invalidated state.
+    m_buffer->Render(0, 0);
+}
+
+//--------------------------------------------------------------
+bool ContextAsync::IsFrameSlotAvailable()
+{
+    // Frames are always handed over without waiting for the GPU.
+    return true;
+}
+
+//--------------------------------------------------------------
+bool ContextAsync::WaitForFramePresented()
+{
+    // Frames are presented by the render thread, so the calling
+    // thread is never delayed until they reach the display.
+    return false;
+}
+
+//--------------------------------------------------------------
+Buffer::Config ContextAsync::ResizeRenderBuffer(const Buffer::Config& a_config)
+{
+    // The buffer that is rendered was created by the render thread
+    // using the same config, so it is only resized after the buffer
+    // written by this thread has been created.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_bufferHost)
+    {
+        return m_renderConfig;
+    }
+
+    m_renderConfig = a_config;
+    m_hasPendingResize = true;
+    m_condition.notify_one();
+    m_condition.wait(lock, [this] { return !m_hasPendingResize; });
+    return m_renderConfig;
+}
+
+//--------------------------------------------------------------
+Buffer::Config ContextAsync::GetRenderConfig(const Buffer& a_buffer,
+                                             const Buffer::Config& a_config)
+{
+    // Use the layout and storage of the buffer (which may fall back
+    // to linear, or resolve AUTO storage), and raise the pitch alignment
+    // to match its pitch (which may be aligned further by the graphics
+    // api), because every graphics api pads the pitch to a power of
+    // two alignment.
+    Buffer::Config config = a_config;
+    config.layout = a_buffer.GetLayout();
+    config.storage = a_buffer.GetStorage();
+    config.pitchAlignment = GetPowerOfTwoAlignment(config.pitchAlignment);
+    while (Buffer::AlignedPitchBytes(config) < a_buffer.GetPitch() &&
+           config.pitchAlignment < 0x80000000u)
+    {
+        config.pitchAlignment <<= 1;
+    }
+    assert(!a_buffer.GetData() ||
+           Buffer::AlignedPitchBytes(config) == a_buffer.GetPitch());
+    return config;
+}
+
+//--------------------------------------------------------------
+void ContextAsync::RenderFrames(const Context::Config& a_config)
+{
+    // Create the platform context on this thread, which presents
+    // frames when they are handed over or the window is redrawn.
+    Context::Config config = a_config;
+    config.bufferConfig = BufferHost::GetHostConfig(a_config.bufferConfig);
+    m_context = Implementation::Create(config);
+    if (m_context)
+    {
+        m_context->m_renderOnDemand = true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_window = m_context ? m_context->GetWindow() : nullptr;
+        m_presentMode = m_context ? m_context->m_presentMode : Context::PresentMode::NONE;
+        m_renderConfig = m_context ? GetRenderConfig(m_context->GetBuffer(), config.bufferConfig) :
+                                     Buffer::Config::Invalid();
+        m_isStarted = true;
+    }
+    m_condition.notify_one();
+
+    if (!m_context)
+    {
+        return;
+    }
+
+    // Pump window events while waiting for each frame, so they are
+    // still processed when no frames are being handed over.
+    const std::chrono::milliseconds pumpInterval(2);
+    while (true)
+    {
+        m_context->OnFrameStart();
+
+        bool hasFrame = false;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait_for(lock, pumpInterval, [this]
+            {
+                return m_hasPendingFrame || m_hasPendingResize || m_exit;
+            });
+            if (m_exit)
+            {
+                break;
+            }
+            if (m_hasPendingResize)
+            {
+                // Resize the buffer while the calling thread waits, and
+                // drop any frame handed over before it was resized.
+                Buffer& buffer = m_context->GetBuffer();
+                buffer.Resize(m_renderConfig);
+                m_renderConfig = GetRenderConfig(buffer, m_renderConfig);
+                if (m_hasPendingFrame)
+                {
+                    m_frameCounters.framesPresented--;
+                    m_frameCounters.framesDropped++;
+                    m_hasPendingFrame = false;
+                }
+                m_hasPendingResize = false;
+                m_condition.notify_one();
+            }
+            if (m_hasPendingFrame)
+            {
+                std::swap(m_pendingFrame, m_renderFrame);
+                m_hasPendingFrame = false;
+                hasFrame = true;
+            }
+        }
+
+        if (hasFrame)
+        {
+            CopyFrame(m_renderFrame);
+        }
+
+        if (m_context->IsPresentRequired())
+        {
+            m_context->Present();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_renderLatencyCounters = m_context->m_latencyCounters;
+            m_renderPresentTiming = m_context->m_presentTiming;
+            m_renderUploadCounters = m_context->GetBuffer().GetUploadCounters();
+        }
+    }
+
+    // Destroy the platform context on the thread that created it.
+    m_context.reset();
+}
+
+//--------------------------------------------------------------
+void ContextAsync::CopyFrame(const Frame& a_frame)
+{
+    // The pixel data matches the layout and pitch of the buffer (see
+    // BufferHost::RenderResizer), so it is copied in a single block.
+    Buffer& buffer = m_context->GetBuffer();
+    void* data = buffer.GetData();
+    if (data && a_frame.data && a_frame.size == buffer.GetSize())
+    {
+        memcpy(data, a_frame.data, a_frame.size);
+    }
+
+    buffer.SetViewport(a_frame.viewport);
+    buffer.Invalidate();
+}
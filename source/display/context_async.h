@@ -0,0 +1,102 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <display/context_implementation.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Display
+{
+
+class BufferHost;
+
+//--------------------------------------------------------------
+// Context that owns a render thread, which creates the platform
+// context (so it owns the graphics context or device queue) then
+// presents the latest frame handed over by the calling thread.
+//--------------------------------------------------------------
+class ContextAsync : public Context::Implementation
+{
+public:
+    ContextAsync(const Context::Config& a_config);
+    ~ContextAsync() override;
+
+    ContextAsync(const ContextAsync&) = delete;
+    ContextAsync& operator=(const ContextAsync&) = delete;
+
+    // Create an async context, or a platform context if the config
+    // cannot be presented asynchronously, or nullptr if either fails.
+    static std::unique_ptr<Context::Implementation> Create(const Context::Config& a_config);
+
+protected:
+    Buffer& GetBuffer() const override;
+    Window* GetWindow() const override;
+
+    void OnFrameStart() override;
+    void OnFrameEnded() override;
+
+    bool IsFrameSlotAvailable() override;
+    bool WaitForFramePresented() override;
+
+private:
+    // Frames own the pixel data memory that is swapped with the
+    // buffer data when they are handed over (see BufferHost::SwapData),
+    // so with the buffer there are three (written, pending, rendered).
+    struct Frame
+    {
+        void* data = nullptr;
+        uint64_t size = 0;
+        Buffer::Viewport viewport = {};
+    };
+
+    // Resize the buffer that is rendered, waiting for the render thread
+    // (see BufferHost::RenderResizer), and get the config it matches.
+    Buffer::Config ResizeRenderBuffer(const Buffer::Config& a_config);
+    static Buffer::Config GetRenderConfig(const Buffer& a_buffer,
+                                          const Buffer::Config& a_config);
+
+    // Render thread functions.
+    void RenderFrames(const Context::Config& a_config);
+    void CopyFrame(const Frame& a_frame);
+
+    // Only accessed from the thread calling OnFrameEnded.
+    Buffer* m_buffer = nullptr;
+    BufferHost* m_bufferHost = nullptr;
+
+    // Only accessed from the render thread once it is started.
+    std::unique_ptr<Context::Implementation> m_context;
+    Frame m_renderFrame;
+
+    // Set by the render thread before it is started.
+    Window* m_window = nullptr;
+
+    // Shared with the render thread, guarded by m_mutex.
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    Frame m_pendingFrame;
+    Buffer::Config m_renderConfig = Buffer::Config::Invalid();
+    Context::LatencyCounters m_renderLatencyCounters;
+    Context::PresentTiming m_renderPresentTiming;
+    Buffer::UploadCounters m_renderUploadCounters;
+    bool m_hasPendingFrame = false;
+    bool m_hasPendingResize = false;
+    bool m_isStarted = false;
+    bool m_exit = false;
+
+    std::thread m_thread;
+};
+
+} // namespace Display
+} // namespace Simple
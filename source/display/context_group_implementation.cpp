@@ -0,0 +1,124 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <display/context_group_implementation.h>
+
+#include <algorithm>
+
+using namespace Simple::Display;
+
+//--------------------------------------------------------------
+//! Create an empty group of display contexts.
+//--------------------------------------------------------------
+ContextGroup::ContextGroup()
+    : m_pimpl(new Implementation())
+{
+}
+
+//--------------------------------------------------------------
+ContextGroup::~ContextGroup()
+{
+}
+
+//--------------------------------------------------------------
+//! Add a display context to the group (if it is not already), so
+//! it is presented together with the rest by PresentAll.
+//!
+//! \param[in] a_context The display context to add to the group.
+//--------------------------------------------------------------
+void ContextGroup::AddContext(Context& a_context)
+{
+    std::vector<Context*>& contexts = m_pimpl->m_contexts;
+    if (std::find(contexts.cbegin(), contexts.cend(), &a_context) == contexts.cend())
+    {
+        contexts.push_back(&a_context);
+    }
+}
+
+//--------------------------------------------------------------
+//! Remove a display context from the group (if it is in it).
+//!
+//! \param[in] a_context The display context to remove from the group.
+//--------------------------------------------------------------
+void ContextGroup::RemoveContext(Context& a_context)
+{
+    std::vector<Context*>& contexts = m_pimpl->m_contexts;
+    contexts.erase(std::remove(contexts.begin(), contexts.end(), &a_context),
+                   contexts.end());
+}
+
+//--------------------------------------------------------------
+//! Get the number of display contexts in the group.
+//!
+//! \return The number of display contexts in the group.
+//--------------------------------------------------------------
+uint32_t ContextGroup::GetContextCount() const
+{
+    return static_cast<uint32_t>(m_pimpl->m_contexts.size());
+}
+
+//--------------------------------------------------------------
+//! Call at the start of each frame instead of calling OnFrameStart
+//! for each display context in the group, which pumps the events of
+//! the window of each context (and only that window processes them).
+//--------------------------------------------------------------
+void ContextGroup::OnFrameStart()
+{
+    for (Context* context : m_pimpl->m_contexts)
+    {
+        context->OnFrameStart();
+    }
+}
+
+//--------------------------------------------------------------
+//! Call at the end of each frame instead of calling OnFrameEnded
+//! for each display context in the group, to render the buffers
+//! of all contexts that must be presented (see OnFrameEnded) before
+//! presenting any of them, so they are presented on the same refresh.
+//--------------------------------------------------------------
+void ContextGroup::PresentAll()
+{
+    // Contexts with queued frames present them when they are due
+    // (see Context::QueueFrame), so they are presented separately.
+    std::vector<Context::Implementation*>& presentingContexts = m_pimpl->m_presentingContexts;
+    presentingContexts.clear();
+    for (Context* context : m_pimpl->m_contexts)
+    {
+        Context::Implementation* implementation = context->m_pimpl.get();
+        if (!implementation)
+        {
+            continue;
+        }
+
+        if (implementation->m_frameScheduler.GetQueuedFrameCount())
+        {
+            context->OnFrameEnded();
+        }
+        else if (implementation->IsPresentRequired())
+        {
+            presentingContexts.push_back(implementation);
+        }
+    }
+
+    // Render (and flush) every buffer first, so the GPU renders them
+    // while the rest are being submitted, then present them all back
+    // to back, and only then wait for any of them (if required).
+    for (Context::Implementation* implementation : presentingContexts)
+    {
+        implementation->BeginPresent();
+        implementation->RenderFrame();
+    }
+    for (Context::Implementation* implementation : presentingContexts)
+    {
+        implementation->PresentFrame();
+    }
+    for (Context::Implementation* implementation : presentingContexts)
+    {
+        implementation->EndPresent();
+    }
+}
@@ -0,0 +1,39 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <simple/display/context_group.h>
+#include <display/context_implementation.h>
+
+#include <vector>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Display
+{
+
+//--------------------------------------------------------------
+class ContextGroup::Implementation
+{
+public:
+    Implementation() = default;
+
+    Implementation(const Implementation&) = delete;
+    Implementation& operator=(const Implementation&) = delete;
+
+    // The contexts in the group, in the order they were added.
+    std::vector<Context*> m_contexts;
+
+    // The contexts presenting this frame (reused to avoid allocating).
+    std::vector<Context::Implementation*> m_presentingContexts;
+};
+
+} // namespace Display
+} // namespace Simple
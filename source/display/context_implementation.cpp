@@ -7,7 +7,9 @@
 //--------------------------------------------------------------
 
 #include <display/context_implementation.h>
+#include <display/context_async.h>
 #include <display/buffer_implementation.h>
+#include <display/window_implementation.h>
 
 using namespace Simple::Display;
 
@@ -17,8 +19,17 @@ using namespace Simple::Display;
 //! \param[in] a_config The values needed to create the context.
 //--------------------------------------------------------------
 Context::Context(const Config& a_config)
-    : m_pimpl(Context::Implementation::Create(a_config))
+    : m_pimpl(a_config.asyncPresent ? ContextAsync::Create(a_config) :
+                                      Context::Implementation::Create(a_config))
 {
+    if (m_pimpl)
+    {
+        m_pimpl->m_renderOnDemand = a_config.renderOnDemand;
+        m_pimpl->m_frameLimiter.SetTargetFrameRate(a_config.targetFrameRate);
+        m_pimpl->m_frameLimiter.SetLowLatency(a_config.lowLatency);
+        m_pimpl->m_frameScheduler.Configure(a_config.frameQueueSize,
+                                            a_config.lateFramePolicy);
+    }
 }
 
 //--------------------------------------------------------------
@@ -49,23 +60,509 @@ Window* Context::GetWindow() const
 }
 
 //--------------------------------------------------------------
-//! Call at the start of each frame to update/pump window events.
+//! Set the region of the buffer that is scaled to fill the display,
+//! which can be changed each frame to pan and/or zoom the buffer.
+//!
+//! \param[in] a_viewport The region of the buffer to be displayed,
+//!                       or a region without any area to display
+//!                       the entire buffer (the default viewport).
+//--------------------------------------------------------------
+void Context::SetViewport(const Buffer::Viewport& a_viewport)
+{
+    GetBuffer().SetViewport(a_viewport);
+}
+
+//--------------------------------------------------------------
+//! Get the region of the buffer that is scaled to fill the display.
+//!
+//! \return The region of the buffer that is scaled to fill the
+//!         display, which has no area if the entire buffer is.
+//--------------------------------------------------------------
+Buffer::Viewport Context::GetViewport() const
+{
+    return GetBuffer().GetViewport();
+}
+
+//--------------------------------------------------------------
+//! Get the mode actually used to present frames to the display,
+//! which may differ from the mode requested in the context config
+//! if it is not supported by the graphics API or display device.
+//!
+//! \return The mode used to present frames to the display, or
+//!         PresentMode::NONE if the context could not be created.
+//--------------------------------------------------------------
+Context::PresentMode Context::GetPresentMode() const
+{
+    return m_pimpl ? m_pimpl->m_presentMode : PresentMode::NONE;
+}
+
+//--------------------------------------------------------------
+//! Get the counters that measure the latency of rendered frames,
+//! from the time each was submitted to the time it was completed.
+//!
+//! \return Counters that measure the latency of rendered frames,
+//!         which are all zero if the graphics API does not support
+//!         measuring frame latency or the context was not created.
+//--------------------------------------------------------------
+Context::LatencyCounters Context::GetLatencyCounters() const
+{
+    return m_pimpl ? m_pimpl->m_latencyCounters : LatencyCounters();
+}
+
+//--------------------------------------------------------------
+//! Call at the start of each frame to update/pump window events,
+//! after first waiting until the frame is due if the context paces
+//! frames at a target frame rate (see Config::targetFrameRate) or
+//! just in time for the next refresh (see Config::lowLatency).
 //--------------------------------------------------------------
 void Context::OnFrameStart()
 {
     if (m_pimpl)
     {
+        m_pimpl->m_frameLimiter.WaitForNextFrame(m_pimpl->m_pacingCounters);
         m_pimpl->OnFrameStart();
     }
 }
 
 //--------------------------------------------------------------
-//! Call at the end of each frame to render/display the buffer.
+//! Call at the end of each frame to render/display the buffer,
+//! which contexts that render on demand only do if the buffer was
+//! invalidated or the window was exposed or requested a redraw.
+//!
+//! While frames are queued (see QueueFrame) the queued frame that
+//! is due is presented instead (waiting briefly for the next one if
+//! none is due yet), and nothing is presented if none is due.
 //--------------------------------------------------------------
 void Context::OnFrameEnded()
 {
-    if (m_pimpl)
+    if (!m_pimpl)
+    {
+        return;
+    }
+
+    if (m_pimpl->m_frameScheduler.GetQueuedFrameCount())
+    {
+        m_pimpl->PresentQueuedFrame(true);
+        return;
+    }
+
+    // Frames are no longer queued, so the buffer data can be mapped
+    // write only again (from when it is next mapped, if it is).
+    Buffer::Implementation::SetBufferDataReadable(GetBuffer(), false);
+    if (m_pimpl->IsPresentRequired())
+    {
+        m_pimpl->Present();
+    }
+}
+
+//--------------------------------------------------------------
+//! Check whether a frame can be presented without waiting for the
+//! GPU to complete earlier frames (see Config::framesInFlight).
+//!
+//! \return True if a frame can be presented without waiting for
+//!         the GPU, false if presenting would block until one of
+//!         the earlier frames in flight has been completed.
+//--------------------------------------------------------------
+bool Context::IsFrameSlotAvailable() const
+{
+    return m_pimpl ? m_pimpl->IsFrameSlotAvailable() : false;
+}
+
+//--------------------------------------------------------------
+//! Call at the end of each frame instead of OnFrameEnded to render
+//! and present the buffer only if it can be done without waiting
+//! for the GPU, otherwise the frame is dropped so the caller can
+//! keep its own cadence (the buffer remains invalidated, so it is
+//! still presented by the next frame of contexts that render on
+//! demand). Presenting may still wait for vertical sync, which
+//! can be avoided by selecting an uncapped Config::presentMode.
+//!
+//! While frames are queued (see QueueFrame) the queued frame that
+//! is due is presented as by OnFrameEnded, except that it does not
+//! wait for the next queued frame to be due if none is due yet, and
+//! frames remain queued if no frame slot is available (they are
+//! not dropped by TryPresent, only by Config::lateFramePolicy).
+//!
+//! \return True if the frame was presented (or did not need to
+//!         be), false if it was dropped (see GetFrameCounters),
+//!         or if frames are queued but none of them was presented.
+//--------------------------------------------------------------
+bool Context::TryPresent()
+{
+    if (!m_pimpl)
+    {
+        return false;
+    }
+
+    if (m_pimpl->m_frameScheduler.GetQueuedFrameCount())
+    {
+        return m_pimpl->IsFrameSlotAvailable() &&
+               m_pimpl->PresentQueuedFrame(false);
+    }
+
+    if (m_pimpl->IsPresentRequired() &&
+        !m_pimpl->IsFrameSlotAvailable())
+    {
+        m_pimpl->m_frameCounters.framesDropped++;
+        return false;
+    }
+
+    OnFrameEnded();
+    return true;
+}
+
+//--------------------------------------------------------------
+//! Get the counters that measure the number of frames presented,
+//! and the number dropped because no frame slot was available.
+//!
+//! \return Counters that measure the number of frames presented
+//!         and dropped, which are zero if there is no context.
+//--------------------------------------------------------------
+Context::FrameCounters Context::GetFrameCounters() const
+{
+    return m_pimpl ? m_pimpl->m_frameCounters : FrameCounters();
+}
+
+//--------------------------------------------------------------
+//! Get the counters that measure how late each frame was started
+//! by OnFrameStart relative to its deadline, which can be used to
+//! monitor the cadence of contexts that pace frames at a target
+//! frame rate (see Config::targetFrameRate).
+//!
+//! \return Counters that measure the pacing error of frames, which
+//!         are zero if frames are not paced or there is no context.
+//--------------------------------------------------------------
+Context::PacingCounters Context::GetPacingCounters() const
+{
+    return m_pimpl ? m_pimpl->m_pacingCounters : PacingCounters();
+}
+
+//--------------------------------------------------------------
+//! Get the counters that measure the latency of presented frames,
+//! from the time each was submitted to the time it was presented
+//! (ie. reached the display), which are only measured by contexts
+//! that minimize latency (see Config::lowLatency).
+//!
+//! \return Counters that measure the latency of presented frames,
+//!         which are all zero if the context does not measure it.
+//--------------------------------------------------------------
+Context::LatencyCounters Context::GetPresentLatencyCounters() const
+{
+    return m_pimpl ? m_pimpl->m_presentLatencyCounters : LatencyCounters();
+}
+
+//--------------------------------------------------------------
+//! Get the timing of the last frame that reached the display, and
+//! the predicted time that the next frame presented will reach it,
+//! which is updated by OnFrameStart and OnFrameEnded.
+//!
+//! \return The timing of the last frame that reached the display,
+//!         which is all zero if the graphics API does not expose it.
+//--------------------------------------------------------------
+Context::PresentTiming Context::GetPresentTiming() const
+{
+    return m_pimpl ? m_pimpl->m_presentTiming : PresentTiming();
+}
+
+//--------------------------------------------------------------
+//! Queue a copy of the buffer data to be presented by OnFrameEnded
+//! at a target time, so frames can be rendered ahead of when they
+//! are displayed (eg. decoded video frames) without the caller
+//! implementing its own timing loop. Each frame is presented at the
+//! refresh closest to its target time (held by the graphics API
+//! until then where supported), and frames that are late because a
+//! later frame is also due are handled by Config::lateFramePolicy.
+//! Buffer data that is mapped write only is mapped again so it can
+//! be read while frames are queued, so Buffer::GetData must be
+//! called again after each call (pointers got before it are stale).
+//!
+//! \param[in] a_targetPresentMicroseconds The time the frame is to
+//!                                         be displayed, measured
+//!                                         by GetTimeMicroseconds.
+//!
+//! \return True if the frame was queued, false if the queue is full
+//!         (see Config::frameQueueSize), or the buffer data is not
+//!         stored in host memory, or there is no context.
+//--------------------------------------------------------------
+bool Context::QueueFrame(uint64_t a_targetPresentMicroseconds)
+{
+    if (!m_pimpl)
+    {
+        return false;
+    }
+
+    // The buffer data is copied into the queue, so it must be mapped
+    // for reading (not only writing) while frames are being queued.
+    Buffer& buffer = GetBuffer();
+    Buffer::Implementation::SetBufferDataReadable(buffer, true);
+    return m_pimpl->m_frameScheduler.QueueFrame(buffer,
+                                                a_targetPresentMicroseconds);
+}
+
+//--------------------------------------------------------------
+//! Get the number of frames queued that have not been presented.
+//!
+//! \return The number of frames queued to be presented at target
+//!         times, which is zero if there is no context.
+//--------------------------------------------------------------
+uint32_t Context::GetQueuedFrameCount() const
+{
+    return m_pimpl ? m_pimpl->m_frameScheduler.GetQueuedFrameCount() : 0;
+}
+
+//--------------------------------------------------------------
+//! Get the current time of the monotonic clock that is used to
+//! measure present timing and the target times of queued frames.
+//!
+//! \return The current time of the monotonic clock, in microseconds.
+//--------------------------------------------------------------
+uint64_t Context::GetTimeMicroseconds()
+{
+    using namespace std::chrono;
+    const FrameLimiter::Clock::duration time = FrameLimiter::Clock::now().time_since_epoch();
+    return static_cast<uint64_t>(duration_cast<microseconds>(time).count());
+}
+
+//--------------------------------------------------------------
+//! Add a window that mirrors the display buffer (eg. on a second
+//! display or projector), which is rendered to it each frame with
+//! its own viewport without uploading the buffer data again. The
+//! events of mirror windows are pumped by OnFrameStart along with
+//! those of the context window (but each processes only its own),
+//! and mirror windows are destroyed with the context.
+//!
+//! \param[in] a_windowConfig The values needed to create the window.
+//!
+//! \return The mirror window, or nullptr if the graphics API does
+//!         not support mirror windows (currently only OpenGL on
+//!         Linux does) or the context was not created.
+//--------------------------------------------------------------
+Window* Context::AddMirrorWindow(const Window::Config& a_windowConfig)
+{
+    if (!m_pimpl)
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<Window> window = std::make_unique<Window>(a_windowConfig);
+    if (!m_pimpl->AddMirrorWindow(*window))
+    {
+        return nullptr;
+    }
+    window->Show();
+
+    Implementation::MirrorWindow mirrorWindow;
+    mirrorWindow.window = std::move(window);
+    m_pimpl->m_mirrorWindows.push_back(std::move(mirrorWindow));
+
+    // The buffer data is uploaded again so the mirror can display
+    // any region of it (not only the viewport of the context).
+    m_pimpl->GetBuffer().Invalidate();
+    return m_pimpl->m_mirrorWindows.back().window.get();
+}
+
+//--------------------------------------------------------------
+//! Remove (and destroy) a window that mirrors the display buffer.
+//!
+//! \param[in] a_window The mirror window returned by AddMirrorWindow.
+//--------------------------------------------------------------
+void Context::RemoveMirrorWindow(Window* a_window)
+{
+    Implementation::MirrorWindow* mirrorWindow = m_pimpl ? m_pimpl->FindMirrorWindow(a_window) : nullptr;
+    if (!mirrorWindow)
+    {
+        return;
+    }
+
+    m_pimpl->RemoveMirrorWindow(*a_window);
+    std::vector<Implementation::MirrorWindow>& mirrorWindows = m_pimpl->m_mirrorWindows;
+    mirrorWindows.erase(mirrorWindows.begin() + (mirrorWindow - mirrorWindows.data()));
+}
+
+//--------------------------------------------------------------
+//! Get the number of windows that mirror the display buffer.
+//!
+//! \return The number of mirror windows, which is zero if there
+//!         are none or the context was not created.
+//--------------------------------------------------------------
+uint32_t Context::GetMirrorWindowCount() const
+{
+    return m_pimpl ? static_cast<uint32_t>(m_pimpl->m_mirrorWindows.size()) : 0;
+}
+
+//--------------------------------------------------------------
+//! Set the region of the buffer that is scaled to fill a window
+//! that mirrors the display buffer (see SetViewport).
+//!
+//! \param[in] a_window The mirror window returned by AddMirrorWindow.
+//! \param[in] a_viewport The region of the buffer to be displayed,
+//!                       or a region without any area to display
+//!                       the entire buffer (the default viewport).
+//--------------------------------------------------------------
+void Context::SetMirrorViewport(Window* a_window,
+                                const Buffer::Viewport& a_viewport)
+{
+    Implementation::MirrorWindow* mirrorWindow = m_pimpl ? m_pimpl->FindMirrorWindow(a_window) : nullptr;
+    if (mirrorWindow)
+    {
+        mirrorWindow->viewport = a_viewport;
+        a_window->RequestRedraw();
+    }
+}
+
+//--------------------------------------------------------------
+bool Context::Implementation::IsPresentRequired() const
+{
+    // Contexts that render on demand only present the buffer if
+    // it was invalidated or the window was exposed or requested
+    // a redraw, otherwise it is presented at the end every frame.
+    Window* window = GetWindow();
+    if (!m_renderOnDemand ||
+        GetBuffer().IsInvalidated() ||
+        (window && window->IsRedrawRequested()))
+    {
+        return true;
+    }
+
+    // Mirror windows are presented with the window of the context.
+    for (const MirrorWindow& mirrorWindow : m_mirrorWindows)
+    {
+        if (mirrorWindow.window->IsRedrawRequested())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//--------------------------------------------------------------
+void Context::Implementation::Present()
+{
+    BeginPresent();
+    OnFrameEnded();
+    EndPresent();
+}
+
+//--------------------------------------------------------------
+void Context::Implementation::BeginPresent()
+{
+    // Clear any redraw request before presenting, so requests made
+    // while presenting (possibly by another thread) are not lost.
+    Window* window = GetWindow();
+    if (window)
+    {
+        window->ClearRedrawRequest();
+    }
+    for (MirrorWindow& mirrorWindow : m_mirrorWindows)
+    {
+        mirrorWindow.window->ClearRedrawRequest();
+    }
+}
+
+//--------------------------------------------------------------
+void Context::Implementation::EndPresent()
+{
+    m_frameCounters.framesPresented++;
+
+    // Wait until the frame is presented, so the next frame can be
+    // started just in time for the refresh after it was presented.
+    if (m_frameLimiter.IsLowLatency())
+    {
+        const FrameLimiter::Clock::time_point submitTime = FrameLimiter::Clock::now();
+        if (WaitForFramePresented())
+        {
+            m_frameLimiter.OnFramePresented(submitTime, m_presentLatencyCounters);
+        }
+    }
+}
+
+//--------------------------------------------------------------
+void Context::Implementation::RenderFrame()
+{
+    // Rendered when presenting instead.
+}
+
+//--------------------------------------------------------------
+void Context::Implementation::PresentFrame()
+{
+    OnFrameEnded();
+}
+
+//--------------------------------------------------------------
+Context::Implementation::MirrorWindow* Context::Implementation::FindMirrorWindow(const Window* a_window)
+{
+    for (MirrorWindow& mirrorWindow : m_mirrorWindows)
+    {
+        if (mirrorWindow.window.get() == a_window)
+        {
+            return &mirrorWindow;
+        }
+    }
+    return nullptr;
+}
+
+//--------------------------------------------------------------
+bool Context::Implementation::AddMirrorWindow(Window& a_window)
+{
+    // Mirror windows are not supported by default.
+    (void)a_window;
+    return false;
+}
+
+//--------------------------------------------------------------
+void Context::Implementation::RemoveMirrorWindow(Window& a_window)
+{
+    // Nothing to release by default.
+    (void)a_window;
+}
+
+//--------------------------------------------------------------
+bool Context::Implementation::PresentQueuedFrame(bool a_wait)
+{
+    // Frames presented now are displayed at the next refresh that is
+    // predicted by the present timing (or as soon as possible if it
+    // is unknown), so frames are due if their target time is within
+    // half a refresh after it (ie. it is the closest refresh).
+    using namespace std::chrono;
+    const FrameLimiter::Clock::time_point now = FrameLimiter::Clock::now();
+    const uint64_t nowMicroseconds = duration_cast<microseconds>(now.time_since_epoch()).count();
+    uint64_t dueMicroseconds = std::max(m_presentTiming.nextPresentMicroseconds, nowMicroseconds) +
+                               m_presentTiming.refreshPeriodNanoseconds / 2000;
+
+    // Wait until the next frame is due if it is not already, for no
+    // longer than the max wait so window events are still pumped.
+    const uint64_t nextTargetMicroseconds = m_frameScheduler.GetNextTargetMicroseconds();
+    if (a_wait && nextTargetMicroseconds > dueMicroseconds)
+    {
+        const uint64_t waitMicroseconds = std::min<uint64_t>(nextTargetMicroseconds - dueMicroseconds,
+                                                             FRAME_SCHEDULER_MAX_WAIT_MICROSECONDS);
+        m_frameLimiter.WaitUntil(now + microseconds(waitMicroseconds), now);
+        dueMicroseconds += waitMicroseconds;
+    }
+
+    uint64_t targetMicroseconds = 0;
+    uint64_t framesDropped = 0;
+    const bool isFrameDue = m_frameScheduler.DequeueFrame(GetBuffer(),
+                                                          dueMicroseconds,
+                                                          targetMicroseconds,
+                                                          framesDropped);
+    m_frameCounters.framesDropped += framesDropped;
+    if (isFrameDue)
+    {
+        m_targetPresentMicroseconds = targetMicroseconds;
+        Present();
+        m_targetPresentMicroseconds = 0;
+        return true;
+    }
+
+    // The buffer data may have been overwritten by frames queued
+    // since, so restore the frame displayed before redrawing it.
+    Window* window = GetWindow();
+    if (window && window->IsRedrawRequested() &&
+        m_frameScheduler.RestoreFrame(GetBuffer()))
     {
-        m_pimpl->OnFrameEnded();
+        Present();
+        return true;
     }
+    return false;
 }
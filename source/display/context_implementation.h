@@ -8,7 +8,11 @@
 
 #pragma once
 
-#include <simple/display/context.h>
+#include <display/frame_limiter.h>
+#include <display/frame_scheduler.h>
+
+#include <memory>
+#include <vector>
 
 //--------------------------------------------------------------
 namespace Simple
@@ -28,6 +32,8 @@ protected:
     static std::unique_ptr<Implementation> Create(const Config&);
 
     friend class Context;
+    friend class ContextAsync;
+    friend class ContextGroup;
     Implementation() = default;
 
     Implementation(const Implementation&) = delete;
@@ -38,6 +44,81 @@ protected:
 
     virtual void OnFrameStart() = 0;
     virtual void OnFrameEnded() = 0;
+
+    // Whether a frame can be rendered without waiting for the GPU
+    // to complete earlier frames (or always for graphics APIs that
+    // wait for each frame to complete before presenting the next).
+    virtual bool IsFrameSlotAvailable() = 0;
+
+    // Wait until the last frame presented has reached the display,
+    // or return false for graphics APIs that cannot wait for it.
+    virtual bool WaitForFramePresented() = 0;
+
+    // Render the buffer, then present it, as separate steps so that
+    // a group of contexts can render all their buffers before any are
+    // presented (see ContextGroup), where implementations that cannot
+    // separate them do both when presenting (using OnFrameEnded).
+    virtual void RenderFrame();
+    virtual void PresentFrame();
+
+    // Prepare a window to display the buffer rendered each frame (or
+    // return false if mirror windows are not supported), and release
+    // it before it is removed from the mirror windows and destroyed.
+    virtual bool AddMirrorWindow(Window& a_window);
+    virtual void RemoveMirrorWindow(Window& a_window);
+
+    // Whether the buffer must be presented at the end of a frame,
+    // and present it (clearing any redraw request of the window).
+    bool IsPresentRequired() const;
+    void Present();
+
+    // Called before rendering and after presenting the buffer (which
+    // Present does), to track frames and wait for them if required.
+    void BeginPresent();
+    void EndPresent();
+
+    // Present the queued frame that is due (if any), after waiting
+    // a short time for the next one if none is due yet (unless it
+    // must not wait, eg. when called by Context::TryPresent), and
+    // return whether a frame was presented.
+    bool PresentQueuedFrame(bool a_wait);
+
+    bool m_renderOnDemand = false;
+
+    // Set by each implementation to the present mode in effect.
+    PresentMode m_presentMode = PresentMode::NONE;
+
+    // Updated by each implementation as frames are completed.
+    LatencyCounters m_latencyCounters;
+
+    // Updated by the context as frames are presented or dropped.
+    FrameCounters m_frameCounters;
+
+    // Updated by each implementation that measures present timing.
+    PresentTiming m_presentTiming;
+
+    // Updated by the context as frames are started and presented.
+    FrameLimiter m_frameLimiter;
+    PacingCounters m_pacingCounters;
+    LatencyCounters m_presentLatencyCounters;
+
+    // Updated by the context as frames are queued and presented.
+    FrameScheduler m_frameScheduler;
+
+    // The time the frame being presented is due to be displayed,
+    // which implementations that can present frames at a target
+    // time use to hold it until then (otherwise it is zero).
+    uint64_t m_targetPresentMicroseconds = 0;
+
+    // Windows that display the same buffer data (uploaded once each
+    // frame), each scaling the region of the buffer in its viewport.
+    struct MirrorWindow
+    {
+        std::unique_ptr<Window> window;
+        Buffer::Viewport viewport = {};
+    };
+    std::vector<MirrorWindow> m_mirrorWindows;
+    MirrorWindow* FindMirrorWindow(const Window* a_window);
 };
 
 } // namespace Display
@@ -0,0 +1,267 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <simple/display/context.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+//--------------------------------------------------------------
+//! The initial duration (measured in microseconds) that the frame
+//! limiter spins for before each deadline instead of sleeping, which
+//! is then adapted to the precision of sleeps measured at runtime.
+//--------------------------------------------------------------
+#ifndef FRAME_LIMITER_INITIAL_SPIN_MICROSECONDS
+#define FRAME_LIMITER_INITIAL_SPIN_MICROSECONDS 2000
+#endif//FRAME_LIMITER_INITIAL_SPIN_MICROSECONDS
+
+//--------------------------------------------------------------
+//! The min duration (measured in microseconds) that frames started
+//! just in time for the next refresh (see Config::lowLatency) are
+//! started early by, which is increased whenever a refresh is missed.
+//--------------------------------------------------------------
+#ifndef FRAME_LIMITER_MIN_MARGIN_MICROSECONDS
+#define FRAME_LIMITER_MIN_MARGIN_MICROSECONDS 1000
+#endif//FRAME_LIMITER_MIN_MARGIN_MICROSECONDS
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Display
+{
+
+//--------------------------------------------------------------
+// Paces frames at a target rate, and/or just in time for the next
+// refresh, using a monotonic clock, sleeping until shortly before
+// each deadline (as sleeps can overshoot by the scheduler granularity)
+// then spinning until the deadline is reached.
+//--------------------------------------------------------------
+class FrameLimiter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    FrameLimiter() = default;
+
+    FrameLimiter(const FrameLimiter&) = delete;
+    FrameLimiter& operator=(const FrameLimiter&) = delete;
+
+    // Set the target frame rate (or zero to not limit the rate),
+    // and whether to start frames just in time for the next refresh.
+    void SetTargetFrameRate(float a_framesPerSecond);
+    void SetLowLatency(bool a_lowLatency);
+    bool IsLowLatency() const;
+
+    // Wait until the next frame is due (unless it is already late).
+    void WaitForNextFrame(Context::PacingCounters& o_pacingCounters);
+
+    // Call once each frame submitted has been presented (ie. reached
+    // the display) to measure its latency and schedule the next one.
+    void OnFramePresented(Clock::time_point a_submitTime,
+                          Context::LatencyCounters& o_latencyCounters);
+
+    // Wait until the deadline, returning the time waited until.
+    Clock::time_point WaitUntil(Clock::time_point a_deadline,
+                                Clock::time_point a_now);
+
+private:
+    // Frames limited to a target rate.
+    Clock::duration m_framePeriod = Clock::duration::zero();
+    Clock::time_point m_deadline;
+    bool m_hasDeadline = false;
+
+    // Frames started just in time for the next refresh.
+    Clock::duration m_refreshPeriod = Clock::duration::zero();
+    Clock::duration m_frameDuration = Clock::duration::zero();
+    Clock::duration m_margin = std::chrono::microseconds(FRAME_LIMITER_MIN_MARGIN_MICROSECONDS);
+    Clock::time_point m_frameStartTime;
+    Clock::time_point m_presentTime;
+    bool m_isLowLatency = false;
+
+    // Adapted to the precision of sleeps.
+    Clock::duration m_spinDuration = std::chrono::microseconds(FRAME_LIMITER_INITIAL_SPIN_MICROSECONDS);
+};
+
+//--------------------------------------------------------------
+inline void FrameLimiter::SetTargetFrameRate(float a_framesPerSecond)
+{
+    using namespace std::chrono;
+    m_framePeriod = (a_framesPerSecond > 0.0f) ?
+                    duration_cast<Clock::duration>(duration<double>(1.0 / a_framesPerSecond)) :
+                    Clock::duration::zero();
+    m_hasDeadline = false;
+}
+
+//--------------------------------------------------------------
+inline void FrameLimiter::SetLowLatency(bool a_lowLatency)
+{
+    m_isLowLatency = a_lowLatency;
+    m_refreshPeriod = Clock::duration::zero();
+    m_presentTime = Clock::time_point();
+}
+
+//--------------------------------------------------------------
+inline bool FrameLimiter::IsLowLatency() const
+{
+    return m_isLowLatency;
+}
+
+//--------------------------------------------------------------
+inline void FrameLimiter::WaitForNextFrame(Context::PacingCounters& o_pacingCounters)
+{
+    const bool isRateLimited = m_framePeriod > Clock::duration::zero();
+    if (!isRateLimited && !m_isLowLatency)
+    {
+        return;
+    }
+
+    // Frames limited to the target rate are due one period after
+    // the previous deadline (the first frame starts immediately).
+    Clock::time_point now = Clock::now();
+    Clock::time_point deadline;
+    bool hasDeadline = false;
+    if (isRateLimited && m_hasDeadline)
+    {
+        deadline = m_deadline;
+        hasDeadline = true;
+    }
+
+    // Frames started just in time are due the expected duration of
+    // the frame (plus a margin) before the refresh that follows the
+    // one the previous frame was presented at, and never more than
+    // one refresh from now (in case the refresh period is wrong).
+    if (m_isLowLatency && m_refreshPeriod > Clock::duration::zero())
+    {
+        const Clock::time_point justInTime = std::min(m_presentTime +
+                                                      m_refreshPeriod -
+                                                      m_frameDuration -
+                                                      m_margin,
+                                                      now + m_refreshPeriod);
+        if (!hasDeadline || justInTime > deadline)
+        {
+            deadline = justInTime;
+            hasDeadline = true;
+        }
+    }
+
+    // Wait for the deadline, then measure how late the frame was.
+    if (hasDeadline)
+    {
+        now = WaitUntil(deadline, now);
+
+        using namespace std::chrono;
+        const uint64_t errorMicroseconds = duration_cast<microseconds>(now - deadline).count();
+        o_pacingCounters.framesPaced++;
+        o_pacingCounters.totalErrorMicroseconds += errorMicroseconds;
+        o_pacingCounters.maxErrorMicroseconds = std::max(o_pacingCounters.maxErrorMicroseconds,
+                                                         errorMicroseconds);
+        o_pacingCounters.lastErrorMicroseconds = errorMicroseconds;
+    }
+
+    // Schedule the next deadline from this one instead of from now,
+    // so errors do not accumulate as drift, unless this frame was
+    // a whole period late, in which case the schedule is reset from
+    // now instead of starting frames back to back to catch up.
+    if (isRateLimited)
+    {
+        m_deadline = m_hasDeadline ? m_deadline + m_framePeriod :
+                                     now + m_framePeriod;
+        m_hasDeadline = true;
+        if (m_deadline <= now)
+        {
+            m_deadline = now + m_framePeriod;
+        }
+    }
+
+    m_frameStartTime = now;
+}
+
+//--------------------------------------------------------------
+inline void FrameLimiter::OnFramePresented(Clock::time_point a_submitTime,
+                                           Context::LatencyCounters& o_latencyCounters)
+{
+    // Measure the latency from submitting the frame to presenting it.
+    using namespace std::chrono;
+    const Clock::time_point now = Clock::now();
+    const uint64_t latencyMicroseconds = duration_cast<microseconds>(now - a_submitTime).count();
+    o_latencyCounters.framesMeasured++;
+    o_latencyCounters.totalMicroseconds += latencyMicroseconds;
+    o_latencyCounters.maxMicroseconds = std::max(o_latencyCounters.maxMicroseconds,
+                                                 latencyMicroseconds);
+
+    // Estimate the refresh period from the interval between frames
+    // presented at consecutive refreshes, ignoring longer intervals
+    // (where a refresh was missed) except to increase the margin,
+    // which otherwise decays slowly back to the min margin.
+    const Clock::duration minMargin = microseconds(FRAME_LIMITER_MIN_MARGIN_MICROSECONDS);
+    if (m_presentTime != Clock::time_point())
+    {
+        const Clock::duration interval = now - m_presentTime;
+        if (m_refreshPeriod <= Clock::duration::zero())
+        {
+            m_refreshPeriod = interval;
+        }
+        else if (interval < m_refreshPeriod * 3 / 2)
+        {
+            m_refreshPeriod += (interval - m_refreshPeriod) / 8;
+            m_margin = std::max(m_margin - m_margin / 32, minMargin);
+        }
+        else
+        {
+            m_margin = std::max(std::min(m_margin * 2, m_refreshPeriod / 2), minMargin);
+        }
+    }
+    m_presentTime = now;
+
+    // Estimate the duration from the start of each frame until it
+    // is submitted, decaying slowly so that only frames which are
+    // consistently shorter are started any later.
+    if (m_frameStartTime != Clock::time_point())
+    {
+        const Clock::duration frameDuration = a_submitTime - m_frameStartTime;
+        m_frameDuration = std::max(frameDuration,
+                                   m_frameDuration - m_frameDuration / 16);
+    }
+}
+
+//--------------------------------------------------------------
+inline FrameLimiter::Clock::time_point FrameLimiter::WaitUntil(Clock::time_point a_deadline,
+                                                               Clock::time_point a_now)
+{
+    // Sleep until shortly before the deadline, then adapt the spin
+    // duration to how much the sleep overshot, decaying it slowly
+    // so an occasional late wakeup does not cause excessive spins.
+    Clock::time_point now = a_now;
+    const Clock::time_point wakeTime = a_deadline - m_spinDuration;
+    if (now < wakeTime)
+    {
+        std::this_thread::sleep_until(wakeTime);
+        now = Clock::now();
+
+        const Clock::duration maxSpinDuration = std::chrono::milliseconds(20);
+        const Clock::duration oversleep = now - wakeTime;
+        m_spinDuration = std::max(oversleep * 2,
+                                  m_spinDuration - m_spinDuration / 16);
+        m_spinDuration = std::min(m_spinDuration, maxSpinDuration);
+    }
+
+    // Spin for the rest, yielding to any other threads that are
+    // ready to run (which otherwise returns immediately).
+    while (now < a_deadline)
+    {
+        std::this_thread::yield();
+        now = Clock::now();
+    }
+    return now;
+}
+
+} // namespace Display
+} // namespace Simple
@@ -0,0 +1,218 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <simple/display/context.h>
+
+#include <cstring>
+#include <deque>
+#include <vector>
+
+//--------------------------------------------------------------
+//! The max duration (measured in microseconds) that OnFrameEnded
+//! waits for the next queued frame to be due (see QueueFrame), so
+//! window events are still pumped while waiting for distant frames.
+//! TryPresent never waits, so it returns as soon as possible.
+//--------------------------------------------------------------
+#ifndef FRAME_SCHEDULER_MAX_WAIT_MICROSECONDS
+#define FRAME_SCHEDULER_MAX_WAIT_MICROSECONDS 4000
+#endif//FRAME_SCHEDULER_MAX_WAIT_MICROSECONDS
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Display
+{
+
+//--------------------------------------------------------------
+// Queues copies of the buffer data ordered by the time each is to
+// be displayed, then copies the frame that is due back into the
+// buffer when it is presented, dropping late frames (by policy).
+//--------------------------------------------------------------
+class FrameScheduler
+{
+public:
+    FrameScheduler() = default;
+
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    // Set the max number of frames queued, and the late frame policy.
+    void Configure(uint32_t a_queueSize,
+                   Context::LateFramePolicy a_lateFramePolicy);
+
+    // Copy the buffer data into the queue, returning false if it is
+    // full or the buffer data is not stored in host memory.
+    bool QueueFrame(const Buffer& a_buffer,
+                    uint64_t a_targetMicroseconds);
+
+    // Get the number of frames queued, and the earliest target time.
+    uint32_t GetQueuedFrameCount() const;
+    uint64_t GetNextTargetMicroseconds() const;
+
+    // Copy the frame that is due by the given time into the buffer,
+    // returning false if none is, and counting any frames dropped.
+    bool DequeueFrame(Buffer& o_buffer,
+                      uint64_t a_dueMicroseconds,
+                      uint64_t& o_targetMicroseconds,
+                      uint64_t& o_framesDropped);
+
+    // Copy the frame last dequeued back into the buffer (so it can be
+    // redrawn after the buffer data was overwritten by later frames).
+    bool RestoreFrame(Buffer& o_buffer) const;
+
+private:
+    struct Frame
+    {
+        std::vector<uint8_t> data;
+        uint64_t targetMicroseconds = 0;
+    };
+
+    void CopyFrame(const Frame& a_frame, Buffer& o_buffer) const;
+    void RecycleFrame(Frame& a_frame);
+
+    // Queued frames ordered by target time, and the frame displayed.
+    std::deque<Frame> m_queuedFrames;
+    Frame m_currentFrame;
+    bool m_hasCurrentFrame = false;
+
+    // Frames whose data can be reused, to avoid reallocating it.
+    std::vector<Frame> m_freeFrames;
+
+    uint32_t m_queueSize = 0;
+    Context::LateFramePolicy m_lateFramePolicy = Context::LateFramePolicy::NONE;
+};
+
+//--------------------------------------------------------------
+inline void FrameScheduler::Configure(uint32_t a_queueSize,
+                                      Context::LateFramePolicy a_lateFramePolicy)
+{
+    m_queueSize = a_queueSize;
+    m_lateFramePolicy = a_lateFramePolicy;
+}
+
+//--------------------------------------------------------------
+inline bool FrameScheduler::QueueFrame(const Buffer& a_buffer,
+                                       uint64_t a_targetMicroseconds)
+{
+    const uint8_t* data = static_cast<const uint8_t*>(a_buffer.GetData());
+    if (m_queuedFrames.size() >= m_queueSize ||
+        a_buffer.GetInterop() != Buffer::Interop::HOST ||
+        !data)
+    {
+        return false;
+    }
+
+    Frame frame;
+    if (!m_freeFrames.empty())
+    {
+        frame = std::move(m_freeFrames.back());
+        m_freeFrames.pop_back();
+    }
+    frame.data.assign(data, data + a_buffer.GetSize());
+    frame.targetMicroseconds = a_targetMicroseconds;
+
+    // Insert the frame after any others with the same target time,
+    // so frames queued out of order are still displayed in order.
+    auto position = m_queuedFrames.begin();
+    while (position != m_queuedFrames.end() &&
+           position->targetMicroseconds <= a_targetMicroseconds)
+    {
+        ++position;
+    }
+    m_queuedFrames.insert(position, std::move(frame));
+    return true;
+}
+
+//--------------------------------------------------------------
+inline uint32_t FrameScheduler::GetQueuedFrameCount() const
+{
+    return static_cast<uint32_t>(m_queuedFrames.size());
+}
+
+//--------------------------------------------------------------
+inline uint64_t FrameScheduler::GetNextTargetMicroseconds() const
+{
+    return m_queuedFrames.empty() ? 0 : m_queuedFrames.front().targetMicroseconds;
+}
+
+//--------------------------------------------------------------
+inline bool FrameScheduler::DequeueFrame(Buffer& o_buffer,
+                                         uint64_t a_dueMicroseconds,
+                                         uint64_t& o_targetMicroseconds,
+                                         uint64_t& o_framesDropped)
+{
+    if (m_queuedFrames.empty() ||
+        m_queuedFrames.front().targetMicroseconds > a_dueMicroseconds)
+    {
+        return false;
+    }
+
+    // Frames that are late because a later frame is also due are
+    // dropped, so the display catches up to the target times (unless
+    // every frame must be presented, which then falls behind them).
+    if (m_lateFramePolicy == Context::LateFramePolicy::DROP)
+    {
+        while (m_queuedFrames.size() > 1 &&
+               m_queuedFrames[1].targetMicroseconds <= a_dueMicroseconds)
+        {
+            RecycleFrame(m_queuedFrames.front());
+            m_queuedFrames.pop_front();
+            o_framesDropped++;
+        }
+    }
+
+    // Keep the frame that is displayed so it can be restored.
+    if (m_hasCurrentFrame)
+    {
+        RecycleFrame(m_currentFrame);
+    }
+    m_currentFrame = std::move(m_queuedFrames.front());
+    m_queuedFrames.pop_front();
+    m_hasCurrentFrame = true;
+
+    CopyFrame(m_currentFrame, o_buffer);
+    o_targetMicroseconds = m_currentFrame.targetMicroseconds;
+    return true;
+}
+
+//--------------------------------------------------------------
+inline bool FrameScheduler::RestoreFrame(Buffer& o_buffer) const
+{
+    if (!m_hasCurrentFrame)
+    {
+        return false;
+    }
+
+    CopyFrame(m_currentFrame, o_buffer);
+    return true;
+}
+
+//--------------------------------------------------------------
+inline void FrameScheduler::CopyFrame(const Frame& a_frame, Buffer& o_buffer) const
+{
+    // Frames queued before the buffer was resized no longer match
+    // its layout, so the buffer is left unchanged.
+    void* data = o_buffer.GetData();
+    if (data && a_frame.data.size() == o_buffer.GetSize())
+    {
+        memcpy(data, a_frame.data.data(), a_frame.data.size());
+    }
+    o_buffer.Invalidate();
+}
+
+//--------------------------------------------------------------
+inline void FrameScheduler::RecycleFrame(Frame& a_frame)
+{
+    m_freeFrames.push_back(std::move(a_frame));
+    a_frame = Frame();
+}
+
+} // namespace Display
+} // namespace Simple
@@ -23,7 +23,7 @@ namespace DirectX
 class BufferD3D12 : public Buffer::Implementation
 {
 public:
-    BufferD3D12(const Buffer::Config& a_config, HWND a_hwnd);
+    BufferD3D12(const Buffer::Config& a_config, HWND a_hwnd, UINT a_syncInterval = 1);
     ~BufferD3D12() override;
 
     BufferD3D12(const BufferD3D12&) = delete;
@@ -38,25 +38,50 @@ protected:
     void Render(uint32_t a_displayWidth,
                 uint32_t a_displayHeight) override;
 
+    void SetViewport(const Buffer::Viewport& a_viewport) override;
+    Buffer::Viewport GetViewport() const override;
+
+    void CommitRows(uint32_t a_firstRow,
+                    uint32_t a_rowCount) override;
+
+    void FillRect(const Buffer::Rect& a_rect,
+                  const uint8_t* a_pixel) override;
+    void CopyRect(const Buffer::Rect& a_source,
+                  uint32_t a_destX,
+                  uint32_t a_destY) override;
+
+    bool StoreFlipbookFrame(uint32_t a_frame) override;
+    void SetDataReadable(bool a_readable) override;
+
     void* GetData() const override;
-    uint32_t GetSize() const override;
-    uint32_t GetPitch() const override;
+    uint64_t GetSize() const override;
+    uint64_t GetPitch() const override;
     uint32_t GetWidth() const override;
     uint32_t GetHeight() const override;
     Buffer::Format GetFormat() const override;
     Buffer::Interop GetInterop() const override;
+    Buffer::Storage GetStorage() const override;
+    Buffer::Layout GetLayout() const override;
+    Buffer::Scroll GetScroll() const override;
+    uint32_t GetFlipbookFrameCount() const override;
+    bool IsAccumulating() const override;
+    Buffer::UploadCounters GetUploadCounters() const override;
 
 private:
     Buffer::Config m_config = Buffer::Config::Invalid();
+    Buffer::Viewport m_viewport = {};
     PipelineD3D12* m_pipeline = nullptr;
     void* m_data = nullptr;
     HWND m_hwnd = nullptr;
+    UINT m_syncInterval = 1;
 };
 
 //--------------------------------------------------------------
 inline BufferD3D12::BufferD3D12(const Buffer::Config& a_config,
-                                HWND a_hwnd)
+                                HWND a_hwnd,
+                                UINT a_syncInterval)
     : m_hwnd(a_hwnd)
+    , m_syncInterval(a_syncInterval)
 {
     Create(a_config);
 }
@@ -71,8 +96,21 @@ inline BufferD3D12::~BufferD3D12()
 inline void BufferD3D12::Create(const Buffer::Config& a_config,
                                 bool a_fullScreenState)
 {
-    // Store the config.
+    // Store the config, ensuring the pitch alignment is a power of
+    // two at least that required to copy the shared buffer to the
+    // texture.
     m_config = a_config;
+    m_config.pitchAlignment = GetPowerOfTwoAlignment(m_config.pitchAlignment);
+    if (m_config.pitchAlignment < D3D12_TEXTURE_DATA_PITCH_ALIGNMENT)
+    {
+        m_config.pitchAlignment = D3D12_TEXTURE_DATA_PITCH_ALIGNMENT;
+    }
+
+    // Block-compressed buffers are stored as rows of blocks.
+    if (Buffer::BlockSize(m_config.format) > 1)
+    {
+        m_config.layout = Buffer::Layout::LINEAR;
+    }
 
     // Create the pipeline.
     assert(m_hwnd);
@@ -81,6 +119,7 @@ inline void BufferD3D12::Create(const Buffer::Config& a_config,
     m_pipeline = new PipelineD3D12(m_hwnd,
                                    &m_data,
                                    m_config,
+                                   m_syncInterval,
                                    a_fullScreenState);
 }
 
@@ -118,8 +157,81 @@ inline void BufferD3D12::Render(uint32_t a_displayWidth,
         Resize(config);
     }
 
-    // Render the pixel buffer.
-    m_pipeline->Render(a_displayWidth, a_displayHeight);
+    // Render the region of the pixel buffer in the viewport.
+    m_pipeline->Render(a_displayWidth,
+                       a_displayHeight,
+                       GetTextureRegion(m_viewport,
+                                        m_config.width,
+                                        m_config.height));
+}
+
+//--------------------------------------------------------------
+inline void BufferD3D12::SetViewport(const Buffer::Viewport& a_viewport)
+{
+    m_viewport = a_viewport;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Viewport BufferD3D12::GetViewport() const
+{
+    return m_viewport;
+}
+
+//--------------------------------------------------------------
+inline void BufferD3D12::CommitRows(uint32_t a_firstRow,
+                                    uint32_t a_rowCount)
+{
+    // Bands of rows are not uploaded separately, so the entire
+    // buffer will be uploaded when it is rendered.
+    (void)a_firstRow;
+    (void)a_rowCount;
+}
+
+//--------------------------------------------------------------
+inline void BufferD3D12::FillRect(const Buffer::Rect& a_rect,
+                                  const uint8_t* a_pixel)
+{
+    // Operations are not recorded into the command stream, so are
+    // applied to host accessible buffer data immediately instead.
+    if (m_data && m_config.interop == Buffer::Interop::HOST)
+    {
+        FillByteRanges(m_data,
+                       GetByteRanges(m_config, a_rect),
+                       a_pixel,
+                       Buffer::BytesPerPixel(m_config.format));
+    }
+}
+
+//--------------------------------------------------------------
+inline void BufferD3D12::CopyRect(const Buffer::Rect& a_source,
+                                  uint32_t a_destX,
+                                  uint32_t a_destY)
+{
+    // Operations are not recorded into the command stream, so are
+    // applied to host accessible buffer data immediately instead.
+    if (m_data && m_config.interop == Buffer::Interop::HOST)
+    {
+        std::vector<ByteRange> source;
+        std::vector<ByteRange> dest;
+        GetCopyByteRanges(m_config, a_source, a_destX, a_destY, source, dest);
+        CopyByteRanges(m_data, source, dest);
+    }
+}
+
+//--------------------------------------------------------------
+inline bool BufferD3D12::StoreFlipbookFrame(uint32_t a_frame)
+{
+    // Frames cannot be stored on the GPU, so the buffer data is
+    // always uploaded and displayed when the buffer is rendered.
+    (void)a_frame;
+    return false;
+}
+
+//--------------------------------------------------------------
+inline void BufferD3D12::SetDataReadable(bool a_readable)
+{
+    // The upload buffer stays mapped and can be read (if slowly).
+    (void)a_readable;
 }
 
 //--------------------------------------------------------------
@@ -129,15 +241,15 @@ inline void* BufferD3D12::GetData() const
 }
 
 //--------------------------------------------------------------
-inline uint32_t BufferD3D12::GetSize() const
+inline uint64_t BufferD3D12::GetSize() const
 {
-    return Buffer::MinSizeBytes(m_config);
+    return Buffer::AlignedSizeBytes(m_config);
 }
 
 //--------------------------------------------------------------
-inline uint32_t BufferD3D12::GetPitch() const
+inline uint64_t BufferD3D12::GetPitch() const
 {
-    return Buffer::MinPitchBytes(m_config);
+    return Buffer::AlignedPitchBytes(m_config);
 }
 
 //--------------------------------------------------------------
@@ -164,6 +276,42 @@ inline Buffer::Interop BufferD3D12::GetInterop() const
     return m_config.interop;
 }
 
+//--------------------------------------------------------------
+inline Buffer::Storage BufferD3D12::GetStorage() const
+{
+    return Buffer::Storage::NATIVE;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Layout BufferD3D12::GetLayout() const
+{
+    return m_config.layout;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Scroll BufferD3D12::GetScroll() const
+{
+    return Buffer::Scroll::NONE;
+}
+
+//--------------------------------------------------------------
+inline uint32_t BufferD3D12::GetFlipbookFrameCount() const
+{
+    return 0;
+}
+
+//--------------------------------------------------------------
+inline bool BufferD3D12::IsAccumulating() const
+{
+    return false;
+}
+
+//--------------------------------------------------------------
+inline Buffer::UploadCounters BufferD3D12::GetUploadCounters() const
+{
+    return Buffer::UploadCounters();
+}
+
 } // namespace DirectX
 } // namespace Display
 } // namespace Simple
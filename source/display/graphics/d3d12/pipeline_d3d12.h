@@ -38,6 +38,7 @@ public:
     PipelineD3D12(HWND a_windowHandle,
                   void** a_bufferData,
                   Cfg& a_bufferConfig,
+                  UINT a_syncInterval,
                   bool a_fullScreenState = false);
     ~PipelineD3D12();
 
@@ -45,7 +46,8 @@ public:
     PipelineD3D12& operator=(const PipelineD3D12&) = delete;
 
     void Render(uint32_t a_displayWidth,
-                uint32_t a_displayHeight);
+                uint32_t a_displayHeight,
+                const TextureRegion& a_textureRegion);
     void WaitForFrameCompletion();
 
     uint32_t GetSwapChainWidth() const;
@@ -78,12 +80,14 @@ private:
     CD3DX12_RESOURCE_BARRIER m_sharedBufferToCopySrc;
     CD3DX12_RESOURCE_BARRIER m_sharedBufferToDefault;
     D3D12_VERTEX_BUFFER_VIEW m_vertexBufferView = {};
+    TextureTiling m_textureTiling = {};
     CD3DX12_VIEWPORT m_viewport = {};
     CD3DX12_RECT m_scissorRect = {};
     UINT m_rtDescriptorSize = 0;
     HANDLE m_fenceEvent = {};
     UINT64 m_fenceValue = 0;
     UINT m_frameIndex = 0;
+    UINT m_syncInterval = 1;
 };
 
 //--------------------------------------------------------------
@@ -107,7 +111,9 @@ inline bool DoesAdapterSupportsD3D12(IDXGIAdapter1* adapter)
 inline PipelineD3D12::PipelineD3D12(HWND a_windowHandle,
                                     void** a_bufferData,
                                     Cfg& a_bufferConfig,
+                                    UINT a_syncInterval,
                                     bool a_fullScreenState)
+    : m_syncInterval(a_syncInterval)
 {
     UINT factoryFlags = 0;
 #if !defined(NDEBUG)
@@ -237,9 +243,11 @@ inline PipelineD3D12::PipelineD3D12(HWND a_windowHandle,
         CD3DX12_DESCRIPTOR_RANGE1 ranges[1];
         ranges[0].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 0,
                        D3D12_DESCRIPTOR_RANGE_FLAG_DATA_VOLATILE);
-        CD3DX12_ROOT_PARAMETER1 rootParams[1];
+        CD3DX12_ROOT_PARAMETER1 rootParams[2];
         rootParams[0].InitAsDescriptorTable(1, &ranges[0],
                                             D3D12_SHADER_VISIBILITY_PIXEL);
+        rootParams[1].InitAsConstants((sizeof(TextureRegion) + sizeof(TextureTiling)) / sizeof(uint32_t), 0, 0,
+                                      D3D12_SHADER_VISIBILITY_PIXEL);
 
         D3D12_STATIC_SAMPLER_DESC sampler = {};
         sampler.Filter = D3D12_FILTER_MIN_MAG_MIP_POINT;
@@ -288,6 +296,22 @@ inline PipelineD3D12::PipelineD3D12(HWND a_windowHandle,
             Texture2D g_texture : register(t0);
             SamplerState g_sampler : register(s0);
 
+            cbuffer Tiling : register(b0)
+            {
+                float4 g_region;
+                uint2 g_extent;
+                uint g_rowLength;
+                uint g_tileSize;
+                uint g_morton;
+            };
+
+            uint SpreadBits(uint v)
+            {
+                v = (v | (v << 2)) & 0x33;
+                v = (v | (v << 1)) & 0x55;
+                return v;
+            }
+
             PSInput VSMain(float4 pos : POSITION,
                            float4 uv : TEXCOORD)
             {
@@ -299,7 +323,27 @@ inline PipelineD3D12::PipelineD3D12(HWND a_windowHandle,
 
             float4 PSMain(PSInput input) : SV_TARGET
             {
-                return g_texture.Sample(g_sampler, input.uv);
+                // Map the display to the region of the texture,
+                // which is black anywhere outside of the texture.
+                float2 uv = g_region.xy + (input.uv.xy * g_region.zw);
+                if (any(uv < 0.0) || any(uv >= 1.0))
+                {
+                    return float4(0.0, 0.0, 0.0, 1.0);
+                }
+
+                if (g_tileSize <= 1)
+                {
+                    return g_texture.Sample(g_sampler, uv);
+                }
+
+                // Find the index of the pixel in the tiled data.
+                uint2 xy = min(uint2(uv * float2(g_extent)), g_extent - 1);
+                uint2 t = xy % g_tileSize;
+                uint i = ((xy.y / g_tileSize) * g_rowLength * g_tileSize) +
+                         ((xy.x / g_tileSize) * g_tileSize * g_tileSize) +
+                         ((g_morton != 0) ? (SpreadBits(t.x) | (SpreadBits(t.y) << 1)) :
+                                            ((t.y * g_tileSize) + t.x));
+                return g_texture.Load(int3(i % g_rowLength, i / g_rowLength, 0));
             }
         )";
 
@@ -425,17 +469,49 @@ inline PipelineD3D12::PipelineD3D12(HWND a_windowHandle,
             shaderFormat = DXGI_FORMAT_R16G16B16A16_UNORM;
         }
         break;
+        case Buffer::Format::RGB10A2_UNORM:
+        {
+            bufferFormat = DXGI_FORMAT_R10G10B10A2_UINT;
+            shaderFormat = DXGI_FORMAT_R10G10B10A2_UNORM;
+        }
+        break;
+        case Buffer::Format::BC1_UNORM:
+        {
+            bufferFormat = DXGI_FORMAT_BC1_UNORM;
+            shaderFormat = DXGI_FORMAT_BC1_UNORM;
+        }
+        break;
+        case Buffer::Format::BC3_UNORM:
+        {
+            bufferFormat = DXGI_FORMAT_BC3_UNORM;
+            shaderFormat = DXGI_FORMAT_BC3_UNORM;
+        }
+        break;
+        case Buffer::Format::BC7_UNORM:
+        {
+            bufferFormat = DXGI_FORMAT_BC7_UNORM;
+            shaderFormat = DXGI_FORMAT_BC7_UNORM;
+        }
+        break;
     }
     assert(bufferFormat != DXGI_FORMAT_UNKNOWN);
     assert(shaderFormat != DXGI_FORMAT_UNKNOWN);
 
-    // Create the texture.
+    // Block-compressed textures must be a whole number of blocks,
+    // so any partial blocks at the edges are included in full.
+    const uint32_t blockSize = Buffer::BlockSize(a_bufferConfig.format);
+    const uint32_t textureWidth = ((GetTextureWidth(a_bufferConfig) + blockSize - 1) / blockSize) * blockSize;
+    const uint32_t textureHeight = ((GetTextureHeight(a_bufferConfig) + blockSize - 1) / blockSize) * blockSize;
+
+    // Create the texture, which for tiled layouts stores the
+    // pixels as laid out in the shared buffer, along with the
+    // values needed by the pixel shader to de-tile them.
     {
         // Describe and create the Texture2D.
         D3D12_RESOURCE_DESC textureDesc = {};
         textureDesc.Format = bufferFormat;
-        textureDesc.Width = a_bufferConfig.width;
-        textureDesc.Height = a_bufferConfig.height;
+        textureDesc.Width = textureWidth;
+        textureDesc.Height = textureHeight;
         textureDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
         textureDesc.MipLevels = 1;
         textureDesc.DepthOrArraySize = 1;
@@ -449,6 +525,7 @@ inline PipelineD3D12::PipelineD3D12(HWND a_windowHandle,
                                                        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
                                                        nullptr,
                                                        IID_PPV_ARGS(&m_textureBuffer)));
+        m_textureTiling = GetTextureTiling(a_bufferConfig);
 
         // Create the texture buffer copy destination and resource transitions.
         m_textureBufferCopyDest = CD3DX12_TEXTURE_COPY_LOCATION(m_textureBuffer.Get());
@@ -463,7 +540,7 @@ inline PipelineD3D12::PipelineD3D12(HWND a_windowHandle,
     // Create the shared buffer.
     {
         // Create the appropriate interop to map the shared buffer.
-        const UINT64 bufferSize = Buffer::MinSizeBytes(a_bufferConfig);
+        const UINT64 bufferSize = Buffer::AlignedSizeBytes(a_bufferConfig);
         D3D12_RESOURCE_STATES sharedBufferDefaultResourceState = D3D12_RESOURCE_STATE_COMMON;
         if (a_bufferConfig.interop == Buffer::Interop::HOST)
         {
@@ -489,10 +566,10 @@ inline PipelineD3D12::PipelineD3D12(HWND a_windowHandle,
         D3D12_PLACED_SUBRESOURCE_FOOTPRINT subresourceFootprint;
         subresourceFootprint.Offset = 0;
         subresourceFootprint.Footprint.Format = bufferFormat;
-        subresourceFootprint.Footprint.Width = a_bufferConfig.width;
-        subresourceFootprint.Footprint.Height = a_bufferConfig.height;
+        subresourceFootprint.Footprint.Width = textureWidth;
+        subresourceFootprint.Footprint.Height = textureHeight;
         subresourceFootprint.Footprint.Depth = 1;
-        subresourceFootprint.Footprint.RowPitch = Buffer::MinPitchBytes(a_bufferConfig);
+        subresourceFootprint.Footprint.RowPitch = static_cast<UINT>(Buffer::AlignedPitchBytes(a_bufferConfig));
         m_sharedBufferCopySrc = CD3DX12_TEXTURE_COPY_LOCATION(m_sharedBuffer.Get(),
                                                               subresourceFootprint);
         m_sharedBufferToCopySrc = CD3DX12_RESOURCE_BARRIER::Transition(m_sharedBuffer.Get(),
@@ -562,7 +639,8 @@ inline PipelineD3D12::~PipelineD3D12()
 
 //--------------------------------------------------------------
 inline void PipelineD3D12::Render(uint32_t a_displayWidth,
-                                  uint32_t a_displayHeight)
+                                  uint32_t a_displayHeight,
+                                  const TextureRegion& a_textureRegion)
 {
     // Record all the commands needed to render the buffer.
     {
@@ -576,6 +654,9 @@ inline void PipelineD3D12::Render(uint32_t a_displayWidth,
         ID3D12DescriptorHeap* ppHeaps[] = { m_shaderResourceHeap.Get() };
         m_commandList->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
         m_commandList->SetGraphicsRootDescriptorTable(0, m_shaderResourceHeap->GetGPUDescriptorHandleForHeapStart());
+        m_commandList->SetGraphicsRoot32BitConstants(1, sizeof(TextureRegion) / sizeof(uint32_t), &a_textureRegion, 0);
+        m_commandList->SetGraphicsRoot32BitConstants(1, sizeof(TextureTiling) / sizeof(uint32_t), &m_textureTiling,
+                                                     sizeof(TextureRegion) / sizeof(uint32_t));
 
         // Set the viewport and scissor rect.
         (void)a_displayWidth;
@@ -616,7 +697,7 @@ inline void PipelineD3D12::Render(uint32_t a_displayWidth,
     m_commandQueue->ExecuteCommandLists(_countof(ppCommandLists), ppCommandLists);
 
     // Present the frame.
-    D3D12_ENSURE(m_swapChain->Present(1, 0));
+    D3D12_ENSURE(m_swapChain->Present(m_syncInterval, 0));
 
     // Wait for the frame to complete.
     WaitForFrameCompletion();
@@ -38,20 +38,42 @@ protected:
     void Render(uint32_t a_displayWidth,
                 uint32_t a_displayHeight) override;
 
+    void SetViewport(const Buffer::Viewport& a_viewport) override;
+    Buffer::Viewport GetViewport() const override;
+
+    void CommitRows(uint32_t a_firstRow,
+                    uint32_t a_rowCount) override;
+
+    void FillRect(const Buffer::Rect& a_rect,
+                  const uint8_t* a_pixel) override;
+    void CopyRect(const Buffer::Rect& a_source,
+                  uint32_t a_destX,
+                  uint32_t a_destY) override;
+
+    bool StoreFlipbookFrame(uint32_t a_frame) override;
+    void SetDataReadable(bool a_readable) override;
+
     void* GetData() const override;
-    uint32_t GetSize() const override;
-    uint32_t GetPitch() const override;
+    uint64_t GetSize() const override;
+    uint64_t GetPitch() const override;
     uint32_t GetWidth() const override;
     uint32_t GetHeight() const override;
     Buffer::Format GetFormat() const override;
     Buffer::Interop GetInterop() const override;
+    Buffer::Storage GetStorage() const override;
+    Buffer::Layout GetLayout() const override;
+    Buffer::Scroll GetScroll() const override;
+    uint32_t GetFlipbookFrameCount() const override;
+    bool IsAccumulating() const override;
+    Buffer::UploadCounters GetUploadCounters() const override;
 
 private:
     Buffer::Config m_config = Buffer::Config::Invalid();
+    Buffer::Viewport m_viewport = {};
     PipelineMT* m_pipeline = nullptr;
     MTKView* m_metalView = nullptr;
-    uint32_t m_alignedPitch = 0;
-    uint32_t m_alignedSize = 0;
+    uint64_t m_alignedPitch = 0;
+    uint64_t m_alignedSize = 0;
     void* m_data = nullptr;
 };
 
@@ -77,6 +99,10 @@ constexpr MTLPixelFormat GetMetalPixelFormat(const Buffer::Format& a_format)
         case Buffer::Format::RGBA_FLOAT: return MTLPixelFormatRGBA32Float;
         case Buffer::Format::RGBA_UINT8: return MTLPixelFormatRGBA8Unorm;
         case Buffer::Format::RGBA_UINT16: return MTLPixelFormatRGBA16Unorm;
+        case Buffer::Format::RGB10A2_UNORM: return MTLPixelFormatRGB10A2Unorm;
+        case Buffer::Format::BC1_UNORM: return MTLPixelFormatBC1_RGBA;
+        case Buffer::Format::BC3_UNORM: return MTLPixelFormatBC3_RGBA;
+        case Buffer::Format::BC7_UNORM: return MTLPixelFormatBC7_RGBAUnorm;
         default: return MTLPixelFormatInvalid;
     }
 }
@@ -86,8 +112,16 @@ inline void BufferMT::Create(const Buffer::Config& a_config)
 {
     assert(m_metalView);
 
-    // Store the config.
+    // Store the config, rounding the pitch alignment up to a power
+    // of two.
     m_config = a_config;
+    m_config.pitchAlignment = GetPowerOfTwoAlignment(m_config.pitchAlignment);
+
+    // Block-compressed buffers are stored as rows of blocks.
+    if (Buffer::BlockSize(m_config.format) > 1)
+    {
+        m_config.layout = Buffer::Layout::LINEAR;
+    }
 
     // Get the Metal pixel format.
     MTLPixelFormat format = GetMetalPixelFormat(m_config.format);
@@ -96,15 +130,16 @@ inline void BufferMT::Create(const Buffer::Config& a_config)
     // Create the pipeline.
     assert(!m_data);
     assert(!m_pipeline);
-    m_alignedPitch = Buffer::MinPitchBytes(m_config);
-    m_alignedSize = Buffer::MinSizeBytes(m_config);
+    m_alignedPitch = Buffer::AlignedPitchBytes(m_config);
+    m_alignedSize = Buffer::AlignedSizeBytes(m_config);
     m_pipeline = new PipelineMT(m_metalView,
                                 m_data,
                                 m_config.width,
                                 m_config.height,
                                 m_alignedPitch,
                                 m_alignedSize,
-                                format);
+                                format,
+                                GetTextureTiling(m_config));
 }
 
 //--------------------------------------------------------------
@@ -131,8 +166,81 @@ inline void BufferMT::Resize(const Buffer::Config& a_config)
 inline void BufferMT::Render(uint32_t a_displayWidth,
                              uint32_t a_displayHeight)
 {
-    // Render the pixel buffer.
-    m_pipeline->Render(a_displayWidth, a_displayHeight);
+    // Render the region of the pixel buffer in the viewport.
+    m_pipeline->Render(a_displayWidth,
+                       a_displayHeight,
+                       GetTextureRegion(m_viewport,
+                                        m_config.width,
+                                        m_config.height));
+}
+
+//--------------------------------------------------------------
+inline void BufferMT::SetViewport(const Buffer::Viewport& a_viewport)
+{
+    m_viewport = a_viewport;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Viewport BufferMT::GetViewport() const
+{
+    return m_viewport;
+}
+
+//--------------------------------------------------------------
+inline void BufferMT::CommitRows(uint32_t a_firstRow,
+                                 uint32_t a_rowCount)
+{
+    // Bands of rows are not uploaded separately, so the entire
+    // buffer will be uploaded when it is rendered.
+    (void)a_firstRow;
+    (void)a_rowCount;
+}
+
+//--------------------------------------------------------------
+inline void BufferMT::FillRect(const Buffer::Rect& a_rect,
+                               const uint8_t* a_pixel)
+{
+    // Operations are not recorded into the command stream, so are
+    // applied to host accessible buffer data immediately instead.
+    if (m_data && m_config.interop == Buffer::Interop::HOST)
+    {
+        FillByteRanges(m_data,
+                       GetByteRanges(m_config, a_rect),
+                       a_pixel,
+                       Buffer::BytesPerPixel(m_config.format));
+    }
+}
+
+//--------------------------------------------------------------
+inline void BufferMT::CopyRect(const Buffer::Rect& a_source,
+                               uint32_t a_destX,
+                               uint32_t a_destY)
+{
+    // Operations are not recorded into the command stream, so are
+    // applied to host accessible buffer data immediately instead.
+    if (m_data && m_config.interop == Buffer::Interop::HOST)
+    {
+        std::vector<ByteRange> source;
+        std::vector<ByteRange> dest;
+        GetCopyByteRanges(m_config, a_source, a_destX, a_destY, source, dest);
+        CopyByteRanges(m_data, source, dest);
+    }
+}
+
+//--------------------------------------------------------------
+inline bool BufferMT::StoreFlipbookFrame(uint32_t a_frame)
+{
+    // Frames cannot be stored on the GPU, so the buffer data is
+    // always uploaded and displayed when the buffer is rendered.
+    (void)a_frame;
+    return false;
+}
+
+//--------------------------------------------------------------
+inline void BufferMT::SetDataReadable(bool a_readable)
+{
+    // The shared buffer is accessible by the CPU, so is readable.
+    (void)a_readable;
 }
 
 //--------------------------------------------------------------
@@ -142,13 +250,13 @@ inline void* BufferMT::GetData() const
 }
 
 //--------------------------------------------------------------
-inline uint32_t BufferMT::GetSize() const
+inline uint64_t BufferMT::GetSize() const
 {
     return m_alignedSize;
 }
 
 //--------------------------------------------------------------
-inline uint32_t BufferMT::GetPitch() const
+inline uint64_t BufferMT::GetPitch() const
 {
     return m_alignedPitch;
 }
@@ -177,6 +285,42 @@ inline Buffer::Interop BufferMT::GetInterop() const
     return m_config.interop;
 }
 
+//--------------------------------------------------------------
+inline Buffer::Storage BufferMT::GetStorage() const
+{
+    return Buffer::Storage::NATIVE;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Layout BufferMT::GetLayout() const
+{
+    return m_config.layout;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Scroll BufferMT::GetScroll() const
+{
+    return Buffer::Scroll::NONE;
+}
+
+//--------------------------------------------------------------
+inline uint32_t BufferMT::GetFlipbookFrameCount() const
+{
+    return 0;
+}
+
+//--------------------------------------------------------------
+inline bool BufferMT::IsAccumulating() const
+{
+    return false;
+}
+
+//--------------------------------------------------------------
+inline Buffer::UploadCounters BufferMT::GetUploadCounters() const
+{
+    return Buffer::UploadCounters();
+}
+
 } // namespace Metal
 } // namespace Display
 } // namespace Simple
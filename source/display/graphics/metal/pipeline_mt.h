@@ -28,16 +28,18 @@ public:
                void*& a_bufferData,
                uint32_t a_bufferWidth,
                uint32_t a_bufferHeight,
-               uint32_t& o_bufferRowPitch,
-               uint32_t& o_bufferSizeBytes,
-               MTLPixelFormat a_bufferFormat);
+               uint64_t& o_bufferRowPitch,
+               uint64_t& o_bufferSizeBytes,
+               MTLPixelFormat a_bufferFormat,
+               const TextureTiling& a_bufferTiling);
     ~PipelineMT();
 
     PipelineMT(const PipelineMT&) = delete;
     PipelineMT& operator=(const PipelineMT&) = delete;
 
     void Render(uint32_t a_displayWidth,
-                uint32_t a_displayHeight);
+                uint32_t a_displayHeight,
+                const TextureRegion& a_textureRegion);
 
 private:
     MTKView* m_metalView;
@@ -47,19 +49,32 @@ private:
 
     id<MTLTexture> m_texture;
     id<MTLBuffer> m_textureBuffer;
+    uint64_t m_compressedRowPitch = 0;
 
     id<MTLBuffer> m_vertexBuffer;
     uint32_t m_numVertices;
+
+    TextureTiling m_textureTiling;
 };
 
+//--------------------------------------------------------------
+inline bool IsBlockCompressed(MTLPixelFormat a_format)
+{
+    return a_format == MTLPixelFormatBC1_RGBA ||
+           a_format == MTLPixelFormatBC3_RGBA ||
+           a_format == MTLPixelFormatBC7_RGBAUnorm;
+}
+
 //--------------------------------------------------------------
 inline PipelineMT::PipelineMT(MTKView* a_mtkView,
                               void*& a_bufferData,
                               uint32_t a_bufferWidth,
                               uint32_t a_bufferHeight,
-                              uint32_t& o_bufferRowPitch,
-                              uint32_t& o_bufferSizeBytes,
-                              MTLPixelFormat a_bufferFormat)
+                              uint64_t& o_bufferRowPitch,
+                              uint64_t& o_bufferSizeBytes,
+                              MTLPixelFormat a_bufferFormat,
+                              const TextureTiling& a_bufferTiling)
+    : m_textureTiling(a_bufferTiling)
 {
     // Store the metal view.
     m_metalView = a_mtkView;
@@ -69,13 +84,31 @@ inline PipelineMT::PipelineMT(MTKView* a_mtkView,
     id<MTLDevice> device = m_metalView.device;
     assert(device);
 
-    // Align the buffer row pitch if necessary.
-    NSUInteger minAlignment = [device minimumLinearTextureAlignmentForPixelFormat: a_bufferFormat];
-    NSUInteger remainder = o_bufferRowPitch % minAlignment;
-    if (remainder)
+    // Block-compressed textures cannot be created from a buffer,
+    // so are created separately and replaced from it each frame.
+    const bool compressed = IsBlockCompressed(a_bufferFormat);
+
+    // Align the buffer row pitch if necessary, keeping the number
+    // of rows (which are padded to whole tiles if tiled) the same.
+    const bool tiled = (m_textureTiling.tileSize > 1);
+    const uint64_t bufferRows = o_bufferSizeBytes / o_bufferRowPitch;
+    const uint64_t bytesPerPixel = o_bufferRowPitch / m_textureTiling.rowLength;
+    if (!compressed)
+    {
+        NSUInteger minAlignment = [device minimumLinearTextureAlignmentForPixelFormat: a_bufferFormat];
+        NSUInteger remainder = o_bufferRowPitch % minAlignment;
+        if (remainder)
+        {
+            o_bufferRowPitch += (minAlignment - remainder);
+            o_bufferSizeBytes = o_bufferRowPitch * bufferRows;
+        }
+    }
+
+    // Tiled pixels are stored in the texture as they are laid out
+    // in the buffer, so the texture width is the pitch in pixels.
+    if (tiled)
     {
-        o_bufferRowPitch += (minAlignment - remainder);
-        o_bufferSizeBytes = o_bufferRowPitch * a_bufferHeight;
+        m_textureTiling.rowLength = static_cast<uint32_t>(o_bufferRowPitch / bytesPerPixel);
     }
 
     // Create the texture buffer.
@@ -89,15 +122,27 @@ inline PipelineMT::PipelineMT(MTKView* a_mtkView,
     // Describe the texture.
     MTLTextureDescriptor* textureDescriptor = [[MTLTextureDescriptor alloc] init];
     textureDescriptor.pixelFormat = a_bufferFormat;
-    textureDescriptor.width = a_bufferWidth;
-    textureDescriptor.height = a_bufferHeight;
+    textureDescriptor.width = tiled ? m_textureTiling.rowLength : a_bufferWidth;
+    textureDescriptor.height = tiled ? bufferRows : a_bufferHeight;
     textureDescriptor.textureType = MTLTextureType2D;
     textureDescriptor.resourceOptions = MTLResourceStorageModeShared;
 
-    // Create the texture.
-    m_texture = [m_textureBuffer newTextureWithDescriptor: textureDescriptor
-                                                   offset: 0
-                                              bytesPerRow: o_bufferRowPitch];
+    // Create the texture, rounding compressed textures up to whole
+    // blocks, which are the rows of blocks stored in the buffer.
+    if (compressed)
+    {
+        textureDescriptor.width = ((a_bufferWidth + 3) / 4) * 4;
+        textureDescriptor.height = ((a_bufferHeight + 3) / 4) * 4;
+        textureDescriptor.resourceOptions = MTLResourceStorageModeManaged;
+        m_texture = [device newTextureWithDescriptor: textureDescriptor];
+        m_compressedRowPitch = o_bufferRowPitch;
+    }
+    else
+    {
+        m_texture = [m_textureBuffer newTextureWithDescriptor: textureDescriptor
+                                                       offset: 0
+                                                  bytesPerRow: o_bufferRowPitch];
+    }
 
     // Define vertices to render a quad over the entire display.
     struct Vertex { vector_float2 pos, uv; };
@@ -139,6 +184,27 @@ inline PipelineMT::PipelineMT(MTKView* a_mtkView,
 
         };
 
+        struct Region
+        {
+            float2 offset;
+            float2 scale;
+        };
+
+        struct Tiling
+        {
+            uint2 extent;
+            uint rowLength;
+            uint tileSize;
+            uint morton;
+        };
+
+        uint SpreadBits(uint v)
+        {
+            v = (v | (v << 2)) & 0x33;
+            v = (v | (v << 1)) & 0x55;
+            return v;
+        }
+
         vertex VertexData
         vertexShader(uint vertexID [[ vertex_id ]],
                      constant Vertex* vertexArray [[ buffer(0) ]])
@@ -153,11 +219,33 @@ inline PipelineMT::PipelineMT(MTKView* a_mtkView,
 
         fragment float4
         fragmentShader(VertexData in [[stage_in]],
-                       texture2d<half> colorTexture [[ texture(0) ]])
+                       texture2d<half> colorTexture [[ texture(0) ]],
+                       constant Tiling& tiling [[ buffer(0) ]],
+                       constant Region& region [[ buffer(1) ]])
         {
-            constexpr sampler textureSampler (mag_filter::linear,
-                                              min_filter::linear);
-            return float4(colorTexture.sample(textureSampler, in.textureUV));
+            // Map the display to the region of the texture,
+            // which is black anywhere outside of the texture.
+            float2 uv = region.offset + (in.textureUV * region.scale);
+            if (any(uv < 0.0) || any(uv >= 1.0))
+            {
+                return float4(0.0, 0.0, 0.0, 1.0);
+            }
+
+            if (tiling.tileSize <= 1)
+            {
+                constexpr sampler textureSampler (mag_filter::linear,
+                                                  min_filter::linear);
+                return float4(colorTexture.sample(textureSampler, uv));
+            }
+
+            // Find the index of the pixel in the tiled data.
+            uint2 xy = min(uint2(uv * float2(tiling.extent)), tiling.extent - 1);
+            uint2 t = xy % tiling.tileSize;
+            uint i = ((xy.y / tiling.tileSize) * tiling.rowLength * tiling.tileSize) +
+                     ((xy.x / tiling.tileSize) * tiling.tileSize * tiling.tileSize) +
+                     ((tiling.morton != 0) ? (SpreadBits(t.x) | (SpreadBits(t.y) << 1)) :
+                                             ((t.y * tiling.tileSize) + t.x));
+            return float4(colorTexture.read(uint2(i % tiling.rowLength, i / tiling.rowLength)));
         }
     )";
 
@@ -219,11 +307,21 @@ inline PipelineMT::~PipelineMT()
 
 //--------------------------------------------------------------
 inline void PipelineMT::Render(uint32_t a_displayWidth,
-                               uint32_t a_displayHeight)
+                               uint32_t a_displayHeight,
+                               const TextureRegion& a_textureRegion)
 {
     (void)a_displayWidth;
     (void)a_displayHeight;
 
+    // Copy any compressed blocks from the buffer to the texture.
+    if (m_compressedRowPitch)
+    {
+        [m_texture replaceRegion: MTLRegionMake2D(0, 0, m_texture.width, m_texture.height)
+                     mipmapLevel: 0
+                       withBytes: m_textureBuffer.contents
+                     bytesPerRow: m_compressedRowPitch];
+    }
+
     // Create a new command buffer for each render pass.
     id<MTLCommandBuffer> commandBuffer = [m_commandQueue commandBuffer];
     commandBuffer.label = @"SimpleDisplayRenderCommandBuffer";
@@ -244,9 +342,16 @@ inline void PipelineMT::Render(uint32_t a_displayWidth,
                                 offset: 0
                                atIndex: 0];
 
-        // Set the texture.
+        // Set the texture and the values used to de-tile it, then
+        // the region of it that is to be mapped to the display.
         [renderEncoder setFragmentTexture: m_texture
                                   atIndex: 0];
+        [renderEncoder setFragmentBytes: &m_textureTiling
+                                 length: sizeof(m_textureTiling)
+                                atIndex: 0];
+        [renderEncoder setFragmentBytes: &a_textureRegion
+                                 length: sizeof(a_textureRegion)
+                                atIndex: 1];
 
         // Draw the vertices.
         [renderEncoder drawPrimitives: MTLPrimitiveTypeTriangle
@@ -9,6 +9,22 @@
 #pragma once
 
 #include <display/buffer_implementation.h>
+#include <display/change_detector.h>
+
+#include <cstring>
+
+// Block-compressed formats provided by extensions that are not
+// included in every generated OpenGL header (S3TC is supported
+// by all desktop drivers, BPTC is core from OpenGL 4.2).
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif // GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif // GL_COMPRESSED_RGBA_BPTC_UNORM
 
 //--------------------------------------------------------------
 namespace Simple
@@ -29,19 +45,53 @@ public:
     BufferGL& operator=(const BufferGL&) = delete;
 
 protected:
+    void SetViewport(const Buffer::Viewport& a_viewport) override;
+    Buffer::Viewport GetViewport() const override;
+
+    void SetDataReadable(bool a_readable) override;
+
     void* GetData() const override;
-    uint32_t GetSize() const override;
-    uint32_t GetPitch() const override;
+    uint64_t GetSize() const override;
+    uint64_t GetPitch() const override;
     uint32_t GetWidth() const override;
     uint32_t GetHeight() const override;
     Buffer::Format GetFormat() const override;
     Buffer::Interop GetInterop() const override;
+    Buffer::Storage GetStorage() const override;
+    Buffer::Layout GetLayout() const override;
+    Buffer::Scroll GetScroll() const override;
+    uint32_t GetFlipbookFrameCount() const override;
+    bool IsAccumulating() const override;
+    Buffer::UploadCounters GetUploadCounters() const override;
 
 protected:
     Buffer::Config m_config = Buffer::Config::Invalid();
+    Buffer::Storage m_storage = Buffer::Storage::NATIVE;
+    Buffer::Viewport m_viewport = {};
+    ChangeDetector m_changeDetector;
     void* m_data = nullptr;
 };
 
+//--------------------------------------------------------------
+inline void BufferGL::SetViewport(const Buffer::Viewport& a_viewport)
+{
+    m_viewport = a_viewport;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Viewport BufferGL::GetViewport() const
+{
+    return m_viewport;
+}
+
+//--------------------------------------------------------------
+inline void BufferGL::SetDataReadable(bool a_readable)
+{
+    // The buffer data is stored in host memory, so is always readable
+    // (pixel buffers that are mapped override this, see BufferGLCore).
+    (void)a_readable;
+}
+
 //--------------------------------------------------------------
 inline void* BufferGL::GetData() const
 {
@@ -49,15 +99,15 @@ inline void* BufferGL::GetData() const
 }
 
 //--------------------------------------------------------------
-inline uint32_t BufferGL::GetSize() const
+inline uint64_t BufferGL::GetSize() const
 {
-    return Buffer::MinSizeBytes(m_config);
+    return Buffer::AlignedSizeBytes(m_config);
 }
 
 //--------------------------------------------------------------
-inline uint32_t BufferGL::GetPitch() const
+inline uint64_t BufferGL::GetPitch() const
 {
-    return Buffer::MinPitchBytes(m_config);
+    return Buffer::AlignedPitchBytes(m_config);
 }
 
 //--------------------------------------------------------------
@@ -84,6 +134,42 @@ inline Buffer::Interop BufferGL::GetInterop() const
     return m_config.interop;
 }
 
+//--------------------------------------------------------------
+inline Buffer::Storage BufferGL::GetStorage() const
+{
+    return m_storage;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Layout BufferGL::GetLayout() const
+{
+    return m_config.layout;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Scroll BufferGL::GetScroll() const
+{
+    return m_config.scroll;
+}
+
+//--------------------------------------------------------------
+inline uint32_t BufferGL::GetFlipbookFrameCount() const
+{
+    return m_config.flipbookFrames;
+}
+
+//--------------------------------------------------------------
+inline bool BufferGL::IsAccumulating() const
+{
+    return m_config.accumulate;
+}
+
+//--------------------------------------------------------------
+inline Buffer::UploadCounters BufferGL::GetUploadCounters() const
+{
+    return m_changeDetector.GetCounters();
+}
+
 //--------------------------------------------------------------
 constexpr GLenum GetGLPixelDataType(Buffer::Format a_format)
 {
@@ -92,6 +178,7 @@ constexpr GLenum GetGLPixelDataType(Buffer::Format a_format)
         case Buffer::Format::RGBA_FLOAT: return GL_FLOAT;
         case Buffer::Format::RGBA_UINT8: return GL_UNSIGNED_BYTE;
         case Buffer::Format::RGBA_UINT16: return GL_UNSIGNED_SHORT;
+        case Buffer::Format::RGB10A2_UNORM: return GL_UNSIGNED_INT_2_10_10_10_REV;
         default: return 0;
     }
 }
@@ -104,6 +191,7 @@ constexpr GLenum GetGLPixelDataFormat(Buffer::Format a_format)
         case Buffer::Format::RGBA_FLOAT: return GL_RGBA;
         case Buffer::Format::RGBA_UINT8: return GL_RGBA;
         case Buffer::Format::RGBA_UINT16: return GL_RGBA;
+        case Buffer::Format::RGB10A2_UNORM: return GL_RGBA;
         default: return 0;
     }
 }
@@ -116,10 +204,104 @@ constexpr GLint GetGLInternalPixelFormat(Buffer::Format a_format)
         case Buffer::Format::RGBA_FLOAT: return GL_RGBA32F;
         case Buffer::Format::RGBA_UINT8: return GL_RGBA8;
         case Buffer::Format::RGBA_UINT16: return GL_RGBA16;
+        case Buffer::Format::RGB10A2_UNORM: return GL_RGB10_A2;
+        case Buffer::Format::BC1_UNORM: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case Buffer::Format::BC3_UNORM: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case Buffer::Format::BC7_UNORM: return GL_COMPRESSED_RGBA_BPTC_UNORM;
         default: return 0;
     }
 }
 
+//--------------------------------------------------------------
+constexpr GLint GetGLUnpackRowLength(const Buffer::Config& a_config)
+{
+    // Measured in pixels, so the aligned pitch must be a multiple
+    // of the pixel size, which holds for power of two alignments.
+    return Buffer::BytesPerPixel(a_config.format) ?
+           static_cast<GLint>(Buffer::AlignedPitchBytes(a_config) /
+                              Buffer::BytesPerPixel(a_config.format)) : 0;
+}
+
+//--------------------------------------------------------------
+constexpr GLint GetGLUnpackAlignment(const Buffer::Config& a_config)
+{
+    // The largest alignment supported by GL that the aligned pitch is
+    // a multiple of, so rows are read from the start of each pitch
+    // (the default of four would skip padding that is not there).
+    return (Buffer::AlignedPitchBytes(a_config) % 8 == 0) ? 8 :
+           (Buffer::AlignedPitchBytes(a_config) % 4 == 0) ? 4 :
+           (Buffer::AlignedPitchBytes(a_config) % 2 == 0) ? 2 : 1;
+}
+
+//--------------------------------------------------------------
+constexpr GLint GetGLInternalPixelFormat(Buffer::Storage a_storage)
+{
+    switch (a_storage)
+    {
+        case Buffer::Storage::RGBA_HALF: return GL_RGBA16F;
+        case Buffer::Storage::R11G11B10_FLOAT: return GL_R11F_G11F_B10F;
+        default: return 0;
+    }
+}
+
+//--------------------------------------------------------------
+inline bool SupportsGLExtension(const char* a_extension)
+{
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    for (GLint i = 0; i < extensionCount; ++i)
+    {
+        const GLubyte* extension = glGetStringi(GL_EXTENSIONS, i);
+        if (extension && strcmp((const char*)extension, a_extension) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//--------------------------------------------------------------
+inline GLint GetGLAvailableMemoryKB()
+{
+    // Free memory can only be queried using vendor extensions,
+    // so return zero (ie. unknown) if neither are supported.
+    constexpr GLenum GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX = 0x9049;
+    constexpr GLenum GL_TEXTURE_FREE_MEMORY_ATI = 0x87FC;
+    GLint availableMemoryKB[4] = {};
+    if (SupportsGLExtension("GL_NVX_gpu_memory_info"))
+    {
+        glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX,
+                      availableMemoryKB);
+    }
+    else if (SupportsGLExtension("GL_ATI_meminfo"))
+    {
+        glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI,
+                      availableMemoryKB);
+    }
+    return availableMemoryKB[0];
+}
+
+//--------------------------------------------------------------
+inline Buffer::Storage SelectGLStorage(const Buffer::Config& a_config)
+{
+    // Compact storage only applies to float buffers.
+    if (a_config.format != Buffer::Format::RGBA_FLOAT)
+    {
+        return Buffer::Storage::NATIVE;
+    }
+
+    // Use compact storage if free memory is known to be low.
+    if (a_config.storage == Buffer::Storage::AUTO)
+    {
+        constexpr GLint thresholdKB = BUFFER_STORAGE_AUTO_THRESHOLD_MB * 1024;
+        const GLint availableMemoryKB = GetGLAvailableMemoryKB();
+        return (availableMemoryKB > 0 && availableMemoryKB < thresholdKB) ?
+                Buffer::Storage::RGBA_HALF : Buffer::Storage::NATIVE;
+    }
+
+    return a_config.storage;
+}
+
 } // namespace OpenGL
 } // namespace Display
 } // namespace Simple
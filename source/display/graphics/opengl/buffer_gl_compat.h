@@ -10,7 +10,9 @@
 
 #include <display/graphics/opengl/buffer_gl.h>
 
+#include <algorithm>
 #include <assert.h>
+#include <cmath>
 
 //--------------------------------------------------------------
 namespace Simple
@@ -38,6 +40,17 @@ protected:
     void Render(uint32_t a_displayWidth,
                 uint32_t a_displayHeight) override;
 
+    void CommitRows(uint32_t a_firstRow,
+                    uint32_t a_rowCount) override;
+
+    void FillRect(const Buffer::Rect& a_rect,
+                  const uint8_t* a_pixel) override;
+    void CopyRect(const Buffer::Rect& a_source,
+                  uint32_t a_destX,
+                  uint32_t a_destY) override;
+
+    bool StoreFlipbookFrame(uint32_t a_frame) override;
+
 private:
     GLenum m_glPixelDataType = 0;
     GLenum m_glPixelDataFormat = 0;
@@ -62,15 +75,24 @@ inline void BufferGLCompat::Create(const Buffer::Config& a_config)
 {
     assert(!m_data);
 
-    // Store the config.
+    // Store the config (rounding the pitch alignment up to a power
+    // of two), using the linear layout without scrolling, flipbook
+    // frames, or accumulation because pixels are drawn directly from
+    // host memory, so they cannot be de-tiled, offset, stored, or
+    // accumulated.
     m_config = a_config;
+    m_config.pitchAlignment = GetPowerOfTwoAlignment(m_config.pitchAlignment);
+    m_config.layout = Buffer::Layout::LINEAR;
+    m_config.scroll = Buffer::Scroll::NONE;
+    m_config.flipbookFrames = 0;
+    m_config.accumulate = false;
 
     // Store the GL pixel data values.
     m_glPixelDataType = GetGLPixelDataType(m_config.format);
     m_glPixelDataFormat = GetGLPixelDataFormat(m_config.format);
 
     // Allocate the pixel data memory.
-    const uint32_t sizeBytes = Buffer::MinSizeBytes(m_config);
+    const uint64_t sizeBytes = Buffer::AlignedSizeBytes(m_config);
     m_data = ::operator new(sizeBytes);
     memset(m_data, 0, sizeBytes);
 }
@@ -105,19 +127,100 @@ inline void BufferGLCompat::Render(uint32_t a_displayWidth,
     // Clear the display.
     glClear(GL_COLOR_BUFFER_BIT);
 
-    // Ensure the entire display is filled.
-    const float xZoomFactor = static_cast<float>(a_displayWidth) /
-                              static_cast<float>(m_config.width);
-    const float yZoomFactor = static_cast<float>(a_displayHeight) /
-                              static_cast<float>(m_config.height);
+    // Find the columns and rows of pixels inside the viewport.
+    const Buffer::Viewport viewport = ResolveViewport(m_viewport,
+                                                      m_config.width,
+                                                      m_config.height);
+    const float width = static_cast<float>(m_config.width);
+    const float height = static_cast<float>(m_config.height);
+    const uint32_t x0 = static_cast<uint32_t>(std::min(std::max(std::floor(viewport.x), 0.0f), width));
+    const uint32_t y0 = static_cast<uint32_t>(std::min(std::max(std::floor(viewport.y), 0.0f), height));
+    const uint32_t x1 = static_cast<uint32_t>(std::min(std::max(std::ceil(viewport.x + viewport.width), 0.0f), width));
+    const uint32_t y1 = static_cast<uint32_t>(std::min(std::max(std::ceil(viewport.y + viewport.height), 0.0f), height));
+    if (x0 >= x1 || y0 >= y1)
+    {
+        return;
+    }
+
+    // Block-compressed pixels cannot be drawn from host memory.
+    if (!Buffer::BytesPerPixel(m_config.format))
+    {
+        return;
+    }
+
+    // Ensure the viewport fills the entire display, offsetting
+    // the first pixel drawn by any part of it outside the viewport.
+    const float xZoomFactor = static_cast<float>(a_displayWidth) / viewport.width;
+    const float yZoomFactor = static_cast<float>(a_displayHeight) / viewport.height;
     glPixelZoom(xZoomFactor, yZoomFactor);
-
-    // Draw the pixels onto the display.
-    glDrawPixels(m_config.width,
-                 m_config.height,
+    glWindowPos2f((static_cast<float>(x0) - viewport.x) * xZoomFactor,
+                  (static_cast<float>(y0) - viewport.y) * yZoomFactor);
+
+    // Draw the pixels onto the display, skipping any padding
+    // at the end of each row if the pitch has been aligned.
+    const uint8_t* pixels = static_cast<const uint8_t*>(m_data) +
+                            (y0 * Buffer::AlignedPitchBytes(m_config)) +
+                            (x0 * Buffer::BytesPerPixel(m_config.format));
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, GetGLUnpackRowLength(m_config));
+    glPixelStorei(GL_UNPACK_ALIGNMENT, GetGLUnpackAlignment(m_config));
+    glDrawPixels(x1 - x0,
+                 y1 - y0,
                  m_glPixelDataFormat,
                  m_glPixelDataType,
-                 m_data);
+                 pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glWindowPos2f(0.0f, 0.0f);
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCompat::CommitRows(uint32_t a_firstRow,
+                                       uint32_t a_rowCount)
+{
+    // Pixels are drawn directly from host memory when rendered, so
+    // committed rows are displayed along with all the other rows.
+    (void)a_firstRow;
+    (void)a_rowCount;
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCompat::FillRect(const Buffer::Rect& a_rect,
+                                     const uint8_t* a_pixel)
+{
+    // Pixels are stored in host memory, so apply each operation
+    // to them immediately.
+    if (m_data && m_config.interop == Buffer::Interop::HOST)
+    {
+        FillByteRanges(m_data,
+                       GetByteRanges(m_config, a_rect),
+                       a_pixel,
+                       Buffer::BytesPerPixel(m_config.format));
+    }
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCompat::CopyRect(const Buffer::Rect& a_source,
+                                     uint32_t a_destX,
+                                     uint32_t a_destY)
+{
+    // Pixels are stored in host memory, so apply each operation
+    // to them immediately.
+    if (m_data && m_config.interop == Buffer::Interop::HOST)
+    {
+        std::vector<ByteRange> source;
+        std::vector<ByteRange> dest;
+        GetCopyByteRanges(m_config, a_source, a_destX, a_destY, source, dest);
+        CopyByteRanges(m_data, source, dest);
+    }
+}
+
+//--------------------------------------------------------------
+inline bool BufferGLCompat::StoreFlipbookFrame(uint32_t a_frame)
+{
+    // Pixels are drawn directly from host memory when rendered, so
+    // there are never any flipbook frames to store them in.
+    (void)a_frame;
+    return false;
 }
 
 } // namespace OpenGL
@@ -14,8 +14,10 @@
 #   include <display/graphics/opengl/interop_gl_cuda.h>
 #endif // CUDA_SUPPORTED
 
+#include <algorithm>
 #include <assert.h>
 #include <string>
+#include <vector>
 
 //--------------------------------------------------------------
 namespace Simple
@@ -35,6 +37,16 @@ public:
     BufferGLCore(const BufferGLCore&) = delete;
     BufferGLCore& operator=(const BufferGLCore&) = delete;
 
+    // Set whether the buffer is also drawn to other displays, so all
+    // textures are uploaded (not only those inside the viewport).
+    void SetMirrored(bool a_isMirrored);
+
+    // Draw the textures uploaded when the buffer was last rendered
+    // to another display (eg. a mirror window), with its own viewport.
+    void RenderMirror(uint32_t a_displayWidth,
+                      uint32_t a_displayHeight,
+                      const Buffer::Viewport& a_viewport);
+
 protected:
     void Create(const Buffer::Config& a_config);
     void Delete();
@@ -43,20 +55,125 @@ protected:
     void Render(uint32_t a_displayWidth,
                 uint32_t a_displayHeight) override;
 
+    void CommitRows(uint32_t a_firstRow,
+                    uint32_t a_rowCount) override;
+
+    void FillRect(const Buffer::Rect& a_rect,
+                  const uint8_t* a_pixel) override;
+    void CopyRect(const Buffer::Rect& a_source,
+                  uint32_t a_destX,
+                  uint32_t a_destY) override;
+
+    bool StoreFlipbookFrame(uint32_t a_frame) override;
+    void SetDataReadable(bool a_readable) override;
+
 private:
+    // Buffers larger than the max texture size are split into
+    // multiple textures, each displaying a region of the buffer.
+    // Rows committed by buffers that are not progressive are
+    // uploaded to a back texture, displayed once it is complete.
+    struct TextureTile
+    {
+        GLuint textureId = 0;
+        GLuint backTextureId = 0;
+        uint32_t x = 0;
+        uint32_t y = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t textureWidth = 0;
+        uint32_t textureHeight = 0;
+    };
+
+    void UploadTile(const TextureTile& a_tile);
+    void UploadScrollLines(const TextureTile& a_tile);
+    void UploadBlocks(GLenum a_target,
+                      const TextureTile& a_tile,
+                      GLint a_layer);
+    void UploadCommittedRows();
+    void FlushUncommittedRows();
+    void RecommitRows(const std::vector<ByteRange>& a_ranges);
+    void UnmapPixelBuffer();
+    void MapPixelBuffer();
+    void DrawTiles(const Buffer::Viewport& a_viewport,
+                   bool a_upload);
+    bool Accumulate(bool a_upload,
+                    uint32_t a_displayWidth,
+                    uint32_t a_displayHeight);
+    const void* GetUploadSource(uint64_t a_offset) const;
+    GLsizei GetBlocksSizeBytes(uint32_t a_width,
+                               uint32_t a_height) const;
+
+    // Flags stored for each texture row once rows are committed.
+    static constexpr uint8_t ROW_PENDING = 1;   // Not yet uploaded.
+    static constexpr uint8_t ROW_IN_FRAME = 2;  // Part of the frame.
+
     GLuint m_programId = 0;
-    GLuint m_textureId = 0;
+    GLint m_boundsLocation = -1;
+    GLint m_scrollLocation = -1;
+    GLint m_flipbookLocation = -1;
+    GLint m_accumulatorLocation = -1;
+    GLint m_colorScaleLocation = -1;
+    std::vector<TextureTile> m_textureTiles;
     GLuint m_pixelBufferId = 0;
     GLuint m_vertexArrayId = 0;
     GLuint m_vertexBufferId = 0;
     GLenum m_glPixelDataType = 0;
     GLenum m_glPixelDataFormat = 0;
+    GLint m_internalFormat = 0;
     InteropGL* m_pixelBufferInterop = 0;
+
+    // Once any rows of a frame have been committed only committed
+    // rows are uploaded until the frame is complete, so the state of
+    // each texture row is stored along with the number of rows of the
+    // frame that were committed (both cleared once it is complete).
+    std::vector<uint8_t> m_committedRows;
+    uint32_t m_frameRowCount = 0;
+
+    // Operations that fill (if there is no source) or copy ranges
+    // of the pixel buffer on the GPU, applied as soon as they are
+    // called (between unmapping the pixel buffer and mapping it
+    // again), using a scratch buffer to copy regions that overlap.
+    struct Operation
+    {
+        std::vector<ByteRange> source;
+        std::vector<ByteRange> dest;
+        uint8_t pixel[16] = {};
+        bool overlaps = false;
+    };
+    void ApplyOperation(const Operation& a_operation);
+    void FillPixelBuffer(const Operation& a_operation);
+    GLuint m_scratchBufferId = 0;
+    uint64_t m_scratchBufferSize = 0;
+
+    // Flipbook frames are stored as the layers of a texture array,
+    // sampled instead of the textures when a frame is displayed.
+    GLuint m_flipbookTextureId = 0;
+
+    // Batches of samples are accumulated by drawing them into a float
+    // texture, sampled instead of the textures when it is displayed.
+    GLuint m_accumulatorTextureId = 0;
+    GLuint m_accumulatorFramebufferId = 0;
+
+    // Host buffers that detect changes are stored in host memory
+    // instead of a pixel buffer, so they can be read efficiently.
+    std::vector<uint8_t> m_hostData;
+
+    // Whether the accumulator was displayed when last rendered, and
+    // whether the buffer is also drawn to other displays (in which
+    // case textures outside the viewport must be uploaded too).
+    bool m_isShowingAccumulator = false;
+    bool m_isMirrored = false;
+
+    // Whether the pixel buffer is mapped so it can also be read.
+    bool m_isDataReadable = false;
 };
 
 //--------------------------------------------------------------
 void InitializeProgram(GLuint programId);
-void InitializeTexture(GLuint textureId);
+void InitializeTiling(GLuint programId,
+                      const Buffer::Config& a_config);
+void InitializeTexture(GLuint textureId,
+                       GLenum target = GL_TEXTURE_2D);
 void InitializeVertices(GLuint bufferId, GLuint arrayId);
 
 //--------------------------------------------------------------
@@ -65,13 +182,14 @@ inline BufferGLCore::BufferGLCore(const Buffer::Config& a_config)
     // Create an OpenGL program to render a texture for display.
     m_programId = glCreateProgram();
     InitializeProgram(m_programId);
+    m_boundsLocation = glGetUniformLocation(m_programId, "bounds");
+    m_scrollLocation = glGetUniformLocation(m_programId, "scroll");
+    m_flipbookLocation = glGetUniformLocation(m_programId, "flipbookLayer");
+    m_accumulatorLocation = glGetUniformLocation(m_programId, "accumulator");
+    m_colorScaleLocation = glGetUniformLocation(m_programId, "colorScale");
 
-    // Create the texture that will be rendered to the display.
-    glGenTextures(1, &m_textureId);
-    InitializeTexture(m_textureId);
-
-    // Create the vertex buffer that will be used to map the
-    // texture to a quad that is scaled to fill the display,
+    // Create the vertex buffer that will be used to map each
+    // texture to a quad that is scaled to fill the viewport,
     // along with the vertex array object needed to draw it.
     glGenBuffers(1, &m_vertexBufferId);
     glGenVertexArrays(1, &m_vertexArrayId);
@@ -93,9 +211,6 @@ inline BufferGLCore::~BufferGLCore()
     // Delete the vertex buffer.
     glDeleteBuffers(1, &m_vertexBufferId);
 
-    // Delete the texture.
-    glDeleteTextures(1, &m_textureId);
-
     // Delete the program.
     glDeleteProgram(m_programId);
 }
@@ -105,30 +220,209 @@ inline void BufferGLCore::Create(const Buffer::Config& a_config)
 {
     assert(!m_data);
     assert(!m_pixelBufferInterop);
+    assert(m_textureTiles.empty());
 
-    // Store the config.
+    // Store the config (rounding the pitch alignment up to a power
+    // of two), using the linear layout without detecting changes if
+    // scrolling, because only the lines acquired each frame are
+    // uploaded, which must be whole rows or columns.
     m_config = a_config;
+    m_config.pitchAlignment = GetPowerOfTwoAlignment(m_config.pitchAlignment);
+    if (m_config.scroll != Buffer::Scroll::NONE)
+    {
+        m_config.layout = Buffer::Layout::LINEAR;
+        m_config.detectChanges = false;
+    }
+
+    // Block-compressed buffers are stored as rows of blocks, which
+    // are uploaded whole, so they cannot be tiled, scroll, or have
+    // their pixels hashed to detect changes.
+    const bool compressed = (Buffer::BlockSize(m_config.format) > 1);
+    if (compressed)
+    {
+        m_config.layout = Buffer::Layout::LINEAR;
+        m_config.scroll = Buffer::Scroll::NONE;
+        m_config.detectChanges = false;
+    }
+
+    // Get the max width and height of each texture, and use the
+    // linear layout for any tiled buffer that exceeds it because
+    // de-tiling requires all the pixels to be in a single texture.
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    const uint32_t maxSize = static_cast<uint32_t>(std::max(maxTextureSize, 1));
+    if (GetTextureWidth(m_config) > maxSize ||
+        GetTextureHeight(m_config) > maxSize)
+    {
+        m_config.layout = Buffer::Layout::LINEAR;
+    }
+
+    // Scrolling offsets the coordinates used to sample a texture,
+    // so the ring of lines must not be split between textures.
+    if ((m_config.scroll == Buffer::Scroll::ROWS && m_config.height > maxSize) ||
+        (m_config.scroll == Buffer::Scroll::COLUMNS && m_config.width > maxSize))
+    {
+        m_config.scroll = Buffer::Scroll::NONE;
+    }
+
+    // Flipbook frames are stored in the layers of a single texture
+    // array, so they cannot be split between textures or scroll.
+    GLint maxArrayLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxArrayLayers);
+    if (m_config.scroll != Buffer::Scroll::NONE ||
+        GetTextureWidth(m_config) > maxSize ||
+        GetTextureHeight(m_config) > maxSize ||
+        m_config.flipbookFrames > static_cast<uint32_t>(std::max(maxArrayLayers, 0)))
+    {
+        m_config.flipbookFrames = 0;
+    }
+
+    // Samples are accumulated by drawing the buffer data over the
+    // entire accumulator, so it cannot be split between textures or
+    // scroll.
+    if (m_config.scroll != Buffer::Scroll::NONE ||
+        GetTextureWidth(m_config) > maxSize ||
+        GetTextureHeight(m_config) > maxSize)
+    {
+        m_config.accumulate = false;
+    }
 
     // Store the GL pixel data values.
     m_glPixelDataType = GetGLPixelDataType(m_config.format);
     m_glPixelDataFormat = GetGLPixelDataFormat(m_config.format);
 
-    // Create the texture image.
-    glTexImage2D(GL_TEXTURE_2D,
-                 0,
-                 GetGLInternalPixelFormat(m_config.format),
-                 m_config.width,
-                 m_config.height,
-                 0,
-                 m_glPixelDataFormat,
-                 m_glPixelDataType,
-                 0);
+    // Select the texture storage, which if compact will result
+    // in pixels being converted when copied to the texture.
+    m_storage = SelectGLStorage(m_config);
+    m_internalFormat = (m_storage == Buffer::Storage::NATIVE) ?
+                       GetGLInternalPixelFormat(m_config.format) :
+                       GetGLInternalPixelFormat(m_storage);
+
+    // Create the texture images, which for tiled layouts store
+    // the pixels as they are laid out in the pixel buffer, then
+    // set the values needed by the program to de-tile them.
+    const uint32_t textureWidth = GetTextureWidth(m_config);
+    const uint32_t textureHeight = GetTextureHeight(m_config);
+    for (uint32_t y = 0; y < textureHeight; y += maxSize)
+    {
+        for (uint32_t x = 0; x < textureWidth; x += maxSize)
+        {
+            TextureTile tile;
+            tile.x = x;
+            tile.y = y;
+            tile.textureWidth = std::min(maxSize, textureWidth - x);
+            tile.textureHeight = std::min(maxSize, textureHeight - y);
+            tile.width = std::min(tile.textureWidth, m_config.width - x);
+            tile.height = std::min(tile.textureHeight, m_config.height - y);
+
+            glGenTextures(1, &tile.textureId);
+            InitializeTexture(tile.textureId);
+            if (compressed)
+            {
+                glCompressedTexImage2D(GL_TEXTURE_2D,
+                                       0,
+                                       m_internalFormat,
+                                       tile.textureWidth,
+                                       tile.textureHeight,
+                                       0,
+                                       GetBlocksSizeBytes(tile.textureWidth,
+                                                          tile.textureHeight),
+                                       0);
+            }
+            else
+            {
+                glTexImage2D(GL_TEXTURE_2D,
+                             0,
+                             m_internalFormat,
+                             tile.textureWidth,
+                             tile.textureHeight,
+                             0,
+                             m_glPixelDataFormat,
+                             m_glPixelDataType,
+                             0);
+            }
+            m_textureTiles.push_back(tile);
+        }
+    }
+    InitializeTiling(m_programId, m_config);
+
+    // Create the texture array that stores the flipbook frames.
+    if (m_config.flipbookFrames)
+    {
+        glGenTextures(1, &m_flipbookTextureId);
+        InitializeTexture(m_flipbookTextureId, GL_TEXTURE_2D_ARRAY);
+        if (compressed)
+        {
+            glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY,
+                                   0,
+                                   m_internalFormat,
+                                   textureWidth,
+                                   textureHeight,
+                                   m_config.flipbookFrames,
+                                   0,
+                                   GetBlocksSizeBytes(textureWidth, textureHeight) *
+                                   static_cast<GLsizei>(m_config.flipbookFrames),
+                                   0);
+        }
+        else
+        {
+            glTexImage3D(GL_TEXTURE_2D_ARRAY,
+                         0,
+                         m_internalFormat,
+                         textureWidth,
+                         textureHeight,
+                         m_config.flipbookFrames,
+                         0,
+                         m_glPixelDataFormat,
+                         m_glPixelDataType,
+                         0);
+        }
+    }
+
+    // Create the float texture that accumulates batches of samples,
+    // and the framebuffer used to draw each batch into it.
+    if (m_config.accumulate)
+    {
+        glGenTextures(1, &m_accumulatorTextureId);
+        InitializeTexture(m_accumulatorTextureId);
+        glTexImage2D(GL_TEXTURE_2D,
+                     0,
+                     GL_RGBA32F,
+                     m_config.width,
+                     m_config.height,
+                     0,
+                     GL_RGBA,
+                     GL_FLOAT,
+                     0);
+        glGenFramebuffers(1, &m_accumulatorFramebufferId);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_accumulatorFramebufferId);
+        glFramebufferTexture2D(GL_FRAMEBUFFER,
+                               GL_COLOR_ATTACHMENT0,
+                               GL_TEXTURE_2D,
+                               m_accumulatorTextureId,
+                               0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    // Store host buffers that detect changes in host memory, and
+    // upload only the tiles that change each frame from there.
+    if (m_config.detectChanges && m_config.interop == Buffer::Interop::HOST)
+    {
+        m_hostData.assign(Buffer::AlignedSizeBytes(m_config), 0);
+        m_data = m_hostData.data();
+        m_changeDetector.Reset(textureWidth,
+                               textureHeight,
+                               Buffer::BytesPerPixel(m_config.format),
+                               Buffer::AlignedPitchBytes(m_config));
+        return;
+    }
+    m_config.detectChanges = false;
 
     // Create the pixel buffer.
     glGenBuffers(1, &m_pixelBufferId);
     glBindBuffer(GL_ARRAY_BUFFER, m_pixelBufferId);
     glBufferData(GL_ARRAY_BUFFER,
-                 Buffer::MinSizeBytes(m_config),
+                 Buffer::AlignedSizeBytes(m_config),
                  nullptr,
                  GL_STREAM_DRAW);
 
@@ -152,20 +446,49 @@ inline void BufferGLCore::Create(const Buffer::Config& a_config)
 //--------------------------------------------------------------
 inline void BufferGLCore::Delete()
 {
-    assert(m_pixelBufferInterop);
+    assert(m_pixelBufferInterop || !m_hostData.empty());
     delete m_pixelBufferInterop;
     m_pixelBufferInterop = nullptr;
+    m_isDataReadable = false;
 
     assert(m_data);
     m_data = nullptr;
 
-    // Delete the pixel buffer.
+    // Delete the pixel buffer, or the host memory.
     glDeleteBuffers(1, &m_pixelBufferId);
     m_pixelBufferId = 0;
+    m_hostData.clear();
+    m_hostData.shrink_to_fit();
+    m_changeDetector.Reset(0, 0, 0, 0);
+
+    // Delete the textures.
+    for (TextureTile& tile : m_textureTiles)
+    {
+        glDeleteTextures(1, &tile.textureId);
+        glDeleteTextures(1, &tile.backTextureId);
+    }
+    m_textureTiles.clear();
+    glDeleteTextures(1, &m_flipbookTextureId);
+    m_flipbookTextureId = 0;
+    glDeleteFramebuffers(1, &m_accumulatorFramebufferId);
+    m_accumulatorFramebufferId = 0;
+    glDeleteTextures(1, &m_accumulatorTextureId);
+    m_accumulatorTextureId = 0;
+    m_committedRows.clear();
+    m_frameRowCount = 0;
+
+    // Delete the scratch buffer.
+    glDeleteBuffers(1, &m_scratchBufferId);
+    m_scratchBufferId = 0;
+    m_scratchBufferSize = 0;
 
     // Clear the GL pixel data values.
     m_glPixelDataType = 0;
     m_glPixelDataFormat = 0;
+    m_internalFormat = 0;
+
+    // Reset the texture storage.
+    m_storage = Buffer::Storage::NATIVE;
 
     // Invalidate the config.
     m_config = Buffer::Config::Invalid();
@@ -182,35 +505,842 @@ inline void BufferGLCore::Resize(const Buffer::Config& a_config)
 inline void BufferGLCore::Render(uint32_t a_displayWidth,
                                  uint32_t a_displayHeight)
 {
-    m_pixelBufferInterop->Unmap();
-    m_data = nullptr;
+    // Unmap the pixel buffer, flushing all of it unless each band
+    // of rows was flushed when committed, or find the tiles of host
+    // memory that changed, skipping all uploads if none of them have
+    // (or if a flipbook frame is displayed instead of buffer data).
+    const bool showFlipbook = (m_flipbookFrame < m_config.flipbookFrames);
+    if (m_pixelBufferInterop)
+    {
+        if (m_committedRows.empty())
+        {
+            m_pixelBufferInterop->Flush(0, Buffer::AlignedSizeBytes(m_config));
+        }
+        else
+        {
+            FlushUncommittedRows();
+        }
+        m_pixelBufferInterop->Unmap();
+        m_data = nullptr;
+    }
+    else if (m_committedRows.empty() && !showFlipbook)
+    {
+        m_changeDetector.Hash(m_data);
+    }
+
+    // Clear the display and set the viewport size.
+    glClear(GL_COLOR_BUFFER_BIT);
+    glViewport(0, 0, a_displayWidth, a_displayHeight);
 
-    // Copy the pixel buffer to the texture.
-    glBindTexture(GL_TEXTURE_2D, m_textureId);
+    // Prepare to draw each texture onto the quad.
+    glUseProgram(m_programId);
+    glBindVertexArray(m_vertexArrayId);
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pixelBufferId);
-    glTexSubImage2D(GL_TEXTURE_2D,
-                    0,
-                    0,
-                    0,
-                    m_config.width,
-                    m_config.height,
-                    m_glPixelDataFormat,
-                    m_glPixelDataType,
-                    0);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, GetGLUnpackRowLength(m_config));
+    glPixelStorei(GL_UNPACK_ALIGNMENT, GetGLUnpackAlignment(m_config));
+
+    // Sample the layer of the texture array storing the flipbook
+    // frame if one is displayed instead of uploading anything (any
+    // rows committed remain pending until buffer data is displayed),
+    // otherwise copy the lines acquired by a scrolling buffer, or the
+    // rows committed, to every texture (even those outside the viewport)
+    // because they are only uploaded once.
+    const bool uploadAll = (m_config.scroll == Buffer::Scroll::NONE &&
+                            m_committedRows.empty() && !showFlipbook);
+    glUniform1i(m_flipbookLocation, showFlipbook ? static_cast<GLint>(m_flipbookFrame) : -1);
+    if (showFlipbook)
+    {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_flipbookTextureId);
+        glActiveTexture(GL_TEXTURE0);
+    }
+    else if (m_config.scroll != Buffer::Scroll::NONE)
+    {
+        for (const TextureTile& tile : m_textureTiles)
+        {
+            UploadScrollLines(tile);
+        }
+    }
+    else if (!m_committedRows.empty())
+    {
+        UploadCommittedRows();
+    }
+
+    // Offset the texture coordinates of scrolling buffers so the
+    // oldest line in the ring is displayed first.
+    glUniform2f(m_scrollLocation,
+                (m_config.scroll == Buffer::Scroll::COLUMNS) ?
+                static_cast<float>(m_scrollOffset) / static_cast<float>(m_config.width) : 0.0f,
+                (m_config.scroll == Buffer::Scroll::ROWS) ?
+                static_cast<float>(m_scrollOffset) / static_cast<float>(m_config.height) : 0.0f);
+
+    // Add any batch of samples written to the buffer data to the
+    // accumulator, then display the mean of the samples accumulated
+    // instead of the buffer data (once any have been accumulated).
+    const bool showAccumulator = (m_accumulatorFramebufferId && !showFlipbook &&
+                                  Accumulate(uploadAll, a_displayWidth, a_displayHeight));
+    glUniform1i(m_accumulatorLocation, showAccumulator ? 1 : 0);
+    glUniform1f(m_colorScaleLocation, showAccumulator ?
+                1.0f / static_cast<float>(m_accumulatedSamples) : 1.0f);
+
+    // Draw each texture in the viewport, copying the buffer data
+    // to it first (unless it was already copied).
+    m_isShowingAccumulator = showAccumulator;
+    DrawTiles(m_viewport, uploadAll);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (m_pixelBufferInterop)
+    {
+        m_pixelBufferInterop->Map(&m_data);
+    }
+    assert(m_data);
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCore::SetMirrored(bool a_isMirrored)
+{
+    m_isMirrored = a_isMirrored;
+}
 
+//--------------------------------------------------------------
+inline void BufferGLCore::RenderMirror(uint32_t a_displayWidth,
+                                       uint32_t a_displayHeight,
+                                       const Buffer::Viewport& a_viewport)
+{
     // Clear the display and set the viewport size.
     glClear(GL_COLOR_BUFFER_BIT);
     glViewport(0, 0, a_displayWidth, a_displayHeight);
 
-    // Draw the texture onto the quad.
+    // Draw each texture without uploading anything, using the state
+    // of the program (and any flipbook texture) set by Render.
     glUseProgram(m_programId);
     glBindVertexArray(m_vertexArrayId);
+    DrawTiles(a_viewport, false);
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCore::DrawTiles(const Buffer::Viewport& a_viewport,
+                                    bool a_upload)
+{
+    // Get the region of the buffer that will fill the display.
+    const Buffer::Viewport viewport = ResolveViewport(a_viewport,
+                                                      m_config.width,
+                                                      m_config.height);
+    const float viewportX1 = viewport.x + viewport.width;
+    const float viewportY1 = viewport.y + viewport.height;
+
+    for (const TextureTile& tile : m_textureTiles)
+    {
+        // Skip any texture that is entirely outside the viewport
+        // (unless it must be uploaded for a mirror).
+        const float x0 = static_cast<float>(tile.x);
+        const float y0 = static_cast<float>(tile.y);
+        const float x1 = static_cast<float>(tile.x + tile.width);
+        const float y1 = static_cast<float>(tile.y + tile.height);
+        const bool isOutside = (x1 <= viewport.x || x0 >= viewportX1 ||
+                                y1 <= viewport.y || y0 >= viewportY1);
+        if (isOutside && !(a_upload && m_isMirrored))
+        {
+            continue;
+        }
+
+        // Copy the region of the buffer data to the texture (unless
+        // it was already copied), or draw the accumulator instead,
+        // which is only used if the buffer is a single texture.
+        if (m_isShowingAccumulator)
+        {
+            glBindTexture(GL_TEXTURE_2D, m_accumulatorTextureId);
+        }
+        else
+        {
+            glBindTexture(GL_TEXTURE_2D, tile.textureId);
+            if (a_upload)
+            {
+                UploadTile(tile);
+            }
+        }
+        if (isOutside)
+        {
+            continue;
+        }
+
+        // Draw the texture onto the quad, positioned (in normalized
+        // device coordinates) where its region is in the viewport.
+        glUniform4f(m_boundsLocation,
+                    (((x0 - viewport.x) / viewport.width) * 2.0f) - 1.0f,
+                    (((y0 - viewport.y) / viewport.height) * 2.0f) - 1.0f,
+                    (((x1 - viewport.x) / viewport.width) * 2.0f) - 1.0f,
+                    (((y1 - viewport.y) / viewport.height) * 2.0f) - 1.0f);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+    }
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCore::UploadTile(const TextureTile& a_tile)
+{
+    // Copy the region of the pixel buffer to the bound texture,
+    // skipping any padding at the end of each row if the pitch
+    // has been aligned, or only the regions that changed if the
+    // buffer data is stored in host memory.
+    const uint64_t pitch = Buffer::AlignedPitchBytes(m_config);
+    const uint64_t bytesPerPixel = Buffer::BytesPerPixel(m_config.format);
+    if (Buffer::BlockSize(m_config.format) > 1)
+    {
+        UploadBlocks(GL_TEXTURE_2D, a_tile, 0);
+    }
+    else if (m_pixelBufferInterop)
+    {
+        const uint64_t offset = (a_tile.y * pitch) + (a_tile.x * bytesPerPixel);
+        glTexSubImage2D(GL_TEXTURE_2D,
+                        0,
+                        0,
+                        0,
+                        a_tile.textureWidth,
+                        a_tile.textureHeight,
+                        m_glPixelDataFormat,
+                        m_glPixelDataType,
+                        reinterpret_cast<const void*>(static_cast<uintptr_t>(offset)));
+    }
+    else
+    {
+        ChangeDetector::Region textureRegion;
+        textureRegion.x = a_tile.x;
+        textureRegion.y = a_tile.y;
+        textureRegion.width = a_tile.textureWidth;
+        textureRegion.height = a_tile.textureHeight;
+        for (const ChangeDetector::Region& region : m_changeDetector.Upload(textureRegion))
+        {
+            const uint64_t offset = (region.y * pitch) + (region.x * bytesPerPixel);
+            glTexSubImage2D(GL_TEXTURE_2D,
+                            0,
+                            region.x - a_tile.x,
+                            region.y - a_tile.y,
+                            region.width,
+                            region.height,
+                            m_glPixelDataFormat,
+                            m_glPixelDataType,
+                            m_hostData.data() + offset);
+        }
+    }
+}
+
+//--------------------------------------------------------------
+inline bool BufferGLCore::Accumulate(bool a_upload,
+                                     uint32_t a_displayWidth,
+                                     uint32_t a_displayHeight)
+{
+    // The buffer data is only uploaded when a batch is added, and is
+    // displayed as usual until the first batch has been accumulated.
+    if (!m_accumulatePendingSamples)
+    {
+        return m_accumulatedSamples > 0;
+    }
+
+    const TextureTile& tile = m_textureTiles.front();
+    glBindTexture(GL_TEXTURE_2D, tile.textureId);
+    if (a_upload)
+    {
+        UploadTile(tile);
+    }
+
+    // Clear the accumulator if it was reset, then add the batch to it
+    // by drawing the (de-tiled) texture over all of it, weighted by the
+    // number of samples in the batch, using additive blending.
+    glBindFramebuffer(GL_FRAMEBUFFER, m_accumulatorFramebufferId);
+    glViewport(0, 0, m_config.width, m_config.height);
+    if (!m_accumulatedSamples)
+    {
+        const GLfloat zero[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        glClearBufferfv(GL_COLOR, 0, zero);
+    }
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    glUniform1i(m_accumulatorLocation, 0);
+    glUniform1f(m_colorScaleLocation, static_cast<float>(m_accumulatePendingSamples));
+    glUniform4f(m_boundsLocation, -1.0f, -1.0f, 1.0f, 1.0f);
     glDrawArrays(GL_TRIANGLES, 0, 6);
+    glDisable(GL_BLEND);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, a_displayWidth, a_displayHeight);
+
+    m_accumulatedSamples += m_accumulatePendingSamples;
+    return true;
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCore::UploadScrollLines(const TextureTile& a_tile)
+{
+    const bool rows = (m_config.scroll == Buffer::Scroll::ROWS);
+    const uint32_t lineCount = rows ? m_config.height : m_config.width;
+    const uint32_t pendingLines = std::min(m_scrollPendingLines, lineCount);
+    if (!pendingLines)
+    {
+        return;
+    }
+
+    // The lines acquired end just before the oldest line in the
+    // ring, so wrap around the end of the buffer at most once.
+    const uint32_t firstLine = (m_scrollOffset + lineCount - pendingLines) % lineCount;
+    const uint32_t spans[2][2] = { { firstLine, std::min(firstLine + pendingLines, lineCount) },
+                                   { 0, (firstLine + pendingLines > lineCount) ?
+                                        (firstLine + pendingLines - lineCount) : 0 } };
 
+    const uint64_t pitch = Buffer::AlignedPitchBytes(m_config);
+    const uint64_t bytesPerPixel = Buffer::BytesPerPixel(m_config.format);
+    const uint32_t tileLine0 = rows ? a_tile.y : a_tile.x;
+    const uint32_t tileLine1 = tileLine0 + (rows ? a_tile.height : a_tile.width);
+    for (const uint32_t (&span)[2] : spans)
+    {
+        // Copy the part of each span of lines inside the texture.
+        const uint32_t line0 = std::max(span[0], tileLine0);
+        const uint32_t line1 = std::min(span[1], tileLine1);
+        if (line0 >= line1)
+        {
+            continue;
+        }
+
+        const uint32_t x = rows ? a_tile.x : line0;
+        const uint32_t y = rows ? line0 : a_tile.y;
+        const uint64_t offset = (y * pitch) + (x * bytesPerPixel);
+        glTexSubImage2D(GL_TEXTURE_2D,
+                        0,
+                        x - a_tile.x,
+                        y - a_tile.y,
+                        rows ? a_tile.textureWidth : (line1 - line0),
+                        rows ? (line1 - line0) : a_tile.textureHeight,
+                        m_glPixelDataFormat,
+                        m_glPixelDataType,
+                        GetUploadSource(offset));
+    }
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCore::UploadBlocks(GLenum a_target,
+                                       const TextureTile& a_tile,
+                                       GLint a_layer)
+{
+    // Compressed data is not unpacked using the row length (before
+    // OpenGL 4.2), so the rows of blocks in each texture are copied
+    // together only if they are contiguous, otherwise one at a time.
+    const uint32_t blockSize = Buffer::BlockSize(m_config.format);
+    const uint64_t bytesPerBlock = Buffer::BytesPerBlock(m_config.format);
+    const uint64_t pitch = Buffer::AlignedPitchBytes(m_config);
+    const uint64_t rowBytes = ((a_tile.textureWidth + blockSize - 1) / blockSize) * bytesPerBlock;
+    const uint32_t rowCount = (a_tile.textureHeight + blockSize - 1) / blockSize;
+    const uint32_t rowsPerCopy = (rowBytes == pitch) ? rowCount : 1;
+    for (uint32_t row = 0; row < rowCount; row += rowsPerCopy)
+    {
+        const uint32_t y = row * blockSize;
+        const uint32_t height = std::min(rowsPerCopy * blockSize, a_tile.textureHeight - y);
+        const uint64_t offset = (((a_tile.y / blockSize) + row) * pitch) +
+                                ((a_tile.x / blockSize) * bytesPerBlock);
+        const GLsizei size = GetBlocksSizeBytes(a_tile.textureWidth, height);
+        if (a_target == GL_TEXTURE_2D_ARRAY)
+        {
+            glCompressedTexSubImage3D(a_target,
+                                      0,
+                                      0,
+                                      y,
+                                      a_layer,
+                                      a_tile.textureWidth,
+                                      height,
+                                      1,
+                                      m_internalFormat,
+                                      size,
+                                      GetUploadSource(offset));
+        }
+        else
+        {
+            glCompressedTexSubImage2D(a_target,
+                                      0,
+                                      0,
+                                      y,
+                                      a_tile.textureWidth,
+                                      height,
+                                      m_internalFormat,
+                                      size,
+                                      GetUploadSource(offset));
+        }
+    }
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCore::UploadCommittedRows()
+{
+    const uint32_t rowCount = static_cast<uint32_t>(m_committedRows.size());
+    const uint64_t pitch = Buffer::AlignedPitchBytes(m_config);
+    const uint64_t bytesPerPixel = Buffer::BytesPerPixel(m_config.format);
+    for (uint32_t row0 = 0; row0 < rowCount;)
+    {
+        // Find the next band of rows not yet uploaded.
+        if (!(m_committedRows[row0] & ROW_PENDING))
+        {
+            ++row0;
+            continue;
+        }
+        uint32_t row1 = row0;
+        for (; row1 < rowCount && (m_committedRows[row1] & ROW_PENDING); ++row1)
+        {
+            m_committedRows[row1] &= ~ROW_PENDING;
+        }
+
+        // Copy the part of the band inside each texture, to the
+        // back texture if the buffer is not progressive.
+        for (const TextureTile& tile : m_textureTiles)
+        {
+            const uint32_t y0 = std::max(row0, tile.y);
+            const uint32_t y1 = std::min(row1, tile.y + tile.textureHeight);
+            if (y0 >= y1)
+            {
+                continue;
+            }
+
+            const uint64_t offset = (y0 * pitch) + (tile.x * bytesPerPixel);
+            glBindTexture(GL_TEXTURE_2D, tile.backTextureId ?
+                                         tile.backTextureId :
+                                         tile.textureId);
+            glTexSubImage2D(GL_TEXTURE_2D,
+                            0,
+                            0,
+                            y0 - tile.y,
+                            tile.textureWidth,
+                            y1 - y0,
+                            m_glPixelDataFormat,
+                            m_glPixelDataType,
+                            GetUploadSource(offset));
+        }
+        row0 = row1;
+    }
+
+    // Once every row has been committed, display the back textures
+    // (if the buffer is not progressive) that are now complete, then
+    // upload the next frame whole unless its rows are committed too.
+    if (m_frameRowCount < rowCount)
+    {
+        return;
+    }
+    for (TextureTile& tile : m_textureTiles)
+    {
+        if (tile.backTextureId)
+        {
+            std::swap(tile.textureId, tile.backTextureId);
+        }
+    }
+    m_committedRows.clear();
+    m_frameRowCount = 0;
+
+    // The hashes of changed tiles were not updated while the frame
+    // was committed, so every tile of the next frame is uploaded.
+    m_changeDetector.Invalidate();
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCore::FlushUncommittedRows()
+{
+    // Rows not yet committed this frame may have been written since
+    // the pixel buffer was mapped, and anything written but not flushed
+    // is undefined once it is unmapped, so flush them to preserve them
+    // (they are still only uploaded once they have been committed).
+    const uint32_t rowCount = static_cast<uint32_t>(m_committedRows.size());
+    const uint64_t pitch = Buffer::AlignedPitchBytes(m_config);
+    for (uint32_t row0 = 0; row0 < rowCount;)
+    {
+        if (m_committedRows[row0] & ROW_IN_FRAME)
+        {
+            ++row0;
+            continue;
+        }
+        uint32_t row1 = row0;
+        for (; row1 < rowCount && !(m_committedRows[row1] & ROW_IN_FRAME); ++row1) {}
+        m_pixelBufferInterop->Flush(row0 * pitch, (row1 - row0) * pitch);
+        row0 = row1;
+    }
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCore::RecommitRows(const std::vector<ByteRange>& a_ranges)
+{
+    // Rows written by operations after they were committed this frame
+    // (and perhaps already uploaded) must be uploaded again, but rows
+    // not yet committed are uploaded once they are (as usual).
+    const uint64_t pitch = Buffer::AlignedPitchBytes(m_config);
+    for (const ByteRange& range : a_ranges)
+    {
+        if (!range.size)
+        {
+            continue;
+        }
+        const uint64_t lastRow = std::min<uint64_t>((range.offset + range.size - 1) / pitch,
+                                                    m_committedRows.size() - 1);
+        for (uint64_t row = range.offset / pitch; row <= lastRow; ++row)
+        {
+            if (m_committedRows[row] & ROW_IN_FRAME)
+            {
+                m_committedRows[row] |= ROW_PENDING;
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------
+inline const void* BufferGLCore::GetUploadSource(uint64_t a_offset) const
+{
+    // Offsets are relative to the bound pixel buffer if there is
+    // one, otherwise to the host memory storing the buffer data.
+    return m_pixelBufferInterop ?
+           reinterpret_cast<const void*>(static_cast<uintptr_t>(a_offset)) :
+           static_cast<const void*>(m_hostData.data() + a_offset);
+}
+
+//--------------------------------------------------------------
+inline GLsizei BufferGLCore::GetBlocksSizeBytes(uint32_t a_width,
+                                                uint32_t a_height) const
+{
+    // The size of the blocks storing a region of compressed pixels.
+    const uint32_t blockSize = Buffer::BlockSize(m_config.format);
+    return static_cast<GLsizei>(((a_width + blockSize - 1) / blockSize) *
+                                ((a_height + blockSize - 1) / blockSize) *
+                                Buffer::BytesPerBlock(m_config.format));
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCore::CommitRows(uint32_t a_firstRow,
+                                     uint32_t a_rowCount)
+{
+    // Scrolling buffers only upload the lines acquired, and block-
+    // compressed buffers are always uploaded whole.
+    if (m_config.scroll != Buffer::Scroll::NONE ||
+        Buffer::BlockSize(m_config.format) > 1)
+    {
+        return;
+    }
+
+    // Extend the band to whole rows of tiles, which are stored as
+    // consecutive rows of the texture if the layout is tiled.
+    const uint32_t tileSize = Buffer::TileSize(m_config.layout);
+    const uint32_t textureHeight = GetTextureHeight(m_config);
+    const uint32_t row0 = (a_firstRow / tileSize) * tileSize;
+    const uint32_t row1 = std::min(((a_firstRow + a_rowCount + tileSize - 1) / tileSize) * tileSize,
+                                   textureHeight);
+
+    // Start committing the rows of a frame, creating the back
+    // textures (the first time) that each committed frame will be
+    // uploaded to unless the buffer is progressive.
+    if (m_committedRows.empty())
+    {
+        m_committedRows.assign(textureHeight, 0);
+        for (TextureTile& tile : m_textureTiles)
+        {
+            if (!m_config.progressive && !tile.backTextureId)
+            {
+                glGenTextures(1, &tile.backTextureId);
+                InitializeTexture(tile.backTextureId);
+                glTexImage2D(GL_TEXTURE_2D,
+                             0,
+                             m_internalFormat,
+                             tile.textureWidth,
+                             tile.textureHeight,
+                             0,
+                             m_glPixelDataFormat,
+                             m_glPixelDataType,
+                             0);
+            }
+        }
+    }
+
+    // Flush the band of the mapped pixel buffer, so it need not be
+    // flushed again when rendered (the band is only uploaded then,
+    // because the pixel buffer cannot be read while it is mapped).
+    if (m_pixelBufferInterop)
+    {
+        const uint64_t pitch = Buffer::AlignedPitchBytes(m_config);
+        m_pixelBufferInterop->Flush(row0 * pitch, (row1 - row0) * pitch);
+    }
+
+    for (uint32_t row = row0; row < row1; ++row)
+    {
+        if (!(m_committedRows[row] & ROW_IN_FRAME))
+        {
+            ++m_frameRowCount;
+        }
+        m_committedRows[row] = ROW_PENDING | ROW_IN_FRAME;
+    }
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCore::FillRect(const Buffer::Rect& a_rect,
+                                   const uint8_t* a_pixel)
+{
+    // Fill host memory, or the pixel buffer on the GPU, immediately
+    // so the fill is ordered with pixels written through the data.
+    const uint32_t bytesPerPixel = Buffer::BytesPerPixel(m_config.format);
+    Operation operation;
+    operation.dest = GetByteRanges(m_config, a_rect);
+    if (!m_committedRows.empty())
+    {
+        RecommitRows(operation.dest);
+    }
+    if (!m_pixelBufferInterop)
+    {
+        FillByteRanges(m_data,
+                       operation.dest,
+                       a_pixel,
+                       bytesPerPixel);
+        return;
+    }
+
+    memcpy(operation.pixel, a_pixel, std::min<size_t>(bytesPerPixel, sizeof(operation.pixel)));
+    UnmapPixelBuffer();
+    ApplyOperation(operation);
+    MapPixelBuffer();
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCore::CopyRect(const Buffer::Rect& a_source,
+                                   uint32_t a_destX,
+                                   uint32_t a_destY)
+{
+    // Copy host memory, or the pixel buffer on the GPU, immediately
+    // so the copy is ordered with pixels written through the data.
+    Operation operation;
+    operation.overlaps = GetCopyByteRanges(m_config,
+                                           a_source,
+                                           a_destX,
+                                           a_destY,
+                                           operation.source,
+                                           operation.dest);
+    if (!m_committedRows.empty())
+    {
+        RecommitRows(operation.dest);
+    }
+    if (!m_pixelBufferInterop)
+    {
+        CopyByteRanges(m_data, operation.source, operation.dest);
+        return;
+    }
+
+    UnmapPixelBuffer();
+    ApplyOperation(operation);
+    MapPixelBuffer();
+}
+
+//--------------------------------------------------------------
+inline bool BufferGLCore::StoreFlipbookFrame(uint32_t a_frame)
+{
+    assert(m_flipbookTextureId);
+    assert(a_frame < m_config.flipbookFrames);
+
+    // Unmap the pixel buffer so it can be copied to the layer of the
+    // texture array, then map it again so writing can continue this
+    // frame.
+    if (m_pixelBufferInterop)
+    {
+        UnmapPixelBuffer();
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pixelBufferId);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, GetGLUnpackRowLength(m_config));
+    glPixelStorei(GL_UNPACK_ALIGNMENT, GetGLUnpackAlignment(m_config));
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_flipbookTextureId);
+    if (Buffer::BlockSize(m_config.format) > 1)
+    {
+        UploadBlocks(GL_TEXTURE_2D_ARRAY,
+                     m_textureTiles.front(),
+                     static_cast<GLint>(a_frame));
+    }
+    else
+    {
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
+                        0,
+                        0,
+                        0,
+                        static_cast<GLint>(a_frame),
+                        GetTextureWidth(m_config),
+                        GetTextureHeight(m_config),
+                        1,
+                        m_glPixelDataFormat,
+                        m_glPixelDataType,
+                        GetUploadSource(0));
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (m_pixelBufferInterop)
+    {
+        MapPixelBuffer();
+    }
+    assert(m_data);
+    return true;
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCore::SetDataReadable(bool a_readable)
+{
+    // Pixel buffers are mapped write only unless their data must be
+    // read, which only host memory can be (pixel buffers of buffers
+    // that detect changes are never mapped).
+    if (!m_pixelBufferInterop ||
+        m_config.interop != Buffer::Interop::HOST ||
+        a_readable == m_isDataReadable)
+    {
+        return;
+    }
+    m_pixelBufferInterop->SetReadable(a_readable);
+    m_isDataReadable = a_readable;
+    if (!a_readable)
+    {
+        // Mapped write only again when next mapped by Render.
+        return;
+    }
+
+    // Unmap the pixel buffer then map it again so it can be read
+    // immediately, keeping everything written to it so far this frame.
+    UnmapPixelBuffer();
+    MapPixelBuffer();
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCore::UnmapPixelBuffer()
+{
+    // Flush all of the pixel buffer before unmapping it, because any
+    // part of it may have been written since it was mapped.
+    assert(m_pixelBufferInterop);
+    m_pixelBufferInterop->Flush(0, Buffer::AlignedSizeBytes(m_config));
+    m_pixelBufferInterop->Unmap();
+    m_data = nullptr;
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCore::MapPixelBuffer()
+{
+    // Mapping the pixel buffer waits for any GPU commands using it
+    // to complete, which may also change the address it is mapped to.
+    assert(m_pixelBufferInterop);
     m_pixelBufferInterop->Map(&m_data);
     assert(m_data);
 }
 
+//--------------------------------------------------------------
+inline void BufferGLCore::ApplyOperation(const Operation& a_operation)
+{
+    glBindBuffer(GL_COPY_READ_BUFFER, m_pixelBufferId);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_pixelBufferId);
+    if (a_operation.source.empty())
+    {
+        FillPixelBuffer(a_operation);
+    }
+    else if (!a_operation.overlaps)
+    {
+        for (size_t i = 0; i < a_operation.source.size(); ++i)
+        {
+            glCopyBufferSubData(GL_COPY_READ_BUFFER,
+                                GL_COPY_WRITE_BUFFER,
+                                static_cast<GLintptr>(a_operation.source[i].offset),
+                                static_cast<GLintptr>(a_operation.dest[i].offset),
+                                static_cast<GLsizeiptr>(a_operation.source[i].size));
+        }
+    }
+    else
+    {
+        // Ranges of the same buffer that overlap cannot be copied,
+        // so copy the source to the scratch buffer, then from there.
+        uint64_t size = 0;
+        for (const ByteRange& range : a_operation.source)
+        {
+            size += range.size;
+        }
+        if (m_scratchBufferSize < size)
+        {
+            if (!m_scratchBufferId)
+            {
+                glGenBuffers(1, &m_scratchBufferId);
+            }
+            glBindBuffer(GL_COPY_WRITE_BUFFER, m_scratchBufferId);
+            glBufferData(GL_COPY_WRITE_BUFFER,
+                         static_cast<GLsizeiptr>(size),
+                         nullptr,
+                         GL_STREAM_COPY);
+            m_scratchBufferSize = size;
+        }
+
+        glBindBuffer(GL_COPY_READ_BUFFER, m_pixelBufferId);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_scratchBufferId);
+        uint64_t offset = 0;
+        for (const ByteRange& range : a_operation.source)
+        {
+            glCopyBufferSubData(GL_COPY_READ_BUFFER,
+                                GL_COPY_WRITE_BUFFER,
+                                static_cast<GLintptr>(range.offset),
+                                static_cast<GLintptr>(offset),
+                                static_cast<GLsizeiptr>(range.size));
+            offset += range.size;
+        }
+
+        glBindBuffer(GL_COPY_READ_BUFFER, m_scratchBufferId);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_pixelBufferId);
+        offset = 0;
+        for (const ByteRange& range : a_operation.dest)
+        {
+            glCopyBufferSubData(GL_COPY_READ_BUFFER,
+                                GL_COPY_WRITE_BUFFER,
+                                static_cast<GLintptr>(offset),
+                                static_cast<GLintptr>(range.offset),
+                                static_cast<GLsizeiptr>(range.size));
+            offset += range.size;
+        }
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+//--------------------------------------------------------------
+inline void BufferGLCore::FillPixelBuffer(const Operation& a_operation)
+{
+    const uint32_t bytesPerPixel = Buffer::BytesPerPixel(m_config.format);
+#ifdef GL_VERSION_4_3
+    // Fill each range with the pixel, treated as unsigned
+    // integers so any pixel format can be written unchanged.
+    if (GLAD_GL_VERSION_4_3)
+    {
+        const GLenum internalFormat = (bytesPerPixel == 16) ? GL_RGBA32UI :
+                                      (bytesPerPixel == 8) ? GL_RG32UI : GL_R32UI;
+        const GLenum format = (bytesPerPixel == 16) ? GL_RGBA_INTEGER :
+                              (bytesPerPixel == 8) ? GL_RG_INTEGER : GL_RED_INTEGER;
+        for (const ByteRange& range : a_operation.dest)
+        {
+            glClearBufferSubData(GL_COPY_WRITE_BUFFER,
+                                 internalFormat,
+                                 static_cast<GLintptr>(range.offset),
+                                 static_cast<GLsizeiptr>(range.size),
+                                 format,
+                                 GL_UNSIGNED_INT,
+                                 a_operation.pixel);
+        }
+        return;
+    }
+#endif // GL_VERSION_4_3
+
+    // Buffers cannot be cleared before OpenGL 4.3, so fill
+    // each range in host memory and then upload it instead.
+    std::vector<uint8_t> pixels;
+    for (const ByteRange& range : a_operation.dest)
+    {
+        pixels.resize(range.size);
+        FillByteRanges(pixels.data(),
+                       { { 0, range.size } },
+                       a_operation.pixel,
+                       bytesPerPixel);
+        glBufferSubData(GL_COPY_WRITE_BUFFER,
+                        static_cast<GLintptr>(range.offset),
+                        static_cast<GLsizeiptr>(range.size),
+                        pixels.data());
+    }
+}
+
 //--------------------------------------------------------------
 inline void CompileShader(GLuint shaderId,
                           const std::string& source)
@@ -233,13 +1363,14 @@ inline void InitializeProgram(GLuint programId)
         #version 410 core
 
         layout(location = 0) in vec3 vertexPos;
+        uniform vec4 bounds;
         out vec2 uv;
 
         void main()
         {
-	        gl_Position = vec4(vertexPos, 1);
             uv = vec2((vertexPos.x * 0.5) + 0.5,
                       (vertexPos.y * 0.5) + 0.5);
+            gl_Position = vec4(mix(bounds.xy, bounds.zw, uv), 0, 1);
         }
     )";
     const GLuint vertShader = glCreateShader(GL_VERTEX_SHADER);
@@ -253,10 +1384,61 @@ inline void InitializeProgram(GLuint programId)
         in vec2 uv;
         out vec3 color;
         uniform sampler2D texSampler;
+        uniform sampler2DArray flipbookSampler;
+        uniform int flipbookLayer;
+        uniform vec2 scroll;
+        uniform uvec2 extent;
+        uniform uint rowLength;
+        uniform uint tileSize;
+        uniform uint morton;
+        uniform bool accumulator;
+        uniform float colorScale;
+
+        uint SpreadBits(uint v)
+        {
+            v = (v | (v << 2u)) & 0x33u;
+            v = (v | (v << 1u)) & 0x55u;
+            return v;
+        }
+
+        vec3 Sample(vec2 coord)
+        {
+            return (flipbookLayer >= 0) ?
+                   texture(flipbookSampler, vec3(coord, float(flipbookLayer))).xyz :
+                   texture(texSampler, coord).xyz;
+        }
+
+        vec3 Fetch(ivec2 texel)
+        {
+            return (flipbookLayer >= 0) ?
+                   texelFetch(flipbookSampler, ivec3(texel, flipbookLayer), 0).xyz :
+                   texelFetch(texSampler, texel, 0).xyz;
+        }
+
+        vec3 Detile()
+        {
+            // The accumulator is always linear.
+            if (tileSize <= 1u || accumulator)
+            {
+                return Sample((scroll == vec2(0.0)) ? uv : fract(uv + scroll));
+            }
+
+            // Find the index of the pixel in the tiled data.
+            uvec2 xy = min(uvec2(uv * vec2(extent)), extent - 1u);
+            uvec2 t = xy % tileSize;
+            uint i = ((xy.y / tileSize) * rowLength * tileSize) +
+                     ((xy.x / tileSize) * tileSize * tileSize) +
+                     ((morton != 0u) ? (SpreadBits(t.x) | (SpreadBits(t.y) << 1u)) :
+                                       ((t.y * tileSize) + t.x));
+            return Fetch(ivec2(i % rowLength, i / rowLength));
+        }
 
         void main()
         {
-            color = texture(texSampler, uv).xyz;
+            // Scaled by the number of samples in a batch when it is
+            // accumulated, or the reciprocal of the number of samples
+            // accumulated when the accumulator is displayed.
+            color = Detile() * colorScale;
         }
     )";
     const GLuint fragShader = glCreateShader(GL_FRAGMENT_SHADER);
@@ -267,6 +1449,14 @@ inline void InitializeProgram(GLuint programId)
     glAttachShader(programId, fragShader);
     glLinkProgram(programId);
 
+    // Bind the texture array to a different texture unit, because
+    // samplers of different types cannot share the same unit.
+    glUseProgram(programId);
+    glUniform1i(glGetUniformLocation(programId, "texSampler"), 0);
+    glUniform1i(glGetUniformLocation(programId, "flipbookSampler"), 1);
+    glUniform1f(glGetUniformLocation(programId, "colorScale"), 1.0f);
+    glUseProgram(0);
+
     // Detach the shaders and then delete them.
     glDetachShader(programId, fragShader);
     glDetachShader(programId, vertShader);
@@ -275,15 +1465,31 @@ inline void InitializeProgram(GLuint programId)
 }
 
 //--------------------------------------------------------------
-inline void InitializeTexture(GLuint textureId)
+inline void InitializeTiling(GLuint programId,
+                             const Buffer::Config& a_config)
+{
+    assert(programId);
+
+    const TextureTiling tiling = GetTextureTiling(a_config);
+    glUseProgram(programId);
+    glUniform2ui(glGetUniformLocation(programId, "extent"), tiling.width, tiling.height);
+    glUniform1ui(glGetUniformLocation(programId, "rowLength"), tiling.rowLength);
+    glUniform1ui(glGetUniformLocation(programId, "tileSize"), tiling.tileSize);
+    glUniform1ui(glGetUniformLocation(programId, "morton"), tiling.morton);
+    glUseProgram(0);
+}
+
+//--------------------------------------------------------------
+inline void InitializeTexture(GLuint textureId,
+                              GLenum target)
 {
     assert(textureId);
 
-    glBindTexture(GL_TEXTURE_2D, textureId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(target, textureId);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 }
 
 //--------------------------------------------------------------
@@ -0,0 +1,47 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <cstring>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Display
+{
+namespace OpenGL
+{
+
+//--------------------------------------------------------------
+// Whether an extension is named in a space separated list of
+// extensions (eg. as returned by glXQueryExtensionsString or
+// wglGetExtensionsStringEXT).
+//--------------------------------------------------------------
+inline bool IsExtensionSupported(const char* a_extensions,
+                                 const char* a_extension)
+{
+    // Match whole space separated names, not just their prefixes.
+    const size_t length = strlen(a_extension);
+    for (const char* start = a_extensions;
+         start && (start = strstr(start, a_extension));
+         start += length)
+    {
+        const bool atStart = (start == a_extensions) || (start[-1] == ' ');
+        const bool atEnd = (start[length] == ' ') || (start[length] == '\0');
+        if (atStart && atEnd)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace OpenGL
+} // namespace Display
+} // namespace Simple
@@ -0,0 +1,167 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <display/context_implementation.h>
+
+#include <algorithm>
+#include <assert.h>
+#include <chrono>
+#include <deque>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Display
+{
+namespace OpenGL
+{
+
+//--------------------------------------------------------------
+// Bounds the number of frames queued by the driver using fences,
+// equivalent to the frames in flight of the explicit graphics APIs,
+// and measures the latency of each frame as they are completed.
+//--------------------------------------------------------------
+class FrameQueueGL
+{
+public:
+    FrameQueueGL(uint32_t a_framesInFlight,
+                 Context::LatencyCounters& a_latencyCounters);
+    ~FrameQueueGL();
+
+    FrameQueueGL(const FrameQueueGL&) = delete;
+    FrameQueueGL& operator=(const FrameQueueGL&) = delete;
+
+    // Call before rendering and after presenting each frame.
+    bool IsFrameSlotAvailable();
+    void WaitForFrameSlot();
+    void OnFramePresented();
+
+    // Wait until the last frame presented has been completed.
+    void WaitForFramePresented();
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Frame
+    {
+        GLsync fence = nullptr;
+        Clock::time_point submitTime;
+    };
+
+    void CompleteFinishedFrames();
+    void CompleteOldestFrame();
+
+    const uint32_t m_framesInFlight;
+    Context::LatencyCounters& m_latencyCounters;
+    std::deque<Frame> m_frames;
+};
+
+//--------------------------------------------------------------
+inline FrameQueueGL::FrameQueueGL(uint32_t a_framesInFlight,
+                                  Context::LatencyCounters& a_latencyCounters)
+    : m_framesInFlight(std::max(a_framesInFlight, 1u))
+    , m_latencyCounters(a_latencyCounters)
+{
+}
+
+//--------------------------------------------------------------
+inline FrameQueueGL::~FrameQueueGL()
+{
+    for (const Frame& frame : m_frames)
+    {
+        glDeleteSync(frame.fence);
+    }
+}
+
+//--------------------------------------------------------------
+inline bool FrameQueueGL::IsFrameSlotAvailable()
+{
+    CompleteFinishedFrames();
+    return m_frames.size() < m_framesInFlight;
+}
+
+//--------------------------------------------------------------
+inline void FrameQueueGL::WaitForFrameSlot()
+{
+    // Wait until fewer frames than the max are in flight, so the
+    // next frame can be rendered without exceeding the max.
+    CompleteFinishedFrames();
+    while (m_frames.size() >= m_framesInFlight)
+    {
+        const GLuint64 timeoutNanoseconds = 1000000000;
+        GLenum result = GL_TIMEOUT_EXPIRED;
+        while (result == GL_TIMEOUT_EXPIRED)
+        {
+            result = glClientWaitSync(m_frames.front().fence,
+                                      GL_SYNC_FLUSH_COMMANDS_BIT,
+                                      timeoutNanoseconds);
+        }
+        assert(result != GL_WAIT_FAILED);
+        CompleteOldestFrame();
+    }
+}
+
+//--------------------------------------------------------------
+inline void FrameQueueGL::OnFramePresented()
+{
+    // Insert a fence that is signaled once this frame completes.
+    Frame frame;
+    frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    frame.submitTime = Clock::now();
+    m_frames.push_back(frame);
+}
+
+//--------------------------------------------------------------
+inline void FrameQueueGL::WaitForFramePresented()
+{
+    // OpenGL does not expose when frames reach the display, but
+    // finishing all commands after swapping buffers blocks until the
+    // swap completes (at the next refresh if vertical sync is on),
+    // which approximates the time the last frame was presented.
+    glFinish();
+    CompleteFinishedFrames();
+}
+
+//--------------------------------------------------------------
+inline void FrameQueueGL::CompleteFinishedFrames()
+{
+    // Measure the latency of earlier frames that have completed,
+    // which complete in the order they were submitted.
+    while (!m_frames.empty())
+    {
+        const GLenum result = glClientWaitSync(m_frames.front().fence,
+                                               GL_SYNC_FLUSH_COMMANDS_BIT,
+                                               0);
+        if (result != GL_ALREADY_SIGNALED &&
+            result != GL_CONDITION_SATISFIED)
+        {
+            break;
+        }
+        CompleteOldestFrame();
+    }
+}
+
+//--------------------------------------------------------------
+inline void FrameQueueGL::CompleteOldestFrame()
+{
+    using namespace std::chrono;
+    const Frame& frame = m_frames.front();
+    const auto latency = Clock::now() - frame.submitTime;
+    const uint64_t latencyMicroseconds = duration_cast<microseconds>(latency).count();
+    m_latencyCounters.framesMeasured++;
+    m_latencyCounters.totalMicroseconds += latencyMicroseconds;
+    m_latencyCounters.maxMicroseconds = std::max(m_latencyCounters.maxMicroseconds,
+                                                 latencyMicroseconds);
+    glDeleteSync(frame.fence);
+    m_frames.pop_front();
+}
+
+} // namespace OpenGL
+} // namespace Display
+} // namespace Simple
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 //--------------------------------------------------------------
 namespace Simple
 {
@@ -23,6 +25,8 @@ public:
     virtual ~InteropGL() = default;
     virtual void Map(void** a_bufferData) = 0;
     virtual void Unmap() = 0;
+    virtual void Flush(uint64_t a_offset, uint64_t a_size) = 0;
+    virtual void SetReadable(bool a_readable) = 0;
 };
 
 } // namespace OpenGL
@@ -33,6 +33,8 @@ public:
 
     void Map(void** a_bufferData);
     void Unmap();
+    void Flush(uint64_t a_offset, uint64_t a_size);
+    void SetReadable(bool a_readable);
 
 private:
     cudaGraphicsResource_t m_cudaResource = 0;
@@ -77,6 +79,21 @@ inline void InteropGLCuda::Unmap()
     CUDA_ENSURE(cudaGraphicsUnmapResources(1, &m_cudaResource, 0));
 }
 
+//--------------------------------------------------------------
+inline void InteropGLCuda::Flush(uint64_t a_offset, uint64_t a_size)
+{
+    // Writes from CUDA are only visible once the buffer is unmapped.
+    (void)a_offset;
+    (void)a_size;
+}
+
+//--------------------------------------------------------------
+inline void InteropGLCuda::SetReadable(bool a_readable)
+{
+    // Device memory mapped by CUDA can always be read.
+    (void)a_readable;
+}
+
 } // namespace OpenGL
 } // namespace Display
 } // namespace Simple
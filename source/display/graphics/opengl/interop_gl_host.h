@@ -30,9 +30,13 @@ public:
 
     void Map(void** a_bufferData) override;
     void Unmap() override;
+    void Flush(uint64_t a_offset, uint64_t a_size) override;
+    void SetReadable(bool a_readable) override;
 
 private:
     const GLuint m_pixelBufferId = 0;
+    GLint64 m_pixelBufferSize = 0;
+    bool m_isReadable = false;
 };
 
 //--------------------------------------------------------------
@@ -40,6 +44,8 @@ inline InteropGLHost::InteropGLHost(GLuint a_pixelBufferId,
                                     void** a_bufferData)
     : m_pixelBufferId(a_pixelBufferId)
 {
+    glBindBuffer(GL_ARRAY_BUFFER, m_pixelBufferId);
+    glGetBufferParameteri64v(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &m_pixelBufferSize);
     Map(a_bufferData);
 }
 
@@ -52,9 +58,15 @@ inline InteropGLHost::~InteropGLHost()
 //--------------------------------------------------------------
 inline void InteropGLHost::Map(void** a_bufferData)
 {
-    // Map the pixel buffer to host memory.
+    // Map the pixel buffer to host memory, with each range that is
+    // written needing to be flushed before the buffer is unmapped,
+    // and only allowing it to be read if that was requested.
+    const GLbitfield readAccess = m_isReadable ? GL_MAP_READ_BIT : 0;
     glBindBuffer(GL_ARRAY_BUFFER, m_pixelBufferId);
-    *a_bufferData = glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+    *a_bufferData = glMapBufferRange(GL_ARRAY_BUFFER,
+                                     0,
+                                     m_pixelBufferSize,
+                                     readAccess | GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT);
 }
 
 //--------------------------------------------------------------
@@ -65,6 +77,23 @@ inline void InteropGLHost::Unmap()
     glUnmapBuffer(GL_ARRAY_BUFFER);
 }
 
+//--------------------------------------------------------------
+inline void InteropGLHost::Flush(uint64_t a_offset, uint64_t a_size)
+{
+    // Flush the range of the pixel buffer written to host memory.
+    glBindBuffer(GL_ARRAY_BUFFER, m_pixelBufferId);
+    glFlushMappedBufferRange(GL_ARRAY_BUFFER,
+                             static_cast<GLintptr>(a_offset),
+                             static_cast<GLsizeiptr>(a_size));
+}
+
+//--------------------------------------------------------------
+inline void InteropGLHost::SetReadable(bool a_readable)
+{
+    // Takes effect when the pixel buffer is next mapped.
+    m_isReadable = a_readable;
+}
+
 } // namespace OpenGL
 } // namespace Display
 } // namespace Simple
@@ -38,16 +38,38 @@ protected:
     void Render(uint32_t a_displayWidth,
                 uint32_t a_displayHeight) override;
 
+    void SetViewport(const Buffer::Viewport& a_viewport) override;
+    Buffer::Viewport GetViewport() const override;
+
+    void CommitRows(uint32_t a_firstRow,
+                    uint32_t a_rowCount) override;
+
+    void FillRect(const Buffer::Rect& a_rect,
+                  const uint8_t* a_pixel) override;
+    void CopyRect(const Buffer::Rect& a_source,
+                  uint32_t a_destX,
+                  uint32_t a_destY) override;
+
+    bool StoreFlipbookFrame(uint32_t a_frame) override;
+    void SetDataReadable(bool a_readable) override;
+
     void* GetData() const override;
-    uint32_t GetSize() const override;
-    uint32_t GetPitch() const override;
+    uint64_t GetSize() const override;
+    uint64_t GetPitch() const override;
     uint32_t GetWidth() const override;
     uint32_t GetHeight() const override;
     Buffer::Format GetFormat() const override;
     Buffer::Interop GetInterop() const override;
+    Buffer::Storage GetStorage() const override;
+    Buffer::Layout GetLayout() const override;
+    Buffer::Scroll GetScroll() const override;
+    uint32_t GetFlipbookFrameCount() const override;
+    bool IsAccumulating() const override;
+    Buffer::UploadCounters GetUploadCounters() const override;
 
 private:
     Buffer::Config m_config = Buffer::Config::Invalid();
+    Buffer::Viewport m_viewport = {};
     PipelineContext& m_pipelineContext;
     PipelineVK* m_pipeline = nullptr;
     void* m_data = nullptr;
@@ -70,8 +92,16 @@ inline BufferVK::~BufferVK()
 //--------------------------------------------------------------
 inline void BufferVK::Create(const Buffer::Config& a_config)
 {
-    // Store the config.
+    // Store the config, rounding the pitch alignment up to a power
+    // of two.
     m_config = a_config;
+    m_config.pitchAlignment = GetPowerOfTwoAlignment(m_config.pitchAlignment);
+
+    // Block-compressed buffers are stored as rows of blocks.
+    if (Buffer::BlockSize(m_config.format) > 1)
+    {
+        m_config.layout = Buffer::Layout::LINEAR;
+    }
 
     // Create the pipeline.
     assert(!m_data);
@@ -79,6 +109,10 @@ inline void BufferVK::Create(const Buffer::Config& a_config)
     m_pipelineContext.bufferData = &m_data;
     m_pipeline = new PipelineVK(m_config,
                                 m_pipelineContext);
+
+    // Store the present mode in effect and the pipeline.
+    m_pipelineContext.presentMode = m_pipeline->GetPresentMode();
+    m_pipelineContext.pipeline = m_pipeline;
 }
 
 //--------------------------------------------------------------
@@ -88,6 +122,7 @@ inline void BufferVK::Delete()
     assert(m_pipeline);
     delete m_pipeline;
     m_pipeline = nullptr;
+    m_pipelineContext.pipeline = nullptr;
     m_data = nullptr;
 
     // Invalidate the config.
@@ -114,8 +149,81 @@ inline void BufferVK::Render(uint32_t a_displayWidth,
         Resize(config);
     }
 
-    // Render the pixel buffer.
-    m_pipeline->Render(a_displayWidth, a_displayHeight);
+    // Render the region of the pixel buffer in the viewport.
+    m_pipeline->Render(a_displayWidth,
+                       a_displayHeight,
+                       GetTextureRegion(m_viewport,
+                                        m_config.width,
+                                        m_config.height));
+}
+
+//--------------------------------------------------------------
+inline void BufferVK::SetViewport(const Buffer::Viewport& a_viewport)
+{
+    m_viewport = a_viewport;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Viewport BufferVK::GetViewport() const
+{
+    return m_viewport;
+}
+
+//--------------------------------------------------------------
+inline void BufferVK::CommitRows(uint32_t a_firstRow,
+                                 uint32_t a_rowCount)
+{
+    // Bands of rows are not uploaded separately, so the entire
+    // buffer will be uploaded when it is rendered.
+    (void)a_firstRow;
+    (void)a_rowCount;
+}
+
+//--------------------------------------------------------------
+inline void BufferVK::FillRect(const Buffer::Rect& a_rect,
+                               const uint8_t* a_pixel)
+{
+    // Operations are not recorded into the command stream, so are
+    // applied to host accessible buffer data immediately instead.
+    if (m_data && m_config.interop == Buffer::Interop::HOST)
+    {
+        FillByteRanges(m_data,
+                       GetByteRanges(m_config, a_rect),
+                       a_pixel,
+                       Buffer::BytesPerPixel(m_config.format));
+    }
+}
+
+//--------------------------------------------------------------
+inline void BufferVK::CopyRect(const Buffer::Rect& a_source,
+                               uint32_t a_destX,
+                               uint32_t a_destY)
+{
+    // Operations are not recorded into the command stream, so are
+    // applied to host accessible buffer data immediately instead.
+    if (m_data && m_config.interop == Buffer::Interop::HOST)
+    {
+        std::vector<ByteRange> source;
+        std::vector<ByteRange> dest;
+        GetCopyByteRanges(m_config, a_source, a_destX, a_destY, source, dest);
+        CopyByteRanges(m_data, source, dest);
+    }
+}
+
+//--------------------------------------------------------------
+inline bool BufferVK::StoreFlipbookFrame(uint32_t a_frame)
+{
+    // Frames cannot be stored on the GPU, so the buffer data is
+    // always uploaded and displayed when the buffer is rendered.
+    (void)a_frame;
+    return false;
+}
+
+//--------------------------------------------------------------
+inline void BufferVK::SetDataReadable(bool a_readable)
+{
+    // The shared buffer is host coherent, so can always be read.
+    (void)a_readable;
 }
 
 //--------------------------------------------------------------
@@ -125,15 +233,15 @@ inline void* BufferVK::GetData() const
 }
 
 //--------------------------------------------------------------
-inline uint32_t BufferVK::GetSize() const
+inline uint64_t BufferVK::GetSize() const
 {
-    return Buffer::MinSizeBytes(m_config);
+    return Buffer::AlignedSizeBytes(m_config);
 }
 
 //--------------------------------------------------------------
-inline uint32_t BufferVK::GetPitch() const
+inline uint64_t BufferVK::GetPitch() const
 {
-    return Buffer::MinPitchBytes(m_config);
+    return Buffer::AlignedPitchBytes(m_config);
 }
 
 //--------------------------------------------------------------
@@ -160,6 +268,42 @@ inline Buffer::Interop BufferVK::GetInterop() const
     return m_config.interop;
 }
 
+//--------------------------------------------------------------
+inline Buffer::Storage BufferVK::GetStorage() const
+{
+    return m_pipeline->GetStorage();
+}
+
+//--------------------------------------------------------------
+inline Buffer::Layout BufferVK::GetLayout() const
+{
+    return m_config.layout;
+}
+
+//--------------------------------------------------------------
+inline Buffer::Scroll BufferVK::GetScroll() const
+{
+    return Buffer::Scroll::NONE;
+}
+
+//--------------------------------------------------------------
+inline uint32_t BufferVK::GetFlipbookFrameCount() const
+{
+    return 0;
+}
+
+//--------------------------------------------------------------
+inline bool BufferVK::IsAccumulating() const
+{
+    return false;
+}
+
+//--------------------------------------------------------------
+inline Buffer::UploadCounters BufferVK::GetUploadCounters() const
+{
+    return Buffer::UploadCounters();
+}
+
 } // namespace Vulkan
 } // namespace Display
 } // namespace Simple
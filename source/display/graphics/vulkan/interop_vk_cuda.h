@@ -51,11 +51,11 @@ inline InteropVKCuda::InteropVKCuda(PipelineVK& a_pipeline)
     exportMemoryAllocateInfo.sType = VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO;
 
     // Create the shared buffer.
-    const VkDeviceSize sharedBufferSize = Buffer::MinSizeBytes(m_pipeline.m_bufferConfig);
+    const VkDeviceSize sharedBufferSize = Buffer::AlignedSizeBytes(m_pipeline.m_bufferConfig);
     const VkDeviceSize allocationSize = m_pipeline.CreateBuffer(m_pipeline.m_sharedBuffer,
                                                                 m_pipeline.m_sharedBufferMemory,
                                                                 sharedBufferSize,
-                                                                VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                                                m_pipeline.GetSharedBufferUsage(),
                                                                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                                                                 &externalMemoryBufferCreateInfo,
                                                                 &exportMemoryAllocateInfo);
@@ -39,11 +39,11 @@ inline InteropVKHost::InteropVKHost(PipelineVK& a_pipeline)
     : m_pipeline(a_pipeline)
 {
     // Create the shared buffer.
-    const VkDeviceSize sharedBufferSize = Buffer::MinSizeBytes(m_pipeline.m_bufferConfig);
+    const VkDeviceSize sharedBufferSize = Buffer::AlignedSizeBytes(m_pipeline.m_bufferConfig);
     m_pipeline.CreateBuffer(m_pipeline.m_sharedBuffer,
                             m_pipeline.m_sharedBufferMemory,
                             sharedBufferSize,
-                            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                            m_pipeline.GetSharedBufferUsage(),
                             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
     // Map the shared buffer.
@@ -8,11 +8,14 @@
 
 #pragma once
 
+#include <simple/display/context.h>
+
 #define NOMINMAX
 #include <shaderc/shaderc.hpp>
 #include <vulkan/vulkan.h>
 #include <algorithm>
 #include <assert.h>
+#include <chrono>
 #include <cstring>
 #include <limits>
 #include <array>
@@ -26,6 +29,7 @@ namespace Vulkan
 {
 
 class InteropVK;
+class PipelineVK;
 class InteropVKCuda;
 class InteropVKHost;
 
@@ -39,6 +43,32 @@ struct PipelineContext
     VkDebugUtilsMessengerEXT debugMessenger = nullptr;
     std::vector<const char*> requiredDeviceExtensions;
     VkExternalMemoryHandleTypeFlagBits externalMemoryHandleType = {};
+
+    // The requested present mode, which is updated with the mode
+    // in effect when a pipeline is created (see BufferVK::Create).
+    Context::PresentMode presentMode = Context::PresentMode::FIFO;
+
+    // The max number of frames in flight and swap chain images.
+    uint32_t framesInFlight = DEFAULT_FRAMES_IN_FLIGHT;
+    uint32_t swapChainImageCount = DEFAULT_SWAP_CHAIN_IMAGE_COUNT;
+
+    // Updated with the latency of each frame that is completed.
+    Context::LatencyCounters* latencyCounters = nullptr;
+
+    // Whether to enable waiting for frames to reach the display.
+    bool lowLatency = false;
+
+    // Read when each frame is presented, to hold it until the target
+    // time (if non-zero) where the display timing extension is enabled.
+    const uint64_t* targetPresentMicroseconds = nullptr;
+
+    // Whether frames rendered are presented by PresentDeferredFrame
+    // (so a group of contexts can render all frames before presenting
+    // any of them) instead of as soon as they are submitted.
+    bool deferPresent = false;
+
+    // The pipeline created using this context (see BufferVK::Create).
+    PipelineVK* pipeline = nullptr;
 };
 
 //--------------------------------------------------------------
@@ -53,15 +83,24 @@ public:
     PipelineVK& operator=(const PipelineVK&) = delete;
 
     void Render(uint32_t a_displayWidth,
-                uint32_t a_displayHeight);
+                uint32_t a_displayHeight,
+                const TextureRegion& a_textureRegion);
 
     uint32_t GetSwapChainWidth() const;
     uint32_t GetSwapChainHeight() const;
+    Buffer::Storage GetStorage() const;
+    Context::PresentMode GetPresentMode() const;
+    bool IsFrameSlotAvailable() const;
+    bool WaitForFramePresented();
+    void PresentDeferredFrame();
 
 protected:
     void SelectPhysicalDevice();
     bool TrySelectPhysicalDevice(const VkPhysicalDevice& a_physicalDevice,
                                  const VkSurfaceKHR& a_surface);
+    void SelectTextureStorage();
+    void SelectPresentWait();
+    void SelectDisplayTiming();
 
     void CreateLogicalDevice();
     void CreateSwapChain();
@@ -79,6 +118,7 @@ protected:
     void CreateIndexBuffer();
     void CreateDescriptorPool();
     void CreateDescriptorSets();
+    void CreateConvertPipeline();
     void CreateCommandBuffers();
     void CreateSyncObjects();
 
@@ -95,16 +135,26 @@ protected:
                     const VkBuffer& a_destinationBuffer,
                     const VkDeviceSize a_sourceBufferSize);
 
+    VkBufferUsageFlags GetSharedBufferUsage() const;
+    uint32_t GetSharedBufferRowLength() const;
+    void CopySharedBufferToTextureImage(const VkCommandBuffer& a_commandBuffer);
+    void ConvertSharedBufferToTextureImage(const VkCommandBuffer& a_commandBuffer);
+
     void RenderFrame();
+    void PresentFrame(uint32_t a_imageIndex,
+                      VkSemaphore a_waitSemaphore);
+    void MeasureFrameLatency(uint32_t a_frameIndex);
 
 private:
-    // The number of frames.
-    static constexpr uint32_t N = 2;
+    // The max number of frames in flight.
+    const uint32_t N;
 
-    // Buffer config, format, and data.
+    // Buffer config, format, data, texture tiling and region.
     const Buffer::Config m_bufferConfig;
     const VkFormat m_bufferFormat;
     void** const m_bufferData;
+    const TextureTiling m_textureTiling;
+    TextureRegion m_textureRegion = {};
 
     // Instance and surface.
     const VkInstance m_instance;
@@ -113,12 +163,15 @@ private:
     // Physical and logical devices.
     std::vector<const char*> m_requiredExtensions = {};
     VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+    VkPhysicalDeviceFeatures m_enabledFeatures = {};
     VkDevice m_device;
 
     // Surface capabilities, format, and present mode.
     VkSurfaceCapabilitiesKHR m_surfaceCapabilities;
     VkSurfaceFormatKHR m_surfaceFormat;
     VkPresentModeKHR m_presentMode;
+    const VkPresentModeKHR m_requestedPresentMode;
+    const uint32_t m_requestedImageCount;
 
     // Graphics and present queue family indices.
     uint32_t m_graphicsQueueFamilyIndex;
@@ -147,6 +200,10 @@ private:
     VkCommandPool m_commandPool;
     std::vector<VkCommandBuffer> m_commandBuffers;
 
+    // Texture storage and format.
+    Buffer::Storage m_textureStorage = Buffer::Storage::NATIVE;
+    VkFormat m_textureFormat = VK_FORMAT_UNDEFINED;
+
     // Texture image and memory.
     VkImage m_textureImage;
     VkDeviceMemory m_textureImageMemory;
@@ -177,12 +234,43 @@ private:
     VkDescriptorPool m_descriptorPool;
     std::vector<VkDescriptorSet> m_descriptorSets;
 
+    // Compute pipeline used to convert compact texture storage.
+    VkDescriptorSetLayout m_convertDescriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool m_convertDescriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet m_convertDescriptorSet = VK_NULL_HANDLE;
+    VkPipelineLayout m_convertPipelineLayout = VK_NULL_HANDLE;
+    VkPipeline m_convertPipeline = VK_NULL_HANDLE;
+
     // Synchronization objects.
     std::vector<VkSemaphore> m_imageAvailableSemaphores;
     std::vector<VkSemaphore> m_renderFinishedSemaphores;
     std::vector<VkFence> m_inFlightFences;
     uint32_t m_currentFrameIndex = 0;
 
+    // Frame submit times, and the counters updated when completed.
+    using Clock = std::chrono::steady_clock;
+    std::vector<Clock::time_point> m_submitTimes;
+    Context::LatencyCounters* const m_latencyCounters;
+
+    // Present ids and wait, used to find when frames are displayed.
+    const bool m_requestedPresentWait;
+    bool m_presentWaitEnabled = false;
+    uint64_t m_presentId = 0;
+#if defined(VK_KHR_present_id) && defined(VK_KHR_present_wait)
+    PFN_vkWaitForPresentKHR m_waitForPresent = nullptr;
+#endif
+
+    // Display timing, used to hold frames until their target time.
+    const uint64_t* const m_targetPresentMicroseconds;
+    bool m_displayTimingEnabled = false;
+    uint32_t m_displayTimingId = 0;
+
+    // The frame submitted but not presented yet, if it is deferred.
+    const bool* const m_deferPresent;
+    VkSemaphore m_deferredSemaphore = VK_NULL_HANDLE;
+    uint32_t m_deferredImageIndex = 0;
+    bool m_hasDeferredFrame = false;
+
     // Vertices and indices defining the quad to render over the
     // entire display surface. Note the v components are flipped
     // for consistency with the graphics apis where y points up.
@@ -227,27 +315,70 @@ constexpr VkFormat GetVkFormat(const Buffer::Format& a_format)
         case Buffer::Format::RGBA_FLOAT: format = VK_FORMAT_R32G32B32A32_SFLOAT; break;
         case Buffer::Format::RGBA_UINT8: format = VK_FORMAT_R8G8B8A8_UNORM; break;
         case Buffer::Format::RGBA_UINT16: format = VK_FORMAT_R16G16B16A16_UNORM; break;
+        case Buffer::Format::RGB10A2_UNORM: format = VK_FORMAT_A2B10G10R10_UNORM_PACK32; break;
+        case Buffer::Format::BC1_UNORM: format = VK_FORMAT_BC1_RGBA_UNORM_BLOCK; break;
+        case Buffer::Format::BC3_UNORM: format = VK_FORMAT_BC3_UNORM_BLOCK; break;
+        case Buffer::Format::BC7_UNORM: format = VK_FORMAT_BC7_UNORM_BLOCK; break;
         default: format = VK_FORMAT_UNDEFINED; break;
     }
     assert(format != VK_FORMAT_UNDEFINED);
     return format;
 }
 
+//--------------------------------------------------------------
+constexpr VkFormat GetVkFormat(const Buffer::Storage& a_storage)
+{
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    switch (a_storage)
+    {
+        case Buffer::Storage::RGBA_HALF: format = VK_FORMAT_R16G16B16A16_SFLOAT; break;
+        case Buffer::Storage::R11G11B10_FLOAT: format = VK_FORMAT_B10G11R11_UFLOAT_PACK32; break;
+        default: format = VK_FORMAT_UNDEFINED; break;
+    }
+    assert(format != VK_FORMAT_UNDEFINED);
+    return format;
+}
+
+//--------------------------------------------------------------
+constexpr VkPresentModeKHR GetVkPresentMode(const Context::PresentMode& a_presentMode)
+{
+    VkPresentModeKHR presentMode = VK_PRESENT_MODE_FIFO_KHR;
+    switch (a_presentMode)
+    {
+        case Context::PresentMode::FIFO_RELAXED: presentMode = VK_PRESENT_MODE_FIFO_RELAXED_KHR; break;
+        case Context::PresentMode::MAILBOX: presentMode = VK_PRESENT_MODE_MAILBOX_KHR; break;
+        case Context::PresentMode::IMMEDIATE: presentMode = VK_PRESENT_MODE_IMMEDIATE_KHR; break;
+        default: presentMode = VK_PRESENT_MODE_FIFO_KHR; break;
+    }
+    return presentMode;
+}
+
 //--------------------------------------------------------------
 inline PipelineVK::PipelineVK(const Buffer::Config& a_bufferConfig,
                               const PipelineContext& a_pipelineContext)
-    : m_bufferConfig(a_bufferConfig)
+    : N(std::max(a_pipelineContext.framesInFlight, 1u))
+    , m_bufferConfig(a_bufferConfig)
     , m_bufferFormat(GetVkFormat(a_bufferConfig.format))
     , m_bufferData(a_pipelineContext.bufferData)
+    , m_textureTiling(GetTextureTiling(a_bufferConfig))
     , m_instance(a_pipelineContext.instance)
     , m_surface(a_pipelineContext.surface)
     , m_requiredExtensions(a_pipelineContext.requiredDeviceExtensions)
+    , m_requestedPresentMode(GetVkPresentMode(a_pipelineContext.presentMode))
+    , m_requestedImageCount(a_pipelineContext.swapChainImageCount)
     , m_swapChainExtent(a_pipelineContext.displayExtent)
     , m_externalMemoryHandleType(a_pipelineContext.externalMemoryHandleType)
+    , m_latencyCounters(a_pipelineContext.latencyCounters)
+    , m_requestedPresentWait(a_pipelineContext.lowLatency)
+    , m_targetPresentMicroseconds(a_pipelineContext.targetPresentMicroseconds)
+    , m_deferPresent(&a_pipelineContext.deferPresent)
 {
     m_requiredExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
 
     SelectPhysicalDevice();
+    SelectTextureStorage();
+    SelectPresentWait();
+    SelectDisplayTiming();
     CreateLogicalDevice();
     CreateSwapChain();
     CreateImageViews();
@@ -264,6 +395,7 @@ inline PipelineVK::PipelineVK(const Buffer::Config& a_bufferConfig,
     CreateIndexBuffer();
     CreateDescriptorPool();
     CreateDescriptorSets();
+    CreateConvertPipeline();
     CreateCommandBuffers();
     CreateSyncObjects();
 }
@@ -286,6 +418,11 @@ inline PipelineVK::~PipelineVK()
 
     vkDestroySwapchainKHR(m_device, m_swapChain, nullptr);
 
+    vkDestroyPipeline(m_device, m_convertPipeline, nullptr);
+    vkDestroyPipelineLayout(m_device, m_convertPipelineLayout, nullptr);
+    vkDestroyDescriptorPool(m_device, m_convertDescriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(m_device, m_convertDescriptorSetLayout, nullptr);
+
     vkDestroyPipeline(m_device, m_graphicsPipeline, nullptr);
     vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
 
@@ -322,10 +459,12 @@ inline PipelineVK::~PipelineVK()
 
 //--------------------------------------------------------------
 inline void PipelineVK::Render(uint32_t a_displayWidth,
-                               uint32_t a_displayHeight)
+                               uint32_t a_displayHeight,
+                               const TextureRegion& a_textureRegion)
 {
     (void)a_displayWidth;
     (void)a_displayHeight;
+    m_textureRegion = a_textureRegion;
     RenderFrame();
 }
 
@@ -341,6 +480,71 @@ inline uint32_t PipelineVK::GetSwapChainHeight() const
     return m_swapChainExtent.height;
 }
 
+//--------------------------------------------------------------
+inline Buffer::Storage PipelineVK::GetStorage() const
+{
+    return m_textureStorage;
+}
+
+//--------------------------------------------------------------
+inline Context::PresentMode PipelineVK::GetPresentMode() const
+{
+    switch (m_presentMode)
+    {
+        case VK_PRESENT_MODE_FIFO_RELAXED_KHR: return Context::PresentMode::FIFO_RELAXED;
+        case VK_PRESENT_MODE_MAILBOX_KHR: return Context::PresentMode::MAILBOX;
+        case VK_PRESENT_MODE_IMMEDIATE_KHR: return Context::PresentMode::IMMEDIATE;
+        default: return Context::PresentMode::FIFO;
+    }
+}
+
+//--------------------------------------------------------------
+inline bool PipelineVK::IsFrameSlotAvailable() const
+{
+    // Check whether the last frame which used the current index has
+    // completed, without waiting for it as RenderFrame would have to.
+    return vkGetFenceStatus(m_device,
+                            m_inFlightFences[m_currentFrameIndex]) == VK_SUCCESS;
+}
+
+//--------------------------------------------------------------
+inline bool PipelineVK::WaitForFramePresented()
+{
+#if defined(VK_KHR_present_id) && defined(VK_KHR_present_wait)
+    // Wait until the last frame presented reaches the display, with
+    // a timeout as frames may never be displayed (eg. when hidden).
+    if (m_presentWaitEnabled)
+    {
+        if (m_presentId == 0)
+        {
+            return false;
+        }
+
+        const uint64_t timeoutNanoseconds = 100000000;
+        const VkResult result = m_waitForPresent(m_device,
+                                                 m_swapChain,
+                                                 m_presentId,
+                                                 timeoutNanoseconds);
+        return result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR;
+    }
+#endif
+
+    // Otherwise wait until the present queue is idle, which (as with
+    // OpenGL) approximates the time the last frame was presented.
+    VULKAN_ENSURE(vkQueueWaitIdle(m_presentQueue));
+    return true;
+}
+
+//--------------------------------------------------------------
+inline void PipelineVK::PresentDeferredFrame()
+{
+    if (m_hasDeferredFrame)
+    {
+        m_hasDeferredFrame = false;
+        PresentFrame(m_deferredImageIndex, m_deferredSemaphore);
+    }
+}
+
 //--------------------------------------------------------------
 inline void PipelineVK::SelectPhysicalDevice()
 {
@@ -525,15 +729,24 @@ inline bool PipelineVK::TrySelectPhysicalDevice(const VkPhysicalDevice& a_physic
         }
     }
 
-    // Select the best available present mode.
+    // Select the requested present mode if it is available, else
+    // fall back from immediate to mailbox (neither of which waits
+    // for vertical sync), else to FIFO which is always available.
+    auto isAvailable = [&presentModes](VkPresentModeKHR a_presentMode)
+    {
+        return std::find(presentModes.begin(),
+                         presentModes.end(),
+                         a_presentMode) != presentModes.end();
+    };
     m_presentMode = VK_PRESENT_MODE_FIFO_KHR;
-    for (const auto& availablePresentMode : presentModes)
+    if (isAvailable(m_requestedPresentMode))
     {
-        if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR)
-        {
-            m_presentMode = availablePresentMode;
-            break;
-        }
+        m_presentMode = m_requestedPresentMode;
+    }
+    else if (m_requestedPresentMode == VK_PRESENT_MODE_IMMEDIATE_KHR &&
+             isAvailable(VK_PRESENT_MODE_MAILBOX_KHR))
+    {
+        m_presentMode = VK_PRESENT_MODE_MAILBOX_KHR;
     }
 
     // Get the surface capabilities.
@@ -551,6 +764,192 @@ inline bool PipelineVK::TrySelectPhysicalDevice(const VkPhysicalDevice& a_physic
     return true;
 }
 
+//--------------------------------------------------------------
+inline VkDeviceSize GetAvailableMemoryBytes(const VkInstance& a_instance,
+                                            const VkPhysicalDevice& a_physicalDevice)
+{
+    // Free memory can only be queried using the memory budget
+    // extension, which also requires the instance to have been
+    // created with the physical device properties 2 extension,
+    // so return zero (ie. unknown) if either is not supported.
+    const auto getMemoryProperties2 = (PFN_vkGetPhysicalDeviceMemoryProperties2KHR)
+        vkGetInstanceProcAddr(a_instance, "vkGetPhysicalDeviceMemoryProperties2KHR");
+    if (!getMemoryProperties2 ||
+        !SupportsExtensions(a_physicalDevice, { VK_EXT_MEMORY_BUDGET_EXTENSION_NAME }))
+    {
+        return 0;
+    }
+
+    // Get the memory budget of each memory heap.
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT memoryBudget = {};
+    memoryBudget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+    VkPhysicalDeviceMemoryProperties2KHR memoryProperties = {};
+    memoryProperties.pNext = &memoryBudget;
+    memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2_KHR;
+    getMemoryProperties2(a_physicalDevice, &memoryProperties);
+
+    // Sum the remaining budget of all device local memory heaps.
+    VkDeviceSize availableBytes = 0;
+    for (uint32_t i = 0; i < memoryProperties.memoryProperties.memoryHeapCount; ++i)
+    {
+        const VkMemoryHeap& memoryHeap = memoryProperties.memoryProperties.memoryHeaps[i];
+        if ((memoryHeap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) &&
+            memoryBudget.heapBudget[i] > memoryBudget.heapUsage[i])
+        {
+            availableBytes += memoryBudget.heapBudget[i] - memoryBudget.heapUsage[i];
+        }
+    }
+
+    return availableBytes;
+}
+
+//--------------------------------------------------------------
+inline void PipelineVK::SelectTextureStorage()
+{
+    // Compact storage only applies to float buffers.
+    m_textureStorage = (m_bufferConfig.format == Buffer::Format::RGBA_FLOAT) ?
+                        m_bufferConfig.storage : Buffer::Storage::NATIVE;
+
+    // Use compact storage if free memory is known to be low.
+    if (m_textureStorage == Buffer::Storage::AUTO)
+    {
+        constexpr VkDeviceSize thresholdBytes = VkDeviceSize(BUFFER_STORAGE_AUTO_THRESHOLD_MB) << 20;
+        const VkDeviceSize availableBytes = GetAvailableMemoryBytes(m_instance,
+                                                                    m_physicalDevice);
+        m_textureStorage = (availableBytes && availableBytes < thresholdBytes) ?
+                            Buffer::Storage::RGBA_HALF : Buffer::Storage::NATIVE;
+    }
+
+    // Compact storage is converted from the shared buffer by a
+    // compute shader, so the graphics queue must support compute
+    // and the shared buffer must fit within a storage buffer.
+    if (m_textureStorage != Buffer::Storage::NATIVE)
+    {
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(m_physicalDevice,
+                                                 &queueFamilyCount,
+                                                 nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(m_physicalDevice,
+                                                 &queueFamilyCount,
+                                                 queueFamilies.data());
+
+        VkPhysicalDeviceProperties deviceProperties;
+        vkGetPhysicalDeviceProperties(m_physicalDevice,
+                                      &deviceProperties);
+
+        const VkQueueFlags queueFlags = queueFamilies[m_graphicsQueueFamilyIndex].queueFlags;
+        if (!(queueFlags & VK_QUEUE_COMPUTE_BIT) ||
+            Buffer::AlignedSizeBytes(m_bufferConfig) > deviceProperties.limits.maxStorageBufferRange)
+        {
+            m_textureStorage = Buffer::Storage::NATIVE;
+        }
+    }
+
+    // Storing 11/11/10 bit float images is an optional feature,
+    // so fall back to half float storage if it is not supported.
+    if (m_textureStorage == Buffer::Storage::R11G11B10_FLOAT)
+    {
+        VkPhysicalDeviceFeatures deviceFeatures;
+        vkGetPhysicalDeviceFeatures(m_physicalDevice,
+                                    &deviceFeatures);
+
+        VkFormatProperties formatProperties;
+        vkGetPhysicalDeviceFormatProperties(m_physicalDevice,
+                                            GetVkFormat(m_textureStorage),
+                                            &formatProperties);
+
+        if (deviceFeatures.shaderStorageImageExtendedFormats &&
+            (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT))
+        {
+            m_enabledFeatures.shaderStorageImageExtendedFormats = VK_TRUE;
+        }
+        else
+        {
+            m_textureStorage = Buffer::Storage::RGBA_HALF;
+        }
+    }
+
+    // Sampling block-compressed images is an optional feature,
+    // which is enabled if supported (otherwise creating the texture
+    // image fails and nothing is displayed, as for any other error).
+    if (Buffer::BlockSize(m_bufferConfig.format) > 1)
+    {
+        VkPhysicalDeviceFeatures deviceFeatures;
+        vkGetPhysicalDeviceFeatures(m_physicalDevice,
+                                    &deviceFeatures);
+        m_enabledFeatures.textureCompressionBC = deviceFeatures.textureCompressionBC;
+    }
+
+    // Set the texture format.
+    m_textureFormat = (m_textureStorage == Buffer::Storage::NATIVE) ?
+                       m_bufferFormat : GetVkFormat(m_textureStorage);
+}
+
+//--------------------------------------------------------------
+inline void PipelineVK::SelectPresentWait()
+{
+#if defined(VK_KHR_present_id) && defined(VK_KHR_present_wait)
+    // Present wait requires the present id and present wait device
+    // extensions and features, which can only be queried if the
+    // instance was created with the physical device properties 2
+    // extension, otherwise frames are waited for by idling the queue.
+    const std::vector<const char*> presentWaitExtensions = { VK_KHR_PRESENT_ID_EXTENSION_NAME,
+                                                             VK_KHR_PRESENT_WAIT_EXTENSION_NAME };
+    const auto getFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2KHR)
+        vkGetInstanceProcAddr(m_instance, "vkGetPhysicalDeviceFeatures2KHR");
+    if (!m_requestedPresentWait ||
+        !getFeatures2 ||
+        !SupportsExtensions(m_physicalDevice, presentWaitExtensions))
+    {
+        return;
+    }
+
+    // Get the present id and present wait features.
+    VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures = {};
+    presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+    VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures = {};
+    presentIdFeatures.pNext = &presentWaitFeatures;
+    presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+    VkPhysicalDeviceFeatures2KHR features = {};
+    features.pNext = &presentIdFeatures;
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+    getFeatures2(m_physicalDevice, &features);
+    if (!presentIdFeatures.presentId || !presentWaitFeatures.presentWait)
+    {
+        return;
+    }
+
+    // Enable the extensions when creating the logical device.
+    m_requiredExtensions.insert(m_requiredExtensions.end(),
+                                presentWaitExtensions.cbegin(),
+                                presentWaitExtensions.cend());
+    m_presentWaitEnabled = true;
+#else
+    // Present wait is not supported by these Vulkan headers.
+    (void)m_requestedPresentWait;
+#endif
+}
+
+//--------------------------------------------------------------
+inline void PipelineVK::SelectDisplayTiming()
+{
+#ifdef VK_GOOGLE_display_timing
+    // Frames can be held until a target time if the device supports
+    // the display timing extension, which is then enabled when the
+    // logical device is created, otherwise frames are presented as
+    // soon as possible (where the context schedules when they are).
+    if (!m_targetPresentMicroseconds ||
+        !SupportsExtensions(m_physicalDevice, { VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME }))
+    {
+        return;
+    }
+
+    m_requiredExtensions.push_back(VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME);
+    m_displayTimingEnabled = true;
+#endif
+}
+
 //--------------------------------------------------------------
 inline void PipelineVK::CreateLogicalDevice()
 {
@@ -585,14 +984,40 @@ inline void PipelineVK::CreateLogicalDevice()
     createInfo.ppEnabledExtensionNames = m_requiredExtensions.data();
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
+    createInfo.pEnabledFeatures = &m_enabledFeatures;
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 
+#if defined(VK_KHR_present_id) && defined(VK_KHR_present_wait)
+    // Enable the present id and present wait features.
+    VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures = {};
+    presentWaitFeatures.presentWait = VK_TRUE;
+    presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+    VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures = {};
+    presentIdFeatures.presentId = VK_TRUE;
+    presentIdFeatures.pNext = &presentWaitFeatures;
+    presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+    if (m_presentWaitEnabled)
+    {
+        createInfo.pNext = &presentIdFeatures;
+    }
+#endif
+
     // Create the device.
     VULKAN_ENSURE(vkCreateDevice(m_physicalDevice,
                                  &createInfo,
                                  nullptr,
                                  &m_device));
 
+#if defined(VK_KHR_present_id) && defined(VK_KHR_present_wait)
+    // Get the present wait function.
+    if (m_presentWaitEnabled)
+    {
+        m_waitForPresent = (PFN_vkWaitForPresentKHR)vkGetDeviceProcAddr(m_device,
+                                                                        "vkWaitForPresentKHR");
+        m_presentWaitEnabled = (m_waitForPresent != nullptr);
+    }
+#endif
+
     // Get the graphics queue.
     vkGetDeviceQueue(m_device,
                      m_graphicsQueueFamilyIndex,
@@ -615,8 +1040,12 @@ inline void PipelineVK::CreateSwapChain()
         m_swapChainExtent = m_surfaceCapabilities.currentExtent;
     }
 
-    // Determine the swap chain image count.
-    uint32_t imageCount = m_surfaceCapabilities.minImageCount + 1;
+    // Determine the swap chain image count, clamped to the range
+    // supported by the surface (which has no max if it is zero).
+    uint32_t imageCount = m_requestedImageCount ?
+                          m_requestedImageCount :
+                          m_surfaceCapabilities.minImageCount + 1;
+    imageCount = std::max(imageCount, m_surfaceCapabilities.minImageCount);
     if (m_surfaceCapabilities.maxImageCount &&
         m_surfaceCapabilities.maxImageCount <= imageCount)
     {
@@ -854,10 +1283,48 @@ inline const std::vector<uint32_t>& GetFragShaderBuffer()
             layout(location = 0) in vec2 fragUV;
             layout(location = 0) out vec4 color;
             layout(binding = 1) uniform sampler2D texSampler;
+            layout(push_constant) uniform Tiling
+            {
+                vec4 region;
+                uvec2 extent;
+                uint rowLength;
+                uint tileSize;
+                uint morton;
+            } tiling;
+
+            uint SpreadBits(uint v)
+            {
+                v = (v | (v << 2u)) & 0x33u;
+                v = (v | (v << 1u)) & 0x55u;
+                return v;
+            }
 
             void main()
             {
-                color = texture(texSampler, fragUV);
+                // Map the display to the region of the texture,
+                // which is black anywhere outside of the texture.
+                vec2 uv = tiling.region.xy + (fragUV * tiling.region.zw);
+                if (any(lessThan(uv, vec2(0.0))) || any(greaterThanEqual(uv, vec2(1.0))))
+                {
+                    color = vec4(0.0, 0.0, 0.0, 1.0);
+                    return;
+                }
+
+                if (tiling.tileSize <= 1u)
+                {
+                    color = texture(texSampler, uv);
+                    return;
+                }
+
+                // Find the index of the pixel in the tiled data.
+                uint tileSize = tiling.tileSize;
+                uvec2 xy = min(uvec2(uv * vec2(tiling.extent)), tiling.extent - 1u);
+                uvec2 t = xy % tileSize;
+                uint i = ((xy.y / tileSize) * tiling.rowLength * tileSize) +
+                         ((xy.x / tileSize) * tileSize * tileSize) +
+                         ((tiling.morton != 0u) ? (SpreadBits(t.x) | (SpreadBits(t.y) << 1u)) :
+                                                  ((t.y * tileSize) + t.x));
+                color = texelFetch(texSampler, ivec2(i % tiling.rowLength, i / tiling.rowLength), 0);
             }
         )";
         CompileShader(fragShaderSourceUint,
@@ -869,6 +1336,46 @@ inline const std::vector<uint32_t>& GetFragShaderBuffer()
     return s_fragShaderBuffer;
 }
 
+//--------------------------------------------------------------
+inline const std::vector<uint32_t>& GetConvertShaderBuffer(const Buffer::Storage& a_storage)
+{
+    // Each compact storage format needs a different compute shader,
+    // but the source of each one still only needs compiling once.
+    static std::vector<uint32_t> s_convertShaderBufferHalf;
+    static std::vector<uint32_t> s_convertShaderBufferPacked;
+    const bool packed = (a_storage == Buffer::Storage::R11G11B10_FLOAT);
+    std::vector<uint32_t>& convertShaderBuffer = packed ? s_convertShaderBufferPacked :
+                                                          s_convertShaderBufferHalf;
+    if (convertShaderBuffer.empty())
+    {
+        const std::string imageFormat = packed ? "r11f_g11f_b10f" : "rgba16f";
+        const std::string convertShaderSource =
+        R"(
+            #version 450
+
+            layout(local_size_x = 16, local_size_y = 16) in;
+            layout(std430, binding = 0) readonly buffer Pixels { vec4 pixels[]; };
+            layout(binding = 1, )" + imageFormat + R"() uniform writeonly image2D image;
+            layout(push_constant) uniform Constants { uvec2 extent; uint rowLength; } constants;
+
+            void main()
+            {
+                uvec2 xy = gl_GlobalInvocationID.xy;
+                if (xy.x < constants.extent.x && xy.y < constants.extent.y)
+                {
+                    imageStore(image, ivec2(xy), pixels[(xy.y * constants.rowLength) + xy.x]);
+                }
+            }
+        )";
+        CompileShader(convertShaderSource,
+                      "convert_shader",
+                      shaderc_glsl_compute_shader,
+                      convertShaderBuffer);
+    }
+
+    return convertShaderBuffer;
+}
+
 //--------------------------------------------------------------
 inline VkShaderModule CreateShaderModule(const VkDevice& a_device,
                                          const std::vector<uint32_t>& a_shaderCode)
@@ -997,10 +1504,19 @@ inline void PipelineVK::CreateGraphicsPipeline()
     dynamicState.pDynamicStates = dynamicStates.data();
     dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
 
+    // Describe the push constants used to map the region of the
+    // texture to the display, followed by those used to de-tile it.
+    VkPushConstantRange pushConstantRange = {};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = sizeof(TextureRegion) + sizeof(TextureTiling);
+
     // Describe the pipeline layout.
     VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
     pipelineLayoutInfo.setLayoutCount = 1;
     pipelineLayoutInfo.pSetLayouts = &m_descriptorSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
     pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 
     // Create the pipeline layout.
@@ -1110,15 +1626,19 @@ inline void PipelineVK::CreateTextureImage()
     // Describe the image.
     VkImageCreateInfo imageInfo = {};
     imageInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageInfo.extent.width = m_bufferConfig.width;
-    imageInfo.extent.height = m_bufferConfig.height;
+    imageInfo.extent.width = GetTextureWidth(m_bufferConfig);
+    imageInfo.extent.height = GetTextureHeight(m_bufferConfig);
     imageInfo.extent.depth = 1;
     imageInfo.mipLevels = 1;
     imageInfo.arrayLayers = 1;
-    imageInfo.format = m_bufferFormat;
+    imageInfo.format = m_textureFormat;
     imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
     imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
     imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    if (m_textureStorage != Buffer::Storage::NATIVE)
+    {
+        imageInfo.usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+    }
     imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
     imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
     imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -1160,7 +1680,7 @@ inline void PipelineVK::CreateTextureImage()
 inline void PipelineVK::CreateTextureImageView()
 {
     m_textureImageView = CreateImageView(m_textureImage,
-                                         m_bufferFormat,
+                                         m_textureFormat,
                                          m_device);
 }
 
@@ -1350,6 +1870,150 @@ inline void PipelineVK::CreateDescriptorSets()
     }
 }
 
+//--------------------------------------------------------------
+inline void PipelineVK::CreateConvertPipeline()
+{
+    // Only compact storage needs to be converted.
+    if (m_textureStorage == Buffer::Storage::NATIVE)
+    {
+        return;
+    }
+
+    // Describe the shared buffer descriptor set layout binding.
+    VkDescriptorSetLayoutBinding bufferLayoutBinding = {};
+    bufferLayoutBinding.binding = 0;
+    bufferLayoutBinding.descriptorCount = 1;
+    bufferLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bufferLayoutBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    // Describe the texture image descriptor set layout binding.
+    VkDescriptorSetLayoutBinding imageLayoutBinding = {};
+    imageLayoutBinding.binding = 1;
+    imageLayoutBinding.descriptorCount = 1;
+    imageLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    imageLayoutBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    // Describe the descriptor set layout.
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    std::array<VkDescriptorSetLayoutBinding, 2> bindings = { bufferLayoutBinding,
+                                                             imageLayoutBinding };
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+
+    // Create the descriptor set layout.
+    VULKAN_ENSURE(vkCreateDescriptorSetLayout(m_device,
+                                              &layoutInfo,
+                                              nullptr,
+                                              &m_convertDescriptorSetLayout));
+
+    // Describe the push constant range (extent and row length).
+    VkPushConstantRange pushConstantRange = {};
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = 3 * sizeof(uint32_t);
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    // Describe the pipeline layout.
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &m_convertDescriptorSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+
+    // Create the pipeline layout.
+    VULKAN_ENSURE(vkCreatePipelineLayout(m_device,
+                                         &pipelineLayoutInfo,
+                                         nullptr,
+                                         &m_convertPipelineLayout));
+
+    // Create the compute shader module.
+    const std::vector<uint32_t>& convertShaderBuffer = GetConvertShaderBuffer(m_textureStorage);
+    VkShaderModule convertShaderModule = CreateShaderModule(m_device, convertShaderBuffer);
+
+    // Describe the compute pipeline.
+    VkComputePipelineCreateInfo pipelineInfo = {};
+    pipelineInfo.stage.pName = "main";
+    pipelineInfo.stage.module = convertShaderModule;
+    pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.layout = m_convertPipelineLayout;
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+
+    // Create the compute pipeline.
+    VULKAN_ENSURE(vkCreateComputePipelines(m_device,
+                                           VK_NULL_HANDLE,
+                                           1,
+                                           &pipelineInfo,
+                                           nullptr,
+                                           &m_convertPipeline));
+
+    // Destroy the compute shader module.
+    vkDestroyShaderModule(m_device, convertShaderModule, nullptr);
+
+    // Describe the descriptor pool sizes.
+    std::array<VkDescriptorPoolSize, 2> poolSizes = {};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSizes[0].descriptorCount = 1;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    poolSizes[1].descriptorCount = 1;
+
+    // Describe the descriptor pool.
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+    poolInfo.maxSets = 1;
+
+    // Create the descriptor pool.
+    VULKAN_ENSURE(vkCreateDescriptorPool(m_device,
+                                         &poolInfo,
+                                         nullptr,
+                                         &m_convertDescriptorPool));
+
+    // Describe the descriptor set.
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &m_convertDescriptorSetLayout;
+    allocInfo.descriptorPool = m_convertDescriptorPool;
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+
+    // Create the descriptor set.
+    VULKAN_ENSURE(vkAllocateDescriptorSets(m_device,
+                                           &allocInfo,
+                                           &m_convertDescriptorSet));
+
+    // Update the descriptor set.
+    VkDescriptorBufferInfo bufferInfo = {};
+    bufferInfo.buffer = m_sharedBuffer;
+    bufferInfo.offset = 0;
+    bufferInfo.range = VK_WHOLE_SIZE;
+
+    VkDescriptorImageInfo imageInfo = {};
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+    imageInfo.imageView = m_textureImageView;
+
+    std::array<VkWriteDescriptorSet, 2> descriptorWrites = {};
+    descriptorWrites[0].pBufferInfo = &bufferInfo;
+    descriptorWrites[0].dstSet = m_convertDescriptorSet;
+    descriptorWrites[0].dstBinding = 0;
+    descriptorWrites[0].descriptorCount = 1;
+    descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrites[1].pImageInfo = &imageInfo;
+    descriptorWrites[1].dstSet = m_convertDescriptorSet;
+    descriptorWrites[1].dstBinding = 1;
+    descriptorWrites[1].descriptorCount = 1;
+    descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+
+    vkUpdateDescriptorSets(m_device,
+                           static_cast<uint32_t>(descriptorWrites.size()),
+                           descriptorWrites.data(),
+                           0,
+                           nullptr);
+}
+
 //--------------------------------------------------------------
 inline void PipelineVK::CreateCommandBuffers()
 {
@@ -1383,6 +2047,7 @@ inline void PipelineVK::CreateSyncObjects()
     m_imageAvailableSemaphores.resize(N);
     m_renderFinishedSemaphores.resize(N);
     m_inFlightFences.resize(N);
+    m_submitTimes.resize(N);
     for (size_t n = 0; n < N; ++n)
     {
         VULKAN_ENSURE(vkCreateSemaphore(m_device,
@@ -1553,6 +2218,22 @@ inline void TransitionImageLayout(const VkImage& a_image,
         barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
         barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
     }
+    else if (a_oldLayout == VK_IMAGE_LAYOUT_UNDEFINED &&
+             a_newLayout == VK_IMAGE_LAYOUT_GENERAL)
+    {
+        sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        destinationStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    }
+    else if (a_oldLayout == VK_IMAGE_LAYOUT_GENERAL &&
+             a_newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+    {
+        sourceStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    }
     assert(destinationStage);
     assert(sourceStage);
 
@@ -1569,15 +2250,139 @@ inline void TransitionImageLayout(const VkImage& a_image,
                          &barrier);
 }
 
+//--------------------------------------------------------------
+inline VkBufferUsageFlags PipelineVK::GetSharedBufferUsage() const
+{
+    // Compact storage reads the shared buffer from a compute shader.
+    return (m_textureStorage == Buffer::Storage::NATIVE) ?
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT :
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+}
+
+//--------------------------------------------------------------
+inline uint32_t PipelineVK::GetSharedBufferRowLength() const
+{
+    // Measured in pixels, so the aligned pitch must be a multiple
+    // of the pixel (or block) size, which holds for power of two
+    // alignments, and each block is counted as its width in pixels.
+    const uint32_t bytesPerBlock = Buffer::BytesPerBlock(m_bufferConfig.format);
+    assert(Buffer::AlignedPitchBytes(m_bufferConfig) % bytesPerBlock == 0);
+    return static_cast<uint32_t>(Buffer::AlignedPitchBytes(m_bufferConfig) / bytesPerBlock) *
+           Buffer::BlockSize(m_bufferConfig.format);
+}
+
+//--------------------------------------------------------------
+inline void PipelineVK::CopySharedBufferToTextureImage(const VkCommandBuffer& a_commandBuffer)
+{
+    // Transition the texture image to a copy destination.
+    TransitionImageLayout(m_textureImage,
+                          VK_IMAGE_LAYOUT_UNDEFINED,
+                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                          a_commandBuffer);
+
+    // Describe the buffer copy.
+    VkBufferImageCopy region = {};
+    region.bufferOffset = 0;
+    region.bufferRowLength = GetSharedBufferRowLength();
+    region.bufferImageHeight = 0;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = { 0, 0, 0 };
+    region.imageExtent = { GetTextureWidth(m_bufferConfig),
+                           GetTextureHeight(m_bufferConfig),
+                           1 };
+
+    // Copy the shared buffer to the texture image.
+    vkCmdCopyBufferToImage(a_commandBuffer,
+                           m_sharedBuffer,
+                           m_textureImage,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           1,
+                           &region);
+
+    // Transition the texture image back to read only.
+    TransitionImageLayout(m_textureImage,
+                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                          a_commandBuffer);
+}
+
+//--------------------------------------------------------------
+inline void PipelineVK::ConvertSharedBufferToTextureImage(const VkCommandBuffer& a_commandBuffer)
+{
+    // Transition the texture image to a storage image.
+    TransitionImageLayout(m_textureImage,
+                          VK_IMAGE_LAYOUT_UNDEFINED,
+                          VK_IMAGE_LAYOUT_GENERAL,
+                          a_commandBuffer);
+
+    // Bind the compute pipeline and descriptor set.
+    vkCmdBindPipeline(a_commandBuffer,
+                      VK_PIPELINE_BIND_POINT_COMPUTE,
+                      m_convertPipeline);
+    vkCmdBindDescriptorSets(a_commandBuffer,
+                            VK_PIPELINE_BIND_POINT_COMPUTE,
+                            m_convertPipelineLayout,
+                            0,
+                            1,
+                            &m_convertDescriptorSet,
+                            0,
+                            nullptr);
+
+    // Push the texture extent and buffer row length.
+    const uint32_t textureWidth = GetTextureWidth(m_bufferConfig);
+    const uint32_t textureHeight = GetTextureHeight(m_bufferConfig);
+    const uint32_t constants[] = { textureWidth,
+                                   textureHeight,
+                                   GetSharedBufferRowLength() };
+    vkCmdPushConstants(a_commandBuffer,
+                       m_convertPipelineLayout,
+                       VK_SHADER_STAGE_COMPUTE_BIT,
+                       0,
+                       sizeof(constants),
+                       constants);
+
+    // Convert each pixel using 16x16 pixel work groups.
+    vkCmdDispatch(a_commandBuffer,
+                  (textureWidth + 15) / 16,
+                  (textureHeight + 15) / 16,
+                  1);
+
+    // Transition the texture image back to read only.
+    TransitionImageLayout(m_textureImage,
+                          VK_IMAGE_LAYOUT_GENERAL,
+                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                          a_commandBuffer);
+}
+
 //--------------------------------------------------------------
 inline void PipelineVK::RenderFrame()
 {
+    // Present any frame that is still deferred, so it is not lost.
+    PresentDeferredFrame();
+
+    // Measure the latency of earlier frames that have completed,
+    // which complete in the order they were submitted (starting
+    // with the last frame which used this index).
+    for (uint32_t n = 0; n < N; ++n)
+    {
+        const uint32_t frameIndex = (m_currentFrameIndex + n) % N;
+        if (vkGetFenceStatus(m_device, m_inFlightFences[frameIndex]) != VK_SUCCESS)
+        {
+            break;
+        }
+        MeasureFrameLatency(frameIndex);
+    }
+
     // Wait for the last frame which used this index to complete.
     VULKAN_ENSURE(vkWaitForFences(m_device,
                                   1,
                                   &m_inFlightFences[m_currentFrameIndex],
                                   VK_TRUE,
                                   UINT64_MAX));
+    MeasureFrameLatency(m_currentFrameIndex);
 
     // Get the next image index.
     uint32_t imageIndex;
@@ -1605,39 +2410,16 @@ inline void PipelineVK::RenderFrame()
         VULKAN_ENSURE(vkBeginCommandBuffer(commandBuffer,
                                            &beginInfo));
 
-        // Transition the texture image to a copy destination.
-        TransitionImageLayout(m_textureImage,
-                              VK_IMAGE_LAYOUT_UNDEFINED,
-                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                              commandBuffer);
-
-        // Describe the buffer copy.
-        VkBufferImageCopy region = {};
-        region.bufferOffset = 0;
-        region.bufferRowLength = 0;
-        region.bufferImageHeight = 0;
-        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        region.imageSubresource.mipLevel = 0;
-        region.imageSubresource.baseArrayLayer = 0;
-        region.imageSubresource.layerCount = 1;
-        region.imageOffset = { 0, 0, 0 };
-        region.imageExtent = { m_bufferConfig.width,
-                               m_bufferConfig.height,
-                               1 };
-
-        // Copy the shared buffer to the texture image.
-        vkCmdCopyBufferToImage(commandBuffer,
-                               m_sharedBuffer,
-                               m_textureImage,
-                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                               1,
-                               &region);
-
-        // Transition the texture image back to read only.
-        TransitionImageLayout(m_textureImage,
-                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                              commandBuffer);
+        // Copy the shared buffer to the texture image, converting
+        // it with a compute shader if using compact storage.
+        if (m_textureStorage == Buffer::Storage::NATIVE)
+        {
+            CopySharedBufferToTextureImage(commandBuffer);
+        }
+        else
+        {
+            ConvertSharedBufferToTextureImage(commandBuffer);
+        }
 
         // Describe the render pass.
         VkRenderPassBeginInfo renderPassInfo = {};
@@ -1701,6 +2483,20 @@ inline void PipelineVK::RenderFrame()
                                 0,
                                 nullptr);
 
+        // Push the values used to map and de-tile the texture.
+        vkCmdPushConstants(commandBuffer,
+                           m_pipelineLayout,
+                           VK_SHADER_STAGE_FRAGMENT_BIT,
+                           0,
+                           sizeof(TextureRegion),
+                           &m_textureRegion);
+        vkCmdPushConstants(commandBuffer,
+                           m_pipelineLayout,
+                           VK_SHADER_STAGE_FRAGMENT_BIT,
+                           sizeof(TextureRegion),
+                           sizeof(TextureTiling),
+                           &m_textureTiling);
+
         // Draw the indexed quad.
         vkCmdDrawIndexed(commandBuffer,
                          static_cast<uint32_t>(QuadIndices.size()),
@@ -1732,23 +2528,94 @@ inline void PipelineVK::RenderFrame()
                                 1, 
                                 &submitInfo,
                                 m_inFlightFences[m_currentFrameIndex]));
+    m_submitTimes[m_currentFrameIndex] = Clock::now();
 
+    // Present the rendered image, unless it is deferred until the
+    // frames of other contexts have been rendered.
+    if (*m_deferPresent)
+    {
+        m_deferredSemaphore = signalSemaphores[0];
+        m_deferredImageIndex = imageIndex;
+        m_hasDeferredFrame = true;
+    }
+    else
+    {
+        PresentFrame(imageIndex, signalSemaphores[0]);
+    }
+
+    // Cycle to the next frame index.
+    m_currentFrameIndex = (m_currentFrameIndex + 1) % N;
+}
+
+//--------------------------------------------------------------
+inline void PipelineVK::PresentFrame(uint32_t a_imageIndex,
+                                     VkSemaphore a_waitSemaphore)
+{
     // Describe the present.
     VkSwapchainKHR swapChains[] = { m_swapChain };
     VkPresentInfoKHR presentInfo = {};
     presentInfo.swapchainCount = 1;
     presentInfo.pSwapchains = swapChains;
-    presentInfo.pImageIndices = &imageIndex;
+    presentInfo.pImageIndices = &a_imageIndex;
     presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
+    presentInfo.pWaitSemaphores = &a_waitSemaphore;
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 
+#if defined(VK_KHR_present_id) && defined(VK_KHR_present_wait)
+    // Identify each present, so it can be waited for.
+    const uint64_t presentId = m_presentId + 1;
+    VkPresentIdKHR presentIdInfo = {};
+    presentIdInfo.swapchainCount = 1;
+    presentIdInfo.pPresentIds = &presentId;
+    presentIdInfo.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+    if (m_presentWaitEnabled)
+    {
+        presentInfo.pNext = &presentIdInfo;
+        m_presentId = presentId;
+    }
+#endif
+
+#ifdef VK_GOOGLE_display_timing
+    // Hold the frame until its target time (which uses the same
+    // monotonic clock as the context), where one was requested.
+    VkPresentTimeGOOGLE presentTime = {};
+    presentTime.presentID = ++m_displayTimingId;
+    presentTime.desiredPresentTime = m_targetPresentMicroseconds ?
+                                     *m_targetPresentMicroseconds * 1000 : 0;
+    VkPresentTimesInfoGOOGLE presentTimesInfo = {};
+    presentTimesInfo.swapchainCount = 1;
+    presentTimesInfo.pTimes = &presentTime;
+    presentTimesInfo.pNext = presentInfo.pNext;
+    presentTimesInfo.sType = VK_STRUCTURE_TYPE_PRESENT_TIMES_INFO_GOOGLE;
+    if (m_displayTimingEnabled && presentTime.desiredPresentTime)
+    {
+        presentInfo.pNext = &presentTimesInfo;
+    }
+#endif
+
     // Present the rendered image on the display.
     VULKAN_ENSURE(vkQueuePresentKHR(m_presentQueue,
                                     &presentInfo));
+}
 
-    // Cycle to the next frame index.
-    m_currentFrameIndex = (m_currentFrameIndex + 1) % N;
+//--------------------------------------------------------------
+inline void PipelineVK::MeasureFrameLatency(uint32_t a_frameIndex)
+{
+    // Ignore frames that were not submitted or already measured.
+    if (!m_latencyCounters ||
+        m_submitTimes[a_frameIndex] == Clock::time_point())
+    {
+        return;
+    }
+
+    using namespace std::chrono;
+    const auto latency = Clock::now() - m_submitTimes[a_frameIndex];
+    const uint64_t latencyMicroseconds = duration_cast<microseconds>(latency).count();
+    m_latencyCounters->framesMeasured++;
+    m_latencyCounters->totalMicroseconds += latencyMicroseconds;
+    m_latencyCounters->maxMicroseconds = std::max(m_latencyCounters->maxMicroseconds,
+                                                  latencyMicroseconds);
+    m_submitTimes[a_frameIndex] = Clock::time_point();
 }
 
 } // namespace Vulkan
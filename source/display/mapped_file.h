@@ -0,0 +1,46 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <memory>
+#include <stdint.h>
+#include <string>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Display
+{
+
+//--------------------------------------------------------------
+// Read only view of an entire file mapped into memory, so pages
+// are only read from the file when they are first accessed.
+//--------------------------------------------------------------
+class MappedFile
+{
+public:
+    // Platform specific factory function opens and maps the file,
+    // returning nullptr if the file cannot be opened or mapped.
+    static std::unique_ptr<MappedFile> Open(const std::string& a_filePathUTF8);
+
+    // Public destructor for unique_ptr.
+    virtual ~MappedFile() = default;
+
+    virtual const uint8_t* GetData() const = 0;
+    virtual uint64_t GetSize() const = 0;
+
+protected:
+    MappedFile() = default;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
+
+} // namespace Display
+} // namespace Simple
@@ -13,11 +13,55 @@
 #define GLAD_GL_IMPLEMENTATION
 #include <display/graphics/opengl/glad/gl_core_4.6.h>
 #include <display/graphics/opengl/buffer_gl_core.h>
+#include <display/graphics/opengl/extensions_gl.h>
+#include <display/graphics/opengl/frame_queue_gl.h>
 #include <GL/glx.h>
+#include <cstring>
+
+#include "present_timing_glx.h"
 
 using namespace Simple::Display;
 using namespace Simple::Display::OpenGL;
 
+//--------------------------------------------------------------
+static Context::PresentMode SetSwapInterval(::Display* a_nativeDisplay,
+                                            ::Window a_nativeWindow,
+                                            Context::PresentMode a_presentMode)
+{
+    // Swap intervals require GLX_EXT_swap_control, without which
+    // the driver default (usually vertical sync) remains in effect.
+    const int screen = DefaultScreen(a_nativeDisplay);
+    const char* extensions = ::glXQueryExtensionsString(a_nativeDisplay,
+                                                        screen);
+    using SwapIntervalFunction = PFNGLXSWAPINTERVALEXTPROC;
+    auto swapIntervalFunction = (SwapIntervalFunction)::glXGetProcAddressARB((const GLubyte*)"glXSwapIntervalEXT");
+    if (!swapIntervalFunction ||
+        !IsExtensionSupported(extensions, "GLX_EXT_swap_control"))
+    {
+        return Context::PresentMode::FIFO;
+    }
+
+    // Adaptive vertical sync requires GLX_EXT_swap_control_tear,
+    // and mailbox presentation is not supported so it falls back
+    // to vertical sync (as opposed to the immediate mode, which
+    // can tear), in both cases matching the Vulkan fallbacks.
+    int swapInterval = 1;
+    Context::PresentMode presentMode = Context::PresentMode::FIFO;
+    if (a_presentMode == Context::PresentMode::IMMEDIATE)
+    {
+        swapInterval = 0;
+        presentMode = Context::PresentMode::IMMEDIATE;
+    }
+    else if (a_presentMode == Context::PresentMode::FIFO_RELAXED &&
+             IsExtensionSupported(extensions, "GLX_EXT_swap_control_tear"))
+    {
+        swapInterval = -1;
+        presentMode = Context::PresentMode::FIFO_RELAXED;
+    }
+    swapIntervalFunction(a_nativeDisplay, a_nativeWindow, swapInterval);
+    return presentMode;
+}
+
 //--------------------------------------------------------------
 ContextLinuxGL::ContextLinuxGL(const Context::Config& a_config)
 {
@@ -55,11 +99,27 @@ ContextLinuxGL::ContextLinuxGL(const Context::Config& a_config)
     // Initialize glad.
     gladLoaderLoadGL();
 
+    // Set the swap interval.
+    m_presentMode = SetSwapInterval(nativeDisplay,
+                                    *nativeWindow,
+                                    a_config.presentMode);
+
     // Create the buffer.
     using namespace std;
     using BufferImpl = BufferGLCore;
     const Buffer::Config& bufferConfig = a_config.bufferConfig;
-    m_buffer = new Buffer(make_unique<BufferImpl>(bufferConfig));
+    unique_ptr<BufferImpl> bufferImpl = make_unique<BufferImpl>(bufferConfig);
+    m_bufferGL = bufferImpl.get();
+    m_buffer = new Buffer(move(bufferImpl));
+
+    // Create the frame queue.
+    m_frameQueue = new FrameQueueGL(a_config.framesInFlight,
+                                    m_latencyCounters);
+
+    // Create the present timing.
+    m_presentTimingGLX = new PresentTimingGLX(nativeDisplay,
+                                              *nativeWindow,
+                                              m_presentTiming);
 
     // Show the window.
     m_window->Show();
@@ -75,6 +135,15 @@ ContextLinuxGL::~ContextLinuxGL()
     // Destroy the buffer.
     delete m_buffer;
     m_buffer = nullptr;
+    m_bufferGL = nullptr;
+
+    // Destroy the frame queue.
+    delete m_frameQueue;
+    m_frameQueue = nullptr;
+
+    // Destroy the present timing.
+    delete m_presentTimingGLX;
+    m_presentTimingGLX = nullptr;
 
     // Get the native display handle.
     ::Display* nativeDisplay = (::Display*)m_window->GetNativeDisplayHandle();
@@ -108,14 +177,47 @@ Simple::Display::Window* ContextLinuxGL::GetWindow() const
 //--------------------------------------------------------------
 void ContextLinuxGL::OnFrameStart()
 {
-    // Process all pending window events.
+    // Process all pending window events, including those of each
+    // mirror window (which only processes its own events).
     m_window->PumpWindowEventsUntilEmpty();
+    for (const MirrorWindow& mirrorWindow : m_mirrorWindows)
+    {
+        mirrorWindow.window->PumpWindowEventsUntilEmpty();
+    }
+
+    // Update the timing of frames that reached the display.
+    m_presentTimingGLX->Update();
 }
 
 //--------------------------------------------------------------
 void ContextLinuxGL::OnFrameEnded()
 {
-    if (m_window->IsMinimized() || m_window->IsClosed())
+    RenderFrame();
+    PresentFrame();
+}
+
+//--------------------------------------------------------------
+bool ContextLinuxGL::IsFrameSlotAvailable()
+{
+    return m_frameQueue->IsFrameSlotAvailable();
+}
+
+//--------------------------------------------------------------
+bool ContextLinuxGL::WaitForFramePresented()
+{
+    MakeCurrent(*m_window);
+    m_frameQueue->WaitForFramePresented();
+    return true;
+}
+
+//--------------------------------------------------------------
+void ContextLinuxGL::RenderFrame()
+{
+    // Buffers are still rendered while the window is minimized if
+    // they are mirrored, as they are uploaded when they are rendered.
+    m_isFrameRendered = false;
+    if (m_window->IsClosed() ||
+        (m_window->IsMinimized() && m_mirrorWindows.empty()))
     {
         return;
     }
@@ -125,19 +227,124 @@ void ContextLinuxGL::OnFrameEnded()
     uint32_t displayHeight = 0;
     m_window->GetDisplayDimensions(displayWidth, displayHeight);
 
+    // Activate the rendering context, which may not be current if
+    // this thread also renders other contexts (see ContextGroup).
+    MakeCurrent(*m_window);
+
+    // Wait until a frame slot is available.
+    m_frameQueue->WaitForFrameSlot();
+
     // Render the pixel buffer.
     m_buffer->Render(displayWidth, displayHeight);
 
+    // Draw the textures uploaded by the buffer to each mirror window,
+    // using the same rendering context (so nothing is uploaded again).
+    for (const MirrorWindow& mirrorWindow : m_mirrorWindows)
+    {
+        Window& window = *mirrorWindow.window;
+        if (window.IsMinimized() || window.IsClosed())
+        {
+            continue;
+        }
+
+        window.GetDisplayDimensions(displayWidth, displayHeight);
+        MakeCurrent(window);
+        m_bufferGL->RenderMirror(displayWidth,
+                                 displayHeight,
+                                 mirrorWindow.viewport);
+    }
+
+    // Flush the commands so the GPU renders them while any other
+    // contexts are being rendered.
+    glFlush();
+    m_isFrameRendered = true;
+}
+
+//--------------------------------------------------------------
+void ContextLinuxGL::PresentFrame()
+{
+    if (!m_isFrameRendered)
+    {
+        return;
+    }
+    m_isFrameRendered = false;
+
     // Get the native display handle.
     ::Display* nativeDisplay = (::Display*)m_window->GetNativeDisplayHandle();
     assert(nativeDisplay);
 
-    // Get the native window handle.
-    ::Window* nativeWindow = (::Window*)m_window->GetNativeWindowHandle();
-    assert(nativeWindow);
+    // Present the image rendered to each mirror window.
+    for (const MirrorWindow& mirrorWindow : m_mirrorWindows)
+    {
+        const Window& window = *mirrorWindow.window;
+        if (!window.IsMinimized() && !window.IsClosed())
+        {
+            glXSwapBuffers(nativeDisplay, *(::Window*)window.GetNativeWindowHandle());
+        }
+    }
+
+    // Present the rendered image on the display, at the refresh
+    // closest to the target time of frames queued to be presented
+    // at one (see Context::QueueFrame).
+    MakeCurrent(*m_window);
+    if (!m_window->IsMinimized())
+    {
+        ::Window* nativeWindow = (::Window*)m_window->GetNativeWindowHandle();
+        assert(nativeWindow);
+        if (!m_presentTimingGLX->SwapBuffersAt(m_targetPresentMicroseconds))
+        {
+            glXSwapBuffers(nativeDisplay, *nativeWindow);
+        }
+        m_presentTimingGLX->OnFrameSwapped();
+    }
+
+    // Track the frame until it is completed.
+    m_frameQueue->OnFramePresented();
+}
+
+//--------------------------------------------------------------
+bool ContextLinuxGL::AddMirrorWindow(Window& a_window)
+{
+    // Mirror windows share the display connection of this thread
+    // (and so this rendering context), and present at the same rate.
+    ::Display* nativeDisplay = (::Display*)a_window.GetNativeDisplayHandle();
+    ::Window* nativeWindow = (::Window*)a_window.GetNativeWindowHandle();
+    if (nativeDisplay != (::Display*)m_window->GetNativeDisplayHandle() || !nativeWindow)
+    {
+        return false;
+    }
+
+    MakeCurrent(a_window);
+    SetSwapInterval(nativeDisplay, *nativeWindow, m_presentMode);
+    MakeCurrent(*m_window);
+
+    // Textures outside the viewport of the buffer may be inside the
+    // viewport of the mirror, so they must all be uploaded from now.
+    m_bufferGL->SetMirrored(true);
+    return true;
+}
 
-    // Present the rendered image on the display.
-    glXSwapBuffers(nativeDisplay, *nativeWindow);
+//--------------------------------------------------------------
+void ContextLinuxGL::RemoveMirrorWindow(Window& a_window)
+{
+    // Never leave the rendering context current to a destroyed window.
+    (void)a_window;
+    MakeCurrent(*m_window);
+    m_bufferGL->SetMirrored(m_mirrorWindows.size() > 1);
+}
+
+//--------------------------------------------------------------
+void ContextLinuxGL::MakeCurrent(const Window& a_window) const
+{
+    ::Window* nativeWindow = (::Window*)a_window.GetNativeWindowHandle();
+    assert(nativeWindow);
+    if (::glXGetCurrentContext() != m_glxContext ||
+        ::glXGetCurrentDrawable() != *nativeWindow)
+    {
+        ::Display* nativeDisplay = (::Display*)a_window.GetNativeDisplayHandle();
+        assert(nativeDisplay);
+        ::glXMakeCurrent(nativeDisplay, *nativeWindow, m_glxContext);
+    }
 }
 
 #endif // OPENGL_SUPPORTED
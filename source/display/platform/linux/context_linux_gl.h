@@ -20,6 +20,10 @@ namespace Display
 namespace OpenGL
 {
 
+class BufferGLCore;
+class FrameQueueGL;
+class PresentTimingGLX;
+
 //--------------------------------------------------------------
 class ContextLinuxGL : public Context::Implementation
 {
@@ -37,10 +41,25 @@ protected:
     void OnFrameStart() override;
     void OnFrameEnded() override;
 
+    bool IsFrameSlotAvailable() override;
+    bool WaitForFramePresented() override;
+
+    void RenderFrame() override;
+    void PresentFrame() override;
+
+    bool AddMirrorWindow(Window& a_window) override;
+    void RemoveMirrorWindow(Window& a_window) override;
+
 private:
+    void MakeCurrent(const Window& a_window) const;
+
     Buffer* m_buffer = nullptr;
+    BufferGLCore* m_bufferGL = nullptr;
     Window* m_window = nullptr;
+    FrameQueueGL* m_frameQueue = nullptr;
+    PresentTimingGLX* m_presentTimingGLX = nullptr;
     GLXContext m_glxContext = nullptr;
+    bool m_isFrameRendered = false;
 };
 
 } // namespace OpenGL
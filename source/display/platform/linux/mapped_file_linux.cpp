@@ -0,0 +1,86 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <display/mapped_file.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Simple::Display;
+
+//--------------------------------------------------------------
+class MappedFileLinux : public MappedFile
+{
+public:
+    MappedFileLinux(void* a_data, uint64_t a_size);
+    ~MappedFileLinux() override;
+
+    const uint8_t* GetData() const override;
+    uint64_t GetSize() const override;
+
+private:
+    void* const m_data;
+    const uint64_t m_size;
+};
+
+//--------------------------------------------------------------
+std::unique_ptr<MappedFile> MappedFile::Open(const std::string& a_filePathUTF8)
+{
+    const int file = open(a_filePathUTF8.c_str(), O_RDONLY);
+    if (file == -1)
+    {
+        return nullptr;
+    }
+
+    struct stat fileStat = {};
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        close(file);
+        return nullptr;
+    }
+
+    // The mapping remains valid after the file is closed.
+    const uint64_t size = static_cast<uint64_t>(fileStat.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    // Tiles are accessed out of order, so disable read ahead.
+    madvise(data, size, MADV_RANDOM);
+    return std::unique_ptr<MappedFile>(new MappedFileLinux(data, size));
+}
+
+//--------------------------------------------------------------
+MappedFileLinux::MappedFileLinux(void* a_data, uint64_t a_size)
+    : m_data(a_data)
+    , m_size(a_size)
+{
+}
+
+//--------------------------------------------------------------
+MappedFileLinux::~MappedFileLinux()
+{
+    munmap(m_data, m_size);
+}
+
+//--------------------------------------------------------------
+const uint8_t* MappedFileLinux::GetData() const
+{
+    return static_cast<const uint8_t*>(m_data);
+}
+
+//--------------------------------------------------------------
+uint64_t MappedFileLinux::GetSize() const
+{
+    return m_size;
+}
@@ -0,0 +1,217 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <display/context_implementation.h>
+
+#include <algorithm>
+#include <cstring>
+#include <time.h>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Display
+{
+namespace OpenGL
+{
+
+//--------------------------------------------------------------
+// Measures when each frame swapped reaches the display, using the
+// system time (UST), refresh counter (MSC), and swap counter (SBC)
+// of GLX_OML_sync_control, which are updated by the X server as it
+// receives Present CompleteNotify events for the drawable.
+//--------------------------------------------------------------
+class PresentTimingGLX
+{
+public:
+    PresentTimingGLX(::Display* a_nativeDisplay,
+                     GLXDrawable a_drawable,
+                     Context::PresentTiming& a_presentTiming);
+
+    PresentTimingGLX(const PresentTimingGLX&) = delete;
+    PresentTimingGLX& operator=(const PresentTimingGLX&) = delete;
+
+    // Call after swapping each frame, and to update the timing.
+    void OnFrameSwapped();
+    void Update();
+
+    // Swap the frame at the refresh closest to the target time, or
+    // return false if it is unknown (so it can be swapped normally).
+    bool SwapBuffersAt(uint64_t a_targetMicroseconds);
+
+private:
+    ::Display* const m_nativeDisplay;
+    const GLXDrawable m_drawable;
+    Context::PresentTiming& m_presentTiming;
+
+    PFNGLXGETSYNCVALUESOMLPROC m_getSyncValues = nullptr;
+    PFNGLXWAITFORSBCOMLPROC m_waitForSbc = nullptr;
+    PFNGLXSWAPBUFFERSMSCOMLPROC m_swapBuffersMsc = nullptr;
+
+    // Swap counts of the first and last frames swapped and displayed.
+    int64_t m_initialSbc = 0;
+    int64_t m_swappedSbc = 0;
+    int64_t m_presentedSbc = 0;
+    int64_t m_presentedMsc = 0;
+    int64_t m_presentedUst = 0;
+    bool m_hadPendingSwaps = false;
+};
+
+//--------------------------------------------------------------
+inline PresentTimingGLX::PresentTimingGLX(::Display* a_nativeDisplay,
+                                          GLXDrawable a_drawable,
+                                          Context::PresentTiming& a_presentTiming)
+    : m_nativeDisplay(a_nativeDisplay)
+    , m_drawable(a_drawable)
+    , m_presentTiming(a_presentTiming)
+{
+    // Present timing requires GLX_OML_sync_control, without which
+    // the timing remains zero (ie. unknown).
+    const char* extensions = ::glXQueryExtensionsString(m_nativeDisplay,
+                                                        DefaultScreen(m_nativeDisplay));
+    if (!extensions || !strstr(extensions, "GLX_OML_sync_control"))
+    {
+        return;
+    }
+
+    m_getSyncValues = (PFNGLXGETSYNCVALUESOMLPROC)::glXGetProcAddressARB((const GLubyte*)"glXGetSyncValuesOML");
+    m_waitForSbc = (PFNGLXWAITFORSBCOMLPROC)::glXGetProcAddressARB((const GLubyte*)"glXWaitForSbcOML");
+    m_swapBuffersMsc = (PFNGLXSWAPBUFFERSMSCOMLPROC)::glXGetProcAddressARB((const GLubyte*)"glXSwapBuffersMscOML");
+    const auto getMscRate = (PFNGLXGETMSCRATEOMLPROC)::glXGetProcAddressARB((const GLubyte*)"glXGetMscRateOML");
+
+    // Get the swap count when the timing started.
+    int64_t ust = 0;
+    int64_t msc = 0;
+    if (!m_getSyncValues ||
+        !m_waitForSbc ||
+        !m_getSyncValues(m_nativeDisplay, m_drawable, &ust, &msc, &m_initialSbc))
+    {
+        m_getSyncValues = nullptr;
+        m_waitForSbc = nullptr;
+        m_swapBuffersMsc = nullptr;
+        return;
+    }
+    m_swappedSbc = m_initialSbc;
+    m_presentedSbc = m_initialSbc;
+
+    // Get the nominal refresh rate, until it can be measured.
+    int32_t numerator = 0;
+    int32_t denominator = 0;
+    if (getMscRate &&
+        getMscRate(m_nativeDisplay, m_drawable, &numerator, &denominator) &&
+        numerator > 0 && denominator > 0)
+    {
+        m_presentTiming.refreshPeriodNanoseconds = (1000000000ull * denominator) / numerator;
+    }
+}
+
+//--------------------------------------------------------------
+inline void PresentTimingGLX::OnFrameSwapped()
+{
+    ++m_swappedSbc;
+    Update();
+}
+
+//--------------------------------------------------------------
+inline void PresentTimingGLX::Update()
+{
+    if (!m_getSyncValues)
+    {
+        return;
+    }
+
+    // Get the count of swaps completed, without waiting for any.
+    int64_t ust = 0;
+    int64_t msc = 0;
+    int64_t sbc = 0;
+    if (!m_getSyncValues(m_nativeDisplay, m_drawable, &ust, &msc, &sbc))
+    {
+        return;
+    }
+
+    // Get the time and refresh that the last completed swap reached
+    // the display, which returns immediately as it has completed.
+    if (sbc > m_presentedSbc &&
+        m_waitForSbc(m_nativeDisplay, m_drawable, sbc, &ust, &msc, &sbc))
+    {
+        const int64_t swapCount = sbc - m_presentedSbc;
+        const int64_t refreshCount = msc - m_presentedMsc;
+        if (m_presentedUst && refreshCount > 0)
+        {
+            // Frames that were already swapped when the previous one
+            // was displayed should have been displayed at consecutive
+            // refreshes, so any extra refreshes were missed by them.
+            if (m_hadPendingSwaps && refreshCount > swapCount)
+            {
+                m_presentTiming.missedRefreshes += refreshCount - swapCount;
+            }
+
+            // Measure the refresh period, smoothing out any jitter.
+            const uint64_t measuredNanoseconds = ((ust - m_presentedUst) * 1000) / refreshCount;
+            uint64_t& refreshPeriod = m_presentTiming.refreshPeriodNanoseconds;
+            refreshPeriod = refreshPeriod ? refreshPeriod - refreshPeriod / 8 + measuredNanoseconds / 8 :
+                                            measuredNanoseconds;
+        }
+
+        m_presentedSbc = sbc;
+        m_presentedMsc = msc;
+        m_presentedUst = ust;
+        m_hadPendingSwaps = (m_swappedSbc > sbc);
+        m_presentTiming.framesPresented = static_cast<uint64_t>(sbc - m_initialSbc);
+        m_presentTiming.presentMicroseconds = static_cast<uint64_t>(ust);
+        m_presentTiming.presentRefresh = static_cast<uint64_t>(msc);
+    }
+
+    // Predict when the next frame swapped will be displayed, which is
+    // after any frames already swapped, and no sooner than the first
+    // refresh from now (where UST is measured by the monotonic clock).
+    const uint64_t refreshPeriod = m_presentTiming.refreshPeriodNanoseconds;
+    if (!m_presentedUst || !refreshPeriod)
+    {
+        return;
+    }
+    timespec time = {};
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    const uint64_t nowNanoseconds = static_cast<uint64_t>(time.tv_sec) * 1000000000ull +
+                                    static_cast<uint64_t>(time.tv_nsec);
+    const uint64_t presentedNanoseconds = static_cast<uint64_t>(m_presentedUst) * 1000;
+    const uint64_t pendingSwaps = static_cast<uint64_t>(std::max<int64_t>(m_swappedSbc - m_presentedSbc, 0));
+    const uint64_t elapsedRefreshes = (nowNanoseconds > presentedNanoseconds) ?
+        (nowNanoseconds - presentedNanoseconds + refreshPeriod - 1) / refreshPeriod : 0;
+    const uint64_t nextRefresh = std::max(pendingSwaps + 1, elapsedRefreshes);
+    m_presentTiming.nextPresentMicroseconds = (presentedNanoseconds + nextRefresh * refreshPeriod) / 1000;
+}
+
+//--------------------------------------------------------------
+inline bool PresentTimingGLX::SwapBuffersAt(uint64_t a_targetMicroseconds)
+{
+    // The refresh closest to the target time can only be found once
+    // the time and refresh of an earlier frame displayed are known.
+    const uint64_t refreshPeriod = m_presentTiming.refreshPeriodNanoseconds;
+    const uint64_t presentedUst = static_cast<uint64_t>(m_presentedUst);
+    if (!m_swapBuffersMsc ||
+        !presentedUst ||
+        !refreshPeriod ||
+        a_targetMicroseconds <= presentedUst)
+    {
+        return false;
+    }
+
+    // Frames targeting a refresh that has already passed are swapped
+    // at the next refresh (which is the same as swapping normally).
+    const uint64_t elapsedNanoseconds = (a_targetMicroseconds - presentedUst) * 1000;
+    const int64_t targetMsc = m_presentedMsc +
+        static_cast<int64_t>((elapsedNanoseconds + refreshPeriod / 2) / refreshPeriod);
+    return m_swapBuffersMsc(m_nativeDisplay, m_drawable, targetMsc, 0, 0) >= 0;
+}
+
+} // namespace OpenGL
+} // namespace Display
+} // namespace Simple
@@ -11,7 +11,9 @@
 #include <X11/Xatom.h>
 #include <X11/Xlib.h>
 
+#include <algorithm>
 #include <assert.h>
+#include <vector>
 
 //--------------------------------------------------------------
 #if NDEBUG
@@ -74,6 +76,9 @@ protected:
     Window::NativeTextEvents* GetNativeTextEvents() override;
 
 private:
+    static Bool ShouldProcessEvent(::Display* a_display,
+                                   XEvent* a_event,
+                                   XPointer a_window);
     void ProcessEvent(const XEvent& a_event);
     void CacheFrameExtents();
     bool IsNativeWindowInState(const Atom& a_stateAtom) const;
@@ -98,15 +103,39 @@ private:
         {
             return m_display;
         }
+
+        // Track the windows created by this thread, as they all
+        // share the display (and so the queue of native events).
+        void AddWindow(::Window a_window)
+        {
+            m_windows.push_back(a_window);
+        }
+        void RemoveWindow(::Window a_window)
+        {
+            m_windows.erase(std::remove(m_windows.begin(),
+                                        m_windows.end(),
+                                        a_window),
+                            m_windows.end());
+        }
+        bool HasWindow(::Window a_window) const
+        {
+            return std::find(m_windows.begin(),
+                             m_windows.end(),
+                             a_window) != m_windows.end();
+        }
     private:
         ::Display* m_display = nullptr;
+        std::vector<::Window> m_windows;
     };
     static thread_local ThreadLocalDisplay tl_display;
 
     Window::NativeInputEvents m_nativeInputEvents;
     ::Display* m_xDisplay = nullptr;
     ::Window m_xWindow = 0;
-    bool m_isClosed = false;
+
+    // Set by events pumped on the thread that owns the window, which
+    // may not be the thread querying it (see Config::asyncPresent).
+    std::atomic<bool> m_isClosed{ false };
 
     Atom m_xStateAtom;
     Atom m_xStateHiddenAtom;
@@ -165,6 +194,7 @@ WindowLinux::WindowLinux(const Window::Config& a_config)
                               attributeMask,
                               &windowAttributes);
     assert(m_xWindow);
+    tl_display.AddWindow(m_xWindow);
 
     // Set the name of the native window.
     X11_ENSURE(XStoreName(m_xDisplay,
@@ -216,6 +246,7 @@ WindowLinux::~WindowLinux()
     Hide();
 
     // Destroy the native window.
+    tl_display.RemoveWindow(m_xWindow);
     X11_ENSURE(XDestroyWindow(m_xDisplay, m_xWindow));
 
     // Flush the native window destruction.
@@ -417,9 +448,21 @@ void WindowLinux::FullScreen(Bool a_enable)
 }
 
 //--------------------------------------------------------------
-static Bool ShouldProcessEvent(::Display*, XEvent*, XPointer)
+Bool WindowLinux::ShouldProcessEvent(::Display*,
+                                     XEvent* a_event,
+                                     XPointer a_window)
 {
-    return true;
+    // Each window only processes its own events, because all windows
+    // created by the same thread share the display (and its queue).
+    // Generic (extension) events, and events of any other window (eg.
+    // the root window), are processed by whichever window is pumped.
+    if (a_event->type == GenericEvent)
+    {
+        return True;
+    }
+    const ::Window eventWindow = a_event->xany.window;
+    return eventWindow == *(::Window*)a_window ||
+           !tl_display.HasWindow(eventWindow);
 }
 
 //--------------------------------------------------------------
@@ -545,6 +588,23 @@ Window::NativeTextEvents* WindowLinux::GetNativeTextEvents()
 //--------------------------------------------------------------
 void WindowLinux::ProcessEvent(const XEvent& a_event)
 {
+    // Discard events of windows that were destroyed before they were
+    // pumped, instead of handling them as events of this window.
+    if (a_event.type != GenericEvent &&
+        a_event.xany.window != m_xWindow &&
+        a_event.xany.window != DefaultRootWindow(m_xDisplay))
+    {
+        return;
+    }
+
+    // Redraw the window after it is exposed, mapped, or resized.
+    if (a_event.type == Expose ||
+        a_event.type == MapNotify ||
+        a_event.type == ConfigureNotify)
+    {
+        m_isRedrawRequested = true;
+    }
+
     if (a_event.type == ClientMessage &&
         a_event.xclient.message_type == m_xProtocolsAtom &&
         (Atom)a_event.xclient.data.l[0] == m_xDeleteWindowAtom)
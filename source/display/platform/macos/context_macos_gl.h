@@ -20,6 +20,8 @@ namespace Display
 namespace OpenGL
 {
 
+class FrameQueueGL;
+
 //--------------------------------------------------------------
 class ContextMacOSGL : public Context::Implementation
 {
@@ -37,9 +39,13 @@ protected:
     void OnFrameStart() override;
     void OnFrameEnded() override;
 
+    bool IsFrameSlotAvailable() override;
+    bool WaitForFramePresented() override;
+
 private:
     Buffer* m_buffer = nullptr;
     Window* m_window = nullptr;
+    FrameQueueGL* m_frameQueue = nullptr;
     NSOpenGLView* m_nsOpenGLView;
 };
 
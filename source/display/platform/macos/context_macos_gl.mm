@@ -14,6 +14,7 @@
 #define GLAD_GL_IMPLEMENTATION
 #include <display/graphics/opengl/glad/gl_core_4.1.h>
 #include <display/graphics/opengl/buffer_gl_core.h>
+#include <display/graphics/opengl/frame_queue_gl.h>
 #include <OpenGL/CGLCurrent.h>
 #import <Cocoa/Cocoa.h>
 
@@ -57,6 +58,15 @@ ContextMacOSGL::ContextMacOSGL(const Context::Config& a_config)
         [[m_nsOpenGLView openGLContext] makeCurrentContext];
         [[m_nsOpenGLView openGLContext] setView: m_nsOpenGLView];
         assert(m_nsOpenGLView.openGLContext.CGLContextObj == CGLGetCurrentContext());
+
+        // Set the swap interval, with mailbox and adaptive vertical
+        // sync not supported so they fall back to vertical sync.
+        const bool immediate = a_config.presentMode == Context::PresentMode::IMMEDIATE;
+        const GLint swapInterval = immediate ? 0 : 1;
+        [[m_nsOpenGLView openGLContext] setValues: &swapInterval
+                                     forParameter: NSOpenGLContextParameterSwapInterval];
+        m_presentMode = immediate ? Context::PresentMode::IMMEDIATE :
+                                    Context::PresentMode::FIFO;
     }
 
     // Initialize glad.
@@ -68,6 +78,10 @@ ContextMacOSGL::ContextMacOSGL(const Context::Config& a_config)
     const Buffer::Config& bufferConfig = a_config.bufferConfig;
     m_buffer = new Buffer(make_unique<BufferImpl>(bufferConfig));
 
+    // Create the frame queue.
+    m_frameQueue = new FrameQueueGL(a_config.framesInFlight,
+                                    m_latencyCounters);
+
     // Show the window.
     m_window->Show();
 }
@@ -83,6 +97,10 @@ ContextMacOSGL::~ContextMacOSGL()
     delete m_buffer;
     m_buffer = nullptr;
 
+    // Destroy the frame queue.
+    delete m_frameQueue;
+    m_frameQueue = nullptr;
+
     // Release the OpenGL view.
     [m_nsOpenGLView release];
     m_nsOpenGLView = nullptr;
@@ -124,11 +142,30 @@ void ContextMacOSGL::OnFrameEnded()
     uint32_t displayHeight = 0;
     m_window->GetDisplayDimensions(displayWidth, displayHeight);
 
+    // Wait until a frame slot is available.
+    m_frameQueue->WaitForFrameSlot();
+
     // Render the pixel buffer.
     m_buffer->Render(displayWidth, displayHeight);
 
     // Present the rendered image on the display.
     [[m_nsOpenGLView openGLContext] flushBuffer];
+
+    // Track the frame until it is completed.
+    m_frameQueue->OnFramePresented();
+}
+
+//--------------------------------------------------------------
+bool ContextMacOSGL::IsFrameSlotAvailable()
+{
+    return m_frameQueue->IsFrameSlotAvailable();
+}
+
+//--------------------------------------------------------------
+bool ContextMacOSGL::WaitForFramePresented()
+{
+    m_frameQueue->WaitForFramePresented();
+    return true;
 }
 
 #endif // OPENGL_SUPPORTED
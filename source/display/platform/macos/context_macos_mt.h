@@ -37,6 +37,9 @@ protected:
     void OnFrameStart() override;
     void OnFrameEnded() override;
 
+    bool IsFrameSlotAvailable() override;
+    bool WaitForFramePresented() override;
+
 private:
     Buffer* m_buffer = nullptr;
     Window* m_window = nullptr;
@@ -32,6 +32,18 @@ ContextMacOSMT::ContextMacOSMT(const Context::Config& a_config)
         [m_metalView initWithFrame: rect
                             device: MTLCreateSystemDefaultDevice()];
 
+        // Set whether presenting waits for vertical sync, which it
+        // does not for mailbox or immediate presentation (both are
+        // composited without tearing), and adaptive vertical sync
+        // is not supported so it falls back to vertical sync.
+        const Context::PresentMode presentMode = a_config.presentMode;
+        const bool displaySync = presentMode != Context::PresentMode::MAILBOX &&
+                                 presentMode != Context::PresentMode::IMMEDIATE;
+        CAMetalLayer* metalLayer = (CAMetalLayer*)m_metalView.layer;
+        metalLayer.displaySyncEnabled = displaySync;
+        m_presentMode = displaySync ? Context::PresentMode::FIFO :
+                                      presentMode;
+
         // Get the native window handle.
         NSWindow* nsWindow = (NSWindow*)m_window->GetNativeWindowHandle();
         assert(nsWindow);
@@ -107,3 +119,18 @@ void ContextMacOSMT::OnFrameEnded()
     // Render the pixel buffer.
     m_buffer->Render(displayWidth, displayHeight);
 }
+
+//--------------------------------------------------------------
+bool ContextMacOSMT::IsFrameSlotAvailable()
+{
+    // The view does not expose whether a drawable is available
+    // without waiting for one, so a frame slot is always assumed.
+    return true;
+}
+
+//--------------------------------------------------------------
+bool ContextMacOSMT::WaitForFramePresented()
+{
+    // The view does not expose when drawables are presented.
+    return false;
+}
@@ -39,6 +39,12 @@ protected:
     void OnFrameStart() override;
     void OnFrameEnded() override;
 
+    bool IsFrameSlotAvailable() override;
+    bool WaitForFramePresented() override;
+
+    void RenderFrame() override;
+    void PresentFrame() override;
+
 private:
     Buffer* m_buffer = nullptr;
     Window* m_window = nullptr;
@@ -55,6 +55,12 @@ ContextMacOSVK::ContextMacOSVK(const Context::Config& a_config)
                           m_mtkView,
                           *m_window);
     assert(m_pipelineContext);
+    m_pipelineContext->presentMode = a_config.presentMode;
+    m_pipelineContext->framesInFlight = a_config.framesInFlight;
+    m_pipelineContext->swapChainImageCount = a_config.swapChainImageCount;
+    m_pipelineContext->latencyCounters = &m_latencyCounters;
+    m_pipelineContext->lowLatency = a_config.lowLatency;
+    m_pipelineContext->targetPresentMicroseconds = &m_targetPresentMicroseconds;
 
     // Create the buffer.
     using namespace std;
@@ -63,6 +69,9 @@ ContextMacOSVK::ContextMacOSVK(const Context::Config& a_config)
     m_buffer = new Buffer(make_unique<BufferImpl>(bufferConfig,
                                                   *m_pipelineContext));
 
+    // Store the present mode in effect.
+    m_presentMode = m_pipelineContext->presentMode;
+
     // Show the window.
     m_window->Show();
 }
@@ -127,6 +136,49 @@ void ContextMacOSVK::OnFrameEnded()
     m_buffer->Render(displayWidth, displayHeight);
 }
 
+//--------------------------------------------------------------
+bool ContextMacOSVK::IsFrameSlotAvailable()
+{
+    assert(m_pipelineContext->pipeline);
+    return m_pipelineContext->pipeline->IsFrameSlotAvailable();
+}
+
+//--------------------------------------------------------------
+bool ContextMacOSVK::WaitForFramePresented()
+{
+    assert(m_pipelineContext->pipeline);
+    return m_pipelineContext->pipeline->WaitForFramePresented();
+}
+
+//--------------------------------------------------------------
+void ContextMacOSVK::RenderFrame()
+{
+    if (m_window->IsMinimized() || m_window->IsClosed())
+    {
+        return;
+    }
+
+    // Get the current window dimensions.
+    uint32_t displayWidth = 0;
+    uint32_t displayHeight = 0;
+    m_window->GetDisplayDimensions(displayWidth, displayHeight);
+
+    // Render the pixel buffer, deferring the present until all
+    // contexts presented together have rendered (see ContextGroup).
+    m_pipelineContext->deferPresent = true;
+    m_buffer->Render(displayWidth, displayHeight);
+    m_pipelineContext->deferPresent = false;
+}
+
+//--------------------------------------------------------------
+void ContextMacOSVK::PresentFrame()
+{
+    if (m_pipelineContext->pipeline)
+    {
+        m_pipelineContext->pipeline->PresentDeferredFrame();
+    }
+}
+
 #if VULKAN_DEBUG_SETTING
 //--------------------------------------------------------------
 VKAPI_ATTR VkBool32 VKAPI_CALL DebugMessageCallback(VkDebugUtilsMessageSeverityFlagBitsEXT a_severity,
@@ -193,6 +245,10 @@ void CreatePipelineContext(PipelineContext*& a_pipelineContext,
     extensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
     extensions.push_back(VK_EXT_METAL_SURFACE_EXTENSION_NAME);
     extensions.push_back(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME);
+
+    // Needed by the portability subset device extension, and to query
+    // the memory budget (see GetAvailableMemoryBytes), so it is always
+    // enabled (instead of only for AUTO storage, as on other platforms).
     extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
 #if VULKAN_DEBUG_SETTING
     extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -25,6 +25,7 @@ public:
     void OnNativeWindowDidEnterFullScreen();
     void OnNativeWindowDidExitFullScreen();
     void OnNativeWindowWillClose();
+    void OnNativeWindowExposed();
 
 protected:
     void Show() override;
@@ -401,6 +402,12 @@ void WindowMacOS::OnNativeWindowWillClose()
     m_isClosed = true;
 }
 
+//--------------------------------------------------------------
+void WindowMacOS::OnNativeWindowExposed()
+{
+    m_isRedrawRequested = true;
+}
+
 //--------------------------------------------------------------
 @implementation WindowDelegate
 {
@@ -434,4 +441,28 @@ void WindowMacOS::OnNativeWindowWillClose()
 {
     m_window->OnNativeWindowWillClose();
 }
+
+//--------------------------------------------------------------
+- (void)windowDidResize: (NSNotification*) notification
+{
+    m_window->OnNativeWindowExposed();
+}
+
+//--------------------------------------------------------------
+- (void)windowDidDeminiaturize: (NSNotification*) notification
+{
+    m_window->OnNativeWindowExposed();
+}
+
+//--------------------------------------------------------------
+- (void)windowDidChangeOcclusionState: (NSNotification*) notification
+{
+    m_window->OnNativeWindowExposed();
+}
+
+//--------------------------------------------------------------
+- (void)windowDidChangeBackingProperties: (NSNotification*) notification
+{
+    m_window->OnNativeWindowExposed();
+}
 @end
@@ -23,12 +23,24 @@ ContextWin32DX::ContextWin32DX(const Context::Config& a_config)
     HWND windowHandle = (HWND)m_window->GetNativeWindowHandle();
     assert(windowHandle);
 
+    // Select the sync interval, presenting without waiting for
+    // vertical sync in mailbox mode (flip model swap chains that
+    // are composited do not tear), to which immediate falls back
+    // (tearing requires DXGI_PRESENT_ALLOW_TEARING), and adaptive
+    // vertical sync is not supported so it falls back to FIFO.
+    const bool displaySync = a_config.presentMode != Context::PresentMode::MAILBOX &&
+                             a_config.presentMode != Context::PresentMode::IMMEDIATE;
+    const UINT syncInterval = displaySync ? 1 : 0;
+    m_presentMode = displaySync ? Context::PresentMode::FIFO :
+                                  Context::PresentMode::MAILBOX;
+
     // Create the buffer.
     using namespace std;
     using BufferImpl = BufferD3D12;
     const Buffer::Config& bufferConfig = a_config.bufferConfig;
     m_buffer = new Buffer(make_unique<BufferImpl>(bufferConfig,
-                                                  windowHandle));
+                                                  windowHandle,
+                                                  syncInterval));
 
     // Show the window.
     m_window->Show();
@@ -85,3 +97,18 @@ void ContextWin32DX::OnFrameEnded()
     // Render the pixel buffer.
     m_buffer->Render(displayWidth, displayHeight);
 }
+
+//--------------------------------------------------------------
+bool ContextWin32DX::IsFrameSlotAvailable()
+{
+    // Each frame is completed before the next can be rendered.
+    return true;
+}
+
+//--------------------------------------------------------------
+bool ContextWin32DX::WaitForFramePresented()
+{
+    // Each frame is completed after it is presented, which (as with
+    // OpenGL) approximates the time the last frame was presented.
+    return true;
+}
@@ -37,6 +37,9 @@
 #pragma warning(pop)
 
 #include <display/graphics/opengl/debug_gl.h>
+#include <display/graphics/opengl/extensions_gl.h>
+#include <display/graphics/opengl/frame_queue_gl.h>
+#include <cstring>
 
 using namespace Simple::Display;
 using namespace Simple::Display::OpenGL;
@@ -66,6 +69,43 @@ void GLAPIENTRY DebugMessageCallback(GLenum source,
     }
 }
 
+//--------------------------------------------------------------
+static Context::PresentMode SetSwapInterval(Context::PresentMode a_presentMode)
+{
+    // Swap intervals require WGL_EXT_swap_control, without which
+    // the driver default (usually vertical sync) remains in effect.
+    using ExtensionsFunction = const char* (WINAPI*)(void);
+    using SwapIntervalFunction = BOOL (WINAPI*)(int);
+    auto extensionsFunction = (ExtensionsFunction)::wglGetProcAddress("wglGetExtensionsStringEXT");
+    auto swapIntervalFunction = (SwapIntervalFunction)::wglGetProcAddress("wglSwapIntervalEXT");
+    const char* extensions = extensionsFunction ? extensionsFunction() : nullptr;
+    if (!swapIntervalFunction ||
+        !IsExtensionSupported(extensions, "WGL_EXT_swap_control"))
+    {
+        return Context::PresentMode::FIFO;
+    }
+
+    // Adaptive vertical sync requires WGL_EXT_swap_control_tear,
+    // and mailbox presentation is not supported so it falls back
+    // to vertical sync (as opposed to the immediate mode, which
+    // can tear), in both cases matching the Vulkan fallbacks.
+    int swapInterval = 1;
+    Context::PresentMode presentMode = Context::PresentMode::FIFO;
+    if (a_presentMode == Context::PresentMode::IMMEDIATE)
+    {
+        swapInterval = 0;
+        presentMode = Context::PresentMode::IMMEDIATE;
+    }
+    else if (a_presentMode == Context::PresentMode::FIFO_RELAXED &&
+             IsExtensionSupported(extensions, "WGL_EXT_swap_control_tear"))
+    {
+        swapInterval = -1;
+        presentMode = Context::PresentMode::FIFO_RELAXED;
+    }
+    return swapIntervalFunction(swapInterval) ? presentMode :
+                                                Context::PresentMode::FIFO;
+}
+
 //--------------------------------------------------------------
 ContextWin32GL::ContextWin32GL(const Context::Config& a_config)
 {
@@ -107,6 +147,9 @@ ContextWin32GL::ContextWin32GL(const Context::Config& a_config)
     // Initialize glad.
     gladLoaderLoadGL();
 
+    // Set the swap interval.
+    m_presentMode = SetSwapInterval(a_config.presentMode);
+
     // Enable debug info.
 #if defined(GL_DEBUG_OUTPUT) && OPENGL_DEBUG_SETTING
     glEnable(GL_DEBUG_OUTPUT);
@@ -125,6 +168,10 @@ ContextWin32GL::ContextWin32GL(const Context::Config& a_config)
     const Buffer::Config& bufferConfig = a_config.bufferConfig;
     m_buffer = new Buffer(make_unique<BufferImpl>(bufferConfig));
 
+    // Create the frame queue.
+    m_frameQueue = new FrameQueueGL(a_config.framesInFlight,
+                                    m_latencyCounters);
+
     // Show the window.
     m_window->Show();
 }
@@ -140,6 +187,10 @@ ContextWin32GL::~ContextWin32GL()
     delete m_buffer;
     m_buffer = nullptr;
 
+    // Destroy the frame queue.
+    delete m_frameQueue;
+    m_frameQueue = nullptr;
+
     // Deactivate the rendering context.
     ::wglMakeCurrent(nullptr, nullptr);
 
@@ -184,6 +235,28 @@ void ContextWin32GL::OnFrameStart()
 //--------------------------------------------------------------
 void ContextWin32GL::OnFrameEnded()
 {
+    RenderFrame();
+    PresentFrame();
+}
+
+//--------------------------------------------------------------
+bool ContextWin32GL::IsFrameSlotAvailable()
+{
+    return m_frameQueue->IsFrameSlotAvailable();
+}
+
+//--------------------------------------------------------------
+bool ContextWin32GL::WaitForFramePresented()
+{
+    MakeCurrent();
+    m_frameQueue->WaitForFramePresented();
+    return true;
+}
+
+//--------------------------------------------------------------
+void ContextWin32GL::RenderFrame()
+{
+    m_isFrameRendered = false;
     if (m_window->IsMinimized() || m_window->IsClosed())
     {
         return;
@@ -194,11 +267,44 @@ void ContextWin32GL::OnFrameEnded()
     uint32_t displayHeight = 0;
     m_window->GetDisplayDimensions(displayWidth, displayHeight);
 
-    // Render the pixel buffer.
+    // Activate the rendering context, which may not be current if
+    // this thread also renders other contexts (see ContextGroup).
+    MakeCurrent();
+
+    // Wait until a frame slot is available.
+    m_frameQueue->WaitForFrameSlot();
+
+    // Render the pixel buffer, and flush the commands so the GPU
+    // renders them while any other contexts are being rendered.
     m_buffer->Render(displayWidth, displayHeight);
+    glFlush();
+    m_isFrameRendered = true;
+}
+
+//--------------------------------------------------------------
+void ContextWin32GL::PresentFrame()
+{
+    if (!m_isFrameRendered)
+    {
+        return;
+    }
+    m_isFrameRendered = false;
 
     // Present the rendered image on the display.
+    MakeCurrent();
     ::SwapBuffers(m_deviceContext);
+
+    // Track the frame until it is completed.
+    m_frameQueue->OnFramePresented();
+}
+
+//--------------------------------------------------------------
+void ContextWin32GL::MakeCurrent() const
+{
+    if (::wglGetCurrentContext() != m_openGLContext)
+    {
+        ::wglMakeCurrent(m_deviceContext, m_openGLContext);
+    }
 }
 
 #endif // OPENGL_SUPPORTED
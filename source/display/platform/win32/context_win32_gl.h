@@ -21,6 +21,8 @@ namespace Display
 namespace OpenGL
 {
 
+class FrameQueueGL;
+
 //--------------------------------------------------------------
 class ContextWin32GL : public Context::Implementation
 {
@@ -38,11 +40,21 @@ protected:
     void OnFrameStart() override;
     void OnFrameEnded() override;
 
+    bool IsFrameSlotAvailable() override;
+    bool WaitForFramePresented() override;
+
+    void RenderFrame() override;
+    void PresentFrame() override;
+
 private:
+    void MakeCurrent() const;
+
     Buffer* m_buffer = nullptr;
     Window* m_window = nullptr;
+    FrameQueueGL* m_frameQueue = nullptr;
     HDC m_deviceContext = nullptr;
     HGLRC m_openGLContext = nullptr;
+    bool m_isFrameRendered = false;
 };
 
 } // namespace OpenGL
@@ -34,6 +34,12 @@ ContextWin32VK::ContextWin32VK(const Context::Config& a_config)
                           bufferConfig,
                           *m_window);
     assert(m_pipelineContext);
+    m_pipelineContext->presentMode = a_config.presentMode;
+    m_pipelineContext->framesInFlight = a_config.framesInFlight;
+    m_pipelineContext->swapChainImageCount = a_config.swapChainImageCount;
+    m_pipelineContext->latencyCounters = &m_latencyCounters;
+    m_pipelineContext->lowLatency = a_config.lowLatency;
+    m_pipelineContext->targetPresentMicroseconds = &m_targetPresentMicroseconds;
 
     // Create the buffer.
     using namespace std;
@@ -41,6 +47,9 @@ ContextWin32VK::ContextWin32VK(const Context::Config& a_config)
     m_buffer = new Buffer(make_unique<BufferImpl>(bufferConfig,
                                                   *m_pipelineContext));
 
+    // Store the present mode in effect.
+    m_presentMode = m_pipelineContext->presentMode;
+
     // Show the window.
     m_window->Show();
 }
@@ -101,6 +110,49 @@ void ContextWin32VK::OnFrameEnded()
     m_buffer->Render(displayWidth, displayHeight);
 }
 
+//--------------------------------------------------------------
+bool ContextWin32VK::IsFrameSlotAvailable()
+{
+    assert(m_pipelineContext->pipeline);
+    return m_pipelineContext->pipeline->IsFrameSlotAvailable();
+}
+
+//--------------------------------------------------------------
+bool ContextWin32VK::WaitForFramePresented()
+{
+    assert(m_pipelineContext->pipeline);
+    return m_pipelineContext->pipeline->WaitForFramePresented();
+}
+
+//--------------------------------------------------------------
+void ContextWin32VK::RenderFrame()
+{
+    if (m_window->IsMinimized() || m_window->IsClosed())
+    {
+        return;
+    }
+
+    // Get the current window dimensions.
+    uint32_t displayWidth = 0;
+    uint32_t displayHeight = 0;
+    m_window->GetDisplayDimensions(displayWidth, displayHeight);
+
+    // Render the pixel buffer, deferring the present until all
+    // contexts presented together have rendered (see ContextGroup).
+    m_pipelineContext->deferPresent = true;
+    m_buffer->Render(displayWidth, displayHeight);
+    m_pipelineContext->deferPresent = false;
+}
+
+//--------------------------------------------------------------
+void ContextWin32VK::PresentFrame()
+{
+    if (m_pipelineContext->pipeline)
+    {
+        m_pipelineContext->pipeline->PresentDeferredFrame();
+    }
+}
+
 #if VULKAN_DEBUG_SETTING
 //--------------------------------------------------------------
 VKAPI_ATTR VkBool32 VKAPI_CALL DebugMessageCallback(VkDebugUtilsMessageSeverityFlagBitsEXT a_severity,
@@ -168,11 +220,16 @@ void CreatePipelineContext(PipelineContext*& a_pipelineContext,
     if (a_bufferConfig.interop == Buffer::Interop::CUDA)
     {
         extensions.push_back(VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME);
-        extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
         a_pipelineContext->requiredDeviceExtensions.push_back(VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME);
         a_pipelineContext->requiredDeviceExtensions.push_back(VK_KHR_EXTERNAL_MEMORY_WIN32_EXTENSION_NAME);
         a_pipelineContext->externalMemoryHandleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_WIN32_BIT;
     }
+    if (a_bufferConfig.interop == Buffer::Interop::CUDA ||
+        a_bufferConfig.storage == Buffer::Storage::AUTO)
+    {
+        // Needed to query external memory and memory budget properties.
+        extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+    }
 #if VULKAN_DEBUG_SETTING
     extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
 #endif
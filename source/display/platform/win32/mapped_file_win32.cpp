@@ -0,0 +1,101 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <display/mapped_file.h>
+
+#define NOMINMAX
+#include <windows.h>
+#include <codecvt>
+
+using namespace Simple::Display;
+
+//--------------------------------------------------------------
+class MappedFileWin32 : public MappedFile
+{
+public:
+    MappedFileWin32(const void* a_data, uint64_t a_size);
+    ~MappedFileWin32() override;
+
+    const uint8_t* GetData() const override;
+    uint64_t GetSize() const override;
+
+private:
+    const void* const m_data;
+    const uint64_t m_size;
+};
+
+//--------------------------------------------------------------
+std::unique_ptr<MappedFile> MappedFile::Open(const std::string& a_filePathUTF8)
+{
+    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> con;
+    const std::wstring filePathUTF16 = con.from_bytes(a_filePathUTF8);
+
+    // Tiles are accessed out of order, so disable read ahead.
+    HANDLE file = CreateFileW(filePathUTF16.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_FLAG_RANDOM_ACCESS,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return nullptr;
+    }
+
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0)
+    {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    // The view remains valid after both handles are closed.
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY,
+                                        0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+    {
+        return nullptr;
+    }
+
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data)
+    {
+        return nullptr;
+    }
+
+    const uint64_t size = static_cast<uint64_t>(fileSize.QuadPart);
+    return std::unique_ptr<MappedFile>(new MappedFileWin32(data, size));
+}
+
+//--------------------------------------------------------------
+MappedFileWin32::MappedFileWin32(const void* a_data, uint64_t a_size)
+    : m_data(a_data)
+    , m_size(a_size)
+{
+}
+
+//--------------------------------------------------------------
+MappedFileWin32::~MappedFileWin32()
+{
+    UnmapViewOfFile(m_data);
+}
+
+//--------------------------------------------------------------
+const uint8_t* MappedFileWin32::GetData() const
+{
+    return static_cast<const uint8_t*>(m_data);
+}
+
+//--------------------------------------------------------------
+uint64_t MappedFileWin32::GetSize() const
+{
+    return m_size;
+}
@@ -39,6 +39,7 @@ public:
     WindowWin32& operator=(const WindowWin32&) = delete;
 
     void OnNativeWindowDestroyed();
+    void OnNativeWindowExposed();
     void OnNativeDeviceEvent(WPARAM a_wParam);
     void OnNativeInputEvent(RAWINPUT* a_rawInput);
     void OnNativeTextEvent(const USHORT a_codeUnitUTF16);
@@ -83,9 +84,12 @@ private:
     Window::NativeTextEvents m_nativeTextEvents;
     UTF16ToUTF8Converter m_utf16ToUtf8Converter;
     HWND m_windowHandle = nullptr;
-    bool m_isFullScreen = false;
-    bool m_isVisible = false;
-    bool m_isClosed = false;
+
+    // Set by messages pumped on the thread that owns the window, which
+    // may not be the thread querying it (see Config::asyncPresent).
+    std::atomic<bool> m_isFullScreen{ false };
+    std::atomic<bool> m_isVisible{ false };
+    std::atomic<bool> m_isClosed{ false };
 };
 
 //--------------------------------------------------------------
@@ -201,7 +205,7 @@ void WindowWin32::Close()
     Hide();
 
     // Destroy the native window.
-    m_isClosed = ::DestroyWindow(m_windowHandle);
+    m_isClosed = (::DestroyWindow(m_windowHandle) != FALSE);
 }
 
 //--------------------------------------------------------------
@@ -401,6 +405,12 @@ void WindowWin32::OnNativeWindowDestroyed()
     m_isClosed = true;
 }
 
+//--------------------------------------------------------------
+void WindowWin32::OnNativeWindowExposed()
+{
+    m_isRedrawRequested = true;
+}
+
 //--------------------------------------------------------------
 void WindowWin32::OnNativeDeviceEvent(WPARAM a_wParam)
 {
@@ -477,6 +487,16 @@ LRESULT CALLBACK OnWindowMessage(HWND a_handle,
             return 0;
         }
         break;
+        case WM_PAINT:
+        case WM_SIZE:
+        {
+            window->OnNativeWindowExposed();
+            return ::DefWindowProcW(a_handle,
+                                    a_message,
+                                    a_wParam,
+                                    a_lParam);
+        }
+        break;
         case WM_INPUT:
         {
             UINT rawInputSize;
@@ -0,0 +1,593 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <display/tile_source_implementation.h>
+#include <display/buffer_implementation.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace Simple::Display;
+
+//--------------------------------------------------------------
+//! Create a tile source by mapping the configured image file.
+//!
+//! \param[in] a_config The values needed to create the source.
+//--------------------------------------------------------------
+TileSource::TileSource(const Config& a_config)
+    : m_pimpl(new Implementation(a_config))
+{
+}
+
+//--------------------------------------------------------------
+TileSource::~TileSource()
+{
+}
+
+//--------------------------------------------------------------
+//! Copy the region of the image in the viewport to the display
+//! buffer of a context, which must be a host buffer with a linear
+//! layout and the same pixel format as the image.
+//!
+//! Tiles that have not been read from the file yet are requested
+//! from the background thread, and in the meantime are copied from
+//! a coarser mip level (or as black pixels if none are cached).
+//!
+//! \param[in] a_context The context with the buffer to update.
+//! \return True if the buffer was updated, false otherwise.
+//--------------------------------------------------------------
+bool TileSource::Update(Context& a_context)
+{
+    Buffer& buffer = a_context.GetBuffer();
+    if (buffer.GetFormat() != m_pimpl->GetConfig().format ||
+        buffer.GetInterop() != Buffer::Interop::HOST ||
+        buffer.GetLayout() != Buffer::Layout::LINEAR)
+    {
+        return false;
+    }
+
+    return m_pimpl->Update(buffer.GetData(),
+                           buffer.GetWidth(),
+                           buffer.GetHeight(),
+                           buffer.GetPitch());
+}
+
+//--------------------------------------------------------------
+//! Copy the region of the image in the viewport to pixels stored
+//! in host memory, in rows using the same pixel format as the image.
+//!
+//! \param[out] o_pixels The memory the pixels are copied to.
+//! \param[in] a_width The number of pixels in each row.
+//! \param[in] a_height The number of rows of pixels.
+//! \param[in] a_pitch The size in bytes of each row of pixels.
+//! \return True if the pixels were updated, false otherwise.
+//--------------------------------------------------------------
+bool TileSource::Update(void* o_pixels,
+                        uint32_t a_width,
+                        uint32_t a_height,
+                        uint64_t a_pitch)
+{
+    return m_pimpl->Update(o_pixels, a_width, a_height, a_pitch);
+}
+
+//--------------------------------------------------------------
+//! Set the region of the image (measured in pixels of the full
+//! resolution image) that is scaled to fill each updated buffer.
+//!
+//! \param[in] a_viewport The region of the image to be displayed,
+//!                       or a region without any area to display
+//!                       the entire image (the default viewport).
+//--------------------------------------------------------------
+void TileSource::SetViewport(const Buffer::Viewport& a_viewport)
+{
+    m_pimpl->SetViewport(a_viewport);
+}
+
+//--------------------------------------------------------------
+//! Get the region of the image that is scaled to fill each buffer.
+//!
+//! \return The region of the image that is scaled to fill each
+//!         buffer, which has no area if the entire image is.
+//--------------------------------------------------------------
+Buffer::Viewport TileSource::GetViewport() const
+{
+    return m_pimpl->GetViewport();
+}
+
+//--------------------------------------------------------------
+//! Query whether the image file was successfully mapped.
+//!
+//! \return True if the file is mapped and large enough to contain
+//!         all configured mip levels, false otherwise.
+//--------------------------------------------------------------
+bool TileSource::IsOpen() const
+{
+    return m_pimpl->IsOpen();
+}
+
+//--------------------------------------------------------------
+//! Get the mip level sampled by the most recent update.
+//!
+//! \return The mip level sampled by the most recent update.
+//--------------------------------------------------------------
+uint32_t TileSource::GetLevel() const
+{
+    return m_pimpl->GetLevel();
+}
+
+//--------------------------------------------------------------
+//! Get the number of tiles currently kept in memory.
+//!
+//! \return The number of tiles currently kept in memory.
+//--------------------------------------------------------------
+uint32_t TileSource::GetCachedTileCount() const
+{
+    return m_pimpl->GetCachedTileCount();
+}
+
+//--------------------------------------------------------------
+//! Get the number of tiles waiting to be read from the file.
+//!
+//! \return The number of tiles waiting to be read from the file.
+//--------------------------------------------------------------
+uint32_t TileSource::GetPendingTileCount() const
+{
+    return m_pimpl->GetPendingTileCount();
+}
+
+//--------------------------------------------------------------
+TileSource::Implementation::Implementation(const Config& a_config)
+    : m_config(a_config)
+{
+    if (!IsValid(m_config))
+    {
+        return;
+    }
+
+    m_file = MappedFile::Open(m_config.filePathUTF8);
+    if (!m_file || m_file->GetSize() < FileSizeBytes(m_config))
+    {
+        m_file.reset();
+        return;
+    }
+
+    m_thread = std::thread(&Implementation::ReadTiles, this);
+}
+
+//--------------------------------------------------------------
+TileSource::Implementation::~Implementation()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_exit = true;
+    }
+    m_condition.notify_one();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+//--------------------------------------------------------------
+bool TileSource::Implementation::Update(void* o_pixels,
+                                        uint32_t a_width,
+                                        uint32_t a_height,
+                                        uint64_t a_pitch)
+{
+    const uint32_t bytesPerPixel = Buffer::BytesPerPixel(m_config.format);
+    if (!IsOpen() || !o_pixels || !a_width || !a_height ||
+        a_pitch < static_cast<uint64_t>(a_width) * bytesPerPixel)
+    {
+        return false;
+    }
+
+    // Sample the coarsest level with at least one pixel per pixel.
+    const Buffer::Viewport viewport = ResolveViewport(m_viewport,
+                                                      m_config.width,
+                                                      m_config.height);
+    const float scale = std::min(viewport.width / static_cast<float>(a_width),
+                                 viewport.height / static_cast<float>(a_height));
+    uint32_t level = 0;
+    while (level + 1 < m_config.levelCount &&
+           static_cast<float>(1ull << (level + 1)) <= scale)
+    {
+        ++level;
+    }
+    m_level = level;
+
+    // Map each column and row of the buffer to the sampled level.
+    MapPixels(viewport.x, viewport.width, a_width, m_config.width,
+              level, LevelWidth(m_config, level), m_columns);
+    MapPixels(viewport.y, viewport.height, a_height, m_config.height,
+              level, LevelHeight(m_config, level), m_rows);
+
+    // Find the range of tiles that are visible in the viewport.
+    const auto isInside = [](uint32_t a_pixel) { return a_pixel != OUTSIDE; };
+    const auto firstColumn = std::find_if(m_columns.begin(), m_columns.end(), isInside);
+    const auto lastColumn = std::find_if(m_columns.rbegin(), m_columns.rend(), isInside);
+    const auto firstRow = std::find_if(m_rows.begin(), m_rows.end(), isInside);
+    const auto lastRow = std::find_if(m_rows.rbegin(), m_rows.rend(), isInside);
+    const bool isVisible = firstColumn != m_columns.end() &&
+                           firstRow != m_rows.end();
+
+    const uint32_t tileSize = m_config.tileSize;
+    const uint32_t firstX = isVisible ? *firstColumn / tileSize : 0;
+    const uint32_t lastX = isVisible ? *lastColumn / tileSize : 0;
+    const uint32_t firstY = isVisible ? *firstRow / tileSize : 0;
+    const uint32_t lastY = isVisible ? *lastRow / tileSize : 0;
+    const uint32_t visibleCountX = isVisible ? lastX - firstX + 1 : 0;
+    const uint32_t visibleCountY = isVisible ? lastY - firstY + 1 : 0;
+
+    // Find the visible tiles in the cache, falling back to coarser
+    // levels, and request any that are missing (or are upcoming).
+    m_visibleTiles.assign(static_cast<size_t>(visibleCountX) * visibleCountY,
+                          VisibleTile());
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingTiles.clear();
+
+        for (uint32_t y = 0; y < visibleCountY; ++y)
+        {
+            for (uint32_t x = 0; x < visibleCountX; ++x)
+            {
+                VisibleTile& tile = m_visibleTiles[y * visibleCountX + x];
+                for (uint32_t l = level; l < m_config.levelCount; ++l)
+                {
+                    const uint32_t shift = l - level;
+                    const uint32_t tileX = std::min((firstX + x) >> shift,
+                                                    TileCountX(m_config, l) - 1);
+                    const uint32_t tileY = std::min((firstY + y) >> shift,
+                                                    TileCountY(m_config, l) - 1);
+                    tile.data = FindTile(MakeKey(l, tileX, tileY));
+                    if (tile.data)
+                    {
+                        tile.level = l;
+                        tile.originX = tileX * tileSize;
+                        tile.originY = tileY * tileSize;
+                        tile.maxX = LevelWidth(m_config, l) - 1;
+                        tile.maxY = LevelHeight(m_config, l) - 1;
+                        break;
+                    }
+                }
+            }
+        }
+
+        RequestTiles(level, firstX, lastX, firstY, lastY, viewport);
+    }
+    m_condition.notify_one();
+    m_previousViewport = viewport;
+    m_hasPreviousViewport = true;
+
+    // Copy each pixel from the visible tile it falls within.
+    uint8_t* pixels = static_cast<uint8_t*>(o_pixels);
+    for (uint32_t y = 0; y < a_height; ++y)
+    {
+        uint8_t* pixel = pixels + (y * a_pitch);
+        const uint32_t row = m_rows[y];
+        if (row == OUTSIDE)
+        {
+            memset(pixel, 0, static_cast<size_t>(a_width) * bytesPerPixel);
+            continue;
+        }
+
+        const VisibleTile* tileRow = m_visibleTiles.data() +
+                                     ((row / tileSize) - firstY) * visibleCountX;
+        for (uint32_t x = 0; x < a_width; ++x, pixel += bytesPerPixel)
+        {
+            const uint32_t column = m_columns[x];
+            const VisibleTile* tile = (column != OUTSIDE) ?
+                                      tileRow + ((column / tileSize) - firstX) :
+                                      nullptr;
+            if (!tile || !tile->data)
+            {
+                memset(pixel, 0, bytesPerPixel);
+                continue;
+            }
+
+            const uint32_t shift = tile->level - level;
+            const uint32_t tilePixelX = std::min(column >> shift, tile->maxX) -
+                                        tile->originX;
+            const uint32_t tilePixelY = std::min(row >> shift, tile->maxY) -
+                                        tile->originY;
+            const size_t offset = (static_cast<size_t>(tilePixelY) * tileSize +
+                                   tilePixelX) * bytesPerPixel;
+            memcpy(pixel, tile->data->data() + offset, bytesPerPixel);
+        }
+    }
+
+    // Release visible tiles so only the cache keeps tiles in memory.
+    m_visibleTiles.clear();
+    return true;
+}
+
+//--------------------------------------------------------------
+void TileSource::Implementation::SetViewport(const Buffer::Viewport& a_viewport)
+{
+    m_viewport = a_viewport;
+}
+
+//--------------------------------------------------------------
+Buffer::Viewport TileSource::Implementation::GetViewport() const
+{
+    return m_viewport;
+}
+
+//--------------------------------------------------------------
+const TileSource::Config& TileSource::Implementation::GetConfig() const
+{
+    return m_config;
+}
+
+//--------------------------------------------------------------
+bool TileSource::Implementation::IsOpen() const
+{
+    return m_file != nullptr;
+}
+
+//--------------------------------------------------------------
+uint32_t TileSource::Implementation::GetLevel() const
+{
+    return m_level;
+}
+
+//--------------------------------------------------------------
+uint32_t TileSource::Implementation::GetCachedTileCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<uint32_t>(m_cache.size());
+}
+
+//--------------------------------------------------------------
+uint32_t TileSource::Implementation::GetPendingTileCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<uint32_t>(m_pendingTiles.size()) +
+           (m_readingTile ? 1 : 0);
+}
+
+//--------------------------------------------------------------
+bool TileSource::Implementation::IsValid(const Config& a_config)
+{
+    // Tile columns and rows must each fit in 28 bits of a key.
+    constexpr uint32_t MAX_TILE_COUNT = 1u << 28;
+    return a_config.width && a_config.height && a_config.tileSize &&
+           a_config.levelCount && a_config.levelCount <= 32 &&
+           a_config.cacheTileCount &&
+           Buffer::BytesPerPixel(a_config.format) &&
+           TileCountX(a_config, 0) < MAX_TILE_COUNT &&
+           TileCountY(a_config, 0) < MAX_TILE_COUNT;
+}
+
+//--------------------------------------------------------------
+TileSource::Implementation::TileKey
+TileSource::Implementation::MakeKey(uint32_t a_level,
+                                    uint32_t a_tileX,
+                                    uint32_t a_tileY)
+{
+    return (static_cast<uint64_t>(a_level) << 56) |
+           (static_cast<uint64_t>(a_tileY) << 28) |
+           static_cast<uint64_t>(a_tileX);
+}
+
+//--------------------------------------------------------------
+void TileSource::Implementation::MapPixels(float a_start,
+                                           float a_extent,
+                                           uint32_t a_count,
+                                           uint32_t a_imageSize,
+                                           uint32_t a_level,
+                                           uint32_t a_levelSize,
+                                           std::vector<uint32_t>& o_pixels)
+{
+    // Sample the center of each pixel, in full resolution pixels.
+    o_pixels.resize(a_count);
+    const double step = static_cast<double>(a_extent) / a_count;
+    for (uint32_t i = 0; i < a_count; ++i)
+    {
+        const double pixel = a_start + ((i + 0.5) * step);
+        o_pixels[i] = (pixel >= 0.0 && pixel < a_imageSize) ?
+                      std::min(static_cast<uint32_t>(pixel) >> a_level,
+                               a_levelSize - 1) :
+                      OUTSIDE;
+    }
+}
+
+//--------------------------------------------------------------
+TileSource::Implementation::TileData
+TileSource::Implementation::FindTile(TileKey a_key)
+{
+    const auto it = m_cache.find(a_key);
+    if (it == m_cache.end())
+    {
+        return nullptr;
+    }
+
+    // Move the tile to the front of the most recently used list.
+    m_recentTiles.splice(m_recentTiles.begin(),
+                         m_recentTiles,
+                         it->second.recent);
+    return it->second.data;
+}
+
+//--------------------------------------------------------------
+void TileSource::Implementation::RequestTiles(uint32_t a_level,
+                                              uint32_t a_firstX,
+                                              uint32_t a_lastX,
+                                              uint32_t a_firstY,
+                                              uint32_t a_lastY,
+                                              const Buffer::Viewport& a_viewport)
+{
+    if (m_visibleTiles.empty())
+    {
+        return;
+    }
+
+    // Request tiles in order of priority, until the cache is full,
+    // marking cached tiles as recently used so they aren't evicted.
+    const uint32_t visibleCountX = a_lastX - a_firstX + 1;
+    const uint32_t visibleCountY = a_lastY - a_firstY + 1;
+    size_t budget = m_config.cacheTileCount;
+    const auto request = [this, &budget](TileKey a_key)
+    {
+        if (budget)
+        {
+            --budget;
+            if (!FindTile(a_key))
+            {
+                m_pendingTiles.push_back(a_key);
+            }
+        }
+    };
+
+    // First request the coarsest level of any visible tiles that
+    // are not cached at any level, which covers them the quickest.
+    const bool anyMissing = std::any_of(m_visibleTiles.begin(),
+                                        m_visibleTiles.end(),
+                                        [](const VisibleTile& a_tile)
+                                        { return !a_tile.data; });
+    const uint32_t coarsest = m_config.levelCount - 1;
+    if (anyMissing && coarsest > a_level)
+    {
+        const uint32_t shift = coarsest - a_level;
+        const uint32_t maxX = TileCountX(m_config, coarsest) - 1;
+        const uint32_t maxY = TileCountY(m_config, coarsest) - 1;
+        for (uint32_t y = std::min(a_firstY >> shift, maxY);
+             y <= std::min(a_lastY >> shift, maxY); ++y)
+        {
+            for (uint32_t x = std::min(a_firstX >> shift, maxX);
+                 x <= std::min(a_lastX >> shift, maxX); ++x)
+            {
+                request(MakeKey(coarsest, x, y));
+            }
+        }
+    }
+
+    // Then request the visible tiles at the sampled level.
+    for (uint32_t y = 0; y < visibleCountY; ++y)
+    {
+        for (uint32_t x = 0; x < visibleCountX; ++x)
+        {
+            request(MakeKey(a_level, a_firstX + x, a_firstY + y));
+        }
+    }
+
+    // Then prefetch one tile around the visible tiles, extended
+    // by how far each edge of the viewport is expected to move.
+    double aheadLeft = 1.0, aheadRight = 1.0;
+    double aheadUp = 1.0, aheadDown = 1.0;
+    if (m_hasPreviousViewport)
+    {
+        const Buffer::Viewport& previous = m_previousViewport;
+        const double scale = static_cast<double>(m_config.prefetchFrames) /
+                             (static_cast<double>(m_config.tileSize) *
+                              static_cast<double>(1ull << a_level));
+        const double left = (a_viewport.x - previous.x) * scale;
+        const double right = ((a_viewport.x + a_viewport.width) -
+                              (previous.x + previous.width)) * scale;
+        const double up = (a_viewport.y - previous.y) * scale;
+        const double down = ((a_viewport.y + a_viewport.height) -
+                             (previous.y + previous.height)) * scale;
+        const double limit = static_cast<double>(budget);
+        aheadLeft += std::min(std::max(-left, 0.0), limit);
+        aheadRight += std::min(std::max(right, 0.0), limit);
+        aheadUp += std::min(std::max(-up, 0.0), limit);
+        aheadDown += std::min(std::max(down, 0.0), limit);
+    }
+
+    const int64_t maxX = TileCountX(m_config, a_level) - 1;
+    const int64_t maxY = TileCountY(m_config, a_level) - 1;
+    const int64_t prefetchFirstX = std::max<int64_t>(a_firstX - static_cast<int64_t>(std::ceil(aheadLeft)), 0);
+    const int64_t prefetchLastX = std::min<int64_t>(a_lastX + static_cast<int64_t>(std::ceil(aheadRight)), maxX);
+    const int64_t prefetchFirstY = std::max<int64_t>(a_firstY - static_cast<int64_t>(std::ceil(aheadUp)), 0);
+    const int64_t prefetchLastY = std::min<int64_t>(a_lastY + static_cast<int64_t>(std::ceil(aheadDown)), maxY);
+
+    // Prefetch the tiles closest to the visible tiles first.
+    std::vector<std::pair<int64_t, TileKey>> prefetchTiles;
+    for (int64_t y = prefetchFirstY; y <= prefetchLastY; ++y)
+    {
+        for (int64_t x = prefetchFirstX; x <= prefetchLastX; ++x)
+        {
+            const int64_t distanceX = std::max<int64_t>(a_firstX - x, x - a_lastX);
+            const int64_t distanceY = std::max<int64_t>(a_firstY - y, y - a_lastY);
+            const int64_t distance = std::max(distanceX, distanceY);
+            if (distance > 0)
+            {
+                const TileKey key = MakeKey(a_level,
+                                            static_cast<uint32_t>(x),
+                                            static_cast<uint32_t>(y));
+                prefetchTiles.emplace_back(distance, key);
+            }
+        }
+    }
+    std::stable_sort(prefetchTiles.begin(), prefetchTiles.end(),
+                     [](const std::pair<int64_t, TileKey>& a_first,
+                        const std::pair<int64_t, TileKey>& a_second)
+                     { return a_first.first < a_second.first; });
+    for (const auto& prefetchTile : prefetchTiles)
+    {
+        request(prefetchTile.second);
+    }
+}
+
+//--------------------------------------------------------------
+void TileSource::Implementation::ReadTiles()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_condition.wait(lock, [this]()
+        {
+            return m_exit || !m_pendingTiles.empty();
+        });
+        if (m_exit)
+        {
+            return;
+        }
+
+        const TileKey key = m_pendingTiles.front();
+        m_pendingTiles.pop_front();
+        if (m_cache.count(key))
+        {
+            continue;
+        }
+
+        // Read the tile without holding the lock, because pages of
+        // the mapped file are read from storage on first access.
+        m_readingTile = true;
+        lock.unlock();
+        TileData data = ReadTile(key);
+        lock.lock();
+        m_readingTile = false;
+
+        // Evict the least recently used tiles to make room.
+        m_recentTiles.push_front(key);
+        m_cache[key] = { std::move(data), m_recentTiles.begin() };
+        while (m_cache.size() > m_config.cacheTileCount)
+        {
+            m_cache.erase(m_recentTiles.back());
+            m_recentTiles.pop_back();
+        }
+    }
+}
+
+//--------------------------------------------------------------
+TileSource::Implementation::TileData
+TileSource::Implementation::ReadTile(TileKey a_key) const
+{
+    constexpr uint64_t MASK = (1ull << 28) - 1;
+    const uint32_t level = static_cast<uint32_t>(a_key >> 56);
+    const uint32_t tileY = static_cast<uint32_t>((a_key >> 28) & MASK);
+    const uint32_t tileX = static_cast<uint32_t>(a_key & MASK);
+
+    // The file size was validated to contain every tile when opened.
+    const uint8_t* tile = m_file->GetData() +
+                          TileOffsetBytes(m_config, level, tileX, tileY);
+    return std::make_shared<const std::vector<uint8_t>>(
+        tile, tile + TileSizeBytes(m_config));
+}
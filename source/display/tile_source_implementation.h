@@ -0,0 +1,122 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#pragma once
+
+#include <simple/display/tile_source.h>
+#include <display/mapped_file.h>
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//--------------------------------------------------------------
+namespace Simple
+{
+namespace Display
+{
+
+//--------------------------------------------------------------
+class TileSource::Implementation
+{
+public:
+    Implementation(const Config& a_config);
+    ~Implementation();
+
+    Implementation(const Implementation&) = delete;
+    Implementation& operator=(const Implementation&) = delete;
+
+    bool Update(void* o_pixels,
+                uint32_t a_width,
+                uint32_t a_height,
+                uint64_t a_pitch);
+
+    void SetViewport(const Buffer::Viewport& a_viewport);
+    Buffer::Viewport GetViewport() const;
+
+    const Config& GetConfig() const;
+    bool IsOpen() const;
+    uint32_t GetLevel() const;
+    uint32_t GetCachedTileCount() const;
+    uint32_t GetPendingTileCount() const;
+
+private:
+    // Tiles are identified by their level, column, and row.
+    using TileKey = uint64_t;
+    using TileData = std::shared_ptr<const std::vector<uint8_t>>;
+    static constexpr uint32_t OUTSIDE = UINT32_MAX;
+
+    struct CachedTile
+    {
+        TileData data;
+        std::list<TileKey>::iterator recent;
+    };
+
+    struct VisibleTile
+    {
+        TileData data;          // Null if no level is cached.
+        uint32_t level = 0;     // The level the data was read from.
+        uint32_t originX = 0;   // First column of the data in its level.
+        uint32_t originY = 0;   // First row of the data in its level.
+        uint32_t maxX = 0;      // Last column of its level.
+        uint32_t maxY = 0;      // Last row of its level.
+    };
+
+    static bool IsValid(const Config& a_config);
+    static TileKey MakeKey(uint32_t a_level,
+                           uint32_t a_tileX,
+                           uint32_t a_tileY);
+    static void MapPixels(float a_start,
+                          float a_extent,
+                          uint32_t a_count,
+                          uint32_t a_imageSize,
+                          uint32_t a_level,
+                          uint32_t a_levelSize,
+                          std::vector<uint32_t>& o_pixels);
+
+    // Must be called while holding m_mutex.
+    TileData FindTile(TileKey a_key);
+    void RequestTiles(uint32_t a_level,
+                      uint32_t a_firstX, uint32_t a_lastX,
+                      uint32_t a_firstY, uint32_t a_lastY,
+                      const Buffer::Viewport& a_viewport);
+
+    // Background thread function.
+    void ReadTiles();
+    TileData ReadTile(TileKey a_key) const;
+
+    const Config m_config;
+    std::unique_ptr<MappedFile> m_file;
+
+    // Only accessed from the thread calling Update.
+    Buffer::Viewport m_viewport;
+    Buffer::Viewport m_previousViewport;
+    bool m_hasPreviousViewport = false;
+    uint32_t m_level = 0;
+    std::vector<uint32_t> m_columns;
+    std::vector<uint32_t> m_rows;
+    std::vector<VisibleTile> m_visibleTiles;
+
+    // Shared with the background thread, guarded by m_mutex.
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::unordered_map<TileKey, CachedTile> m_cache;
+    std::list<TileKey> m_recentTiles; // Most recently used first.
+    std::deque<TileKey> m_pendingTiles;
+    bool m_readingTile = false;
+    bool m_exit = false;
+
+    std::thread m_thread;
+};
+
+} // namespace Display
+} // namespace Simple
@@ -146,6 +146,40 @@ void Window::PumpWindowEventsUntilEmpty()
     }
 }
 
+//--------------------------------------------------------------
+//! Request the window be redrawn at the end of the current frame
+//! by a context that renders on demand, even if its buffer was not
+//! invalidated. Requested automatically when the window is exposed
+//! or resized.
+//--------------------------------------------------------------
+void Window::RequestRedraw()
+{
+    if (m_pimpl)
+    {
+        m_pimpl->m_isRedrawRequested = true;
+    }
+}
+
+//--------------------------------------------------------------
+//! Query whether the window has been requested to be redrawn since
+//! it was last redrawn by its context.
+//!
+//! \return True if the window must be redrawn, false otherwise.
+//--------------------------------------------------------------
+bool Window::IsRedrawRequested() const
+{
+    return m_pimpl ? m_pimpl->m_isRedrawRequested.load() : false;
+}
+
+//--------------------------------------------------------------
+void Window::ClearRedrawRequest()
+{
+    if (m_pimpl)
+    {
+        m_pimpl->m_isRedrawRequested = false;
+    }
+}
+
 //--------------------------------------------------------------
 //! Query whether the window is currently in a full screen state.
 //!
@@ -10,6 +10,8 @@
 
 #include <simple/display/window.h>
 
+#include <atomic>
+
 //--------------------------------------------------------------
 namespace Simple
 {
@@ -65,6 +67,12 @@ protected:
     virtual NativeDeviceEvents* GetNativeDeviceEvents() = 0;
     virtual NativeInputEvents* GetNativeInputEvents() = 0;
     virtual NativeTextEvents* GetNativeTextEvents() = 0;
+
+    // Set when the window must be redrawn (eg. it was exposed or
+    // resized), possibly by a native thread, and cleared after its
+    // context has rendered, so contexts that render on demand can
+    // present frames only when they are needed.
+    std::atomic<bool> m_isRedrawRequested{ true };
 };
 
 } // namespace Display
@@ -0,0 +1,152 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <display/change_detector.h>
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+using namespace Simple::Display;
+
+//--------------------------------------------------------------
+inline uint32_t CountDirtyTiles(ChangeDetector& a_changeDetector,
+                                uint32_t a_width,
+                                uint32_t a_height)
+{
+    // Uploading the entire data cleans every tile.
+    ChangeDetector::Region region;
+    region.width = a_width;
+    region.height = a_height;
+    const uint64_t uploaded = a_changeDetector.GetCounters().tilesUploaded;
+    a_changeDetector.Upload(region);
+    return static_cast<uint32_t>(a_changeDetector.GetCounters().tilesUploaded - uploaded);
+}
+
+//--------------------------------------------------------------
+inline void TestChangeDetectorBytes(uint32_t a_width,
+                                    uint32_t a_height,
+                                    uint32_t a_bytesPerPixel,
+                                    uint64_t a_pitch)
+{
+    std::vector<uint8_t> data(a_pitch * a_height);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>((i * 7919) >> 3);
+    }
+
+    ChangeDetector changeDetector;
+    changeDetector.Reset(a_width, a_height, a_bytesPerPixel, a_pitch);
+    changeDetector.Hash(data.data());
+    CountDirtyTiles(changeDetector, a_width, a_height);
+
+    // Changing any single byte of a tile (or any bit of it) changes
+    // the hash of that tile, and only that tile, as does undoing it.
+    const uint64_t rowBytes = static_cast<uint64_t>(a_width) * a_bytesPerPixel;
+    for (uint32_t y = 0; y < a_height; ++y)
+    {
+        for (uint64_t x = 0; x < rowBytes; ++x)
+        {
+            uint8_t& byte = data[y * a_pitch + x];
+            const uint8_t bit = static_cast<uint8_t>(1u << ((x + y) % 8));
+            byte ^= bit;
+            changeDetector.Hash(data.data());
+            REQUIRE(CountDirtyTiles(changeDetector, a_width, a_height) == 1);
+
+            byte ^= bit;
+            changeDetector.Hash(data.data());
+            REQUIRE(CountDirtyTiles(changeDetector, a_width, a_height) == 1);
+        }
+    }
+
+    // Bytes in the padding of each row are ignored.
+    for (uint32_t y = 0; y < a_height; ++y)
+    {
+        for (uint64_t x = rowBytes; x < a_pitch; ++x)
+        {
+            data[y * a_pitch + x] ^= 0xFF;
+        }
+    }
+    changeDetector.Hash(data.data());
+    REQUIRE(CountDirtyTiles(changeDetector, a_width, a_height) == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Change Detector Bytes", "[change_detector][bytes]")
+{
+    TestChangeDetectorBytes(3, 2, 4, 12);
+    TestChangeDetectorBytes(67, 3, 4, 272);
+    TestChangeDetectorBytes(64, 8, 16, 1024);
+    TestChangeDetectorBytes(65, 2, 2, 136);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Change Detector Swap", "[change_detector][swap]")
+{
+    constexpr uint32_t width = 64;
+    constexpr uint32_t height = 64;
+    constexpr uint32_t bytesPerPixel = 4;
+    constexpr uint64_t pitch = width * bytesPerPixel;
+    std::vector<uint32_t> pixels(width * height);
+    for (uint32_t i = 0; i < pixels.size(); ++i)
+    {
+        pixels[i] = i * 2654435761u;
+    }
+
+    ChangeDetector changeDetector;
+    changeDetector.Reset(width, height, bytesPerPixel, pitch);
+    changeDetector.Hash(pixels.data());
+    REQUIRE(CountDirtyTiles(changeDetector, width, height) == 1);
+
+    // Swapping pixels (which leaves the sum of the data unchanged)
+    // changes the hash, at every distance within and between rows.
+    for (uint32_t distance = 1; distance < pixels.size(); distance += 7)
+    {
+        std::swap(pixels[0], pixels[distance]);
+        changeDetector.Hash(pixels.data());
+        REQUIRE(CountDirtyTiles(changeDetector, width, height) == 1);
+
+        std::swap(pixels[0], pixels[distance]);
+        changeDetector.Hash(pixels.data());
+        REQUIRE(CountDirtyTiles(changeDetector, width, height) == 1);
+    }
+
+    // Unchanged data is never uploaded again.
+    changeDetector.Hash(pixels.data());
+    REQUIRE(CountDirtyTiles(changeDetector, width, height) == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Change Detector Threads", "[change_detector][threads]")
+{
+    // Large data is hashed by multiple threads, which must detect the
+    // same changes as a single thread (in every band of tile rows).
+    constexpr uint32_t width = 1024;
+    constexpr uint32_t height = 2048;
+    constexpr uint32_t bytesPerPixel = 4;
+    constexpr uint64_t pitch = width * bytesPerPixel;
+    std::vector<uint8_t> data(pitch * height, 0);
+
+    ChangeDetector changeDetector;
+    changeDetector.Reset(width, height, bytesPerPixel, pitch);
+    changeDetector.Hash(data.data());
+    constexpr uint32_t tileCount = (width / ChangeDetector::TILE_SIZE) *
+                                   (height / ChangeDetector::TILE_SIZE);
+    REQUIRE(CountDirtyTiles(changeDetector, width, height) == tileCount);
+    REQUIRE(changeDetector.GetCounters().tilesHashed == tileCount);
+
+    for (uint32_t frame = 1; frame <= 4; ++frame)
+    {
+        for (uint32_t y = 0; y < height; y += ChangeDetector::TILE_SIZE)
+        {
+            data[y * pitch] = static_cast<uint8_t>(frame);
+        }
+        changeDetector.Hash(data.data());
+        REQUIRE(CountDirtyTiles(changeDetector, width, height) == height / ChangeDetector::TILE_SIZE);
+    }
+    REQUIRE(changeDetector.GetCounters().tilesHashed == tileCount * 5);
+}
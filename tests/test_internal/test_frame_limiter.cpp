@@ -0,0 +1,103 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <display/frame_limiter.h>
+#include <catch2/catch.hpp>
+
+using namespace Simple::Display;
+using Clock = FrameLimiter::Clock;
+
+//--------------------------------------------------------------
+inline Clock::duration GetFramePeriod(float a_framesPerSecond)
+{
+    using namespace std::chrono;
+    return duration_cast<Clock::duration>(duration<double>(1.0 / a_framesPerSecond));
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Frame Limiter Unlimited", "[frame_limiter][unlimited]")
+{
+    // Frames are never paced without a target rate or low latency.
+    FrameLimiter frameLimiter;
+    Context::PacingCounters pacingCounters;
+    for (uint32_t frame = 0; frame < 4; ++frame)
+    {
+        frameLimiter.WaitForNextFrame(pacingCounters);
+    }
+    REQUIRE(pacingCounters.framesPaced == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Frame Limiter Drift", "[frame_limiter][drift]")
+{
+    constexpr float framesPerSecond = 25.0f;
+    constexpr uint32_t frameCount = 12;
+    const Clock::duration framePeriod = GetFramePeriod(framesPerSecond);
+
+    FrameLimiter frameLimiter;
+    frameLimiter.SetTargetFrameRate(framesPerSecond);
+    Context::PacingCounters pacingCounters;
+
+    // The first frame starts immediately.
+    const Clock::time_point firstStart = Clock::now();
+    frameLimiter.WaitForNextFrame(pacingCounters);
+    REQUIRE(pacingCounters.framesPaced == 0);
+
+    // Each frame is due one period after the previous deadline, so
+    // frames that start late (by sleeping, or the work done in them)
+    // do not delay the frames that follow, and errors do not drift.
+    for (uint32_t frame = 1; frame < frameCount; ++frame)
+    {
+        std::this_thread::sleep_for(framePeriod / 4);
+        frameLimiter.WaitForNextFrame(pacingCounters);
+    }
+    const Clock::time_point lastStart = Clock::now();
+    REQUIRE(pacingCounters.framesPaced == frameCount - 1);
+
+    // The total duration is the sum of the periods plus the error of
+    // only the last frame (not the sum of the errors of every frame).
+    using namespace std::chrono;
+    const Clock::duration scheduled = framePeriod * (frameCount - 1);
+    const Clock::duration lastError = microseconds(pacingCounters.lastErrorMicroseconds);
+    REQUIRE(lastStart - firstStart >= scheduled);
+    REQUIRE(lastStart - firstStart < scheduled + lastError + framePeriod / 2);
+    REQUIRE(pacingCounters.maxErrorMicroseconds >= pacingCounters.lastErrorMicroseconds);
+    REQUIRE(pacingCounters.totalErrorMicroseconds >= pacingCounters.maxErrorMicroseconds);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Frame Limiter Late Frame", "[frame_limiter][late]")
+{
+    constexpr float framesPerSecond = 25.0f;
+    const Clock::duration framePeriod = GetFramePeriod(framesPerSecond);
+
+    FrameLimiter frameLimiter;
+    frameLimiter.SetTargetFrameRate(framesPerSecond);
+    Context::PacingCounters pacingCounters;
+    frameLimiter.WaitForNextFrame(pacingCounters);
+    frameLimiter.WaitForNextFrame(pacingCounters);
+    REQUIRE(pacingCounters.framesPaced == 1);
+
+    // A frame that is several periods late starts immediately...
+    std::this_thread::sleep_for(framePeriod * 3);
+    const Clock::time_point lateStart = Clock::now();
+    frameLimiter.WaitForNextFrame(pacingCounters);
+    const Clock::time_point lateEnd = Clock::now();
+    REQUIRE(pacingCounters.framesPaced == 2);
+    REQUIRE(lateEnd - lateStart < framePeriod);
+    using namespace std::chrono;
+    REQUIRE(microseconds(pacingCounters.lastErrorMicroseconds) >= framePeriod * 2);
+
+    // ...then the schedule is reset from it, so the next frame is
+    // due a whole period later instead of starting back to back.
+    frameLimiter.WaitForNextFrame(pacingCounters);
+    const Clock::time_point nextStart = Clock::now();
+    REQUIRE(pacingCounters.framesPaced == 3);
+    REQUIRE(nextStart - lateEnd >= framePeriod * 9 / 10);
+    REQUIRE(nextStart - lateEnd < framePeriod * 3);
+}
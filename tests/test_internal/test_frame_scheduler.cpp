@@ -0,0 +1,198 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <display/buffer_host.h>
+#include <display/frame_scheduler.h>
+#include <catch2/catch.hpp>
+
+#include <memory>
+
+using namespace Simple::Display;
+
+//--------------------------------------------------------------
+inline Buffer::Config GetSchedulerBufferConfig(uint32_t a_width,
+                                               uint32_t a_height)
+{
+    Buffer::Config config;
+    config.width = a_width;
+    config.height = a_height;
+    return BufferHost::GetHostConfig(config);
+}
+
+//--------------------------------------------------------------
+inline void FillBuffer(Buffer& a_buffer, uint8_t a_value)
+{
+    memset(a_buffer.GetData(), a_value, a_buffer.GetSize());
+}
+
+//--------------------------------------------------------------
+inline bool IsBufferFilled(const Buffer& a_buffer, uint8_t a_value)
+{
+    const uint8_t* data = static_cast<const uint8_t*>(a_buffer.GetData());
+    for (uint64_t i = 0; i < a_buffer.GetSize(); ++i)
+    {
+        if (data[i] != a_value)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//--------------------------------------------------------------
+inline void QueueFrames(FrameScheduler& a_frameScheduler,
+                        Buffer& a_buffer)
+{
+    // Queue frames out of order, each filled with its target time
+    // (in milliseconds), and two with the same target time (which
+    // are displayed in the order they were queued).
+    const uint64_t targetMilliseconds[] = { 30, 10, 20, 40, 20 };
+    const uint8_t values[] = { 30, 10, 20, 40, 21 };
+    for (size_t i = 0; i < 5; ++i)
+    {
+        FillBuffer(a_buffer, values[i]);
+        REQUIRE(a_frameScheduler.QueueFrame(a_buffer, targetMilliseconds[i] * 1000));
+    }
+    REQUIRE(a_frameScheduler.GetQueuedFrameCount() == 5);
+    REQUIRE(a_frameScheduler.GetNextTargetMicroseconds() == 10000);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Frame Scheduler Queue", "[frame_scheduler][queue]")
+{
+    Buffer buffer(std::make_unique<BufferHost>(GetSchedulerBufferConfig(4, 2)));
+    FrameScheduler frameScheduler;
+    frameScheduler.Configure(2, Context::LateFramePolicy::PRESENT);
+
+    // Frames are not queued beyond the queue size.
+    REQUIRE(frameScheduler.QueueFrame(buffer, 1000));
+    REQUIRE(frameScheduler.QueueFrame(buffer, 2000));
+    REQUIRE(!frameScheduler.QueueFrame(buffer, 3000));
+    REQUIRE(frameScheduler.GetQueuedFrameCount() == 2);
+
+    // Frames are not dequeued before they are due.
+    uint64_t target = 0;
+    uint64_t framesDropped = 0;
+    REQUIRE(!frameScheduler.DequeueFrame(buffer, 999, target, framesDropped));
+    REQUIRE(frameScheduler.DequeueFrame(buffer, 1000, target, framesDropped));
+    REQUIRE(target == 1000);
+    REQUIRE(frameScheduler.GetQueuedFrameCount() == 1);
+
+    // Nothing is restored before a frame has been dequeued.
+    FrameScheduler emptyScheduler;
+    REQUIRE(!emptyScheduler.RestoreFrame(buffer));
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Frame Scheduler Present", "[frame_scheduler][present]")
+{
+    Buffer buffer(std::make_unique<BufferHost>(GetSchedulerBufferConfig(4, 2)));
+    FrameScheduler frameScheduler;
+    frameScheduler.Configure(8, Context::LateFramePolicy::PRESENT);
+    QueueFrames(frameScheduler, buffer);
+
+    // Every frame is presented in order of target time, one each
+    // time a frame is dequeued, even though all of them are late.
+    const uint64_t expectedTargets[] = { 10, 20, 20, 30, 40 };
+    const uint8_t expectedValues[] = { 10, 20, 21, 30, 40 };
+    uint64_t framesDropped = 0;
+    for (size_t i = 0; i < 5; ++i)
+    {
+        uint64_t target = 0;
+        REQUIRE(frameScheduler.DequeueFrame(buffer, 100000, target, framesDropped));
+        REQUIRE(target == expectedTargets[i] * 1000);
+        REQUIRE(IsBufferFilled(buffer, expectedValues[i]));
+        REQUIRE(buffer.IsInvalidated());
+        REQUIRE(frameScheduler.GetQueuedFrameCount() == 4 - i);
+    }
+    REQUIRE(framesDropped == 0);
+
+    uint64_t target = 0;
+    REQUIRE(!frameScheduler.DequeueFrame(buffer, 100000, target, framesDropped));
+    REQUIRE(frameScheduler.GetNextTargetMicroseconds() == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Frame Scheduler Drop", "[frame_scheduler][drop]")
+{
+    Buffer buffer(std::make_unique<BufferHost>(GetSchedulerBufferConfig(4, 2)));
+    FrameScheduler frameScheduler;
+    frameScheduler.Configure(8, Context::LateFramePolicy::DROP);
+    QueueFrames(frameScheduler, buffer);
+
+    // Only the latest frame that is due is presented, dropping any
+    // earlier ones (including those with the same target time).
+    uint64_t target = 0;
+    uint64_t framesDropped = 0;
+    REQUIRE(frameScheduler.DequeueFrame(buffer, 25000, target, framesDropped));
+    REQUIRE(target == 20000);
+    REQUIRE(IsBufferFilled(buffer, 21));
+    REQUIRE(framesDropped == 2);
+    REQUIRE(frameScheduler.GetQueuedFrameCount() == 2);
+    REQUIRE(frameScheduler.GetNextTargetMicroseconds() == 30000);
+
+    // A frame that is due is not dropped if no later frame is due.
+    REQUIRE(frameScheduler.DequeueFrame(buffer, 35000, target, framesDropped));
+    REQUIRE(target == 30000);
+    REQUIRE(IsBufferFilled(buffer, 30));
+    REQUIRE(framesDropped == 2);
+
+    REQUIRE(frameScheduler.DequeueFrame(buffer, 40000, target, framesDropped));
+    REQUIRE(target == 40000);
+    REQUIRE(IsBufferFilled(buffer, 40));
+    REQUIRE(framesDropped == 2);
+    REQUIRE(frameScheduler.GetQueuedFrameCount() == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Frame Scheduler Restore", "[frame_scheduler][restore]")
+{
+    const Buffer::Config config = GetSchedulerBufferConfig(4, 2);
+    Buffer buffer(std::make_unique<BufferHost>(config));
+    FrameScheduler frameScheduler;
+    frameScheduler.Configure(8, Context::LateFramePolicy::DROP);
+    FillBuffer(buffer, 7);
+    REQUIRE(frameScheduler.QueueFrame(buffer, 1000));
+
+    uint64_t target = 0;
+    uint64_t framesDropped = 0;
+    REQUIRE(frameScheduler.DequeueFrame(buffer, 1000, target, framesDropped));
+    buffer.Render(4, 2);
+
+    // The frame last dequeued is restored after the buffer data was
+    // overwritten, and the buffer is invalidated so it is redrawn.
+    FillBuffer(buffer, 9);
+    REQUIRE(frameScheduler.RestoreFrame(buffer));
+    REQUIRE(IsBufferFilled(buffer, 7));
+    REQUIRE(buffer.IsInvalidated());
+    buffer.Render(4, 2);
+
+    // It no longer matches the layout of the buffer after a resize,
+    // so the buffer data is left unchanged (but still invalidated).
+    buffer.Resize(GetSchedulerBufferConfig(8, 4));
+    buffer.Render(8, 4);
+    FillBuffer(buffer, 9);
+    REQUIRE(frameScheduler.RestoreFrame(buffer));
+    REQUIRE(IsBufferFilled(buffer, 9));
+    REQUIRE(buffer.IsInvalidated());
+
+    // Frames queued after the resize are restored as usual.
+    FillBuffer(buffer, 11);
+    REQUIRE(frameScheduler.QueueFrame(buffer, 2000));
+    REQUIRE(frameScheduler.DequeueFrame(buffer, 2000, target, framesDropped));
+    FillBuffer(buffer, 9);
+    REQUIRE(frameScheduler.RestoreFrame(buffer));
+    REQUIRE(IsBufferFilled(buffer, 11));
+
+    // The frame queued before the resize matches again once the
+    // buffer is resized back, but it is no longer the last dequeued.
+    buffer.Resize(config);
+    FillBuffer(buffer, 9);
+    REQUIRE(frameScheduler.RestoreFrame(buffer));
+    REQUIRE(IsBufferFilled(buffer, 9));
+}
@@ -21,6 +21,7 @@ template<typename DataType, uint32_t ChannelsPerPixel, uint32_t NumColors>
 __global__ void CycleColorsKernel(DataType* a_bufferData,
                                   uint32_t a_bufferWidth,
                                   uint32_t a_bufferHeight,
+                                  uint32_t a_bufferRowLength,
                                   uint32_t a_secondsElapsed)
 {
     const uint32_t x = blockIdx.x * blockDim.x + threadIdx.x;
@@ -52,7 +53,7 @@ __global__ void CycleColorsKernel(DataType* a_bufferData,
     }
 
     const uint32_t i = (x * ChannelsPerPixel) +
-                       (y * a_bufferWidth * ChannelsPerPixel);
+                       (y * a_bufferRowLength);
     for (uint32_t z = 0; z < ChannelsPerPixel; ++z)
     {
         a_bufferData[i + z] = color[z];
@@ -66,6 +67,7 @@ extern void CycleColorsCuda(const Buffer& a_buffer,
 {
     const uint32_t bufferWidth = a_buffer.GetWidth();
     const uint32_t bufferHeight = a_buffer.GetHeight();
+    const uint32_t bufferRowLength = a_buffer.GetPitch() / sizeof(DataType);
     DataType* bufferData = a_buffer.GetData<DataType, Buffer::Interop::CUDA>();
     if (!bufferData || !bufferWidth || !bufferHeight || !bufferData)
     {
@@ -78,6 +80,7 @@ extern void CycleColorsCuda(const Buffer& a_buffer,
     CycleColorsKernel<DataType, ChannelsPerPixel, NumColors><<<gridDim, blockDim>>>(bufferData,
                                                                                     bufferWidth,
                                                                                     bufferHeight,
+                                                                                    bufferRowLength,
                                                                                     (uint32_t)a_secondsElapsed);
 }
 
@@ -109,3 +112,8 @@ template void CycleColorsCuda<uint8_t, 4, 4>(const uint8_t a_colors[4][4],
 template void CycleColorsCuda<uint16_t, 4, 4>(const uint16_t a_colors[4][4],
                                               const Buffer& a_buffer,
                                               float a_secondsElapsed);
+
+//--------------------------------------------------------------
+template void CycleColorsCuda<uint32_t, 1, 4>(const uint32_t a_colors[4][1],
+                                              const Buffer& a_buffer,
+                                              float a_secondsElapsed);
@@ -0,0 +1,351 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <simple/display/block_encoder.h>
+#include <simple/display/context.h>
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+using namespace Simple::Display;
+
+//--------------------------------------------------------------
+inline void Decode565(uint32_t a_packed, uint32_t* o_color)
+{
+    const uint32_t r = (a_packed >> 11) & 31;
+    const uint32_t g = (a_packed >> 5) & 63;
+    const uint32_t b = a_packed & 31;
+    o_color[0] = (r << 3) | (r >> 2);
+    o_color[1] = (g << 2) | (g >> 4);
+    o_color[2] = (b << 3) | (b >> 2);
+    o_color[3] = 255;
+}
+
+//--------------------------------------------------------------
+inline uint64_t ReadBits(const uint8_t* a_block,
+                         uint32_t a_first,
+                         uint32_t a_count)
+{
+    uint64_t value = 0;
+    for (uint32_t i = 0; i < a_count; ++i)
+    {
+        const uint32_t bit = a_first + i;
+        value |= uint64_t((a_block[bit / 8] >> (bit % 8)) & 1) << i;
+    }
+    return value;
+}
+
+//--------------------------------------------------------------
+// Decode a single pixel of a BC1 or BC3 color block.
+//--------------------------------------------------------------
+inline void DecodeColor(const uint8_t* a_block,
+                        uint32_t a_pixel,
+                        bool a_alwaysFourColors,
+                        uint32_t* o_rgba)
+{
+    const uint32_t packed0 = a_block[0] | (a_block[1] << 8);
+    const uint32_t packed1 = a_block[2] | (a_block[3] << 8);
+    const uint32_t index = static_cast<uint32_t>(ReadBits(a_block + 4, a_pixel * 2, 2));
+    uint32_t color0[4];
+    uint32_t color1[4];
+    Decode565(packed0, color0);
+    Decode565(packed1, color1);
+    const bool fourColors = a_alwaysFourColors || (packed0 > packed1);
+    for (uint32_t c = 0; c < 3; ++c)
+    {
+        switch (index)
+        {
+            case 0: o_rgba[c] = color0[c]; break;
+            case 1: o_rgba[c] = color1[c]; break;
+            case 2: o_rgba[c] = fourColors ? ((2 * color0[c]) + color1[c]) / 3 :
+                                             (color0[c] + color1[c]) / 2; break;
+            default: o_rgba[c] = fourColors ? (color0[c] + (2 * color1[c])) / 3 : 0; break;
+        }
+    }
+    o_rgba[3] = (!fourColors && index == 3) ? 0 : 255;
+}
+
+//--------------------------------------------------------------
+// Decode a single pixel of a BC3 alpha block.
+//--------------------------------------------------------------
+inline uint32_t DecodeAlpha(const uint8_t* a_block,
+                            uint32_t a_pixel)
+{
+    const uint32_t alpha0 = a_block[0];
+    const uint32_t alpha1 = a_block[1];
+    const uint32_t index = static_cast<uint32_t>(ReadBits(a_block + 2, a_pixel * 3, 3));
+    if (index < 2)
+    {
+        return index ? alpha1 : alpha0;
+    }
+    if (alpha0 > alpha1)
+    {
+        return (((8 - index) * alpha0) + ((index - 1) * alpha1)) / 7;
+    }
+    return (index == 6) ? 0 : (index == 7) ? 255 :
+           (((6 - index) * alpha0) + ((index - 1) * alpha1)) / 5;
+}
+
+//--------------------------------------------------------------
+// Decode a single pixel of a BC7 block (only mode 6 is encoded).
+//--------------------------------------------------------------
+inline void DecodeBC7(const uint8_t* a_block,
+                      uint32_t a_pixel,
+                      uint32_t* o_rgba)
+{
+    static constexpr uint32_t Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30,
+                                              34, 38, 43, 47, 51, 55, 60, 64 };
+    REQUIRE(ReadBits(a_block, 0, 7) == (1 << 6));
+    const uint32_t pBit0 = static_cast<uint32_t>(ReadBits(a_block, 63, 1));
+    const uint32_t pBit1 = static_cast<uint32_t>(ReadBits(a_block, 64, 1));
+    const uint32_t index = a_pixel ?
+        static_cast<uint32_t>(ReadBits(a_block, 65 + 3 + ((a_pixel - 1) * 4), 4)) :
+        static_cast<uint32_t>(ReadBits(a_block, 65, 3));
+    for (uint32_t c = 0; c < 4; ++c)
+    {
+        const uint32_t endpoint0 = static_cast<uint32_t>(ReadBits(a_block, 7 + (c * 14), 7) << 1) | pBit0;
+        const uint32_t endpoint1 = static_cast<uint32_t>(ReadBits(a_block, 14 + (c * 14), 7) << 1) | pBit1;
+        o_rgba[c] = (((64 - Weights[index]) * endpoint0) + (Weights[index] * endpoint1) + 32) >> 6;
+    }
+}
+
+//--------------------------------------------------------------
+inline void DecodePixel(const uint8_t* a_blocks,
+                        uint64_t a_blockPitch,
+                        Buffer::Format a_format,
+                        uint32_t a_x,
+                        uint32_t a_y,
+                        uint32_t* o_rgba)
+{
+    const uint8_t* block = a_blocks + ((a_y / 4) * a_blockPitch) +
+                           ((a_x / 4) * Buffer::BytesPerBlock(a_format));
+    const uint32_t pixel = ((a_y % 4) * 4) + (a_x % 4);
+    switch (a_format)
+    {
+        case Buffer::Format::BC1_UNORM:
+        {
+            DecodeColor(block, pixel, false, o_rgba);
+        }
+        break;
+        case Buffer::Format::BC3_UNORM:
+        {
+            DecodeColor(block + 8, pixel, true, o_rgba);
+            o_rgba[3] = DecodeAlpha(block, pixel);
+        }
+        break;
+        case Buffer::Format::BC7_UNORM:
+        {
+            DecodeBC7(block, pixel, o_rgba);
+        }
+        break;
+        default: break;
+    }
+}
+
+//--------------------------------------------------------------
+inline std::vector<uint8_t> GradientPixels(uint32_t a_width,
+                                           uint32_t a_height)
+{
+    std::vector<uint8_t> pixels(a_width * a_height * 4);
+    for (uint32_t y = 0; y < a_height; ++y)
+    {
+        for (uint32_t x = 0; x < a_width; ++x)
+        {
+            uint8_t* pixel = &pixels[((y * a_width) + x) * 4];
+            pixel[0] = static_cast<uint8_t>(x);
+            pixel[1] = static_cast<uint8_t>(y * 2);
+            pixel[2] = static_cast<uint8_t>(255 - x);
+            pixel[3] = static_cast<uint8_t>(128 + (y % 128));
+        }
+    }
+    return pixels;
+}
+
+//--------------------------------------------------------------
+inline void RequireEncodedSolid(Buffer::Format a_format)
+{
+    // Solid colors are encoded to within the precision of the
+    // endpoints, and partial blocks are clamped to the image.
+    constexpr uint32_t width = 6;
+    constexpr uint32_t height = 5;
+    const uint8_t colors[][4] = { { 0, 0, 0, 255 },
+                                  { 255, 255, 255, 255 },
+                                  { 200, 100, 50, 255 },
+                                  { 17, 230, 129, 255 } };
+    const uint32_t tolerance = (a_format == Buffer::Format::BC7_UNORM) ? 1 : 8;
+    for (const uint8_t* color : colors)
+    {
+        std::vector<uint8_t> pixels(width * height * 4);
+        for (uint32_t i = 0; i < width * height; ++i)
+        {
+            std::copy(color, color + 4, &pixels[i * 4]);
+        }
+
+        const uint64_t blockPitch = 2 * Buffer::BytesPerBlock(a_format);
+        std::vector<uint8_t> blocks(blockPitch * 2);
+        REQUIRE(BlockEncoder::Encode(pixels.data(), width, height, width * 4,
+                                     a_format, blocks.data(), blockPitch));
+        for (uint32_t y = 0; y < 8; ++y)
+        {
+            for (uint32_t x = 0; x < 8; ++x)
+            {
+                uint32_t rgba[4];
+                DecodePixel(blocks.data(), blockPitch, a_format, x, y, rgba);
+                for (uint32_t c = 0; c < 4; ++c)
+                {
+                    REQUIRE(uint32_t(std::abs(int32_t(rgba[c]) - int32_t(color[c]))) <= tolerance);
+                }
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Block Encoder Solid", "[block_encoder][solid]")
+{
+    SECTION("Format::BC1_UNORM")
+    {
+        RequireEncodedSolid(Buffer::Format::BC1_UNORM);
+    }
+    SECTION("Format::BC3_UNORM")
+    {
+        RequireEncodedSolid(Buffer::Format::BC3_UNORM);
+    }
+    SECTION("Format::BC7_UNORM")
+    {
+        RequireEncodedSolid(Buffer::Format::BC7_UNORM);
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Block Encoder Transparent", "[block_encoder][transparent]")
+{
+    // BC1 encodes pixels less than half opaque as transparent black.
+    std::vector<uint8_t> pixels(4 * 4 * 4, 255);
+    pixels[3] = 0;
+    pixels[(5 * 4) + 3] = 127;
+    uint8_t block[8];
+    REQUIRE(BlockEncoder::Encode(pixels.data(), 4, 4, 16,
+                                 Buffer::Format::BC1_UNORM, block, 8));
+    for (uint32_t pixel = 0; pixel < 16; ++pixel)
+    {
+        uint32_t rgba[4];
+        DecodeColor(block, pixel, false, rgba);
+        const bool transparent = (pixel == 0 || pixel == 5);
+        REQUIRE(rgba[3] == (transparent ? 0 : 255));
+        REQUIRE(rgba[0] == (transparent ? 0 : 255));
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Block Encoder Gradient", "[block_encoder][gradient]")
+{
+    Buffer::Format format = Buffer::Format::BC1_UNORM;
+    uint32_t tolerance = 0;
+    SECTION("Format::BC1_UNORM")
+    {
+        format = Buffer::Format::BC1_UNORM;
+        tolerance = 12;
+    }
+    SECTION("Format::BC3_UNORM")
+    {
+        format = Buffer::Format::BC3_UNORM;
+        tolerance = 12;
+    }
+    SECTION("Format::BC7_UNORM")
+    {
+        format = Buffer::Format::BC7_UNORM;
+        tolerance = 4;
+    }
+
+    // Large images are encoded by multiple threads, with the same
+    // result as a single thread.
+    constexpr uint32_t width = 258;
+    constexpr uint32_t height = 127;
+    const std::vector<uint8_t> pixels = GradientPixels(width, height);
+    const uint64_t blockPitch = ((width + 3) / 4) * Buffer::BytesPerBlock(format) + 16;
+    const uint64_t blocksSize = blockPitch * ((height + 3) / 4);
+    std::vector<uint8_t> singleThreaded(blocksSize);
+    std::vector<uint8_t> multiThreaded(blocksSize);
+    REQUIRE(BlockEncoder::Encode(pixels.data(), width, height, width * 4,
+                                 format, singleThreaded.data(), blockPitch, 1));
+    REQUIRE(BlockEncoder::Encode(pixels.data(), width, height, width * 4,
+                                 format, multiThreaded.data(), blockPitch, 8));
+    REQUIRE(singleThreaded == multiThreaded);
+
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            uint32_t rgba[4];
+            DecodePixel(singleThreaded.data(), blockPitch, format, x, y, rgba);
+            const uint8_t* pixel = &pixels[((y * width) + x) * 4];
+            const uint32_t channels = (format == Buffer::Format::BC1_UNORM) ? 3 : 4;
+            for (uint32_t c = 0; c < channels; ++c)
+            {
+                REQUIRE(uint32_t(std::abs(int32_t(rgba[c]) - int32_t(pixel[c]))) <= tolerance);
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Block Encoder Invalid", "[block_encoder][invalid]")
+{
+    const std::vector<uint8_t> pixels = GradientPixels(8, 8);
+    std::vector<uint8_t> blocks(64);
+    REQUIRE(!BlockEncoder::Encode(nullptr, 8, 8, 32, Buffer::Format::BC1_UNORM, blocks.data(), 16));
+    REQUIRE(!BlockEncoder::Encode(pixels.data(), 8, 8, 32, Buffer::Format::BC1_UNORM, nullptr, 16));
+    REQUIRE(!BlockEncoder::Encode(pixels.data(), 0, 8, 32, Buffer::Format::BC1_UNORM, blocks.data(), 16));
+    REQUIRE(!BlockEncoder::Encode(pixels.data(), 8, 0, 32, Buffer::Format::BC1_UNORM, blocks.data(), 16));
+    REQUIRE(!BlockEncoder::Encode(pixels.data(), 8, 8, 16, Buffer::Format::BC1_UNORM, blocks.data(), 16));
+    REQUIRE(!BlockEncoder::Encode(pixels.data(), 8, 8, 32, Buffer::Format::BC7_UNORM, blocks.data(), 16));
+    REQUIRE(!BlockEncoder::Encode(pixels.data(), 8, 8, 32, Buffer::Format::RGBA_UINT8, blocks.data(), 32));
+    REQUIRE(BlockEncoder::Encode(pixels.data(), 8, 8, 32, Buffer::Format::BC1_UNORM, blocks.data(), 16));
+    REQUIRE(BlockEncoder::Encode(pixels.data(), 8, 8, 32, Buffer::Format::BC7_UNORM, blocks.data(), 32));
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Block Encoder Buffer", "[block_encoder][buffer]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 64;
+    bufferConfig.height = 30;
+    bufferConfig.format = Buffer::Format::BC7_UNORM;
+    const std::vector<uint8_t> pixels = GradientPixels(bufferConfig.width, bufferConfig.height);
+
+    Context context({ bufferConfig, {} });
+    Buffer& buffer = context.GetBuffer();
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    REQUIRE(BlockEncoder::Encode(pixels.data(), bufferConfig.width * 4, buffer));
+    REQUIRE(buffer.IsInvalidated());
+
+    // The blocks are identical to those encoded separately.
+    const uint64_t blockPitch = buffer.GetPitch();
+    std::vector<uint8_t> blocks(buffer.GetSize());
+    REQUIRE(BlockEncoder::Encode(pixels.data(), bufferConfig.width, bufferConfig.height,
+                                 bufferConfig.width * 4, bufferConfig.format,
+                                 blocks.data(), blockPitch));
+    const uint8_t* data = buffer.GetData<uint8_t>();
+    for (uint32_t row = 0; row < 8; ++row)
+    {
+        REQUIRE(std::equal(data + (row * blockPitch),
+                           data + (row * blockPitch) + (16 * 16),
+                           blocks.data() + (row * blockPitch)));
+    }
+    context.OnFrameStart();
+    context.OnFrameEnded();
+
+    // Only host buffers with block-compressed formats are encoded.
+    bufferConfig.format = Buffer::Format::RGBA_UINT8;
+    buffer.Resize(bufferConfig);
+    REQUIRE(!BlockEncoder::Encode(pixels.data(), bufferConfig.width * 4, buffer));
+}
@@ -9,6 +9,8 @@
 #include <simple/display/buffer.h>
 #include <simple/display/context.h>
 #include <catch2/catch.hpp>
+#include <algorithm>
+#include <cstring>
 
 using namespace Simple::Display;
 
@@ -16,12 +18,22 @@ using namespace Simple::Display;
 inline void RequireBufferValues(const Buffer& a_buffer,
                                 const Buffer::Config& a_config)
 {
-    const uint32_t minSize = Buffer::MinSizeBytes(a_config);
-    const uint32_t minPitch = Buffer::MinPitchBytes(a_config);
+    // Tiled layouts may fall back to linear if not supported.
+    Buffer::Config config = a_config;
+    config.layout = a_buffer.GetLayout();
+    REQUIRE((config.layout == a_config.layout ||
+             config.layout == Buffer::Layout::LINEAR));
+
+    const uint64_t minSize = Buffer::AlignedSizeBytes(config);
+    const uint64_t minPitch = Buffer::AlignedPitchBytes(config);
+    const uint32_t alignment = a_config.pitchAlignment ? a_config.pitchAlignment : 1;
+    const uint64_t paddedHeight = minSize / minPitch;
 
     REQUIRE(a_buffer.GetData());
     REQUIRE(a_buffer.GetSize() >= minSize);
     REQUIRE(a_buffer.GetPitch() >= minPitch);
+    REQUIRE(a_buffer.GetPitch() % alignment == 0);
+    REQUIRE(a_buffer.GetSize() == a_buffer.GetPitch() * paddedHeight);
     REQUIRE(a_buffer.GetWidth() == a_config.width);
     REQUIRE(a_buffer.GetHeight() == a_config.height);
     REQUIRE(a_buffer.GetFormat() == a_config.format);
@@ -43,8 +55,10 @@ inline void RequireBufferValues(const Buffer& a_buffer,
             }
             REQUIRE(!a_buffer.GetData<uint8_t>());
             REQUIRE(!a_buffer.GetData<uint16_t>());
+            REQUIRE(!a_buffer.GetData<uint32_t>());
             REQUIRE(!a_buffer.GetData<uint8_t, Buffer::Interop::CUDA>());
             REQUIRE(!a_buffer.GetData<uint16_t, Buffer::Interop::CUDA>());
+            REQUIRE(!a_buffer.GetData<uint32_t, Buffer::Interop::CUDA>());
         }
         break;
         case Buffer::Format::RGBA_UINT8:
@@ -61,8 +75,10 @@ inline void RequireBufferValues(const Buffer& a_buffer,
             }
             REQUIRE(!a_buffer.GetData<float>());
             REQUIRE(!a_buffer.GetData<uint16_t>());
+            REQUIRE(!a_buffer.GetData<uint32_t>());
             REQUIRE(!a_buffer.GetData<float, Buffer::Interop::CUDA>());
             REQUIRE(!a_buffer.GetData<uint16_t, Buffer::Interop::CUDA>());
+            REQUIRE(!a_buffer.GetData<uint32_t, Buffer::Interop::CUDA>());
         }
         break;
         case Buffer::Format::RGBA_UINT16:
@@ -79,8 +95,30 @@ inline void RequireBufferValues(const Buffer& a_buffer,
             }
             REQUIRE(!a_buffer.GetData<float>());
             REQUIRE(!a_buffer.GetData<uint8_t>());
+            REQUIRE(!a_buffer.GetData<uint32_t>());
             REQUIRE(!a_buffer.GetData<float, Buffer::Interop::CUDA>());
             REQUIRE(!a_buffer.GetData<uint8_t, Buffer::Interop::CUDA>());
+            REQUIRE(!a_buffer.GetData<uint32_t, Buffer::Interop::CUDA>());
+        }
+        break;
+        case Buffer::Format::RGB10A2_UNORM:
+        {
+            if (a_buffer.GetInterop() == Buffer::Interop::HOST)
+            {
+                REQUIRE(a_buffer.GetData<uint32_t>());
+                REQUIRE(!a_buffer.GetData<uint32_t, Buffer::Interop::CUDA>());
+            }
+            else
+            {
+                REQUIRE(!a_buffer.GetData<uint32_t>());
+                REQUIRE(a_buffer.GetData<uint32_t, Buffer::Interop::CUDA>());
+            }
+            REQUIRE(!a_buffer.GetData<float>());
+            REQUIRE(!a_buffer.GetData<uint8_t>());
+            REQUIRE(!a_buffer.GetData<uint16_t>());
+            REQUIRE(!a_buffer.GetData<float, Buffer::Interop::CUDA>());
+            REQUIRE(!a_buffer.GetData<uint8_t, Buffer::Interop::CUDA>());
+            REQUIRE(!a_buffer.GetData<uint16_t, Buffer::Interop::CUDA>());
         }
         break;
         default:
@@ -103,6 +141,33 @@ TEST_CASE("Test Buffer None", "[buffer][none]")
     REQUIRE(buffer.GetHeight() == 0);
     REQUIRE(buffer.GetFormat() == Buffer::Format::NONE);
     REQUIRE(buffer.GetInterop() == Buffer::Interop::NONE);
+    REQUIRE(buffer.GetStorage() == Buffer::Storage::NATIVE);
+    REQUIRE(buffer.GetLayout() == Buffer::Layout::LINEAR);
+    REQUIRE(buffer.GetStorageSavings() == 0);
+    REQUIRE(buffer.GetViewport().width == 0.0f);
+    REQUIRE(buffer.GetViewport().height == 0.0f);
+    REQUIRE(buffer.GetUploadCounters().tilesHashed == 0);
+    REQUIRE(buffer.GetUploadCounters().tilesUploaded == 0);
+    buffer.Invalidate();
+    REQUIRE(!buffer.IsInvalidated());
+    REQUIRE(buffer.GetScroll() == Buffer::Scroll::NONE);
+    REQUIRE(!buffer.AcquireScrollLine());
+    REQUIRE(buffer.GetScrollOffset() == 0);
+    buffer.CommitRows(0, 1);
+    REQUIRE(!buffer.IsInvalidated());
+    buffer.Clear({});
+    buffer.FillRect({ 0, 0, 1, 1 }, {});
+    buffer.CopyRect({ 0, 0, 1, 1 }, 1, 1);
+    REQUIRE(!buffer.IsInvalidated());
+    REQUIRE(!buffer.StoreFlipbookFrame(0));
+    buffer.ShowFlipbookFrame(0);
+    REQUIRE(buffer.GetFlipbookFrame() == UINT32_MAX);
+    REQUIRE(buffer.GetFlipbookFrameCount() == 0);
+    buffer.AccumulateSamples(4);
+    buffer.ResetAccumulation();
+    REQUIRE(!buffer.IsInvalidated());
+    REQUIRE(buffer.GetAccumulatedSampleCount() == 0);
+    REQUIRE(!buffer.IsAccumulating());
 }
 
 //--------------------------------------------------------------
@@ -186,6 +251,125 @@ TEST_CASE("Test Buffer RGBA_UINT16", "[buffer][rgba_uint16]")
     RequireBufferValues(context.GetBuffer(), bufferConfig);
 }
 
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer RGB10A2_UNORM", "[buffer][rgb10a2_unorm]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.format = Buffer::Format::RGB10A2_UNORM;
+    Context context({ bufferConfig, {} });
+    RequireBufferValues(context.GetBuffer(), bufferConfig);
+}
+
+//--------------------------------------------------------------
+inline void RequireBufferCompressed(Buffer::Format a_format)
+{
+    // Block-compressed buffers are always linear, and cannot scroll.
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 30;
+    bufferConfig.height = 18;
+    bufferConfig.format = a_format;
+    bufferConfig.layout = Buffer::Layout::TILED_16X16;
+    bufferConfig.scroll = Buffer::Scroll::ROWS;
+    Context context({ bufferConfig, {} });
+    Buffer& buffer = context.GetBuffer();
+    bufferConfig.layout = Buffer::Layout::LINEAR;
+    RequireBufferValues(buffer, bufferConfig);
+    REQUIRE(buffer.GetLayout() == Buffer::Layout::LINEAR);
+    REQUIRE(buffer.GetScroll() == Buffer::Scroll::NONE);
+    REQUIRE(buffer.GetPitch() >= 8 * Buffer::BytesPerBlock(a_format));
+    REQUIRE(buffer.GetSize() == buffer.GetPitch() * 5);
+
+    // Blocks are written directly, and operations are ignored.
+    std::memset(buffer.GetData(), 0x5A, buffer.GetSize());
+    buffer.FillRect({ 0, 0, 30, 18 }, { 0.0f, 0.0f, 0.0f, 0.0f });
+    buffer.CopyRect({ 0, 0, 8, 8 }, 16, 8);
+    const uint8_t* data = static_cast<const uint8_t*>(buffer.GetData());
+    REQUIRE(std::all_of(data, data + buffer.GetSize(),
+                        [](uint8_t a_byte) { return a_byte == 0x5A; }));
+    context.OnFrameStart();
+    context.OnFrameEnded();
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Block Compressed", "[buffer][compressed]")
+{
+    SECTION("Format::BC1_UNORM")
+    {
+        RequireBufferCompressed(Buffer::Format::BC1_UNORM);
+    }
+    SECTION("Format::BC3_UNORM")
+    {
+        RequireBufferCompressed(Buffer::Format::BC3_UNORM);
+    }
+    SECTION("Format::BC7_UNORM")
+    {
+        RequireBufferCompressed(Buffer::Format::BC7_UNORM);
+    }
+}
+
+//--------------------------------------------------------------
+inline void RequireBufferStorage(const Buffer& a_buffer,
+                                 const Buffer::Config& a_config)
+{
+    // Compact storage may fall back to native storage if it is
+    // not supported, and auto storage is resolved on creation.
+    const Buffer::Storage storage = a_buffer.GetStorage();
+    const uint32_t pixelCount = a_config.width * a_config.height;
+    const uint32_t nativeBytes = Buffer::BytesPerPixel(a_config.format);
+    const uint32_t storageBytes = Buffer::BytesPerStoragePixel(a_config.format, storage);
+    REQUIRE(storage != Buffer::Storage::AUTO);
+    REQUIRE(a_buffer.GetStorageSavings() == pixelCount * (nativeBytes - storageBytes));
+    if (a_config.format != Buffer::Format::RGBA_FLOAT ||
+        a_config.storage == Buffer::Storage::NATIVE)
+    {
+        REQUIRE(storage == Buffer::Storage::NATIVE);
+    }
+    else if (a_config.storage == Buffer::Storage::RGBA_HALF)
+    {
+        REQUIRE((storage == Buffer::Storage::RGBA_HALF ||
+                 storage == Buffer::Storage::NATIVE));
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Storage", "[buffer][storage]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.format = Buffer::Format::RGBA_FLOAT;
+
+    SECTION("Storage::NATIVE")
+    {
+        bufferConfig.storage = Buffer::Storage::NATIVE;
+    }
+    SECTION("Storage::RGBA_HALF")
+    {
+        bufferConfig.storage = Buffer::Storage::RGBA_HALF;
+    }
+    SECTION("Storage::R11G11B10_FLOAT")
+    {
+        bufferConfig.storage = Buffer::Storage::R11G11B10_FLOAT;
+    }
+    SECTION("Storage::AUTO")
+    {
+        bufferConfig.storage = Buffer::Storage::AUTO;
+    }
+    SECTION("Format::RGBA_UINT8")
+    {
+        bufferConfig.format = Buffer::Format::RGBA_UINT8;
+        bufferConfig.storage = Buffer::Storage::RGBA_HALF;
+    }
+
+    Context context({ bufferConfig, {} });
+    RequireBufferValues(context.GetBuffer(), bufferConfig);
+    RequireBufferStorage(context.GetBuffer(), bufferConfig);
+
+    bufferConfig.width = 800;
+    bufferConfig.height = 600;
+    context.GetBuffer().Resize(bufferConfig);
+    RequireBufferValues(context.GetBuffer(), bufferConfig);
+    RequireBufferStorage(context.GetBuffer(), bufferConfig);
+}
+
 #ifdef CUDA_SUPPORTED
 //--------------------------------------------------------------
 TEST_CASE("Test Buffer Interop CUDA", "[buffer][interop][cuda]")
@@ -206,6 +390,10 @@ TEST_CASE("Test Buffer Interop CUDA", "[buffer][interop][cuda]")
     buffer.Resize(bufferConfig);
     RequireBufferValues(buffer, bufferConfig);
 
+    bufferConfig.format = Buffer::Format::RGB10A2_UNORM;
+    buffer.Resize(bufferConfig);
+    RequireBufferValues(buffer, bufferConfig);
+
     bufferConfig.format = Buffer::Format::RGBA_FLOAT;
     bufferConfig.interop = Buffer::Interop::HOST;
     buffer.Resize(bufferConfig);
@@ -256,6 +444,18 @@ TEST_CASE("Test Buffer Min Size", "[buffer][size]")
     bufferConfig.format = Buffer::Format::RGBA_UINT16;
     REQUIRE(Buffer::MinSizeBytes(bufferConfig) == 648);
 
+    bufferConfig.format = Buffer::Format::RGB10A2_UNORM;
+    REQUIRE(Buffer::MinSizeBytes(bufferConfig) == 324);
+
+    bufferConfig.format = Buffer::Format::BC1_UNORM;
+    REQUIRE(Buffer::MinSizeBytes(bufferConfig) == 72);
+
+    bufferConfig.format = Buffer::Format::BC3_UNORM;
+    REQUIRE(Buffer::MinSizeBytes(bufferConfig) == 144);
+
+    bufferConfig.format = Buffer::Format::BC7_UNORM;
+    REQUIRE(Buffer::MinSizeBytes(bufferConfig) == 144);
+
     bufferConfig.height = 100;
 
     bufferConfig.format = Buffer::Format::RGBA_FLOAT;
@@ -266,6 +466,604 @@ TEST_CASE("Test Buffer Min Size", "[buffer][size]")
 
     bufferConfig.format = Buffer::Format::RGBA_UINT16;
     REQUIRE(Buffer::MinSizeBytes(bufferConfig) == 7200);
+
+    bufferConfig.format = Buffer::Format::RGB10A2_UNORM;
+    REQUIRE(Buffer::MinSizeBytes(bufferConfig) == 3600);
+
+    bufferConfig.format = Buffer::Format::BC1_UNORM;
+    REQUIRE(Buffer::MinSizeBytes(bufferConfig) == 600);
+
+    bufferConfig.format = Buffer::Format::BC3_UNORM;
+    REQUIRE(Buffer::MinSizeBytes(bufferConfig) == 1200);
+
+    bufferConfig.format = Buffer::Format::BC7_UNORM;
+    REQUIRE(Buffer::MinSizeBytes(bufferConfig) == 1200);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Giant Size", "[buffer][size]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 16384;
+    bufferConfig.height = 16384;
+    bufferConfig.format = Buffer::Format::RGBA_FLOAT;
+
+    // Sizes of 4GiB or more must not overflow.
+    static_assert(Buffer::MinSizeBytes({ 16384, 16384, Buffer::Format::RGBA_FLOAT }) ==
+                  4294967296ull, "");
+    REQUIRE(Buffer::MinPitchBytes(bufferConfig) == 262144);
+    REQUIRE(Buffer::MinSizeBytes(bufferConfig) == 4294967296ull);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 4294967296ull);
+
+    bufferConfig.width = 65536;
+    bufferConfig.height = 65536;
+    bufferConfig.pitchAlignment = 256;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 1048576);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 68719476736ull);
+
+    bufferConfig.width = 0xFFFFFFFF;
+    bufferConfig.height = 1;
+    bufferConfig.pitchAlignment = 1;
+    REQUIRE(Buffer::MinPitchBytes(bufferConfig) == 0xFFFFFFFFull * 16);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Viewport", "[buffer][viewport]")
+{
+    // Wider than the max texture size of most graphics devices,
+    // so the buffer is displayed using multiple textures if the
+    // graphics api splits large buffers.
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 40000;
+    bufferConfig.height = 64;
+    Context context({ bufferConfig, {} });
+    RequireBufferValues(context.GetBuffer(), bufferConfig);
+    REQUIRE(context.GetViewport().width == 0.0f);
+    REQUIRE(context.GetViewport().height == 0.0f);
+
+    Buffer::Viewport viewport;
+    SECTION("Entire")
+    {
+    }
+    SECTION("Inside")
+    {
+        viewport = { 100.0f, 8.0f, 640.0f, 32.0f };
+    }
+    SECTION("Across")
+    {
+        viewport = { 16000.0f, 0.0f, 1000.5f, 64.0f };
+    }
+    SECTION("Outside")
+    {
+        viewport = { -500.0f, -100.0f, 250.0f, 50.0f };
+    }
+    SECTION("Zoomed Out")
+    {
+        viewport = { -40000.0f, -64.0f, 120000.0f, 192.0f };
+    }
+
+    context.SetViewport(viewport);
+    REQUIRE(context.GetViewport().x == viewport.x);
+    REQUIRE(context.GetViewport().y == viewport.y);
+    REQUIRE(context.GetViewport().width == viewport.width);
+    REQUIRE(context.GetViewport().height == viewport.height);
+    REQUIRE(context.GetBuffer().GetViewport().width == viewport.width);
+
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    REQUIRE(context.GetBuffer().GetData());
+
+    // The viewport must be kept when the buffer is resized.
+    bufferConfig.width = 100;
+    context.GetBuffer().Resize(bufferConfig);
+    RequireBufferValues(context.GetBuffer(), bufferConfig);
+    REQUIRE(context.GetViewport().width == viewport.width);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Render On Demand", "[buffer][on_demand]")
+{
+    Context::Config contextConfig;
+    contextConfig.renderOnDemand = true;
+    Context context(contextConfig);
+    Buffer& buffer = context.GetBuffer();
+    Window* window = context.GetWindow();
+    REQUIRE(window);
+
+    // The buffer must be rendered the first frame.
+    REQUIRE(buffer.IsInvalidated());
+    REQUIRE(window->IsRedrawRequested());
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    REQUIRE(!buffer.IsInvalidated());
+    REQUIRE(!window->IsRedrawRequested());
+
+    SECTION("Invalidate")
+    {
+        buffer.Invalidate();
+    }
+    SECTION("Resize")
+    {
+        Buffer::Config bufferConfig;
+        bufferConfig.width = 100;
+        buffer.Resize(bufferConfig);
+    }
+    SECTION("Viewport")
+    {
+        context.SetViewport({ 0.0f, 0.0f, 100.0f, 100.0f });
+    }
+    SECTION("Redraw")
+    {
+        window->RequestRedraw();
+        REQUIRE(window->IsRedrawRequested());
+        REQUIRE(!buffer.IsInvalidated());
+    }
+
+    REQUIRE((buffer.IsInvalidated() || window->IsRedrawRequested()));
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    REQUIRE(!buffer.IsInvalidated());
+    REQUIRE(!window->IsRedrawRequested());
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Scroll", "[buffer][scroll]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 300;
+    bufferConfig.height = 200;
+    bufferConfig.pitchAlignment = 256;
+    bufferConfig.layout = Buffer::Layout::TILED_8X8;
+    SECTION("Rows")
+    {
+        bufferConfig.scroll = Buffer::Scroll::ROWS;
+    }
+    SECTION("Columns")
+    {
+        bufferConfig.scroll = Buffer::Scroll::COLUMNS;
+    }
+    Context context({ bufferConfig, {} });
+    Buffer& buffer = context.GetBuffer();
+    REQUIRE(buffer.GetScrollOffset() == 0);
+    if (buffer.GetScroll() == Buffer::Scroll::NONE)
+    {
+        // Scrolling is not supported by the graphics api.
+        REQUIRE(!buffer.AcquireScrollLine());
+        return;
+    }
+    REQUIRE(buffer.GetScroll() == bufferConfig.scroll);
+    REQUIRE(buffer.GetLayout() == Buffer::Layout::LINEAR);
+
+    const bool rows = (bufferConfig.scroll == Buffer::Scroll::ROWS);
+    const uint32_t lineCount = rows ? bufferConfig.height : bufferConfig.width;
+    const uint64_t lineStride = rows ? buffer.GetPitch() : 4;
+    context.OnFrameStart();
+    context.OnFrameEnded();
+
+    // Each line acquired replaces the oldest, wrapping at the end.
+    for (uint32_t i = 0; i < lineCount + 10; ++i)
+    {
+        uint8_t* line = static_cast<uint8_t*>(buffer.AcquireScrollLine());
+        REQUIRE(line);
+        REQUIRE(buffer.IsInvalidated());
+        REQUIRE(line == buffer.GetData<uint8_t>() + ((i % lineCount) * lineStride));
+        REQUIRE(buffer.GetScrollOffset() == (i + 1) % lineCount);
+        line[0] = static_cast<uint8_t>(i);
+
+        // Acquire multiple lines during some frames.
+        if (i % 3 != 0)
+        {
+            context.OnFrameStart();
+            context.OnFrameEnded();
+        }
+    }
+
+    // Resizing the buffer resets the ring.
+    buffer.Resize(bufferConfig);
+    REQUIRE(buffer.GetScrollOffset() == 0);
+    REQUIRE(buffer.AcquireScrollLine() == buffer.GetData());
+    context.OnFrameStart();
+    context.OnFrameEnded();
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Commit Rows", "[buffer][commit]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 320;
+    bufferConfig.height = 180;
+    SECTION("Complete")
+    {
+        bufferConfig.progressive = false;
+    }
+    SECTION("Progressive")
+    {
+        bufferConfig.progressive = true;
+    }
+    SECTION("Tiled")
+    {
+        bufferConfig.layout = Buffer::Layout::TILED_16X16;
+    }
+    Context context({ bufferConfig, {} });
+    Buffer& buffer = context.GetBuffer();
+    RequireBufferValues(buffer, bufferConfig);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+
+    // Produce each frame in bands, some of them spanning frames.
+    constexpr uint32_t bandHeight = 25;
+    for (uint32_t frame = 0; frame < 3; ++frame)
+    {
+        for (uint32_t row = 0; row < bufferConfig.height; row += bandHeight)
+        {
+            uint8_t* data = buffer.GetData<uint8_t>();
+            REQUIRE(data);
+            memset(data + (row * buffer.GetPitch()),
+                   static_cast<int>(frame * 64),
+                   std::min(bandHeight, bufferConfig.height - row) * buffer.GetPitch());
+            buffer.CommitRows(row, bandHeight);
+            REQUIRE(buffer.IsInvalidated());
+
+            if ((row / bandHeight) % 2)
+            {
+                context.OnFrameStart();
+                context.OnFrameEnded();
+                REQUIRE(!buffer.IsInvalidated());
+            }
+        }
+    }
+
+    // Once a frame is complete, the next frame is uploaded whole
+    // without committing any rows (including any operations).
+    uint8_t* data = buffer.GetData<uint8_t>();
+    REQUIRE(data);
+    memset(data, 255, buffer.GetSize());
+    buffer.Clear({ 0.0f, 0.0f, 1.0f, 1.0f });
+    buffer.Invalidate();
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    REQUIRE(!buffer.IsInvalidated());
+
+    // Operations on rows already committed are uploaded again.
+    buffer.CommitRows(0, bandHeight);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    buffer.FillRect({ 0, 0, 16, 16 }, { 1.0f, 0.0f, 0.0f, 1.0f });
+    REQUIRE(buffer.IsInvalidated());
+    buffer.CommitRows(bandHeight, bufferConfig.height - bandHeight);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    REQUIRE(!buffer.IsInvalidated());
+
+    // Rows outside the buffer are ignored.
+    buffer.CommitRows(bufferConfig.height, 1);
+    buffer.CommitRows(0, 0);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Operations", "[buffer][operations]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 320;
+    bufferConfig.height = 180;
+    SECTION("RGBA_UINT8")
+    {
+        bufferConfig.format = Buffer::Format::RGBA_UINT8;
+    }
+    SECTION("RGBA_FLOAT")
+    {
+        bufferConfig.format = Buffer::Format::RGBA_FLOAT;
+    }
+    SECTION("Tiled")
+    {
+        bufferConfig.layout = Buffer::Layout::TILED_16X16;
+    }
+    SECTION("Detect Changes")
+    {
+        bufferConfig.detectChanges = true;
+    }
+    Context context({ bufferConfig, {} });
+    Buffer& buffer = context.GetBuffer();
+    RequireBufferValues(buffer, bufferConfig);
+
+    // Pixel values are only read back from host buffers that detect
+    // changes, because they are stored in host memory that is always
+    // readable (other host data may be mapped by the graphics api for
+    // writing only, eg. pixel buffers on OpenGL).
+    const bool isReadable = bufferConfig.detectChanges &&
+                            buffer.GetInterop() == Buffer::Interop::HOST &&
+                            buffer.GetLayout() == Buffer::Layout::LINEAR;
+    const uint32_t bytesPerPixel = Buffer::BytesPerPixel(bufferConfig.format);
+    auto requirePixel = [&](uint32_t a_x, uint32_t a_y, float a_red)
+    {
+        if (!isReadable)
+        {
+            return;
+        }
+        const uint8_t* pixel = buffer.GetData<uint8_t>() +
+                               (a_y * buffer.GetPitch()) +
+                               (a_x * bytesPerPixel);
+        if (bufferConfig.format == Buffer::Format::RGBA_FLOAT)
+        {
+            float red = 0.0f;
+            memcpy(&red, pixel, sizeof(red));
+            REQUIRE(red == a_red);
+        }
+        else
+        {
+            REQUIRE(pixel[0] == static_cast<uint8_t>(a_red * 255.0f));
+        }
+    };
+
+    buffer.Clear({ 1.0f, 0.0f, 0.0f, 1.0f });
+    REQUIRE(buffer.IsInvalidated());
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    REQUIRE(!buffer.IsInvalidated());
+    requirePixel(0, 0, 1.0f);
+    requirePixel(bufferConfig.width - 1, bufferConfig.height - 1, 1.0f);
+
+    buffer.FillRect({ 16, 16, 32, 32 }, { 0.0f, 0.0f, 0.0f, 1.0f });
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    requirePixel(15, 15, 1.0f);
+    requirePixel(16, 16, 0.0f);
+    requirePixel(47, 47, 0.0f);
+    requirePixel(48, 48, 1.0f);
+
+    buffer.CopyRect({ 16, 16, 32, 32 }, 128, 64);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    requirePixel(16, 16, 0.0f);
+    requirePixel(128, 64, 0.0f);
+    requirePixel(159, 95, 0.0f);
+    requirePixel(160, 96, 1.0f);
+
+    // Overlapping regions are copied as if through a temporary.
+    buffer.CopyRect({ 128, 64, 48, 48 }, 144, 80);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    requirePixel(144, 80, 0.0f);
+    requirePixel(175, 111, 0.0f);
+    requirePixel(176, 112, 1.0f);
+    requirePixel(191, 127, 1.0f);
+
+    // Operations are ordered with pixels written through the data,
+    // which must be fetched again after each operation.
+    buffer.Clear({ 1.0f, 0.0f, 0.0f, 1.0f });
+    if (buffer.GetInterop() == Buffer::Interop::HOST &&
+        buffer.GetLayout() == Buffer::Layout::LINEAR)
+    {
+        memset(buffer.GetData<uint8_t>() + (8 * buffer.GetPitch()), 0, bytesPerPixel);
+    }
+    buffer.FillRect({ 16, 16, 1, 1 }, { 0.0f, 0.0f, 0.0f, 1.0f });
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    requirePixel(0, 8, 0.0f);
+    requirePixel(1, 8, 1.0f);
+    requirePixel(16, 16, 0.0f);
+
+    // Regions outside the buffer are clipped or ignored.
+    buffer.FillRect({ bufferConfig.width - 1, 0, 64, 64 }, {});
+    buffer.FillRect({ bufferConfig.width, 0, 1, 1 }, {});
+    buffer.CopyRect({ 0, 0, 64, 64 }, bufferConfig.width - 1, 0);
+    buffer.CopyRect({ 0, 0, 64, 64 }, 0, bufferConfig.height);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Flipbook", "[buffer][flipbook]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 320;
+    bufferConfig.height = 180;
+    bufferConfig.flipbookFrames = 8;
+    SECTION("Linear")
+    {
+        bufferConfig.layout = Buffer::Layout::LINEAR;
+    }
+    SECTION("Tiled")
+    {
+        bufferConfig.layout = Buffer::Layout::TILED_16X16;
+    }
+    Context context({ bufferConfig, {} });
+    Buffer& buffer = context.GetBuffer();
+    RequireBufferValues(buffer, bufferConfig);
+
+    // Graphics apis that cannot store frames have none.
+    const uint32_t frameCount = buffer.GetFlipbookFrameCount();
+    REQUIRE((frameCount == bufferConfig.flipbookFrames || frameCount == 0));
+    REQUIRE(buffer.GetFlipbookFrame() == UINT32_MAX);
+
+    // Store each frame, then play them back twice.
+    for (uint32_t frame = 0; frame < bufferConfig.flipbookFrames; ++frame)
+    {
+        const float value = static_cast<float>(frame) / bufferConfig.flipbookFrames;
+        buffer.Clear({ value, value, value, 1.0f });
+        REQUIRE(buffer.StoreFlipbookFrame(frame) == (frame < frameCount));
+        REQUIRE(buffer.GetData());
+    }
+    REQUIRE(!buffer.StoreFlipbookFrame(bufferConfig.flipbookFrames));
+    context.OnFrameStart();
+    context.OnFrameEnded();
+
+    for (uint32_t frame = 0; frame < bufferConfig.flipbookFrames * 2; ++frame)
+    {
+        const uint32_t index = frame % bufferConfig.flipbookFrames;
+        buffer.ShowFlipbookFrame(index);
+        REQUIRE(buffer.IsInvalidated());
+        REQUIRE(buffer.GetFlipbookFrame() == ((index < frameCount) ? index : UINT32_MAX));
+        context.OnFrameStart();
+        context.OnFrameEnded();
+    }
+
+    // Frames not in the flipbook display the buffer data again.
+    buffer.ShowFlipbookFrame(bufferConfig.flipbookFrames);
+    REQUIRE(buffer.GetFlipbookFrame() == UINT32_MAX);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+
+    // Resizing the buffer discards the frames.
+    buffer.ShowFlipbookFrame(0);
+    buffer.Resize(bufferConfig);
+    REQUIRE(buffer.GetFlipbookFrame() == UINT32_MAX);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Accumulate", "[buffer][accumulate]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 320;
+    bufferConfig.height = 180;
+    bufferConfig.format = Buffer::Format::RGBA_FLOAT;
+    bufferConfig.accumulate = true;
+    SECTION("Linear")
+    {
+        bufferConfig.layout = Buffer::Layout::LINEAR;
+    }
+    SECTION("Tiled")
+    {
+        bufferConfig.layout = Buffer::Layout::TILED_16X16;
+    }
+    SECTION("Scroll")
+    {
+        bufferConfig.scroll = Buffer::Scroll::ROWS;
+    }
+    Context context({ bufferConfig, {} });
+    Buffer& buffer = context.GetBuffer();
+    REQUIRE(buffer.GetAccumulatedSampleCount() == 0);
+
+    // Graphics apis that cannot accumulate samples (or buffers that
+    // scroll) display the buffer data as usual.
+    const bool accumulating = buffer.IsAccumulating();
+    if (bufferConfig.scroll != Buffer::Scroll::NONE)
+    {
+        REQUIRE(!accumulating);
+    }
+
+    // Nothing is accumulated until a batch of samples is added.
+    buffer.Clear({ 1.0f, 0.0f, 0.0f, 1.0f });
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    REQUIRE(buffer.GetAccumulatedSampleCount() == 0);
+
+    // Add batches of different sizes, some across multiple frames.
+    uint32_t sampleCount = 0;
+    for (uint32_t frame = 1; frame <= 10; ++frame)
+    {
+        buffer.Clear({ 0.1f * frame, 0.5f, 0.0f, 1.0f });
+        buffer.AccumulateSamples(frame);
+        REQUIRE(buffer.IsInvalidated());
+        sampleCount += frame;
+        context.OnFrameStart();
+        context.OnFrameEnded();
+        REQUIRE(buffer.GetAccumulatedSampleCount() == (accumulating ? sampleCount : 0));
+        if (frame % 3 == 0)
+        {
+            context.OnFrameStart();
+            context.OnFrameEnded();
+            REQUIRE(buffer.GetAccumulatedSampleCount() == (accumulating ? sampleCount : 0));
+        }
+    }
+
+    // Resetting discards the samples, including any batch not yet added.
+    buffer.AccumulateSamples(16);
+    buffer.ResetAccumulation();
+    REQUIRE(buffer.GetAccumulatedSampleCount() == 0);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    REQUIRE(buffer.GetAccumulatedSampleCount() == 0);
+    buffer.AccumulateSamples();
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    REQUIRE(buffer.GetAccumulatedSampleCount() == (accumulating ? 1 : 0));
+
+    // Resizing the buffer also discards the samples.
+    buffer.Resize(bufferConfig);
+    REQUIRE(buffer.GetAccumulatedSampleCount() == 0);
+    REQUIRE(buffer.IsAccumulating() == accumulating);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Flipbook Size", "[buffer][size]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 320;
+    bufferConfig.height = 180;
+    bufferConfig.flipbookFrames = 0;
+    REQUIRE(Buffer::FlipbookSizeBytes(bufferConfig) == 0);
+
+    bufferConfig.flipbookFrames = 4;
+    bufferConfig.format = Buffer::Format::RGBA_UINT8;
+    REQUIRE(Buffer::FlipbookSizeBytes(bufferConfig) == 320 * 180 * 4 * 4);
+
+    bufferConfig.format = Buffer::Format::RGBA_FLOAT;
+    bufferConfig.storage = Buffer::Storage::RGBA_HALF;
+    REQUIRE(Buffer::FlipbookSizeBytes(bufferConfig) == 320 * 180 * 8 * 4);
+
+    // Tiled layouts store the height padded to whole tiles.
+    bufferConfig.format = Buffer::Format::RGBA_UINT8;
+    bufferConfig.layout = Buffer::Layout::TILED_16X16;
+    REQUIRE(Buffer::FlipbookSizeBytes(bufferConfig) == 320 * 192 * 4 * 4);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Detect Changes", "[buffer][changes]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 256;
+    bufferConfig.height = 100;
+    bufferConfig.detectChanges = true;
+    Context context({ bufferConfig, {} });
+    RequireBufferValues(context.GetBuffer(), bufferConfig);
+
+    Buffer& buffer = context.GetBuffer();
+    REQUIRE(buffer.GetUploadCounters().tilesHashed == 0);
+    REQUIRE(buffer.GetUploadCounters().tilesUploaded == 0);
+
+    // Every tile must be uploaded the first frame.
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    if (buffer.GetUploadCounters().tilesHashed == 0)
+    {
+        // Change detection is not supported by the graphics api.
+        REQUIRE(buffer.GetUploadCounters().tilesUploaded == 0);
+        return;
+    }
+    REQUIRE(buffer.GetUploadCounters().tilesHashed == 8);
+    REQUIRE(buffer.GetUploadCounters().tilesUploaded == 8);
+
+    // No tiles are uploaded if nothing changed.
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    REQUIRE(buffer.GetUploadCounters().tilesHashed == 16);
+    REQUIRE(buffer.GetUploadCounters().tilesUploaded == 8);
+
+    // Only the tiles that changed are uploaded.
+    uint8_t* data = buffer.GetData<uint8_t>();
+    REQUIRE(data);
+    data[(70 * buffer.GetPitch()) + (130 * 4)] = 255;
+    data[(99 * buffer.GetPitch()) + (255 * 4) + 3] = 255;
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    REQUIRE(buffer.GetUploadCounters().tilesHashed == 24);
+    REQUIRE(buffer.GetUploadCounters().tilesUploaded == 10);
+    REQUIRE(buffer.GetData<uint8_t>() == data);
+
+    // The counters are reset when the buffer is resized.
+    bufferConfig.width = 64;
+    buffer.Resize(bufferConfig);
+    RequireBufferValues(buffer, bufferConfig);
+    REQUIRE(buffer.GetUploadCounters().tilesHashed == 0);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    REQUIRE(buffer.GetUploadCounters().tilesHashed == 2);
+    REQUIRE(buffer.GetUploadCounters().tilesUploaded == 2);
 }
 
 //--------------------------------------------------------------
@@ -284,6 +1082,18 @@ TEST_CASE("Test Buffer Min Pitch", "[buffer][pitch]")
     bufferConfig.format = Buffer::Format::RGBA_UINT16;
     REQUIRE(Buffer::MinPitchBytes(bufferConfig) == 72);
 
+    bufferConfig.format = Buffer::Format::RGB10A2_UNORM;
+    REQUIRE(Buffer::MinPitchBytes(bufferConfig) == 36);
+
+    bufferConfig.format = Buffer::Format::BC1_UNORM;
+    REQUIRE(Buffer::MinPitchBytes(bufferConfig) == 24);
+
+    bufferConfig.format = Buffer::Format::BC3_UNORM;
+    REQUIRE(Buffer::MinPitchBytes(bufferConfig) == 48);
+
+    bufferConfig.format = Buffer::Format::BC7_UNORM;
+    REQUIRE(Buffer::MinPitchBytes(bufferConfig) == 48);
+
     bufferConfig.height = 100;
 
     bufferConfig.format = Buffer::Format::RGBA_FLOAT;
@@ -294,6 +1104,190 @@ TEST_CASE("Test Buffer Min Pitch", "[buffer][pitch]")
 
     bufferConfig.format = Buffer::Format::RGBA_UINT16;
     REQUIRE(Buffer::MinPitchBytes(bufferConfig) == 72);
+
+    bufferConfig.format = Buffer::Format::RGB10A2_UNORM;
+    REQUIRE(Buffer::MinPitchBytes(bufferConfig) == 36);
+
+    bufferConfig.format = Buffer::Format::BC1_UNORM;
+    REQUIRE(Buffer::MinPitchBytes(bufferConfig) == 24);
+
+    bufferConfig.format = Buffer::Format::BC3_UNORM;
+    REQUIRE(Buffer::MinPitchBytes(bufferConfig) == 48);
+
+    bufferConfig.format = Buffer::Format::BC7_UNORM;
+    REQUIRE(Buffer::MinPitchBytes(bufferConfig) == 48);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Aligned Pitch", "[buffer][pitch]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 9;
+    bufferConfig.height = 9;
+    bufferConfig.format = Buffer::Format::RGBA_UINT8;
+
+    bufferConfig.pitchAlignment = 0;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 36);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 324);
+
+    bufferConfig.pitchAlignment = 1;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 36);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 324);
+
+    bufferConfig.pitchAlignment = 4;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 36);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 324);
+
+    bufferConfig.pitchAlignment = 64;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 64);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 576);
+
+    bufferConfig.pitchAlignment = 256;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 256);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 2304);
+
+    bufferConfig.format = Buffer::Format::RGBA_FLOAT;
+    bufferConfig.pitchAlignment = 64;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 192);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 1728);
+
+    bufferConfig.width = 16;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 256);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 2304);
+
+    bufferConfig.format = Buffer::Format::BC1_UNORM;
+    bufferConfig.pitchAlignment = 0;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 32);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 96);
+
+    bufferConfig.pitchAlignment = 256;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 256);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 768);
+
+    bufferConfig.layout = Buffer::Layout::TILED_16X16;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 256);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 768);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Pitch Alignment", "[buffer][alignment]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 1001;
+    bufferConfig.height = 601;
+
+    SECTION("Alignment 64")
+    {
+        bufferConfig.pitchAlignment = 64;
+    }
+    SECTION("Alignment 256")
+    {
+        bufferConfig.pitchAlignment = 256;
+    }
+    SECTION("Alignment 256 RGBA_FLOAT")
+    {
+        bufferConfig.format = Buffer::Format::RGBA_FLOAT;
+        bufferConfig.pitchAlignment = 256;
+    }
+
+    Context context({ bufferConfig, {} });
+    RequireBufferValues(context.GetBuffer(), bufferConfig);
+
+    bufferConfig.pitchAlignment = 1;
+    context.GetBuffer().Resize(bufferConfig);
+    RequireBufferValues(context.GetBuffer(), bufferConfig);
+
+    // Alignments that are not a power of two are rounded up.
+    bufferConfig.pitchAlignment = 48;
+    context.GetBuffer().Resize(bufferConfig);
+    bufferConfig.pitchAlignment = 64;
+    RequireBufferValues(context.GetBuffer(), bufferConfig);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Tiled Pitch", "[buffer][pitch]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 9;
+    bufferConfig.height = 9;
+    bufferConfig.format = Buffer::Format::RGBA_UINT8;
+
+    bufferConfig.layout = Buffer::Layout::TILED_8X8;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 64);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 1024);
+
+    bufferConfig.layout = Buffer::Layout::TILED_16X16;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 64);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 1024);
+
+    bufferConfig.layout = Buffer::Layout::MORTON_16X16;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 64);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 1024);
+
+    bufferConfig.pitchAlignment = 256;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 256);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 4096);
+
+    bufferConfig.width = 24;
+    bufferConfig.height = 8;
+    bufferConfig.pitchAlignment = 1;
+    bufferConfig.layout = Buffer::Layout::TILED_8X8;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 96);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 768);
+
+    // The pitch must remain a multiple of a row of tile pixels.
+    bufferConfig.pitchAlignment = 16;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 96);
+    bufferConfig.pitchAlignment = 64;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 128);
+
+    bufferConfig.format = Buffer::Format::RGBA_FLOAT;
+    bufferConfig.pitchAlignment = 1;
+    REQUIRE(Buffer::AlignedPitchBytes(bufferConfig) == 384);
+    REQUIRE(Buffer::AlignedSizeBytes(bufferConfig) == 3072);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Layout", "[buffer][layout]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 1001;
+    bufferConfig.height = 601;
+
+    SECTION("Layout::LINEAR")
+    {
+        bufferConfig.layout = Buffer::Layout::LINEAR;
+    }
+    SECTION("Layout::TILED_8X8")
+    {
+        bufferConfig.layout = Buffer::Layout::TILED_8X8;
+    }
+    SECTION("Layout::TILED_16X16")
+    {
+        bufferConfig.layout = Buffer::Layout::TILED_16X16;
+    }
+    SECTION("Layout::MORTON_16X16")
+    {
+        bufferConfig.format = Buffer::Format::RGBA_FLOAT;
+        bufferConfig.layout = Buffer::Layout::MORTON_16X16;
+    }
+
+    Context context({ bufferConfig, {} });
+    RequireBufferValues(context.GetBuffer(), bufferConfig);
+
+    bufferConfig.layout = Buffer::Layout::LINEAR;
+    context.GetBuffer().Resize(bufferConfig);
+    RequireBufferValues(context.GetBuffer(), bufferConfig);
+    REQUIRE(context.GetBuffer().GetLayout() == Buffer::Layout::LINEAR);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Tile Size", "[buffer][tile]")
+{
+    REQUIRE(Buffer::TileSize(Buffer::Layout::LINEAR) == 1);
+    REQUIRE(Buffer::TileSize(Buffer::Layout::TILED_8X8) == 8);
+    REQUIRE(Buffer::TileSize(Buffer::Layout::TILED_16X16) == 16);
+    REQUIRE(Buffer::TileSize(Buffer::Layout::MORTON_16X16) == 16);
 }
 
 //--------------------------------------------------------------
@@ -302,6 +1296,46 @@ TEST_CASE("Test Buffer Bytes Per Pixel", "[buffer][bytes]")
     REQUIRE(Buffer::BytesPerPixel(Buffer::Format::RGBA_FLOAT) == 16);
     REQUIRE(Buffer::BytesPerPixel(Buffer::Format::RGBA_UINT8) == 4);
     REQUIRE(Buffer::BytesPerPixel(Buffer::Format::RGBA_UINT16) == 8);
+    REQUIRE(Buffer::BytesPerPixel(Buffer::Format::RGB10A2_UNORM) == 4);
+    REQUIRE(Buffer::BytesPerPixel(Buffer::Format::BC1_UNORM) == 0);
+    REQUIRE(Buffer::BytesPerPixel(Buffer::Format::BC3_UNORM) == 0);
+    REQUIRE(Buffer::BytesPerPixel(Buffer::Format::BC7_UNORM) == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Bytes Per Block", "[buffer][bytes]")
+{
+    REQUIRE(Buffer::BytesPerBlock(Buffer::Format::RGBA_FLOAT) == 16);
+    REQUIRE(Buffer::BytesPerBlock(Buffer::Format::RGBA_UINT8) == 4);
+    REQUIRE(Buffer::BytesPerBlock(Buffer::Format::RGBA_UINT16) == 8);
+    REQUIRE(Buffer::BytesPerBlock(Buffer::Format::RGB10A2_UNORM) == 4);
+    REQUIRE(Buffer::BytesPerBlock(Buffer::Format::BC1_UNORM) == 8);
+    REQUIRE(Buffer::BytesPerBlock(Buffer::Format::BC3_UNORM) == 16);
+    REQUIRE(Buffer::BytesPerBlock(Buffer::Format::BC7_UNORM) == 16);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Block Size", "[buffer][bytes]")
+{
+    REQUIRE(Buffer::BlockSize(Buffer::Format::RGBA_FLOAT) == 1);
+    REQUIRE(Buffer::BlockSize(Buffer::Format::RGBA_UINT8) == 1);
+    REQUIRE(Buffer::BlockSize(Buffer::Format::RGBA_UINT16) == 1);
+    REQUIRE(Buffer::BlockSize(Buffer::Format::RGB10A2_UNORM) == 1);
+    REQUIRE(Buffer::BlockSize(Buffer::Format::BC1_UNORM) == 4);
+    REQUIRE(Buffer::BlockSize(Buffer::Format::BC3_UNORM) == 4);
+    REQUIRE(Buffer::BlockSize(Buffer::Format::BC7_UNORM) == 4);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Bytes Per Storage Pixel", "[buffer][bytes]")
+{
+    REQUIRE(Buffer::BytesPerStoragePixel(Buffer::Format::RGBA_FLOAT, Buffer::Storage::NATIVE) == 16);
+    REQUIRE(Buffer::BytesPerStoragePixel(Buffer::Format::RGBA_FLOAT, Buffer::Storage::RGBA_HALF) == 8);
+    REQUIRE(Buffer::BytesPerStoragePixel(Buffer::Format::RGBA_FLOAT, Buffer::Storage::R11G11B10_FLOAT) == 4);
+    REQUIRE(Buffer::BytesPerStoragePixel(Buffer::Format::RGBA_FLOAT, Buffer::Storage::AUTO) == 16);
+    REQUIRE(Buffer::BytesPerStoragePixel(Buffer::Format::RGBA_UINT8, Buffer::Storage::RGBA_HALF) == 4);
+    REQUIRE(Buffer::BytesPerStoragePixel(Buffer::Format::RGBA_UINT16, Buffer::Storage::R11G11B10_FLOAT) == 8);
+    REQUIRE(Buffer::BytesPerStoragePixel(Buffer::Format::RGB10A2_UNORM, Buffer::Storage::RGBA_HALF) == 4);
 }
 
 //--------------------------------------------------------------
@@ -310,6 +1344,7 @@ TEST_CASE("Test Buffer Bytes Per Channel", "[buffer][bytes]")
     REQUIRE(Buffer::BytesPerChannel(Buffer::Format::RGBA_FLOAT) == 4);
     REQUIRE(Buffer::BytesPerChannel(Buffer::Format::RGBA_UINT8) == 1);
     REQUIRE(Buffer::BytesPerChannel(Buffer::Format::RGBA_UINT16) == 2);
+    REQUIRE(Buffer::BytesPerChannel(Buffer::Format::RGB10A2_UNORM) == 0);
 }
 
 //--------------------------------------------------------------
@@ -318,4 +1353,28 @@ TEST_CASE("Test Buffer Channels Per Pixel", "[buffer][channels]")
     REQUIRE(Buffer::ChannelsPerPixel(Buffer::Format::RGBA_FLOAT) == 4);
     REQUIRE(Buffer::ChannelsPerPixel(Buffer::Format::RGBA_UINT8) == 4);
     REQUIRE(Buffer::ChannelsPerPixel(Buffer::Format::RGBA_UINT16) == 4);
+    REQUIRE(Buffer::ChannelsPerPixel(Buffer::Format::RGB10A2_UNORM) == 4);
+    REQUIRE(Buffer::ChannelsPerPixel(Buffer::Format::BC1_UNORM) == 4);
+    REQUIRE(Buffer::ChannelsPerPixel(Buffer::Format::BC3_UNORM) == 4);
+    REQUIRE(Buffer::ChannelsPerPixel(Buffer::Format::BC7_UNORM) == 4);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Buffer Pack RGB10A2", "[buffer][pack]")
+{
+    static_assert(Buffer::PackRGB10A2(0.0f, 0.0f, 0.0f, 0.0f) == 0, "");
+    static_assert(Buffer::PackRGB10A2(1.0f, 1.0f, 1.0f, 1.0f) == UINT32_MAX, "");
+
+    REQUIRE(Buffer::PackRGB10A2(1.0f, 0.0f, 0.0f, 0.0f) == 0x000003FF);
+    REQUIRE(Buffer::PackRGB10A2(0.0f, 1.0f, 0.0f, 0.0f) == 0x000FFC00);
+    REQUIRE(Buffer::PackRGB10A2(0.0f, 0.0f, 1.0f, 0.0f) == 0x3FF00000);
+    REQUIRE(Buffer::PackRGB10A2(0.0f, 0.0f, 0.0f, 1.0f) == 0xC0000000);
+    REQUIRE(Buffer::PackRGB10A2(-1.0f, 2.0f, -1.0f, 2.0f) == 0xC00FFC00);
+
+    const uint32_t packed = Buffer::PackRGB10A2(0.25f, 0.5f, 0.75f, 1.0f / 3.0f);
+    REQUIRE(Buffer::UnpackRGB10A2(packed, 0) == Approx(0.25f).margin(0.5f / 1023.0f));
+    REQUIRE(Buffer::UnpackRGB10A2(packed, 1) == Approx(0.5f).margin(0.5f / 1023.0f));
+    REQUIRE(Buffer::UnpackRGB10A2(packed, 2) == Approx(0.75f).margin(0.5f / 1023.0f));
+    REQUIRE(Buffer::UnpackRGB10A2(packed, 3) == Approx(1.0f / 3.0f));
+    REQUIRE(Buffer::UnpackRGB10A2(packed, 4) == 0.0f);
 }
@@ -8,6 +8,7 @@
 
 #include <simple/application/application.h>
 #include <simple/display/context.h>
+#include <simple/display/context_group.h>
 #include <catch2/catch.hpp>
 #include <inttypes.h>
 
@@ -73,6 +74,7 @@ void SetWindowTitle(Context::Config& a_contextConfig)
         case Buffer::Format::RGBA_FLOAT: format = "Format::RGBA_FLOAT"; break;
         case Buffer::Format::RGBA_UINT8: format = "Format::RGBA_UINT8"; break;
         case Buffer::Format::RGBA_UINT16: format = "Format::RGBA_UINT16"; break;
+        case Buffer::Format::RGB10A2_UNORM: format = "Format::RGB10A2_UNORM"; break;
         default: format = "Format::NONE"; break;
     }
 
@@ -190,6 +192,15 @@ void TestApplication::UpdatePixelBuffer()
             CycleColors<uint16_t, 4, 4>(COLORS);
         }
         break;
+        case Buffer::Format::RGB10A2_UNORM:
+        {
+            constexpr uint32_t COLORS[4][1] = { { Buffer::PackRGB10A2(1.0f, 0.0f, 0.0f, 1.0f) },
+                                                { Buffer::PackRGB10A2(0.0f, 1.0f, 0.0f, 1.0f) },
+                                                { Buffer::PackRGB10A2(0.0f, 0.0f, 1.0f, 1.0f) },
+                                                { Buffer::PackRGB10A2(0.0f, 0.0f, 0.0f, 1.0f) } };
+            CycleColors<uint32_t, 1, 4>(COLORS);
+        }
+        break;
         default:
         {
         }
@@ -222,7 +233,8 @@ void CycleColorsHost(const DataType a_colors[NumColors][ChannelsPerPixel],
 
     const uint32_t pixelWidth = a_buffer.GetWidth();
     const uint32_t pixelHeight = a_buffer.GetHeight();
-    assert(ChannelsPerPixel == Buffer::ChannelsPerPixel(a_buffer.GetFormat()));
+    const uint32_t rowLength = a_buffer.GetPitch() / sizeof(DataType);
+    assert(ChannelsPerPixel * sizeof(DataType) == Buffer::BytesPerPixel(a_buffer.GetFormat()));
     for (uint32_t y = 0; y < pixelHeight; ++y)
     {
         for (uint32_t x = 0; x < pixelWidth; ++x)
@@ -236,7 +248,7 @@ void CycleColorsHost(const DataType a_colors[NumColors][ChannelsPerPixel],
                 case 2: color = colorTopLeft; break;
                 case 3: color = colorTopRight; break;
             }
-            const uint32_t i = (x * ChannelsPerPixel) + (y * pixelWidth * ChannelsPerPixel);
+            const uint32_t i = (x * ChannelsPerPixel) + (y * rowLength);
             for (uint32_t z = 0; z < ChannelsPerPixel; ++z)
             {
                 pixelBuffer[i + z] = color[z];
@@ -339,6 +351,16 @@ void TestContext(TestParams a_testParams)
     {
         bufferConfig.format = Buffer::Format::RGBA_UINT16;
     }
+    SECTION("Format::RGB10A2_UNORM")
+    {
+        bufferConfig.format = Buffer::Format::RGB10A2_UNORM;
+    }
+    SECTION("Config::pitchAlignment")
+    {
+        bufferConfig.width = 1001;
+        bufferConfig.height = 601;
+        bufferConfig.pitchAlignment = 256;
+    }
 
     TestApplication testApplication(a_testParams);
     testApplication.Run();
@@ -404,6 +426,643 @@ TEST_CASE("Test Context Vulkan CUDA", "[context][vulkan][cuda]")
     TestContext(testParams);
 }
 
+//--------------------------------------------------------------
+TEST_CASE("Test Context Present Mode", "[context][present_mode]")
+{
+    Context::Config contextConfig;
+    SECTION("GraphicsAPI::NATIVE")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::NATIVE;
+    }
+    SECTION("GraphicsAPI::OPENGL")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::OPENGL;
+    }
+    SECTION("GraphicsAPI::VULKAN")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::VULKAN;
+    }
+
+    using PresentMode = Context::PresentMode;
+    REQUIRE(contextConfig.presentMode == PresentMode::FIFO);
+    const PresentMode presentModes[] = { PresentMode::FIFO,
+                                         PresentMode::FIFO_RELAXED,
+                                         PresentMode::MAILBOX,
+                                         PresentMode::IMMEDIATE };
+    for (PresentMode requestedMode : presentModes)
+    {
+        contextConfig.presentMode = requestedMode;
+        Context context(contextConfig);
+        if (!context.GetBuffer().GetData())
+        {
+            // The graphics API is not supported.
+            REQUIRE(context.GetPresentMode() == PresentMode::NONE);
+            continue;
+        }
+
+        // Unsupported modes fall back to FIFO, except immediate
+        // which falls back to mailbox first if it is supported.
+        const PresentMode presentMode = context.GetPresentMode();
+        switch (requestedMode)
+        {
+            case PresentMode::IMMEDIATE:
+            {
+                REQUIRE((presentMode == PresentMode::IMMEDIATE ||
+                         presentMode == PresentMode::MAILBOX ||
+                         presentMode == PresentMode::FIFO));
+            }
+            break;
+            case PresentMode::FIFO:
+            {
+                REQUIRE(presentMode == PresentMode::FIFO);
+            }
+            break;
+            default:
+            {
+                REQUIRE((presentMode == requestedMode ||
+                         presentMode == PresentMode::FIFO));
+            }
+            break;
+        }
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Present Mode Invalid", "[context][present_mode][invalid]")
+{
+    Context::Config contextConfig;
+    contextConfig.graphicsAPI = Context::GraphicsAPI::NONE;
+    contextConfig.presentMode = Context::PresentMode::IMMEDIATE;
+    Context context(contextConfig);
+    REQUIRE(context.GetPresentMode() == Context::PresentMode::NONE);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Latency", "[context][latency]")
+{
+    // Frame latency is measured by the OpenGL and Vulkan contexts.
+    Context::Config contextConfig;
+    SECTION("GraphicsAPI::OPENGL")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::OPENGL;
+    }
+    SECTION("GraphicsAPI::VULKAN")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::VULKAN;
+    }
+
+    // Latency critical, default, and throughput bound settings.
+    const uint32_t settings[][2] = { { 1, 2 },
+                                     { DEFAULT_FRAMES_IN_FLIGHT,
+                                       DEFAULT_SWAP_CHAIN_IMAGE_COUNT },
+                                     { 3, 3 } };
+    for (const uint32_t* setting : settings)
+    {
+        contextConfig.framesInFlight = setting[0];
+        contextConfig.swapChainImageCount = setting[1];
+        Context context(contextConfig);
+        if (!context.GetBuffer().GetData())
+        {
+            // The graphics API is not supported.
+            continue;
+        }
+
+        constexpr uint32_t frameCount = 120;
+        for (uint32_t frame = 0; frame < frameCount; ++frame)
+        {
+            context.OnFrameStart();
+            context.GetBuffer().Invalidate();
+            context.OnFrameEnded();
+        }
+
+        // Some frames may still be in flight when the loop ends.
+        const Context::LatencyCounters counters = context.GetLatencyCounters();
+        REQUIRE(counters.framesMeasured > 0);
+        REQUIRE(counters.framesMeasured <= frameCount);
+        REQUIRE(counters.maxMicroseconds <= counters.totalMicroseconds);
+        printf("Frames In Flight: %u, Swap Chain Images: %u\n"
+               "    Avg Latency: %" PRIu64 "us\n"
+               "    Max Latency: %" PRIu64 "us\n\n",
+               setting[0],
+               setting[1],
+               counters.totalMicroseconds / counters.framesMeasured,
+               counters.maxMicroseconds);
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Try Present", "[context][try_present]")
+{
+    Context::Config contextConfig;
+    contextConfig.framesInFlight = 1;
+    SECTION("GraphicsAPI::NATIVE")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::NATIVE;
+    }
+    SECTION("GraphicsAPI::OPENGL")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::OPENGL;
+    }
+    SECTION("GraphicsAPI::VULKAN")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::VULKAN;
+    }
+
+    Context context(contextConfig);
+    if (!context.GetBuffer().GetData())
+    {
+        // The graphics API is not supported.
+        REQUIRE(!context.IsFrameSlotAvailable());
+        REQUIRE(!context.TryPresent());
+        return;
+    }
+
+    // Frames are either presented or dropped, never blocking.
+    constexpr uint64_t frameCount = 120;
+    uint64_t framesPresented = 0;
+    for (uint64_t frame = 0; frame < frameCount; ++frame)
+    {
+        context.OnFrameStart();
+        context.GetBuffer().Invalidate();
+        framesPresented += context.TryPresent() ? 1 : 0;
+    }
+
+    Context::FrameCounters counters = context.GetFrameCounters();
+    REQUIRE(counters.framesPresented == framesPresented);
+    REQUIRE(counters.framesDropped == frameCount - framesPresented);
+
+    // Frames presented by OnFrameEnded are never dropped.
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    counters = context.GetFrameCounters();
+    REQUIRE(counters.framesPresented == framesPresented + 1);
+    REQUIRE(counters.framesDropped == frameCount - framesPresented);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Try Present Invalid", "[context][try_present][invalid]")
+{
+    Context::Config contextConfig;
+    contextConfig.graphicsAPI = Context::GraphicsAPI::NONE;
+    Context context(contextConfig);
+    REQUIRE(!context.IsFrameSlotAvailable());
+    REQUIRE(!context.TryPresent());
+
+    const Context::FrameCounters counters = context.GetFrameCounters();
+    REQUIRE(counters.framesPresented == 0);
+    REQUIRE(counters.framesDropped == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Async Present", "[context][async_present]")
+{
+    Context::Config contextConfig;
+    contextConfig.asyncPresent = true;
+    contextConfig.presentMode = Context::PresentMode::FIFO;
+    SECTION("GraphicsAPI::NATIVE")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::NATIVE;
+    }
+    SECTION("GraphicsAPI::OPENGL")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::OPENGL;
+    }
+    SECTION("GraphicsAPI::VULKAN")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::VULKAN;
+    }
+
+    Context context(contextConfig);
+    Buffer& buffer = context.GetBuffer();
+    if (!buffer.GetData())
+    {
+        // The graphics API is not supported.
+        return;
+    }
+    REQUIRE(context.GetWindow());
+    REQUIRE(context.IsFrameSlotAvailable());
+
+    // Frames are handed over faster than the display refresh rate,
+    // so the render thread presents the latest and drops the rest.
+    constexpr uint64_t frameCount = 240;
+    for (uint64_t frame = 0; frame < frameCount; ++frame)
+    {
+        if (frame == frameCount / 2)
+        {
+            Buffer::Config bufferConfig = contextConfig.bufferConfig;
+            bufferConfig.width /= 2;
+            bufferConfig.height /= 2;
+            buffer.Resize(bufferConfig);
+            REQUIRE(buffer.GetWidth() == bufferConfig.width);
+            REQUIRE(buffer.GetHeight() == bufferConfig.height);
+        }
+
+        Buffer::Color color;
+        color.red = (frame & 1) ? 1.0f : 0.0f;
+        context.OnFrameStart();
+        buffer.Clear(color);
+
+        // The buffer data is handed over by swapping its memory, so it
+        // is then stored in different memory, but it is preserved.
+        const void* data = buffer.GetData();
+        context.OnFrameEnded();
+        REQUIRE(buffer.GetData() != data);
+        REQUIRE(buffer.GetData<uint8_t>()[0] == ((frame & 1) ? 255 : 0));
+    }
+
+    const Context::FrameCounters counters = context.GetFrameCounters();
+    REQUIRE(counters.framesPresented > 0);
+    REQUIRE(counters.framesPresented + counters.framesDropped == frameCount);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Frame Limiter", "[context][frame_limiter]")
+{
+    Context::Config contextConfig;
+    contextConfig.presentMode = Context::PresentMode::IMMEDIATE;
+    contextConfig.targetFrameRate = 100.0f;
+    SECTION("GraphicsAPI::NATIVE")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::NATIVE;
+    }
+    SECTION("GraphicsAPI::OPENGL")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::OPENGL;
+    }
+    SECTION("GraphicsAPI::VULKAN")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::VULKAN;
+    }
+
+    Context context(contextConfig);
+    if (!context.GetBuffer().GetData())
+    {
+        // The graphics API is not supported.
+        return;
+    }
+
+    // Every frame after the first is paced, so the frames can not
+    // be started any sooner than one period after the previous one.
+    using Clock = chrono::steady_clock;
+    constexpr uint64_t frameCount = 50;
+    const Clock::time_point startTime = Clock::now();
+    for (uint64_t frame = 0; frame < frameCount; ++frame)
+    {
+        context.OnFrameStart();
+        context.OnFrameEnded();
+    }
+    const Clock::duration elapsed = Clock::now() - startTime;
+    REQUIRE(elapsed >= chrono::milliseconds(10 * (frameCount - 1)));
+
+    const Context::PacingCounters counters = context.GetPacingCounters();
+    REQUIRE(counters.framesPaced == frameCount - 1);
+    REQUIRE(counters.maxErrorMicroseconds >= counters.lastErrorMicroseconds);
+    REQUIRE(counters.totalErrorMicroseconds >= counters.maxErrorMicroseconds);
+    printf("Average Pacing Error: %.1f us\n"
+           "Max Pacing Error: %" PRIu64 " us\n\n",
+           static_cast<double>(counters.totalErrorMicroseconds) / counters.framesPaced,
+           counters.maxErrorMicroseconds);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Frame Limiter Invalid", "[context][frame_limiter][invalid]")
+{
+    Context::Config contextConfig;
+    contextConfig.graphicsAPI = Context::GraphicsAPI::NONE;
+    contextConfig.targetFrameRate = 100.0f;
+    Context context(contextConfig);
+    context.OnFrameStart();
+    context.OnFrameStart();
+
+    const Context::PacingCounters counters = context.GetPacingCounters();
+    REQUIRE(counters.framesPaced == 0);
+    REQUIRE(counters.totalErrorMicroseconds == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Low Latency", "[context][low_latency]")
+{
+    Context::Config contextConfig;
+    contextConfig.lowLatency = true;
+    SECTION("GraphicsAPI::OPENGL")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::OPENGL;
+    }
+    SECTION("GraphicsAPI::VULKAN")
+    {
+        contextConfig.graphicsAPI = Context::GraphicsAPI::VULKAN;
+    }
+
+    Context context(contextConfig);
+    if (!context.GetBuffer().GetData())
+    {
+        // The graphics API is not supported.
+        return;
+    }
+
+    // Every frame presented is waited for and measured, and every
+    // frame after the first is started just in time for a refresh.
+    constexpr uint64_t frameCount = 60;
+    for (uint64_t frame = 0; frame < frameCount; ++frame)
+    {
+        context.OnFrameStart();
+        context.OnFrameEnded();
+    }
+
+    const Context::LatencyCounters counters = context.GetPresentLatencyCounters();
+    REQUIRE(counters.framesMeasured > 0);
+    REQUIRE(counters.framesMeasured <= frameCount);
+    REQUIRE(counters.maxMicroseconds * counters.framesMeasured >= counters.totalMicroseconds);
+    REQUIRE(context.GetPacingCounters().framesPaced > 0);
+    printf("Average Present Latency: %.1f us\n"
+           "Max Present Latency: %" PRIu64 " us\n\n",
+           static_cast<double>(counters.totalMicroseconds) / counters.framesMeasured,
+           counters.maxMicroseconds);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Low Latency Invalid", "[context][low_latency][invalid]")
+{
+    Context::Config contextConfig;
+    contextConfig.graphicsAPI = Context::GraphicsAPI::NONE;
+    contextConfig.lowLatency = true;
+    Context context(contextConfig);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+
+    const Context::LatencyCounters counters = context.GetPresentLatencyCounters();
+    REQUIRE(counters.framesMeasured == 0);
+    REQUIRE(counters.totalMicroseconds == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Present Timing", "[context][present_timing]")
+{
+    Context::Config contextConfig;
+    contextConfig.graphicsAPI = Context::GraphicsAPI::OPENGL;
+    contextConfig.presentMode = Context::PresentMode::FIFO;
+    Context context(contextConfig);
+    if (!context.GetBuffer().GetData())
+    {
+        // The graphics API is not supported.
+        return;
+    }
+
+    constexpr uint64_t frameCount = 60;
+    for (uint64_t frame = 0; frame < frameCount; ++frame)
+    {
+        context.OnFrameStart();
+        context.OnFrameEnded();
+    }
+    context.OnFrameStart();
+
+    // Frames reach the display in order, at increasing times, and
+    // the next frame is predicted to reach it after the last one.
+    const Context::PresentTiming timing = context.GetPresentTiming();
+    REQUIRE(timing.framesPresented <= frameCount);
+    if (timing.framesPresented == 0)
+    {
+        // The graphics API does not expose present timing.
+        REQUIRE(timing.presentMicroseconds == 0);
+        REQUIRE(timing.nextPresentMicroseconds == 0);
+        return;
+    }
+    REQUIRE(timing.presentMicroseconds > 0);
+    REQUIRE(timing.refreshPeriodNanoseconds > 0);
+    REQUIRE(timing.nextPresentMicroseconds > timing.presentMicroseconds);
+    printf("Frames Displayed: %" PRIu64 "\n"
+           "Refresh Period: %" PRIu64 " ns\n"
+           "Missed Refreshes: %" PRIu64 "\n\n",
+           timing.framesPresented,
+           timing.refreshPeriodNanoseconds,
+           timing.missedRefreshes);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Present Timing Invalid", "[context][present_timing][invalid]")
+{
+    Context::Config contextConfig;
+    contextConfig.graphicsAPI = Context::GraphicsAPI::NONE;
+    Context context(contextConfig);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+
+    const Context::PresentTiming timing = context.GetPresentTiming();
+    REQUIRE(timing.framesPresented == 0);
+    REQUIRE(timing.presentMicroseconds == 0);
+    REQUIRE(timing.nextPresentMicroseconds == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Queue Frame", "[context][queue_frame]")
+{
+    Context::Config contextConfig;
+    contextConfig.graphicsAPI = Context::GraphicsAPI::NATIVE;
+    contextConfig.bufferConfig.interop = Buffer::Interop::HOST;
+    contextConfig.frameQueueSize = 4;
+    contextConfig.lateFramePolicy = Context::LateFramePolicy::DROP;
+    Context context(contextConfig);
+    if (!context.GetBuffer().GetData())
+    {
+        // The graphics API is not supported.
+        return;
+    }
+
+    // Queue two frames that are already late (so the first of them
+    // is dropped) and two that are due later, until the queue is full.
+    const uint64_t now = Context::GetTimeMicroseconds();
+    REQUIRE(now > 0);
+    REQUIRE(context.QueueFrame(now - 2000));
+    REQUIRE(context.QueueFrame(now + 200000));
+    REQUIRE(context.QueueFrame(now - 1000));
+    REQUIRE(context.QueueFrame(now + 100000));
+    REQUIRE(!context.QueueFrame(now + 300000));
+    REQUIRE(context.GetQueuedFrameCount() == 4);
+
+    // Present the frames as they are due, without any other timing.
+    for (uint32_t frame = 0; frame < 1000 && context.GetQueuedFrameCount(); ++frame)
+    {
+        context.OnFrameStart();
+        context.OnFrameEnded();
+    }
+    REQUIRE(context.GetQueuedFrameCount() == 0);
+    REQUIRE(Context::GetTimeMicroseconds() >= now + 200000 - 50000);
+
+    const Context::FrameCounters counters = context.GetFrameCounters();
+    REQUIRE(counters.framesPresented == 3);
+    REQUIRE(counters.framesDropped == 1);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Queue Frame Try Present", "[context][queue_frame][try_present]")
+{
+    Context::Config contextConfig;
+    contextConfig.graphicsAPI = Context::GraphicsAPI::NATIVE;
+    contextConfig.bufferConfig.interop = Buffer::Interop::HOST;
+    Context context(contextConfig);
+    if (!context.GetBuffer().GetData())
+    {
+        // The graphics API is not supported.
+        return;
+    }
+
+    // Queue a frame that is due and one that is not due for a while.
+    const uint64_t now = Context::GetTimeMicroseconds();
+    REQUIRE(context.QueueFrame(now - 1000));
+    REQUIRE(context.QueueFrame(now + 10000000));
+
+    // The frame that is due is presented, then nothing is presented
+    // (without waiting) until the next frame is due, which remains
+    // queued instead of being dropped.
+    context.OnFrameStart();
+    REQUIRE(context.TryPresent());
+    REQUIRE(context.GetQueuedFrameCount() == 1);
+    context.OnFrameStart();
+    REQUIRE(!context.TryPresent());
+    REQUIRE(context.GetQueuedFrameCount() == 1);
+    REQUIRE(Context::GetTimeMicroseconds() < now + 10000000);
+
+    const Context::FrameCounters counters = context.GetFrameCounters();
+    REQUIRE(counters.framesPresented == 1);
+    REQUIRE(counters.framesDropped == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Queue Frame Invalid", "[context][queue_frame][invalid]")
+{
+    Context::Config contextConfig;
+    contextConfig.graphicsAPI = Context::GraphicsAPI::NONE;
+    Context context(contextConfig);
+    REQUIRE(!context.QueueFrame(Context::GetTimeMicroseconds()));
+    REQUIRE(context.GetQueuedFrameCount() == 0);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+
+    const Context::FrameCounters counters = context.GetFrameCounters();
+    REQUIRE(counters.framesPresented == 0);
+    REQUIRE(counters.framesDropped == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Group Present All", "[context][context_group]")
+{
+    Context::Config contextConfig;
+    contextConfig.graphicsAPI = Context::GraphicsAPI::NATIVE;
+    contextConfig.windowConfig.initialPositionX = 100;
+    contextConfig.windowConfig.initialPositionY = 100;
+    Context context1(contextConfig);
+    contextConfig.windowConfig.initialPositionX = 200;
+    contextConfig.windowConfig.initialPositionY = 200;
+    Context context2(contextConfig);
+    if (!context1.GetBuffer().GetData() || !context2.GetBuffer().GetData())
+    {
+        // The graphics API is not supported.
+        return;
+    }
+
+    ContextGroup contextGroup;
+    contextGroup.AddContext(context1);
+    contextGroup.AddContext(context2);
+    REQUIRE(contextGroup.GetContextCount() == 2);
+
+    // Every context in the group is presented each frame, and each
+    // context removed from the group is no longer presented by it.
+    constexpr uint64_t frameCount = 30;
+    for (uint64_t frame = 0; frame < frameCount; ++frame)
+    {
+        contextGroup.OnFrameStart();
+        contextGroup.PresentAll();
+    }
+    REQUIRE(context1.GetFrameCounters().framesPresented == frameCount);
+    REQUIRE(context2.GetFrameCounters().framesPresented == frameCount);
+
+    contextGroup.RemoveContext(context1);
+    REQUIRE(contextGroup.GetContextCount() == 1);
+    contextGroup.OnFrameStart();
+    contextGroup.PresentAll();
+    REQUIRE(context1.GetFrameCounters().framesPresented == frameCount);
+    REQUIRE(context2.GetFrameCounters().framesPresented == frameCount + 1);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Group Present All Invalid", "[context][context_group][invalid]")
+{
+    Context::Config contextConfig;
+    contextConfig.graphicsAPI = Context::GraphicsAPI::NONE;
+    Context context(contextConfig);
+
+    ContextGroup contextGroup;
+    contextGroup.AddContext(context);
+    contextGroup.AddContext(context);
+    REQUIRE(contextGroup.GetContextCount() == 1);
+    contextGroup.OnFrameStart();
+    contextGroup.PresentAll();
+    REQUIRE(context.GetFrameCounters().framesPresented == 0);
+
+    contextGroup.RemoveContext(context);
+    contextGroup.RemoveContext(context);
+    REQUIRE(contextGroup.GetContextCount() == 0);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Mirror Window", "[context][mirror_window]")
+{
+    Context::Config contextConfig;
+    contextConfig.graphicsAPI = Context::GraphicsAPI::OPENGL;
+    contextConfig.windowConfig.initialPositionX = 100;
+    contextConfig.windowConfig.initialPositionY = 100;
+    Context context(contextConfig);
+
+    Window::Config windowConfig;
+    windowConfig.initialPositionX = 200;
+    windowConfig.initialPositionY = 200;
+    Window* mirrorWindow = context.AddMirrorWindow(windowConfig);
+    if (!mirrorWindow)
+    {
+        // Mirror windows are not supported.
+        REQUIRE(context.GetMirrorWindowCount() == 0);
+        return;
+    }
+    REQUIRE(context.GetMirrorWindowCount() == 1);
+
+    // The mirror window displays the left half of the buffer, and
+    // is presented with the context (which still presents each frame).
+    const Buffer& buffer = context.GetBuffer();
+    Buffer::Viewport viewport;
+    viewport.width = static_cast<float>(buffer.GetWidth()) * 0.5f;
+    viewport.height = static_cast<float>(buffer.GetHeight());
+    context.SetMirrorViewport(mirrorWindow, viewport);
+
+    constexpr uint64_t frameCount = 30;
+    for (uint64_t frame = 0; frame < frameCount; ++frame)
+    {
+        context.OnFrameStart();
+        context.OnFrameEnded();
+    }
+    REQUIRE(context.GetFrameCounters().framesPresented == frameCount);
+
+    context.RemoveMirrorWindow(mirrorWindow);
+    REQUIRE(context.GetMirrorWindowCount() == 0);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    REQUIRE(context.GetFrameCounters().framesPresented == frameCount + 1);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Mirror Window Invalid", "[context][mirror_window][invalid]")
+{
+    Context::Config contextConfig;
+    contextConfig.graphicsAPI = Context::GraphicsAPI::NONE;
+    Context context(contextConfig);
+
+    Window::Config windowConfig;
+    REQUIRE(context.AddMirrorWindow(windowConfig) == nullptr);
+    REQUIRE(context.GetMirrorWindowCount() == 0);
+    context.RemoveMirrorWindow(nullptr);
+    context.SetMirrorViewport(nullptr, Buffer::Viewport());
+    REQUIRE(context.GetMirrorWindowCount() == 0);
+}
+
 //--------------------------------------------------------------
 void TestContextThreads(TestParams a_testParams)
 {
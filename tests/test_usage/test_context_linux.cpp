@@ -0,0 +1,111 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#if defined(__linux__)
+
+#include <simple/display/context.h>
+#include <simple/display/context_group.h>
+#include <catch2/catch.hpp>
+
+#include <X11/Xlib.h>
+
+// Simple::Display::Window is not brought into scope, because
+// it would be ambiguous with the native X11 Window type.
+using Simple::Display::Context;
+using Simple::Display::ContextGroup;
+
+//--------------------------------------------------------------
+inline void SendNativeCloseRequest(Simple::Display::Window& a_window)
+{
+    // Send the message that the window manager sends when a window
+    // is closed by the user, then wait until it has been received.
+    ::Display* nativeDisplay = (::Display*)a_window.GetNativeDisplayHandle();
+    ::Window nativeWindow = *(::Window*)a_window.GetNativeWindowHandle();
+    XEvent event = {};
+    event.xclient.type = ClientMessage;
+    event.xclient.window = nativeWindow;
+    event.xclient.message_type = XInternAtom(nativeDisplay, "WM_PROTOCOLS", False);
+    event.xclient.format = 32;
+    event.xclient.data.l[0] = (long)XInternAtom(nativeDisplay, "WM_DELETE_WINDOW", False);
+    event.xclient.data.l[1] = CurrentTime;
+    XSendEvent(nativeDisplay, nativeWindow, False, NoEventMask, &event);
+    XSync(nativeDisplay, False);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Mirror Window Close", "[context][mirror_window][close]")
+{
+    Context::Config contextConfig;
+    contextConfig.graphicsAPI = Context::GraphicsAPI::OPENGL;
+    Context context(contextConfig);
+
+    Simple::Display::Window::Config windowConfig;
+    windowConfig.initialPositionX = 200;
+    windowConfig.initialPositionY = 200;
+    Simple::Display::Window* mirrorWindow = context.AddMirrorWindow(windowConfig);
+    if (!mirrorWindow)
+    {
+        // Mirror windows are not supported.
+        return;
+    }
+    Simple::Display::Window* window = context.GetWindow();
+    REQUIRE(window);
+
+    // Closing a mirror window only closes the mirror window, even
+    // though it shares the native display of the context window.
+    SendNativeCloseRequest(*mirrorWindow);
+    context.OnFrameStart();
+    context.OnFrameEnded();
+    REQUIRE(mirrorWindow->IsClosed());
+    REQUIRE(!window->IsClosed());
+    REQUIRE(context.GetFrameCounters().framesPresented == 1);
+
+    // Closing the context window does not close the mirror window.
+    context.RemoveMirrorWindow(mirrorWindow);
+    mirrorWindow = context.AddMirrorWindow(windowConfig);
+    REQUIRE(mirrorWindow);
+    SendNativeCloseRequest(*window);
+    context.OnFrameStart();
+    REQUIRE(window->IsClosed());
+    REQUIRE(!mirrorWindow->IsClosed());
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Context Group Close", "[context][context_group][close]")
+{
+    Context::Config contextConfig;
+    contextConfig.graphicsAPI = Context::GraphicsAPI::OPENGL;
+    contextConfig.windowConfig.initialPositionX = 100;
+    contextConfig.windowConfig.initialPositionY = 100;
+    Context context1(contextConfig);
+    contextConfig.windowConfig.initialPositionX = 200;
+    contextConfig.windowConfig.initialPositionY = 200;
+    Context context2(contextConfig);
+    Simple::Display::Window* window1 = context1.GetWindow();
+    Simple::Display::Window* window2 = context2.GetWindow();
+    if (!window1 || !window2)
+    {
+        // The graphics API is not supported.
+        return;
+    }
+
+    ContextGroup contextGroup;
+    contextGroup.AddContext(context1);
+    contextGroup.AddContext(context2);
+
+    // Closing the window of one context in the group only closes it,
+    // even though the windows share the native display of the thread.
+    SendNativeCloseRequest(*window2);
+    contextGroup.OnFrameStart();
+    contextGroup.PresentAll();
+    REQUIRE(!window1->IsClosed());
+    REQUIRE(window2->IsClosed());
+    REQUIRE(context1.GetFrameCounters().framesPresented == 1);
+}
+
+#endif // defined(__linux__)
@@ -0,0 +1,308 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <simple/display/pixel_view.h>
+#include <simple/display/context.h>
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+using namespace Simple::Display;
+
+//--------------------------------------------------------------
+template<Buffer::Format FormatType>
+inline void RequirePixelTraits()
+{
+    using Traits = PixelTraits<FormatType>;
+    static_assert(Traits::BytesPerPixel == Buffer::BytesPerPixel(FormatType), "");
+    static_assert(Traits::BytesPerChannel == Buffer::BytesPerChannel(FormatType), "");
+    static_assert(Traits::ChannelsPerPixel == Buffer::ChannelsPerPixel(FormatType), "");
+    REQUIRE(sizeof(typename Traits::Pixel) == Buffer::BytesPerPixel(FormatType));
+}
+
+//--------------------------------------------------------------
+template<Buffer::Format FormatType>
+inline void RequirePixelView(const Buffer& a_buffer)
+{
+    using View = PixelView<FormatType>;
+    using Pixel = typename View::Pixel;
+
+    View view(a_buffer);
+    REQUIRE(!view.IsEmpty());
+    REQUIRE(view.GetData() == a_buffer.GetData());
+    REQUIRE(view.GetWidth() == a_buffer.GetWidth());
+    REQUIRE(view.GetHeight() == a_buffer.GetHeight());
+    REQUIRE(view.GetPitch() == a_buffer.GetPitch());
+
+    // Rows must begin on the pitch, not the packed pixel width.
+    const uint8_t* bufferData = static_cast<uint8_t*>(a_buffer.GetData());
+    for (uint32_t y = 0; y < view.GetHeight(); ++y)
+    {
+        const typename View::Row row = view.GetRow(y);
+        REQUIRE(row.size() == view.GetWidth());
+        REQUIRE(reinterpret_cast<const uint8_t*>(row.begin()) ==
+                bufferData + y * a_buffer.GetPitch());
+        for (Pixel& pixel : row)
+        {
+            pixel = Pixel{};
+        }
+    }
+    REQUIRE(&view(view.GetWidth() - 1, view.GetHeight() - 1) + 1 ==
+            view.GetRow(view.GetHeight() - 1).end());
+
+    // Views of other formats or interop must be empty.
+    REQUIRE(PixelView<FormatType, Buffer::Interop::CUDA>(a_buffer).IsEmpty());
+    if (FormatType != Buffer::Format::RGBA_UINT8)
+    {
+        REQUIRE(PixelView<Buffer::Format::RGBA_UINT8>(a_buffer).IsEmpty());
+    }
+    else
+    {
+        REQUIRE(PixelView<Buffer::Format::RGBA_FLOAT>(a_buffer).IsEmpty());
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Pixel View Traits", "[pixel_view][traits]")
+{
+    RequirePixelTraits<Buffer::Format::RGBA_FLOAT>();
+    RequirePixelTraits<Buffer::Format::RGBA_UINT8>();
+    RequirePixelTraits<Buffer::Format::RGBA_UINT16>();
+    RequirePixelTraits<Buffer::Format::RGB10A2_UNORM>();
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Pixel View Empty", "[pixel_view][empty]")
+{
+    PixelView<Buffer::Format::RGBA_UINT8> view;
+    REQUIRE(view.IsEmpty());
+    REQUIRE(!view.GetData());
+    REQUIRE(view.GetWidth() == 0);
+    REQUIRE(view.GetHeight() == 0);
+    REQUIRE(view.GetPitch() == 0);
+    REQUIRE(view.SubView(0, 0, 1, 1).IsEmpty());
+
+    Context context({ {}, {}, Context::GraphicsAPI::NONE });
+    REQUIRE(PixelView<Buffer::Format::RGBA_UINT8>(context.GetBuffer()).IsEmpty());
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Pixel View Rows", "[pixel_view][rows]")
+{
+    using View = PixelView<Buffer::Format::RGBA_UINT16>;
+    constexpr uint32_t width = 3;
+    constexpr uint32_t height = 4;
+    constexpr uint32_t pitch = 32; // Includes 8 bytes of padding.
+    std::vector<uint64_t> data(height * pitch / sizeof(uint64_t), 0);
+
+    View view(reinterpret_cast<View::Pixel*>(data.data()), width, height, pitch);
+    REQUIRE(!view.IsEmpty());
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        uint16_t x = 0;
+        for (View::Pixel& pixel : view.GetRow(y))
+        {
+            pixel = { x++, static_cast<uint16_t>(y), 0, 0xFFFF };
+        }
+    }
+
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        // The padding at the end of each row must be untouched.
+        REQUIRE(data[y * pitch / sizeof(uint64_t) + width] == 0);
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            REQUIRE(view(x, y).r == x);
+            REQUIRE(view(x, y).g == y);
+            REQUIRE(view.GetRow(y)[x].a == 0xFFFF);
+        }
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Pixel View Sub View", "[pixel_view][sub_view]")
+{
+    using View = PixelView<Buffer::Format::RGB10A2_UNORM>;
+    constexpr uint32_t width = 8;
+    constexpr uint32_t height = 6;
+    constexpr uint32_t pitch = width * sizeof(View::Pixel);
+    std::vector<View::Pixel> data(width * height, View::Pixel{ 0 });
+    View view(data.data(), width, height, pitch);
+
+    SECTION("Inside")
+    {
+        View subView = view.SubView(2, 1, 4, 3);
+        REQUIRE(subView.GetWidth() == 4);
+        REQUIRE(subView.GetHeight() == 3);
+        REQUIRE(subView.GetPitch() == pitch);
+        REQUIRE(&subView(0, 0) == &view(2, 1));
+        REQUIRE(&subView(3, 2) == &view(5, 3));
+
+        const uint32_t white = Buffer::PackRGB10A2(1.0f, 1.0f, 1.0f, 1.0f);
+        for (uint32_t y = 0; y < subView.GetHeight(); ++y)
+        {
+            for (View::Pixel& pixel : subView.GetRow(y))
+            {
+                pixel.rgba = white;
+            }
+        }
+
+        uint32_t count = 0;
+        for (const View::Pixel& pixel : data)
+        {
+            count += (pixel.rgba == white);
+        }
+        REQUIRE(count == 4 * 3);
+        REQUIRE(view(1, 1).rgba == 0);
+        REQUIRE(view(6, 1).rgba == 0);
+        REQUIRE(view(2, 0).rgba == 0);
+        REQUIRE(view(2, 4).rgba == 0);
+    }
+
+    SECTION("Clamped")
+    {
+        View subView = view.SubView(6, 4, 10, 10);
+        REQUIRE(subView.GetWidth() == 2);
+        REQUIRE(subView.GetHeight() == 2);
+        REQUIRE(&subView(1, 1) == &view(7, 5));
+    }
+
+    SECTION("Outside")
+    {
+        REQUIRE(view.SubView(width, 0, 1, 1).IsEmpty());
+        REQUIRE(view.SubView(0, height, 1, 1).IsEmpty());
+        REQUIRE(view.SubView(0, 0, 0, 1).IsEmpty());
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Pixel View Tiled", "[pixel_view][tiled]")
+{
+    static_assert(PixelIndex<Buffer::Layout::LINEAR>(24, 9, 2) == 57, "");
+    static_assert(PixelIndex<Buffer::Layout::TILED_8X8>(24, 9, 2) == 81, "");
+    static_assert(PixelIndex<Buffer::Layout::TILED_16X16>(32, 17, 18) == 801, "");
+    static_assert(PixelIndex<Buffer::Layout::MORTON_16X16>(32, 3, 5) == 39, "");
+    static_assert(PixelIndex<Buffer::Layout::MORTON_16X16>(32, 17, 18) == 777, "");
+
+    SECTION("Layout::TILED_8X8")
+    {
+        using View = PixelView<Buffer::Format::RGBA_UINT8,
+                               Buffer::Interop::NONE,
+                               Buffer::Layout::TILED_8X8>;
+        constexpr uint32_t width = 20;
+        constexpr uint32_t height = 12;
+        constexpr uint32_t pitch = 24 * sizeof(View::Pixel);
+        std::vector<View::Pixel> data(24 * 16, View::Pixel{});
+        View view(data.data(), width, height, pitch);
+        REQUIRE(view.TileSize == 8);
+        REQUIRE(view.GetTileCountX() == 3);
+        REQUIRE(view.GetTileCountY() == 2);
+        REQUIRE(&view(9, 2) == data.data() + 81);
+
+        // Each tile must be contiguous, and clamped at the edges.
+        View::Tile tile = view.GetTile(2, 1);
+        REQUIRE(tile.GetWidth() == 4);
+        REQUIRE(tile.GetHeight() == 4);
+        REQUIRE(tile.GetPitch() == 8 * sizeof(View::Pixel));
+        REQUIRE(&tile(0, 0) == &view(16, 8));
+        REQUIRE(&tile(3, 3) == &view(19, 11));
+        REQUIRE(tile.GetRow(1).begin() == tile.GetRow(0).begin() + 8);
+        REQUIRE(view.GetTile(3, 0).IsEmpty());
+        REQUIRE(view.GetTile(0, 2).IsEmpty());
+    }
+
+    SECTION("Layout::MORTON_16X16")
+    {
+        using View = PixelView<Buffer::Format::RGBA_FLOAT,
+                               Buffer::Interop::NONE,
+                               Buffer::Layout::MORTON_16X16>;
+        constexpr uint32_t width = 20;
+        constexpr uint32_t height = 20;
+        constexpr uint32_t pitch = 32 * sizeof(View::Pixel);
+        std::vector<View::Pixel> data(32 * 32, View::Pixel{});
+        View view(data.data(), width, height, pitch);
+        REQUIRE(view.GetTileCountX() == 2);
+        REQUIRE(view.GetTileCountY() == 2);
+
+        // Every pixel must map to a unique location.
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                REQUIRE(view(x, y).a == 0.0f);
+                view(x, y).a = 1.0f;
+            }
+        }
+        REQUIRE(&view(17, 18) == data.data() + 777);
+
+        View::Tile tile = view.GetTile(1, 1);
+        REQUIRE(tile.GetWidth() == 4);
+        REQUIRE(tile.GetHeight() == 4);
+        REQUIRE(&tile(1, 2) == &view(17, 18));
+    }
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Pixel View Buffer", "[pixel_view][buffer]")
+{
+    Buffer::Config bufferConfig;
+    bufferConfig.width = 101;
+    bufferConfig.height = 61;
+    bufferConfig.pitchAlignment = 256;
+
+    SECTION("Format::RGBA_FLOAT")
+    {
+        bufferConfig.format = Buffer::Format::RGBA_FLOAT;
+        Context context({ bufferConfig, {} });
+        RequirePixelView<Buffer::Format::RGBA_FLOAT>(context.GetBuffer());
+    }
+
+    SECTION("Format::RGBA_UINT8")
+    {
+        bufferConfig.format = Buffer::Format::RGBA_UINT8;
+        Context context({ bufferConfig, {} });
+        RequirePixelView<Buffer::Format::RGBA_UINT8>(context.GetBuffer());
+    }
+
+    SECTION("Format::RGBA_UINT16")
+    {
+        bufferConfig.format = Buffer::Format::RGBA_UINT16;
+        Context context({ bufferConfig, {} });
+        RequirePixelView<Buffer::Format::RGBA_UINT16>(context.GetBuffer());
+    }
+
+    SECTION("Format::RGB10A2_UNORM")
+    {
+        bufferConfig.format = Buffer::Format::RGB10A2_UNORM;
+        Context context({ bufferConfig, {} });
+        RequirePixelView<Buffer::Format::RGB10A2_UNORM>(context.GetBuffer());
+    }
+
+    SECTION("Layout::TILED_16X16")
+    {
+        using View = PixelView<Buffer::Format::RGBA_UINT8,
+                               Buffer::Interop::NONE,
+                               Buffer::Layout::TILED_16X16>;
+        bufferConfig.layout = Buffer::Layout::TILED_16X16;
+        Context context({ bufferConfig, {} });
+        const Buffer& buffer = context.GetBuffer();
+
+        // Linear views of tiled buffers must be empty, and vice versa.
+        REQUIRE(PixelView<Buffer::Format::RGBA_UINT8>(buffer).IsEmpty() ==
+                (buffer.GetLayout() != Buffer::Layout::LINEAR));
+        View view(buffer);
+        REQUIRE(view.IsEmpty() == (buffer.GetLayout() != Buffer::Layout::TILED_16X16));
+        if (!view.IsEmpty())
+        {
+            REQUIRE(view.GetTileCountX() == 7);
+            REQUIRE(view.GetTileCountY() == 4);
+            const uint8_t* last = reinterpret_cast<const uint8_t*>(&view(100, 60));
+            REQUIRE(last < static_cast<uint8_t*>(buffer.GetData()) + buffer.GetSize());
+        }
+    }
+}
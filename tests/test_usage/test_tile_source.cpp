@@ -0,0 +1,286 @@
+//--------------------------------------------------------------
+// Copyright (c) David Bosnich <david.bosnich.public@gmail.com>
+//
+// This code is licensed under the MIT License, a copy of which
+// can be found in the license.txt file included at the root of
+// this distribution, or at https://opensource.org/licenses/MIT
+//--------------------------------------------------------------
+
+#include <simple/display/tile_source.h>
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace Simple::Display;
+
+//--------------------------------------------------------------
+// Each pixel stores its level, column, and row in the image.
+//--------------------------------------------------------------
+inline uint32_t TilePixel(uint32_t a_level, uint32_t a_x, uint32_t a_y)
+{
+    return (a_level << 24) | (a_y << 12) | a_x;
+}
+
+//--------------------------------------------------------------
+inline void WriteTiledFile(const TileSource::Config& a_config)
+{
+    std::vector<uint8_t> file(TileSource::FileSizeBytes(a_config), 0xFF);
+    for (uint32_t level = 0; level < a_config.levelCount; ++level)
+    {
+        for (uint32_t y = 0; y < TileSource::LevelHeight(a_config, level); ++y)
+        {
+            for (uint32_t x = 0; x < TileSource::LevelWidth(a_config, level); ++x)
+            {
+                const uint32_t tileX = x / a_config.tileSize;
+                const uint32_t tileY = y / a_config.tileSize;
+                const uint64_t offset = TileSource::TileOffsetBytes(a_config, level,
+                                                                    tileX, tileY) +
+                    ((y % a_config.tileSize) * a_config.tileSize +
+                     (x % a_config.tileSize)) * sizeof(uint32_t);
+                const uint32_t pixel = TilePixel(level, x, y);
+                memcpy(file.data() + offset, &pixel, sizeof(pixel));
+            }
+        }
+    }
+
+    FILE* stream = fopen(a_config.filePathUTF8.c_str(), "wb");
+    REQUIRE(stream != nullptr);
+    REQUIRE(fwrite(file.data(), 1, file.size(), stream) == file.size());
+    fclose(stream);
+}
+
+//--------------------------------------------------------------
+// Update until all requested tiles have been read from the file.
+//--------------------------------------------------------------
+inline void UpdateUntilRead(TileSource& a_source,
+                            std::vector<uint32_t>& o_pixels,
+                            uint32_t a_width,
+                            uint32_t a_height)
+{
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        REQUIRE(a_source.Update(o_pixels.data(), a_width, a_height,
+                                a_width * sizeof(uint32_t)));
+        if (!a_source.GetPendingTileCount())
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    REQUIRE(a_source.GetPendingTileCount() == 0);
+    REQUIRE(a_source.Update(o_pixels.data(), a_width, a_height,
+                            a_width * sizeof(uint32_t)));
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Tile Source Layout", "[tile_source][layout]")
+{
+    TileSource::Config config;
+    config.width = 1000;
+    config.height = 600;
+    config.levelCount = 3;
+    const uint64_t tileSizeBytes = 256 * 256 * 4;
+
+    REQUIRE(TileSource::LevelWidth(config, 0) == 1000);
+    REQUIRE(TileSource::LevelHeight(config, 0) == 600);
+    REQUIRE(TileSource::LevelWidth(config, 2) == 250);
+    REQUIRE(TileSource::LevelHeight(config, 2) == 150);
+    REQUIRE(TileSource::LevelWidth(config, 10) == 1);
+    REQUIRE(TileSource::LevelHeight(config, 31) == 1);
+    REQUIRE(TileSource::TileCountX(config, 0) == 4);
+    REQUIRE(TileSource::TileCountY(config, 0) == 3);
+    REQUIRE(TileSource::TileCountX(config, 1) == 2);
+    REQUIRE(TileSource::TileCountY(config, 1) == 2);
+    REQUIRE(TileSource::TileCountX(config, 2) == 1);
+    REQUIRE(TileSource::TileCountY(config, 2) == 1);
+    REQUIRE(TileSource::TileSizeBytes(config) == tileSizeBytes);
+    REQUIRE(TileSource::TileOffsetBytes(config, 0, 1, 2) == 9 * tileSizeBytes);
+    REQUIRE(TileSource::TileOffsetBytes(config, 1, 1, 1) == 15 * tileSizeBytes);
+    REQUIRE(TileSource::FileSizeBytes(config) == 17 * tileSizeBytes);
+
+    config.fileOffset = 16;
+    config.format = Buffer::Format::RGBA_UINT16;
+    REQUIRE(TileSource::TileSizeBytes(config) == 2 * tileSizeBytes);
+    REQUIRE(TileSource::FileSizeBytes(config) == 34 * tileSizeBytes + 16);
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Tile Source Invalid", "[tile_source][invalid]")
+{
+    TileSource::Config config;
+    config.filePathUTF8 = "test_tile_source_invalid.raw";
+    config.width = 64;
+    config.height = 64;
+    config.tileSize = 32;
+    std::vector<uint32_t> pixels(16 * 16);
+
+    SECTION("Missing File")
+    {
+        TileSource source(config);
+        REQUIRE(!source.IsOpen());
+        REQUIRE(!source.Update(pixels.data(), 16, 16, 16 * 4));
+    }
+    SECTION("Small File")
+    {
+        WriteTiledFile(config);
+        config.height = 65;
+        TileSource source(config);
+        REQUIRE(!source.IsOpen());
+    }
+    SECTION("Invalid Config")
+    {
+        WriteTiledFile(config);
+        config.tileSize = 0;
+        TileSource source(config);
+        REQUIRE(!source.IsOpen());
+    }
+    SECTION("Invalid Pixels")
+    {
+        WriteTiledFile(config);
+        TileSource source(config);
+        REQUIRE(source.IsOpen());
+        REQUIRE(!source.Update(nullptr, 16, 16, 16 * 4));
+        REQUIRE(!source.Update(pixels.data(), 0, 16, 16 * 4));
+        REQUIRE(!source.Update(pixels.data(), 16, 16, 15 * 4));
+    }
+    SECTION("Invalid Context")
+    {
+        WriteTiledFile(config);
+        TileSource source(config);
+        Context context({ {}, {}, Context::GraphicsAPI::NONE });
+        REQUIRE(!source.Update(context));
+    }
+    remove(config.filePathUTF8.c_str());
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Tile Source Update", "[tile_source][update]")
+{
+    TileSource::Config config;
+    config.filePathUTF8 = "test_tile_source_update.raw";
+    config.width = 300;
+    config.height = 200;
+    config.tileSize = 64;
+    config.levelCount = 3;
+    WriteTiledFile(config);
+
+    TileSource source(config);
+    REQUIRE(source.IsOpen());
+
+    uint32_t width = 150;
+    uint32_t height = 100;
+    uint32_t level = 1;
+    Buffer::Viewport viewport;
+    const auto expectedPixel = [&](uint32_t a_x, uint32_t a_y) -> uint32_t
+    {
+        const Buffer::Viewport region = (viewport.width > 0.0f) ?
+            viewport : Buffer::Viewport{ 0.0f, 0.0f, 300.0f, 200.0f };
+        const double x = region.x + (a_x + 0.5) * region.width / width;
+        const double y = region.y + (a_y + 0.5) * region.height / height;
+        if (x < 0.0 || y < 0.0 || x >= 300.0 || y >= 200.0)
+        {
+            return 0;
+        }
+        return TilePixel(level,
+                         static_cast<uint32_t>(x) >> level,
+                         static_cast<uint32_t>(y) >> level);
+    };
+
+    SECTION("Entire")
+    {
+    }
+    SECTION("Zoomed In")
+    {
+        viewport = { 100.0f, 50.0f, 75.0f, 50.0f };
+        level = 0;
+    }
+    SECTION("Zoomed Out")
+    {
+        width = 60;
+        height = 40;
+        level = 2;
+    }
+    SECTION("Across")
+    {
+        viewport = { -100.0f, 150.0f, 300.0f, 200.0f };
+    }
+    SECTION("Outside")
+    {
+        viewport = { 300.0f, 0.0f, 300.0f, 200.0f };
+    }
+
+    std::vector<uint32_t> pixels(width * height, 0xFFFFFFFF);
+    source.SetViewport(viewport);
+    REQUIRE(source.GetViewport().x == viewport.x);
+    REQUIRE(source.GetViewport().width == viewport.width);
+    UpdateUntilRead(source, pixels, width, height);
+    REQUIRE(source.GetLevel() == level);
+
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            REQUIRE(pixels[y * width + x] == expectedPixel(x, y));
+        }
+    }
+    remove(config.filePathUTF8.c_str());
+}
+
+//--------------------------------------------------------------
+TEST_CASE("Test Tile Source Cache", "[tile_source][cache]")
+{
+    TileSource::Config config;
+    config.filePathUTF8 = "test_tile_source_cache.raw";
+    config.width = 512;
+    config.height = 512;
+    config.tileSize = 16;
+    config.levelCount = 2;
+    config.cacheTileCount = 24;
+    WriteTiledFile(config);
+
+    TileSource source(config);
+    REQUIRE(source.IsOpen());
+
+    // Pan across the image, never keeping more tiles than allowed.
+    const uint32_t size = 32;
+    std::vector<uint32_t> pixels(size * size);
+    for (uint32_t step = 0; step < 16; ++step)
+    {
+        const float offset = static_cast<float>(step * 28);
+        source.SetViewport({ offset, offset, 32.0f, 32.0f });
+        UpdateUntilRead(source, pixels, size, size);
+        REQUIRE(source.GetLevel() == 0);
+        REQUIRE(source.GetCachedTileCount() <= config.cacheTileCount);
+
+        for (uint32_t y = 0; y < size; ++y)
+        {
+            for (uint32_t x = 0; x < size; ++x)
+            {
+                const uint32_t imageX = static_cast<uint32_t>(offset) + x;
+                const uint32_t imageY = static_cast<uint32_t>(offset) + y;
+                const uint32_t expected = (imageX < 512 && imageY < 512) ?
+                                          TilePixel(0, imageX, imageY) : 0;
+                REQUIRE(pixels[y * size + x] == expected);
+            }
+        }
+    }
+
+    // Tiles that are not cached are drawn from a coarser level.
+    source.SetViewport({ 0.0f, 480.0f, 32.0f, 32.0f });
+    REQUIRE(source.Update(pixels.data(), size, size, size * sizeof(uint32_t)));
+    for (uint32_t y = 0; y < size; ++y)
+    {
+        for (uint32_t x = 0; x < size; ++x)
+        {
+            const uint32_t pixel = pixels[y * size + x];
+            REQUIRE((pixel == TilePixel(0, x, 480 + y) ||
+                     pixel == TilePixel(1, x / 2, (480 + y) / 2) ||
+                     pixel == 0));
+        }
+    }
+    remove(config.filePathUTF8.c_str());
+}